@@ -24,6 +24,8 @@ CanBusDriver::CanBusDriver(QString adress)
     : _adress(std::move(adress))
 {
     _state = DISCONNECTED;
+    _canFd = false;
+    _txEcho = false;
 }
 
 CanBusDriver::State CanBusDriver::state() const
@@ -31,6 +33,43 @@ CanBusDriver::State CanBusDriver::state() const
     return _state;
 }
 
+/**
+ * @brief returns true if the device sends and receives CAN FD frames, known after connection
+ */
+bool CanBusDriver::isCanFd() const
+{
+    return _canFd;
+}
+
+void CanBusDriver::setCanFd(bool canFd)
+{
+    _canFd = canFd;
+}
+
+/**
+ * @brief rounds size up to the next valid CAN FD payload size (0-8, 12, 16, 20, 24, 32, 48, 64)
+ */
+int CanBusDriver::canFdPayloadSize(int size)
+{
+    if (size <= 8)
+    {
+        return size;
+    }
+    if (size <= 24)
+    {
+        return (size + 3) & ~3;
+    }
+    if (size <= 32)
+    {
+        return 32;
+    }
+    if (size <= 48)
+    {
+        return 48;
+    }
+    return 64;
+}
+
 bool CanBusDriver::connectDevice()
 {
     return false;
@@ -51,6 +90,43 @@ bool CanBusDriver::writeFrame(const QCanBusFrame &qtframe)
     return false;
 }
 
+/**
+ * @brief writes count frames
+ * @return number of frames written, stops at the first refused frame
+ */
+int CanBusDriver::writeFrames(const QCanBusFrame *frames, int count)
+{
+    int written = 0;
+    while (written < count && writeFrame(frames[written]))
+    {
+        written++;
+    }
+    return written;
+}
+
+/**
+ * @brief returns true if sent frames are received back with the local echo flag and their transmission timestamp
+ */
+bool CanBusDriver::hasTxEcho() const
+{
+    return _txEcho;
+}
+
+void CanBusDriver::setTxEcho(bool txEcho)
+{
+    _txEcho = txEcho;
+}
+
+/**
+ * @brief sets the receive filters of standard frames, an empty list accepts all frames
+ * @return false if the driver does not support filtering
+ */
+bool CanBusDriver::setFilters(const QList<CanBusDriver::Filter> &filters)
+{
+    Q_UNUSED(filters);
+    return false;
+}
+
 void CanBusDriver::setState(const State &state)
 {
     bool stateChange = (_state != state);
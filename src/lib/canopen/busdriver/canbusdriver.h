@@ -21,6 +21,7 @@
 
 #include "canopen_global.h"
 
+#include <QList>
 #include <QObject>
 
 #include "busdriver/qcanbusframe.h"
@@ -40,11 +41,23 @@ public:
     };
     State state() const;
 
+    bool isCanFd() const;
+    static int canFdPayloadSize(int size);
+
     virtual bool connectDevice();
     virtual void disconnectDevice();
 
     virtual QCanBusFrame readFrame();
     virtual bool writeFrame(const QCanBusFrame &qtframe);
+    virtual int writeFrames(const QCanBusFrame *frames, int count);
+    bool hasTxEcho() const;
+
+    struct Filter
+    {
+        quint32 id;
+        quint32 mask;  // frame accepted if (frameId & mask) == (id & mask)
+    };
+    virtual bool setFilters(const QList<Filter> &filters);
 
 signals:
     void framesReceived();
@@ -53,9 +66,13 @@ signals:
 protected:
     QString _adress;
     void setState(const State &state);
+    void setCanFd(bool canFd);
+    void setTxEcho(bool txEcho);
 
 private:
     State _state;
+    bool _canFd;
+    bool _txEcho;
 };
 
 #endif  // CANBUSDRIVER_H
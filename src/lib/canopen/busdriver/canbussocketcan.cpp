@@ -23,6 +23,8 @@
 #include <unistd.h>
 
 #include <linux/can.h>
+#include <linux/can/error.h>
+#include <linux/can/raw.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
@@ -33,8 +35,62 @@
 using namespace std;
 
 #include <QDebug>
+#include <QVector>
 
-int createSocketCan(const QString &adress)
+/**
+ * @brief converts qtframe to a raw frame
+ * @return size to write (CAN_MTU or CANFD_MTU), -1 if the frame can not be sent
+ */
+static int toCanFdFrame(const QCanBusFrame &qtframe, struct canfd_frame &frame, bool canFd)
+{
+    memset(&frame, 0, sizeof(frame));
+
+    frame.can_id = qtframe.frameId();
+    if (qtframe.hasExtendedFrameFormat())
+    {
+        frame.can_id |= CAN_EFF_FLAG;
+    }
+
+    if (qtframe.frameType() == QCanBusFrame::RemoteRequestFrame)
+    {
+        frame.can_id += CAN_RTR_FLAG;
+    }
+
+    const QByteArray payload = qtframe.payload();
+    int mtu = CAN_MTU;
+    if (qtframe.hasFlexibleDataRateFormat())
+    {
+        if (!canFd || payload.size() > CANFD_MAX_DLEN)
+        {
+            return -1;
+        }
+        mtu = CANFD_MTU;
+        frame.len = static_cast<__u8>(CanBusDriver::canFdPayloadSize(payload.size()));  // padded with zeros
+#ifdef CANFD_FDF
+        frame.flags = CANFD_FDF;
+#endif
+        if (qtframe.hasBitrateSwitch())
+        {
+            frame.flags |= CANFD_BRS;
+        }
+        if (qtframe.hasErrorStateIndicator())
+        {
+            frame.flags |= CANFD_ESI;
+        }
+    }
+    else
+    {
+        if (payload.size() > CAN_MAX_DLEN)
+        {
+            return -1;
+        }
+        frame.len = static_cast<__u8>(payload.size());
+    }
+    memcpy(frame.data, payload.constData(), static_cast<size_t>(payload.size()));
+    return mtu;
+}
+
+int createSocketCan(const QString &adress, bool &canFd, bool &txEcho)
 {
     struct ifreq ifr;
     struct sockaddr_can addr;
@@ -58,6 +114,22 @@ int createSocketCan(const QString &adress)
 
     addr.can_ifindex = ifr.ifr_ifindex;
 
+    // CAN FD frames enabled if the interface MTU allows it
+    canFd = false;
+    if (ioctl(can_socket, SIOCGIFMTU, &ifr) >= 0 && ifr.ifr_mtu == CANFD_MTU)
+    {
+        int enableFd = 1;
+        canFd = (setsockopt(can_socket, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enableFd, sizeof(enableFd)) == 0);
+    }
+
+    // own frames are received back with MSG_CONFIRM flag and the transmission timestamp
+    int recvOwnMsgs = 1;
+    txEcho = (setsockopt(can_socket, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &recvOwnMsgs, sizeof(recvOwnMsgs)) == 0);
+
+    // bus error frames are received for statistics and log
+    can_err_mask_t errorMask = CAN_ERR_MASK;
+    setsockopt(can_socket, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &errorMask, sizeof(errorMask));
+
     fcntl(can_socket, F_SETFL, O_NONBLOCK);
 
     if (bind(can_socket, (struct sockaddr *)&addr, sizeof(addr)) < 0)
@@ -86,11 +158,16 @@ bool CanBusSocketCAN::connectDevice()
 {
     QMutexLocker socketLocker(&_socketMutex);
 
-    _can_socket = createSocketCan(_adress);
+    bool canFd;
+    bool txEcho;
+    _can_socket = createSocketCan(_adress, canFd, txEcho);
     if (_can_socket < 0)
     {
         return false;
     }
+    setCanFd(canFd);
+    setTxEcho(txEcho);
+    applyFilters(_can_socket, _filters);
 
     _readNotifier = new CanBusSocketCANNotifierThead(this);
     _readNotifier->start();
@@ -124,27 +201,48 @@ QCanBusFrame CanBusSocketCAN::readFrame()
     QMutexLocker socketLocker(&_socketMutex);
     QCanBusFrame qtFrame;
 
-    struct can_frame frame;
-
-    int recvbytes = read(_can_socket, &frame, sizeof(struct can_frame));
-    if (recvbytes < 0)
+    // canfd_frame shares the layout of can_frame, read size gives the frame kind
+    struct canfd_frame frame;
+    struct iovec iov;
+    iov.iov_base = &frame;
+    iov.iov_len = sizeof(struct canfd_frame);
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    int recvbytes = static_cast<int>(recvmsg(_can_socket, &msg, 0));
+    if (recvbytes != CAN_MTU && recvbytes != CANFD_MTU)
     {
         qtFrame.setFrameType(QCanBusFrame::InvalidFrame);
         return qtFrame;
     }
+    qtFrame.setLocalEcho((msg.msg_flags & MSG_CONFIRM) != 0);
 
     struct timeval tv;
     ioctl(_can_socket, SIOCGSTAMP_OLD, &tv);
     qtFrame.setTimeStamp(QCanBusFrame::TimeStamp(tv.tv_sec, tv.tv_usec));
 
-    qtFrame.setFrameId(frame.can_id & 0x1FFFFFFF);
+    if ((frame.can_id & CAN_ERR_FLAG) != 0)
+    {
+        // error classes of linux/can/error.h match QCanBusFrame::FrameError bits
+        qtFrame.setFrameType(QCanBusFrame::ErrorFrame);
+        qtFrame.setExtendedFrameFormat(true);
+        qtFrame.setError(QCanBusFrame::FrameErrors(static_cast<int>(frame.can_id & CAN_ERR_MASK)));
+        qtFrame.setPayload(QByteArray(reinterpret_cast<const char *>(frame.data), CAN_ERR_DLC));
+        return qtFrame;
+    }
+
+    qtFrame.setFrameId(frame.can_id & CAN_EFF_MASK);
+    qtFrame.setExtendedFrameFormat((frame.can_id & CAN_EFF_FLAG) != 0);
 
-    QByteArray payLoad;
-    for (int i = 0; i < frame.can_dlc; i++)
+    qtFrame.setPayload(QByteArray(reinterpret_cast<const char *>(frame.data), frame.len));
+    if (recvbytes == CANFD_MTU)
     {
-        payLoad.append(frame.data[i]);
+        qtFrame.setFlexibleDataRateFormat(true);
+        qtFrame.setBitrateSwitch((frame.flags & CANFD_BRS) != 0);
+        qtFrame.setErrorStateIndicator((frame.flags & CANFD_ESI) != 0);
     }
-    qtFrame.setPayload(payLoad);
 
     qtFrame.setFrameType(QCanBusFrame::DataFrame);
     if ((frame.can_id & CAN_RTR_FLAG) != 0)
@@ -156,26 +254,104 @@ QCanBusFrame CanBusSocketCAN::readFrame()
 }
 
 bool CanBusSocketCAN::writeFrame(const QCanBusFrame &qtframe)
+{
+    return (writeFrames(&qtframe, 1) == 1);
+}
+
+/**
+ * @brief writes frames in batches of one sendmmsg syscall, under one lock
+ * @return number of frames accepted by the socket, stops at the first refused or invalid frame
+ */
+int CanBusSocketCAN::writeFrames(const QCanBusFrame *frames, int count)
 {
     QMutexLocker socketLocker(&_socketMutex);
-    int retval;
-    struct can_frame frame;
+    if (_can_socket < 0)
+    {
+        return 0;
+    }
 
-    frame.can_id = qtframe.frameId();
+    struct canfd_frame txFrames[TX_BATCH_SIZE];
+    struct iovec iovs[TX_BATCH_SIZE];
+    struct mmsghdr msgs[TX_BATCH_SIZE];
 
-    if (qtframe.frameType() == QCanBusFrame::RemoteRequestFrame)
+    int written = 0;
+    while (written < count)
     {
-        frame.can_id += CAN_RTR_FLAG;
+        int batchSize = qMin(count - written, static_cast<int>(TX_BATCH_SIZE));
+        int prepared = 0;
+        while (prepared < batchSize)
+        {
+            int mtu = toCanFdFrame(frames[written + prepared], txFrames[prepared], isCanFd());
+            if (mtu < 0)
+            {
+                break;
+            }
+            iovs[prepared].iov_base = &txFrames[prepared];
+            iovs[prepared].iov_len = static_cast<size_t>(mtu);
+            memset(&msgs[prepared], 0, sizeof(struct mmsghdr));
+            msgs[prepared].msg_hdr.msg_iov = &iovs[prepared];
+            msgs[prepared].msg_hdr.msg_iovlen = 1;
+            prepared++;
+        }
+        if (prepared == 0)
+        {
+            break;
+        }
+
+        int sent = sendmmsg(_can_socket, msgs, static_cast<unsigned int>(prepared), MSG_DONTWAIT);
+        if (sent <= 0)
+        {
+            break;  // ENOBUFS, TX queue full
+        }
+        written += sent;
+        if (sent < batchSize)
+        {
+            break;
+        }
     }
+    return written;
+}
 
-    frame.can_dlc = qtframe.payload().size();
-    for (int i = 0; i < qtframe.payload().size(); i++)
+/**
+ * @brief programs kernel CAN_RAW_FILTER on the read and notifier sockets
+ */
+bool CanBusSocketCAN::setFilters(const QList<Filter> &filters)
+{
+    QMutexLocker socketLocker(&_socketMutex);
+    _filters = filters;
+    if (_can_socket < 0)
+    {
+        return true;
+    }
+
+    applyFilters(_can_socket, _filters);
+    if (_readNotifier != nullptr && _readNotifier->_can_socket >= 0)
+    {
+        applyFilters(_readNotifier->_can_socket, _filters);
+    }
+    return true;
+}
+
+void CanBusSocketCAN::applyFilters(int socket, const QList<Filter> &filters)
+{
+    if (filters.isEmpty())
     {
-        frame.data[i] = qtframe.payload()[i];
+        // default filter, all frames
+        struct can_filter filter;
+        filter.can_id = 0;
+        filter.can_mask = 0;
+        setsockopt(socket, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter));
+        return;
     }
 
-    retval = write(_can_socket, &frame, sizeof(struct can_frame));
-    return (retval == sizeof(struct can_frame));
+    QVector<struct can_filter> rawFilters(filters.size());
+    for (int i = 0; i < filters.size(); i++)
+    {
+        // standard frames only, extended frames with the same low bits are rejected
+        rawFilters[i].can_id = filters.at(i).id & CAN_SFF_MASK;
+        rawFilters[i].can_mask = (filters.at(i).mask & CAN_SFF_MASK) | CAN_EFF_FLAG;
+    }
+    setsockopt(socket, SOL_CAN_RAW, CAN_RAW_FILTER, rawFilters.constData(), static_cast<socklen_t>(sizeof(struct can_filter) * static_cast<size_t>(rawFilters.size())));
 }
 
 void CanBusSocketCAN::notifyRead()
@@ -192,6 +368,7 @@ CanBusSocketCANNotifierThead::CanBusSocketCANNotifierThead(CanBusSocketCAN *driv
     : QThread(driver)
 {
     _driver = driver;
+    _can_socket = -1;
 }
 
 void CanBusSocketCANNotifierThead::run()
@@ -199,7 +376,13 @@ void CanBusSocketCANNotifierThead::run()
     fd_set rdfs;
     bool running = true;
 
-    _can_socket = createSocketCan(_driver->_adress);
+    bool canFd;
+    bool txEcho;
+    _can_socket = createSocketCan(_driver->_adress, canFd, txEcho);
+    {
+        QMutexLocker socketLocker(&_driver->_socketMutex);
+        CanBusSocketCAN::applyFilters(_can_socket, _driver->_filters);
+    }
 
     while (running)
     {
@@ -213,8 +396,8 @@ void CanBusSocketCANNotifierThead::run()
         }
         else
         {
-            struct can_frame frame;
-            read(_can_socket, &frame, sizeof(struct can_frame));
+            struct canfd_frame frame;
+            read(_can_socket, &frame, sizeof(struct canfd_frame));
             _driver->notifyRead();
         }
     }
@@ -42,10 +42,18 @@ public:
 
     QCanBusFrame readFrame() override;
     bool writeFrame(const QCanBusFrame &qtframe) override;
+    int writeFrames(const QCanBusFrame *frames, int count) override;
+    bool setFilters(const QList<Filter> &filters) override;
 
 private:
+    enum
+    {
+        TX_BATCH_SIZE = 32
+    };
     int _can_socket;
     QMutex _socketMutex;
+    QList<Filter> _filters;
+    static void applyFilters(int socket, const QList<Filter> &filters);
     friend class CanBusSocketCANNotifierThead;
     CanBusSocketCANNotifierThead *_readNotifier;
     QSocketNotifier *_errorNotifier;
@@ -64,6 +72,7 @@ public:
 
     // QThread interface
 protected:
+    friend class CanBusSocketCAN;
     int _can_socket;
     void run() override;
     CanBusSocketCAN *_driver;
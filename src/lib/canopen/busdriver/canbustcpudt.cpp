@@ -18,30 +18,88 @@
 
 #include "canbustcpudt.h"
 
-#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
+#include <QMutexLocker>
+#include <QTimer>
+#include <QVarLengthArray>
+
+QHash<QString, CanBusTcpUDTConnection *> CanBusTcpUDTConnection::_connections;
 
 CanBusTcpUDT::CanBusTcpUDT(const QString &adress)
     : CanBusDriver(adress)
 {
-    _sock = new QTcpSocket;
-    QObject::connect(_sock, &QIODevice::readyRead, this, &CanBusTcpUDT::readTCP);
-    QObject::connect(_sock, &QAbstractSocket::stateChanged, this, &CanBusTcpUDT::stateChanged);
+    _host = adress;
+    _port = 5050;
+    _udtBusId = 0;
+    _connectRequested = false;
+
+    int busSep = _host.indexOf('/');
+    if (busSep >= 0)
+    {
+        _udtBusId = static_cast<quint8>(_host.mid(busSep + 1).toUInt());
+        _host.truncate(busSep);
+    }
+    int portSep = _host.lastIndexOf(':');
+    if (portSep >= 0 && _host.count(':') == 1)
+    {
+        _port = static_cast<quint16>(_host.mid(portSep + 1).toUInt());
+        _host.truncate(portSep);
+    }
+
+    _connection = CanBusTcpUDTConnection::attach(this);
+}
+
+CanBusTcpUDT::~CanBusTcpUDT()
+{
+    disconnectDevice();
+    CanBusTcpUDTConnection::detach(this);
+}
+
+const QString &CanBusTcpUDT::host() const
+{
+    return _host;
+}
+
+quint16 CanBusTcpUDT::port() const
+{
+    return _port;
+}
+
+quint8 CanBusTcpUDT::udtBusId() const
+{
+    return _udtBusId;
+}
+
+void CanBusTcpUDT::setCanFdEnabled(bool enabled)
+{
+    setCanFd(enabled);
 }
 
 bool CanBusTcpUDT::connectDevice()
 {
-    _sock->connectToHost(_adress, 5050);
+    if (!_connectRequested)
+    {
+        _connectRequested = true;
+        _connection->connectDevice();
+    }
+    socketStateChanged(_connection->socketState());
     return true;
 }
 
 void CanBusTcpUDT::disconnectDevice()
 {
-    _sock->disconnectFromHost();
+    if (_connectRequested)
+    {
+        _connectRequested = false;
+        _connection->disconnectDevice();
+    }
+    setState(DISCONNECTED);
 }
 
 QCanBusFrame CanBusTcpUDT::readFrame()
 {
+    QMutexLocker locker(&_queueMutex);
     if (_queue.isEmpty())
     {
         return QCanBusFrame(QCanBusFrame::InvalidFrame);
@@ -52,121 +110,228 @@ QCanBusFrame CanBusTcpUDT::readFrame()
 
 bool CanBusTcpUDT::writeFrame(const QCanBusFrame &qtframe)
 {
-    quint8 flags;
-    quint8 dlc;
-    switch (qtframe.frameType())
+    if (!_connectRequested || (qtframe.hasFlexibleDataRateFormat() && !isCanFd()))
     {
-        case QCanBusFrame::UnknownFrame:
-        case QCanBusFrame::InvalidFrame:
-            return false;
+        return false;
+    }
+    return _connection->queueFrame(_udtBusId, qtframe);
+}
 
-        case QCanBusFrame::DataFrame:
-            if (qtframe.hasExtendedFrameFormat())
-            {
-                flags = 2;
-            }
-            else
-            {
-                flags = 1;
-            }
-            break;
+void CanBusTcpUDT::enqueueFrame(const QCanBusFrame &frame)
+{
+    QMutexLocker locker(&_queueMutex);
+    _queue.enqueue(frame);
+}
 
-        case QCanBusFrame::ErrorFrame:
-            flags = 3;
+void CanBusTcpUDT::socketStateChanged(QAbstractSocket::SocketState socketState)
+{
+    if (!_connectRequested)
+    {
+        setState(DISCONNECTED);
+        return;
+    }
+
+    switch (socketState)
+    {
+        case QAbstractSocket::ClosingState:
+        case QAbstractSocket::UnconnectedState:
+        case QAbstractSocket::HostLookupState:
+        case QAbstractSocket::ConnectingState:
+        case QAbstractSocket::BoundState:
+            setState(DISCONNECTED);
             break;
 
-        case QCanBusFrame::RemoteRequestFrame:
-            flags = 4;
+        case QAbstractSocket::ConnectedState:
+        case QAbstractSocket::ListeningState:
+            setState(CONNECTED);
             break;
     }
+}
 
-    QByteArray data;
-    QDataStream stream(&data, QIODevice::WriteOnly);
-    stream.setByteOrder(QDataStream::LittleEndian);
-    dlc = qtframe.payload().size();
+CanBusTcpUDTConnection::CanBusTcpUDTConnection(const QString &host, quint16 port)
+    : _host(host),
+      _port(port)
+{
+    _connectCount = 0;
+    _flushScheduled = false;
+    _unknownBusFramesCount = 0;
+    _txBuffer.reserve(TxFlushThreshold + CanBusTcpUDTFramer::HeaderSize + CanBusTcpUDTFramer::MaxPayloadSize);
 
-    stream << static_cast<quint8>('U');  // Magic id
-    stream << static_cast<quint8>(0);    // bus id
-    stream << flags;                     // flags
-    stream << dlc;                       // dlc
+    _sock = new QTcpSocket(this);
+    connect(_sock, &QIODevice::readyRead, this, &CanBusTcpUDTConnection::readTCP);
+    connect(_sock, &QAbstractSocket::stateChanged, this, &CanBusTcpUDTConnection::updateState);
+}
 
-    stream << static_cast<quint32>(qtframe.frameId());  // frame id
-    data.append(qtframe.payload());
+CanBusTcpUDTConnection::~CanBusTcpUDTConnection()
+{
+    _sock->abort();
+}
 
-    return (_sock->write(data) != -1);
+/**
+ * @brief returns the shared connection for the host and port of driver, created on first use
+ */
+CanBusTcpUDTConnection *CanBusTcpUDTConnection::attach(CanBusTcpUDT *driver)
+{
+    const QString key = driver->host() + QLatin1Char(':') + QString::number(driver->port());
+    CanBusTcpUDTConnection *connection = _connections.value(key, nullptr);
+    if (connection == nullptr)
+    {
+        connection = new CanBusTcpUDTConnection(driver->host(), driver->port());
+        _connections.insert(key, connection);
+    }
+
+    if (connection->_drivers.contains(driver->udtBusId()))
+    {
+        qWarning() << "CanBusTcpUDT: bus id" << driver->udtBusId() << "already used on" << key;
+    }
+    connection->_drivers.insert(driver->udtBusId(), driver);
+    return connection;
 }
 
-void CanBusTcpUDT::readTCP()
+void CanBusTcpUDTConnection::detach(CanBusTcpUDT *driver)
 {
-    QByteArray data = _sock->readAll();
-    int id = 0;
-    int rec = 0;
+    CanBusTcpUDTConnection *connection = driver->_connection;
+    if (connection->_drivers.value(driver->udtBusId(), nullptr) == driver)
+    {
+        connection->_drivers.remove(driver->udtBusId());
+    }
+    if (connection->_drivers.isEmpty())
+    {
+        _connections.remove(_connections.key(connection));
+        delete connection;
+    }
+}
 
-    while (rec >= 0)
+void CanBusTcpUDTConnection::connectDevice()
+{
+    _connectCount++;
+    if (_sock->state() == QAbstractSocket::UnconnectedState)
     {
-        rec = readPacket(data.mid(id));
-        id += rec;
+        _sock->connectToHost(_host, _port);
     }
 }
 
-int CanBusTcpUDT::readPacket(QByteArray data)
+void CanBusTcpUDTConnection::disconnectDevice()
 {
-    QDataStream stream(&data, QIODevice::ReadOnly);
-    stream.setByteOrder(QDataStream::LittleEndian);
+    _connectCount--;
+    if (_connectCount <= 0)
+    {
+        _connectCount = 0;
+        flushWrites();
+        _sock->disconnectFromHost();
+    }
+}
 
-    quint8 magic;
-    quint8 busid;
-    quint8 flags;
-    quint8 dlc;
-    quint32 frameId;
-    stream >> magic;
-    stream >> busid;
-    stream >> flags;
-    stream >> dlc;
-    stream >> frameId;
+QAbstractSocket::SocketState CanBusTcpUDTConnection::socketState() const
+{
+    return _sock->state();
+}
 
-    if (magic != 'U' || busid != 0)
+/**
+ * @brief encodes frame in the transmit buffer, sent in one write at next event loop tick
+ */
+bool CanBusTcpUDTConnection::queueFrame(quint8 busId, const QCanBusFrame &frame)
+{
+    if (_sock->state() != QAbstractSocket::ConnectedState)
+    {
+        return false;
+    }
+    if (!CanBusTcpUDTFramer::encode(busId, frame, _txBuffer))
+    {
+        return false;
+    }
+
+    if (_txBuffer.size() >= TxFlushThreshold)
     {
-        return -1;
+        flushWrites();
     }
+    else if (!_flushScheduled)
+    {
+        _flushScheduled = true;
+        QTimer::singleShot(0, this, &CanBusTcpUDTConnection::flushWrites);
+    }
+    return true;
+}
 
-    QCanBusFrame qtFrame;
-    qtFrame.setFrameId(frameId);
+quint64 CanBusTcpUDTConnection::unknownBusFramesCount() const
+{
+    return _unknownBusFramesCount;
+}
 
-    QByteArray payLoad;
-    for (int i = 0; i < dlc; i++)
+void CanBusTcpUDTConnection::readTCP()
+{
+    QVarLengthArray<CanBusTcpUDT *, 8> notifiedDrivers;
+    QCanBusFrame::TimeStamp timeStamp = QCanBusFrame::TimeStamp::fromMicroSeconds(QDateTime::currentMSecsSinceEpoch() * 1000);
+
+    while (_sock->bytesAvailable() > 0)
     {
-        payLoad.append(data[i + 8]);
+        if (_framer.readFrom(_sock) == 0)
+        {
+            break;
+        }
+
+        quint8 busId;
+        QCanBusFrame frame;
+        while (_framer.takeFrame(busId, frame))
+        {
+            CanBusTcpUDT *driver = _drivers.value(busId, nullptr);
+            if (driver == nullptr || !driver->_connectRequested)
+            {
+                _unknownBusFramesCount++;
+                continue;
+            }
+
+            frame.setTimeStamp(timeStamp);
+            driver->enqueueFrame(frame);
+            if (!notifiedDrivers.contains(driver))
+            {
+                notifiedDrivers.append(driver);
+            }
+        }
     }
-    qtFrame.setPayload(payLoad);
 
-    qtFrame.setFrameType(QCanBusFrame::DataFrame);
-    if (flags == 4)
+    // one notification per driver and per read batch
+    for (CanBusTcpUDT *driver : qAsConst(notifiedDrivers))
     {
-        qtFrame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+        emit driver->framesReceived();
     }
+}
 
-    _queue.append(qtFrame);
-    emit framesReceived();
+void CanBusTcpUDTConnection::flushWrites()
+{
+    _flushScheduled = false;
+    if (_txBuffer.isEmpty())
+    {
+        return;
+    }
 
-    return dlc + 8;
+    if (_sock->state() == QAbstractSocket::ConnectedState)
+    {
+        _sock->write(_txBuffer.constData(), _txBuffer.size());
+    }
+    _txBuffer.resize(0);  // capacity is kept, reserved in constructor
 }
 
-void CanBusTcpUDT::stateChanged(QAbstractSocket::SocketState socketState)
+void CanBusTcpUDTConnection::updateState(QAbstractSocket::SocketState socketState)
 {
     switch (socketState)
     {
-        case QAbstractSocket::ClosingState:
+        case QAbstractSocket::ConnectedState:
+            _sock->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            _framer.clear();
+            break;
+
         case QAbstractSocket::UnconnectedState:
-        case QAbstractSocket::HostLookupState:
-        case QAbstractSocket::ConnectingState:
-        case QAbstractSocket::BoundState:
-            setState(DISCONNECTED);
+            _txBuffer.resize(0);
             break;
 
-        case QAbstractSocket::ConnectedState:
-        case QAbstractSocket::ListeningState:
-            setState(CONNECTED);
+        default:
             break;
     }
+
+    const QList<CanBusTcpUDT *> drivers = _drivers.values();
+    for (CanBusTcpUDT *driver : drivers)
+    {
+        driver->socketStateChanged(socketState);
+    }
 }
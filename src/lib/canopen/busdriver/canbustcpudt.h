@@ -22,16 +22,34 @@
 #include "canopen_global.h"
 
 #include "canbusdriver.h"
+#include "canbustcpudtframer.h"
 
+#include <QHash>
 #include <QMutex>
 #include <QQueue>
 #include <QTcpSocket>
 
+class CanBusTcpUDTConnection;
+
+/**
+ * @brief CAN bus driver over the UDT TCP protocol
+ *
+ * Adress format: host[:port][/busid], default port 5050 and bus id 0.
+ * Drivers with the same host and port share one TCP connection, frames are multiplexed by bus id.
+ * CAN FD capability of the gateway can not be queried, it is enabled with setCanFdEnabled().
+ */
 class CANOPEN_EXPORT CanBusTcpUDT : public CanBusDriver
 {
     Q_OBJECT
 public:
     CanBusTcpUDT(const QString &adress);
+    ~CanBusTcpUDT() override;
+
+    const QString &host() const;
+    quint16 port() const;
+    quint8 udtBusId() const;
+
+    void setCanFdEnabled(bool enabled);
 
     // CanBusDriver interface
 public:
@@ -41,16 +59,61 @@ public:
     bool writeFrame(const QCanBusFrame &qtframe) override;
 
 private:
-    QMutex _socketMutex;
-    QTcpSocket *_sock;
+    QString _host;
+    quint16 _port;
+    quint8 _udtBusId;
+    bool _connectRequested;
+
+    QMutex _queueMutex;
     QQueue<QCanBusFrame> _queue;
+    CanBusTcpUDTConnection *_connection;
+
+    friend class CanBusTcpUDTConnection;
+    void enqueueFrame(const QCanBusFrame &frame);
+    void socketStateChanged(QAbstractSocket::SocketState socketState);
+};
+
+class CanBusTcpUDTConnection : public QObject
+{
+    Q_OBJECT
+public:
+    static CanBusTcpUDTConnection *attach(CanBusTcpUDT *driver);
+    static void detach(CanBusTcpUDT *driver);
+
+    void connectDevice();
+    void disconnectDevice();
+    QAbstractSocket::SocketState socketState() const;
+
+    bool queueFrame(quint8 busId, const QCanBusFrame &frame);
+
+    quint64 unknownBusFramesCount() const;
 
 protected slots:
     void readTCP();
+    void flushWrites();
+    void updateState(QAbstractSocket::SocketState socketState);
+
+private:
+    CanBusTcpUDTConnection(const QString &host, quint16 port);
+    ~CanBusTcpUDTConnection() override;
+
+    enum
+    {
+        TxFlushThreshold = 16384  // flush before next event loop tick above this size
+    };
+
+    QString _host;
+    quint16 _port;
+    QTcpSocket *_sock;
+    int _connectCount;
+
+    CanBusTcpUDTFramer _framer;
+    QByteArray _txBuffer;
+    bool _flushScheduled;
+    quint64 _unknownBusFramesCount;
 
-protected:
-    int readPacket(QByteArray data);
-    void stateChanged(QAbstractSocket::SocketState socketState);
+    QHash<quint8, CanBusTcpUDT *> _drivers;
+    static QHash<QString, CanBusTcpUDTConnection *> _connections;
 };
 
 #endif  // CANBUSTCPUDT_H
@@ -0,0 +1,231 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "canbustcpudtframer.h"
+
+#include "canbusdriver.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+CanBusTcpUDTFramer::CanBusTcpUDTFramer()
+{
+    _head = 0;
+    _count = 0;
+    _desyncBytesCount = 0;
+}
+
+/**
+ * @brief reads available bytes of device into the ring buffer, without intermediate copy
+ * @return number of bytes read, the ring can be full with bytes still available on device
+ */
+int CanBusTcpUDTFramer::readFrom(QIODevice *device)
+{
+    int readCount = 0;
+    while (freeBytes() > 0)
+    {
+        int tail = (_head + _count) & (RingSize - 1);
+        int contiguous = qMin(freeBytes(), static_cast<int>(RingSize - tail));
+        qint64 read = device->read(_ring + tail, contiguous);
+        if (read <= 0)
+        {
+            break;
+        }
+        _count += static_cast<int>(read);
+        readCount += static_cast<int>(read);
+        if (read < contiguous)
+        {
+            break;
+        }
+    }
+    return readCount;
+}
+
+/**
+ * @brief appends data to the ring buffer
+ * @return number of bytes appended, limited by the free space
+ */
+int CanBusTcpUDTFramer::append(const char *data, int size)
+{
+    size = qMin(size, freeBytes());
+    int tail = (_head + _count) & (RingSize - 1);
+    int first = qMin(size, static_cast<int>(RingSize - tail));
+    memcpy(_ring + tail, data, static_cast<size_t>(first));
+    memcpy(_ring, data + first, static_cast<size_t>(size - first));
+    _count += size;
+    return size;
+}
+
+/**
+ * @brief extracts the next complete packet of the ring buffer
+ * @return false if no complete packet is available
+ */
+bool CanBusTcpUDTFramer::takeFrame(quint8 &busId, QCanBusFrame &frame)
+{
+    while (_count >= HeaderSize)
+    {
+        quint8 dlc = peek(3);
+        quint8 flags = peek(2);
+        quint8 kind = flags & FlagKindMask;
+        bool fd = (flags & FlagFdFrame) != 0;
+        bool validDlc = fd ? (dlc <= MaxPayloadSize && CanBusDriver::canFdPayloadSize(dlc) == dlc) : (dlc <= 8);
+        if (peek(0) != 'U' || !validDlc || kind < FlagStdDataFrame || kind > FlagRemoteRequestFrame)
+        {
+            // resync on next magic byte
+            drop(1);
+            _desyncBytesCount++;
+            continue;
+        }
+        if (_count < HeaderSize + dlc)
+        {
+            return false;
+        }
+
+        char header[HeaderSize];
+        copyOut(0, header, HeaderSize);
+        busId = static_cast<quint8>(header[1]);
+
+        QByteArray payload(dlc, Qt::Uninitialized);
+        copyOut(HeaderSize, payload.data(), dlc);
+
+        frame = QCanBusFrame(qFromLittleEndian<quint32>(header + 4), payload);
+        if (fd)
+        {
+            frame.setFlexibleDataRateFormat(true);
+            frame.setBitrateSwitch((flags & FlagBitrateSwitch) != 0);
+            frame.setErrorStateIndicator((flags & FlagErrorStateIndicator) != 0);
+        }
+        switch (kind)
+        {
+            case FlagExtDataFrame:
+                frame.setExtendedFrameFormat(true);
+                break;
+
+            case FlagErrorFrame:
+                frame.setFrameType(QCanBusFrame::ErrorFrame);
+                break;
+
+            case FlagRemoteRequestFrame:
+                frame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+                break;
+
+            default:
+                break;
+        }
+
+        drop(HeaderSize + dlc);
+        return true;
+    }
+    return false;
+}
+
+int CanBusTcpUDTFramer::pendingBytes() const
+{
+    return _count;
+}
+
+int CanBusTcpUDTFramer::freeBytes() const
+{
+    return RingSize - _count;
+}
+
+void CanBusTcpUDTFramer::clear()
+{
+    _head = 0;
+    _count = 0;
+}
+
+quint64 CanBusTcpUDTFramer::desyncBytesCount() const
+{
+    return _desyncBytesCount;
+}
+
+/**
+ * @brief appends the encoded packet of frame to out
+ * @return false if the frame can not be sent with the UDT protocol
+ */
+bool CanBusTcpUDTFramer::encode(quint8 busId, const QCanBusFrame &frame, QByteArray &out)
+{
+    quint8 flags;
+    switch (frame.frameType())
+    {
+        case QCanBusFrame::DataFrame:
+            flags = frame.hasExtendedFrameFormat() ? FlagExtDataFrame : FlagStdDataFrame;
+            break;
+
+        case QCanBusFrame::ErrorFrame:
+            flags = FlagErrorFrame;
+            break;
+
+        case QCanBusFrame::RemoteRequestFrame:
+            flags = FlagRemoteRequestFrame;
+            break;
+
+        default:
+            return false;
+    }
+
+    QByteArray payload = frame.payload();
+    if (frame.hasFlexibleDataRateFormat())
+    {
+        if (payload.size() > MaxPayloadSize)
+        {
+            return false;
+        }
+        payload.append(CanBusDriver::canFdPayloadSize(payload.size()) - payload.size(), '\0');
+        flags |= FlagFdFrame;
+        if (frame.hasBitrateSwitch())
+        {
+            flags |= FlagBitrateSwitch;
+        }
+        if (frame.hasErrorStateIndicator())
+        {
+            flags |= FlagErrorStateIndicator;
+        }
+    }
+    else if (payload.size() > 8)
+    {
+        return false;
+    }
+
+    char header[HeaderSize];
+    header[0] = 'U';  // Magic id
+    header[1] = static_cast<char>(busId);
+    header[2] = static_cast<char>(flags);
+    header[3] = static_cast<char>(payload.size());
+    qToLittleEndian<quint32>(frame.frameId(), header + 4);
+
+    out.append(header, HeaderSize);
+    out.append(payload);
+    return true;
+}
+
+void CanBusTcpUDTFramer::copyOut(int offset, char *dest, int size) const
+{
+    int start = (_head + offset) & (RingSize - 1);
+    int first = qMin(size, static_cast<int>(RingSize - start));
+    memcpy(dest, _ring + start, static_cast<size_t>(first));
+    memcpy(dest + first, _ring, static_cast<size_t>(size - first));
+}
+
+void CanBusTcpUDTFramer::drop(int size)
+{
+    _head = (_head + size) & (RingSize - 1);
+    _count -= size;
+}
@@ -0,0 +1,91 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef CANBUSTCPUDTFRAMER_H
+#define CANBUSTCPUDTFRAMER_H
+
+#include "canopen_global.h"
+
+#include "busdriver/qcanbusframe.h"
+
+#include <QByteArray>
+#include <QIODevice>
+
+/**
+ * @brief Streaming framer of the UDT TCP protocol
+ *
+ * Packet layout (little endian):
+ * | magic 'U' (1) | bus id (1) | flags (1) | dlc (1) | frame id (4) | payload (dlc) |
+ * Low nibble of flags is the frame kind, high bits mark CAN FD frames (payload up to 64 bytes).
+ *
+ * Received bytes are stored in a fixed size ring buffer, packets split across several
+ * TCP reads are kept until complete. A corrupted header makes the framer drop bytes until
+ * the next magic byte.
+ */
+class CANOPEN_EXPORT CanBusTcpUDTFramer
+{
+public:
+    CanBusTcpUDTFramer();
+
+    enum
+    {
+        HeaderSize = 8,
+        MaxPayloadSize = 64,
+        RingSize = 16384  // power of 2
+    };
+
+    enum Flags
+    {
+        FlagStdDataFrame = 1,
+        FlagExtDataFrame = 2,
+        FlagErrorFrame = 3,
+        FlagRemoteRequestFrame = 4,
+        FlagKindMask = 0x0F,
+        FlagFdFrame = 0x10,
+        FlagBitrateSwitch = 0x20,
+        FlagErrorStateIndicator = 0x40
+    };
+
+    // receive
+    int readFrom(QIODevice *device);
+    int append(const char *data, int size);
+    bool takeFrame(quint8 &busId, QCanBusFrame &frame);
+    int pendingBytes() const;
+    int freeBytes() const;
+    void clear();
+
+    quint64 desyncBytesCount() const;
+
+    // transmit
+    static bool encode(quint8 busId, const QCanBusFrame &frame, QByteArray &out);
+
+private:
+    char _ring[RingSize];
+    int _head;
+    int _count;
+    quint64 _desyncBytesCount;
+
+    inline quint8 peek(int offset) const
+    {
+        return static_cast<quint8>(_ring[(_head + offset) & (RingSize - 1)]);
+    }
+    void copyOut(int offset, char *dest, int size) const;
+    void drop(int size);
+};
+
+#endif  // CANBUSTCPUDTFRAMER_H
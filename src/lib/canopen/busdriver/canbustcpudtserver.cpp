@@ -0,0 +1,177 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "canbustcpudtserver.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+
+CanBusTcpUDTServer::CanBusTcpUDTServer(QObject *parent)
+    : QObject(parent)
+{
+    _echoEnabled = true;
+    _framesCount = 0;
+    _bytesCount = 0;
+
+    _server = new QTcpServer(this);
+    connect(_server, &QTcpServer::newConnection, this, &CanBusTcpUDTServer::newClient);
+}
+
+CanBusTcpUDTServer::~CanBusTcpUDTServer()
+{
+    close();
+}
+
+bool CanBusTcpUDTServer::listen(const QHostAddress &address, quint16 port)
+{
+    return _server->listen(address, port);
+}
+
+void CanBusTcpUDTServer::close()
+{
+    _server->close();
+    for (const Client &client : qAsConst(_clients))
+    {
+        client.socket->disconnect(this);
+        client.socket->abort();
+        client.socket->deleteLater();
+        delete client.framer;
+    }
+    _clients.clear();
+}
+
+bool CanBusTcpUDTServer::isListening() const
+{
+    return _server->isListening();
+}
+
+quint16 CanBusTcpUDTServer::serverPort() const
+{
+    return _server->serverPort();
+}
+
+bool CanBusTcpUDTServer::isEchoEnabled() const
+{
+    return _echoEnabled;
+}
+
+void CanBusTcpUDTServer::setEchoEnabled(bool echoEnabled)
+{
+    _echoEnabled = echoEnabled;
+}
+
+int CanBusTcpUDTServer::clientCount() const
+{
+    return _clients.count();
+}
+
+quint64 CanBusTcpUDTServer::framesCount() const
+{
+    return _framesCount;
+}
+
+quint64 CanBusTcpUDTServer::bytesCount() const
+{
+    return _bytesCount;
+}
+
+void CanBusTcpUDTServer::resetCounters()
+{
+    _framesCount = 0;
+    _bytesCount = 0;
+}
+
+void CanBusTcpUDTServer::newClient()
+{
+    while (_server->hasPendingConnections())
+    {
+        Client client;
+        client.socket = _server->nextPendingConnection();
+        client.socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        client.framer = new CanBusTcpUDTFramer();
+        connect(client.socket, &QIODevice::readyRead, this, &CanBusTcpUDTServer::readClient);
+        connect(client.socket, &QAbstractSocket::disconnected, this, &CanBusTcpUDTServer::removeClient);
+        _clients.append(client);
+    }
+}
+
+void CanBusTcpUDTServer::readClient()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    int senderId = -1;
+    for (int i = 0; i < _clients.count(); i++)
+    {
+        if (_clients.at(i).socket == socket)
+        {
+            senderId = i;
+            break;
+        }
+    }
+    if (senderId < 0)
+    {
+        return;
+    }
+
+    // frames of one read batch are re-encoded and sent in one write per client
+    CanBusTcpUDTFramer *framer = _clients.at(senderId).framer;
+    QByteArray out;
+    while (socket->bytesAvailable() > 0)
+    {
+        int read = framer->readFrom(socket);
+        if (read == 0)
+        {
+            break;
+        }
+        _bytesCount += static_cast<quint64>(read);
+
+        quint8 busId;
+        QCanBusFrame frame;
+        while (framer->takeFrame(busId, frame))
+        {
+            CanBusTcpUDTFramer::encode(busId, frame, out);
+            _framesCount++;
+        }
+    }
+    if (out.isEmpty())
+    {
+        return;
+    }
+
+    for (int i = 0; i < _clients.count(); i++)
+    {
+        if (i != senderId || _echoEnabled)
+        {
+            _clients.at(i).socket->write(out);
+        }
+    }
+}
+
+void CanBusTcpUDTServer::removeClient()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    for (int i = 0; i < _clients.count(); i++)
+    {
+        if (_clients.at(i).socket == socket)
+        {
+            delete _clients.at(i).framer;
+            _clients.removeAt(i);
+            break;
+        }
+    }
+    socket->deleteLater();
+}
@@ -0,0 +1,78 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef CANBUSTCPUDTSERVER_H
+#define CANBUSTCPUDTSERVER_H
+
+#include "canopen_global.h"
+
+#include "canbustcpudtframer.h"
+
+#include <QHostAddress>
+#include <QList>
+#include <QObject>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief Local stand-in of an UDT TCP gateway, for throughput tests without hardware
+ *
+ * Each frame received from a client is forwarded to all other clients, as on a real bus, and echoed
+ * back to the sender if echo mode is enabled. Bus ids are kept, so multiplexed buses stay separated.
+ */
+class CANOPEN_EXPORT CanBusTcpUDTServer : public QObject
+{
+    Q_OBJECT
+public:
+    CanBusTcpUDTServer(QObject *parent = nullptr);
+    ~CanBusTcpUDTServer() override;
+
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 5050);
+    void close();
+    bool isListening() const;
+    quint16 serverPort() const;
+
+    bool isEchoEnabled() const;
+    void setEchoEnabled(bool echoEnabled);
+
+    int clientCount() const;
+    quint64 framesCount() const;
+    quint64 bytesCount() const;
+    void resetCounters();
+
+protected slots:
+    void newClient();
+    void readClient();
+    void removeClient();
+
+private:
+    struct Client
+    {
+        QTcpSocket *socket;
+        CanBusTcpUDTFramer *framer;
+    };
+    QTcpServer *_server;
+    QList<Client> _clients;
+    bool _echoEnabled;
+
+    quint64 _framesCount;
+    quint64 _bytesCount;
+};
+
+#endif  // CANBUSTCPUDTSERVER_H
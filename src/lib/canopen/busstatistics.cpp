@@ -0,0 +1,444 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "busstatistics.h"
+
+#include <cstring>
+
+namespace
+{
+struct BitSequence
+{
+    quint8 bits[192];
+    int count = 0;
+
+    void push(quint32 value, int bitCount)
+    {
+        for (int i = bitCount - 1; i >= 0; i--)
+        {
+            bits[count++] = static_cast<quint8>((value >> i) & 1U);
+        }
+    }
+};
+
+int fdDlcCode(int length)
+{
+    if (length <= 8)
+    {
+        return length;
+    }
+    if (length <= 24)
+    {
+        return 9 + (length - 9) / 4;
+    }
+    if (length <= 32)
+    {
+        return 13;
+    }
+    if (length <= 48)
+    {
+        return 14;
+    }
+    return 15;
+}
+
+/**
+ * counts stuff bits of a sequence, stuff bits inserted before bit boundary are counted in stuffBefore
+ */
+void countStuffBits(const BitSequence &sequence, int boundary, int &stuffBefore, int &stuffAfter)
+{
+    stuffBefore = 0;
+    stuffAfter = 0;
+    if (sequence.count == 0)
+    {
+        return;
+    }
+
+    quint8 previous = sequence.bits[0];
+    int run = 1;
+    for (int i = 1; i < sequence.count; i++)
+    {
+        if (sequence.bits[i] == previous)
+        {
+            run++;
+        }
+        else
+        {
+            previous = sequence.bits[i];
+            run = 1;
+        }
+        if (run == 5)
+        {
+            // stuff bit of opposite value starts a new run
+            if (i < boundary)
+            {
+                stuffBefore++;
+            }
+            else
+            {
+                stuffAfter++;
+            }
+            previous = previous ^ 1U;
+            run = 1;
+        }
+    }
+}
+
+/**
+ * computes the stuffed bit length of frame, split in nominal and data bitrate phases
+ */
+void stuffedBitLengths(const QCanBusFrame &frame, int &nominalBits, int &dataBits)
+{
+    BitSequence sequence;
+    const QByteArray payload = frame.payload();
+    int length = payload.size();
+    quint32 id = frame.frameId();
+    bool rtr = (frame.frameType() == QCanBusFrame::RemoteRequestFrame);
+    bool fd = frame.hasFlexibleDataRateFormat();
+
+    sequence.push(0, 1);  // SOF
+    if (frame.hasExtendedFrameFormat())
+    {
+        sequence.push(id >> 18, 11);
+        sequence.push(1, 1);  // SRR
+        sequence.push(1, 1);  // IDE
+        sequence.push(id & 0x3FFFFU, 18);
+        sequence.push(rtr ? 1 : 0, 1);  // RTR or RRS
+        sequence.push(fd ? 1 : 0, 1);   // r1 or FDF
+    }
+    else
+    {
+        sequence.push(id & 0x7FFU, 11);
+        sequence.push(rtr ? 1 : 0, 1);  // RTR or RRS
+        sequence.push(0, 1);            // IDE
+        sequence.push(fd ? 1 : 0, 1);   // r0 or FDF
+    }
+
+    if (!fd)
+    {
+        if (frame.hasExtendedFrameFormat())
+        {
+            sequence.push(0, 1);  // r0
+        }
+        sequence.push(static_cast<quint32>(qMin(length, 8)), 4);
+        if (!rtr)
+        {
+            for (int i = 0; i < length && i < 8; i++)
+            {
+                sequence.push(static_cast<quint8>(payload.at(i)), 8);
+            }
+        }
+
+        // CRC-15 from SOF to end of data
+        quint16 crc = 0;
+        for (int i = 0; i < sequence.count; i++)
+        {
+            bool crcNext = (sequence.bits[i] ^ ((crc >> 14) & 1U)) != 0;
+            crc = static_cast<quint16>((crc << 1) & 0x7FFFU);
+            if (crcNext)
+            {
+                crc ^= 0x4599U;
+            }
+        }
+        sequence.push(crc, 15);
+
+        int stuffBefore;
+        int stuffAfter;
+        countStuffBits(sequence, sequence.count, stuffBefore, stuffAfter);
+
+        // CRC delimiter, ACK slot, ACK delimiter, EOF and intermission are not stuffed
+        nominalBits = sequence.count + stuffBefore + 13;
+        dataBits = 0;
+        return;
+    }
+
+    // CAN FD, data phase starts after BRS
+    sequence.push(0, 1);  // res
+    sequence.push(frame.hasBitrateSwitch() ? 1 : 0, 1);
+    int dataPhaseStart = sequence.count;
+    sequence.push(frame.hasErrorStateIndicator() ? 1 : 0, 1);
+    sequence.push(static_cast<quint32>(fdDlcCode(length)), 4);
+    for (int i = 0; i < length; i++)
+    {
+        sequence.push(static_cast<quint8>(payload.at(i)), 8);
+    }
+
+    int stuffBefore;
+    int stuffAfter;
+    countStuffBits(sequence, dataPhaseStart, stuffBefore, stuffAfter);
+
+    // CRC field: stuff count (4) and CRC-17 or CRC-21, with fixed stuff bits every 4 bits
+    int crcFieldBits = 4 + ((length <= 16) ? 17 : 21);
+    crcFieldBits += 1 + crcFieldBits / 4;
+
+    int arbitrationBits = dataPhaseStart + stuffBefore;
+    int dataPhaseBits = (sequence.count - dataPhaseStart) + stuffAfter + crcFieldBits + 1;  // with CRC delimiter
+    if (frame.hasBitrateSwitch())
+    {
+        nominalBits = arbitrationBits + 12;  // ACK slot, ACK delimiter, EOF and intermission
+        dataBits = dataPhaseBits;
+    }
+    else
+    {
+        nominalBits = arbitrationBits + dataPhaseBits + 12;
+        dataBits = 0;
+    }
+}
+}  // namespace
+
+BusStatistics::BusStatistics(QObject *parent)
+    : QObject(parent)
+{
+    _bitrate = 1000000;
+    _dataBitrate = 2000000;
+
+    _cobStats.resize(0x800);
+    _publishedCounts.resize(0x800);
+    _snapshots[0] = Snapshot();
+    _snapshots[1] = Snapshot();
+    _publishedSnapshot.storeRelease(0);
+    _clock.start();
+    reset();
+
+    _publishTimer = new QTimer(this);
+    connect(_publishTimer, &QTimer::timeout, this, &BusStatistics::publish);
+    _publishTimer->start(PUBLISH_PERIOD_MS);
+    publish();
+}
+
+int BusStatistics::bitrate() const
+{
+    return _bitrate;
+}
+
+void BusStatistics::setBitrate(int bitrate)
+{
+    _bitrate = qMax(bitrate, 1);
+}
+
+int BusStatistics::dataBitrate() const
+{
+    return _dataBitrate;
+}
+
+/**
+ * @brief sets the CAN FD data phase bitrate, used by frames with bitrate switch
+ */
+void BusStatistics::setDataBitrate(int dataBitrate)
+{
+    _dataBitrate = qMax(dataBitrate, 1);
+}
+
+/**
+ * @brief accounts a received or sent (local echo) frame, called for each frame of the bus
+ */
+void BusStatistics::addFrame(const QCanBusFrame &frame)
+{
+    qint64 bucket = _clock.nsecsElapsed() / (WINDOW_BUCKET_MS * Q_INT64_C(1000000));
+    if (bucket != _currentBucket)
+    {
+        advanceWindow(bucket);
+    }
+
+    _framesCount++;
+    if (frame.hasLocalEcho())
+    {
+        _txFramesCount++;
+    }
+    if (frame.frameType() == QCanBusFrame::ErrorFrame)
+    {
+        _errorFramesCount++;
+        return;
+    }
+
+    Bucket &currentBucket = _buckets[bucket % WINDOW_BUCKET_COUNT];
+    currentBucket.busTimeNs += frameDurationNs(frame);
+    currentBucket.frames++;
+
+    if (frame.hasExtendedFrameFormat())
+    {
+        _extendedFramesCount++;
+        return;
+    }
+
+    CobIdStats &stats = _cobStats[static_cast<int>(frame.frameId() & 0x7FFU)];
+    stats.count++;
+    if (frame.hasLocalEcho())
+    {
+        stats.txCount++;
+    }
+
+    qint64 timeUs = frame.timeStamp().seconds() * 1000000 + frame.timeStamp().microSeconds();
+    if (stats.lastTimeUs != 0 && timeUs > stats.lastTimeUs)
+    {
+        qint64 intervalUs = timeUs - stats.lastTimeUs;
+        if (stats.meanIntervalUs == 0)
+        {
+            stats.meanIntervalUs = intervalUs;
+            stats.minIntervalUs = intervalUs;
+            stats.maxIntervalUs = intervalUs;
+        }
+        else
+        {
+            // exponential smoothing, 1/16
+            qint64 deviationUs = qAbs(intervalUs - stats.meanIntervalUs);
+            stats.meanIntervalUs += (intervalUs - stats.meanIntervalUs) / 16;
+            stats.jitterUs += (deviationUs - stats.jitterUs) / 16;
+            stats.minIntervalUs = qMin(stats.minIntervalUs, intervalUs);
+            stats.maxIntervalUs = qMax(stats.maxIntervalUs, intervalUs);
+        }
+    }
+    stats.lastTimeUs = timeUs;
+}
+
+void BusStatistics::reset()
+{
+    for (int cobId = 0; cobId < _cobStats.size(); cobId++)
+    {
+        _cobStats[cobId] = CobIdStats{static_cast<quint32>(cobId), 0, 0, 0.0, 0, 0, 0, 0, 0};
+        _publishedCounts[cobId] = 0;
+    }
+    memset(_buckets, 0, sizeof(_buckets));
+    _currentBucket = _clock.nsecsElapsed() / (WINDOW_BUCKET_MS * Q_INT64_C(1000000));
+    _lastPublishNs = _clock.nsecsElapsed();
+
+    _framesCount = 0;
+    _txFramesCount = 0;
+    _errorFramesCount = 0;
+    _extendedFramesCount = 0;
+    _peakBusLoad = 0.0;
+}
+
+/**
+ * @brief returns a copy of the last published snapshot, lock free
+ */
+BusStatistics::Snapshot BusStatistics::snapshot() const
+{
+    // the buffer is held before being checked still published, publish() then leaves it untouched.
+    // Ordered read-modify-writes on both sides keep the hold and the publication in a total order
+    int published;
+    while (true)
+    {
+        published = _publishedSnapshot.loadAcquire();
+        _snapshotReaders[published].ref();
+        if (_publishedSnapshot.fetchAndAddOrdered(0) == published)
+        {
+            break;
+        }
+        _snapshotReaders[published].deref();
+    }
+    Snapshot snapshot = _snapshots[published];
+    _snapshotReaders[published].deref();
+    return snapshot;
+}
+
+/**
+ * @brief exact bit length of frame on the bus, with stuff bits and intermission
+ */
+int BusStatistics::frameBitLength(const QCanBusFrame &frame)
+{
+    int nominalBits;
+    int dataBits;
+    stuffedBitLengths(frame, nominalBits, dataBits);
+    return nominalBits + dataBits;
+}
+
+qint64 BusStatistics::frameDurationNs(const QCanBusFrame &frame) const
+{
+    int nominalBits;
+    int dataBits;
+    stuffedBitLengths(frame, nominalBits, dataBits);
+    return nominalBits * Q_INT64_C(1000000000) / _bitrate + dataBits * Q_INT64_C(1000000000) / _dataBitrate;
+}
+
+void BusStatistics::publish()
+{
+    // a late reader still copies the other buffer, published next period
+    int next = 1 - _publishedSnapshot.loadAcquire();
+    if (_snapshotReaders[next].fetchAndAddOrdered(0) != 0)
+    {
+        return;
+    }
+
+    qint64 now = _clock.nsecsElapsed();
+    const qint64 bucketNs = WINDOW_BUCKET_MS * Q_INT64_C(1000000);
+    advanceWindow(now / bucketNs);
+
+    Snapshot &snapshot = _snapshots[next];
+
+    // window is made of full past buckets and the elapsed part of the current one
+    qint64 windowNs = qMin((WINDOW_BUCKET_COUNT - 1) * bucketNs + now % bucketNs, now);
+    windowNs = qMax(windowNs, Q_INT64_C(1));
+    qint64 busTimeNs = 0;
+    quint64 frames = 0;
+    for (const Bucket &bucket : _buckets)
+    {
+        busTimeNs += bucket.busTimeNs;
+        frames += bucket.frames;
+    }
+    snapshot.busLoad = qMin(static_cast<qreal>(busTimeNs) / static_cast<qreal>(windowNs), 1.0);
+    _peakBusLoad = qMax(_peakBusLoad, snapshot.busLoad);
+    snapshot.peakBusLoad = _peakBusLoad;
+    snapshot.framesPerSecond = static_cast<qreal>(frames) * 1e9 / static_cast<qreal>(windowNs);
+
+    snapshot.framesCount = _framesCount;
+    snapshot.txFramesCount = _txFramesCount;
+    snapshot.errorFramesCount = _errorFramesCount;
+    snapshot.extendedFramesCount = _extendedFramesCount;
+
+    qreal dt = static_cast<qreal>(qMax(now - _lastPublishNs, Q_INT64_C(1))) / 1e9;
+    _lastPublishNs = now;
+    memset(snapshot.serviceRates, 0, sizeof(snapshot.serviceRates));
+    memset(snapshot.nodeRates, 0, sizeof(snapshot.nodeRates));
+    snapshot.cobIds.clear();
+    for (int cobId = 0; cobId < _cobStats.size(); cobId++)
+    {
+        CobIdStats &stats = _cobStats[cobId];
+        if (stats.count == 0)
+        {
+            continue;
+        }
+
+        qreal instantRate = static_cast<qreal>(stats.count - _publishedCounts[cobId]) / dt;
+        _publishedCounts[cobId] = stats.count;
+        stats.rate = stats.rate * 0.75 + instantRate * 0.25;
+
+        snapshot.serviceRates[cobId >> 7] += stats.rate;
+        snapshot.nodeRates[cobId & 0x7F] += stats.rate;
+        snapshot.cobIds.append(stats);
+    }
+
+    _publishedSnapshot.fetchAndStoreOrdered(next);
+    emit snapshotPublished();
+}
+
+void BusStatistics::advanceWindow(qint64 bucket)
+{
+    if (bucket - _currentBucket >= WINDOW_BUCKET_COUNT)
+    {
+        memset(_buckets, 0, sizeof(_buckets));
+    }
+    else
+    {
+        for (qint64 i = _currentBucket + 1; i <= bucket; i++)
+        {
+            _buckets[i % WINDOW_BUCKET_COUNT] = Bucket{0, 0};
+        }
+    }
+    _currentBucket = bucket;
+}
@@ -0,0 +1,129 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef BUSSTATISTICS_H
+#define BUSSTATISTICS_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include "busdriver/qcanbusframe.h"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @brief Bus load and per cob id traffic statistics, fed with received and sent frames
+ *
+ * Bus load is computed on a sliding window of 1 s from the exact stuffed bit length of
+ * each frame and the bitrate. Statistics are published periodically in a snapshot that
+ * can be copied from any thread without lock.
+ */
+class CANOPEN_EXPORT BusStatistics : public QObject
+{
+    Q_OBJECT
+public:
+    BusStatistics(QObject *parent = nullptr);
+
+    int bitrate() const;
+    void setBitrate(int bitrate);
+    int dataBitrate() const;
+    void setDataBitrate(int dataBitrate);
+
+    void addFrame(const QCanBusFrame &frame);
+    void reset();
+
+    struct CobIdStats
+    {
+        quint32 cobId;
+        quint64 count;
+        quint64 txCount;
+        qreal rate;             // frames per second
+        qint64 meanIntervalUs;  // smoothed inter-arrival time
+        qint64 jitterUs;        // smoothed deviation of inter-arrival time
+        qint64 minIntervalUs;
+        qint64 maxIntervalUs;
+        qint64 lastTimeUs;
+    };
+
+    struct Snapshot
+    {
+        qreal busLoad;  // ratio of the last window, 0 to 1
+        qreal peakBusLoad;
+        qreal framesPerSecond;
+        quint64 framesCount;
+        quint64 txFramesCount;
+        quint64 errorFramesCount;
+        quint64 extendedFramesCount;
+        qreal serviceRates[16];  // frames per second by function code (cob id >> 7)
+        qreal nodeRates[128];    // frames per second by node id (cob id & 7Fh)
+        QVector<CobIdStats> cobIds;  // active cob ids only
+    };
+    Snapshot snapshot() const;
+
+    static int frameBitLength(const QCanBusFrame &frame);
+    qint64 frameDurationNs(const QCanBusFrame &frame) const;
+
+signals:
+    void snapshotPublished();
+
+public slots:
+    void publish();
+
+private:
+    enum
+    {
+        WINDOW_BUCKET_COUNT = 10,
+        WINDOW_BUCKET_MS = 100,
+        PUBLISH_PERIOD_MS = 200
+    };
+    struct Bucket
+    {
+        qint64 busTimeNs;
+        quint64 frames;
+    };
+
+    int _bitrate;
+    int _dataBitrate;
+
+    QElapsedTimer _clock;
+    Bucket _buckets[WINDOW_BUCKET_COUNT];
+    qint64 _currentBucket;
+
+    QVector<CobIdStats> _cobStats;      // standard ids, indexed by cob id
+    QVector<quint64> _publishedCounts;  // counts at last publish, for rates
+    qint64 _lastPublishNs;
+    quint64 _framesCount;
+    quint64 _txFramesCount;
+    quint64 _errorFramesCount;
+    quint64 _extendedFramesCount;
+    qreal _peakBusLoad;
+
+    // double buffered snapshot, a buffer is rebuilt only when no reader is copying it
+    Snapshot _snapshots[2];
+    QAtomicInt _publishedSnapshot;
+    mutable QAtomicInt _snapshotReaders[2];
+    QTimer *_publishTimer;
+
+    void advanceWindow(qint64 bucket);
+};
+
+#endif  // BUSSTATISTICS_H
@@ -14,8 +14,18 @@ CONFIG(release, debug|release) {
 SOURCES += \
     $$PWD/canopen.cpp \
     $$PWD/canopenbus.cpp \
+    $$PWD/txscheduler.cpp \
+    $$PWD/pollscheduler.cpp \
+    $$PWD/busstatistics.cpp \
+    $$PWD/timerwheel.cpp \
+    $$PWD/emergencystore.cpp \
+    $$PWD/odsnapshot.cpp \
+    $$PWD/configurationdownload.cpp \
+    $$PWD/pdomappingplanner.cpp \
+    $$PWD/objectrequest.cpp \
     $$PWD/node.cpp \
     $$PWD/nodeod.cpp \
+    $$PWD/nodeoddcfwriter.cpp \
     $$PWD/nodeindex.cpp \
     $$PWD/nodesubindex.cpp \
     $$PWD/nodeobjectid.cpp \
@@ -34,14 +44,18 @@ SOURCES += \
     $$PWD/services/nodediscover.cpp \
     $$PWD/datalogger/datalogger.cpp \
     $$PWD/datalogger/dldata.cpp \
+    $$PWD/datalogger/dltrigger.cpp \
+    $$PWD/datalogger/dlcapture.cpp \
     $$PWD/datalogger/fastdatalogger.cpp \
     $$PWD/datalogger/fastdataloggerconfig.cpp \
     $$PWD/profile/nodeprofile.cpp \
     $$PWD/profile/nodeprofilefactory.cpp \
     $$PWD/profile/p402/nodeprofile402.cpp \
+    $$PWD/profile/p402/axisgroup.cpp \
     $$PWD/profile/p402/mode.cpp \
     $$PWD/profile/p402/modedty.cpp \
     $$PWD/profile/p402/modeip.cpp \
+    $$PWD/profile/p402/iptrajectorystreamer.cpp \
     $$PWD/profile/p402/modetq.cpp \
     $$PWD/profile/p402/modevl.cpp \
     $$PWD/profile/p402/modepp.cpp \
@@ -51,6 +65,8 @@ SOURCES += \
     $$PWD/busdriver/qcanbusframe.cpp \
     $$PWD/busdriver/canbusdriver.cpp \
     $$PWD/busdriver/canbustcpudt.cpp \
+    $$PWD/busdriver/canbustcpudtframer.cpp \
+    $$PWD/busdriver/canbustcpudtserver.cpp \
     $$PWD/bootloader/bootloader.cpp \
     $$PWD/bootloader/model/ufwmodel.cpp \
     $$PWD/bootloader/parser/hexparser.cpp \
@@ -70,8 +86,18 @@ HEADERS += \
     $$PWD/canopen.h \
     $$PWD/canopen_global.h \
     $$PWD/canopenbus.h \
+    $$PWD/txscheduler.h \
+    $$PWD/pollscheduler.h \
+    $$PWD/busstatistics.h \
+    $$PWD/timerwheel.h \
+    $$PWD/emergencystore.h \
+    $$PWD/odsnapshot.h \
+    $$PWD/configurationdownload.h \
+    $$PWD/pdomappingplanner.h \
+    $$PWD/objectrequest.h \
     $$PWD/node.h \
     $$PWD/nodeod.h \
+    $$PWD/nodeoddcfwriter.h \
     $$PWD/nodeindex.h \
     $$PWD/nodesubindex.h \
     $$PWD/nodeobjectid.h \
@@ -91,14 +117,18 @@ HEADERS += \
     $$PWD/services/nodediscover.h \
     $$PWD/datalogger/datalogger.h \
     $$PWD/datalogger/dldata.h \
+    $$PWD/datalogger/dltrigger.h \
+    $$PWD/datalogger/dlcapture.h \
     $$PWD/datalogger/fastdatalogger.h \
     $$PWD/datalogger/fastdataloggerconfig.h \
     $$PWD/profile/nodeprofilefactory.h \
     $$PWD/profile/p402/nodeprofile402.h \
+    $$PWD/profile/p402/axisgroup.h \
     $$PWD/profile/nodeprofile.h \
     $$PWD/profile/p402/mode.h \
     $$PWD/profile/p402/modedty.h \
     $$PWD/profile/p402/modeip.h \
+    $$PWD/profile/p402/iptrajectorystreamer.h \
     $$PWD/profile/p402/modepp.h \
     $$PWD/profile/p402/modetq.h \
     $$PWD/profile/p402/modevl.h \
@@ -108,6 +138,8 @@ HEADERS += \
     $$PWD/busdriver/qcanbusframe.h \
     $$PWD/busdriver/canbusdriver.h \
     $$PWD/busdriver/canbustcpudt.h \
+    $$PWD/busdriver/canbustcpudtframer.h \
+    $$PWD/busdriver/canbustcpudtserver.h \
     $$PWD/bootloader/bootloader.h \
     $$PWD/bootloader/model/ufwmodel.h \
     $$PWD/bootloader/parser/hexparser.h \
@@ -25,11 +25,18 @@ CanOpenBus::CanOpenBus(CanBusDriver *canBusDriver)
     _busId = 255;
     _canOpen = nullptr;
     _canBusDriver = nullptr;
-    setCanBusDriver(canBusDriver);
     _spyMode = false;
+    _focusedMode = false;
+    _filtersUpdateScheduled = false;
+    _driverFiltered = false;
+    setCanBusDriver(canBusDriver);
+
+    _txScheduler = new TxScheduler(this);
+    _pollScheduler = new PollScheduler(this);
 
     // services
     _serviceDispatcher = new ServiceDispatcher(this);
+    connect(_serviceDispatcher, &ServiceDispatcher::servicesChanged, this, &CanOpenBus::scheduleFiltersUpdate);
 
     _sync = new Sync(this);
     _serviceDispatcher->addService(_sync);
@@ -45,6 +52,9 @@ CanOpenBus::CanOpenBus(CanBusDriver *canBusDriver)
     _canFramesLogTimer = new QTimer();
     connect(_canFramesLogTimer, &QTimer::timeout, this, &CanOpenBus::notifyForNewFrames);
     _canFramesLogTimer->start(100);
+
+    _statistics = new BusStatistics(this);
+    _emergencyStore = new EmergencyStore(this);
 }
 
 CanOpenBus::~CanOpenBus()
@@ -173,6 +183,7 @@ void CanOpenBus::setCanBusDriver(CanBusDriver *canBusDriver)
     }
 
     _canBusDriver = canBusDriver;
+    _driverFiltered = false;
     if (_canBusDriver != nullptr)
     {
         if (_canBusDriver->state() == CanBusDriver::DISCONNECTED)
@@ -181,6 +192,10 @@ void CanOpenBus::setCanBusDriver(CanBusDriver *canBusDriver)
         }
         connect(_canBusDriver, &CanBusDriver::framesReceived, this, &CanOpenBus::canFrameRec, Qt::UniqueConnection);
         connect(_canBusDriver, &CanBusDriver::stateChanged, this, &CanOpenBus::updateState);
+        if (_focusedMode)
+        {
+            updateFilters();
+        }
     }
 }
 
@@ -198,18 +213,76 @@ bool CanOpenBus::canWrite() const
     return !((_canBusDriver == nullptr) || _spyMode);
 }
 
+bool CanOpenBus::isCanFd() const
+{
+    if (_canBusDriver == nullptr)
+    {
+        return false;
+    }
+    return _canBusDriver->isCanFd();
+}
+
+bool CanOpenBus::isSpyMode() const
+{
+    return _spyMode;
+}
+
+/**
+ * @brief spy mode, no frame is sent and all frames are captured
+ */
+void CanOpenBus::setSpyMode(bool spyMode)
+{
+    _spyMode = spyMode;
+    updateFilters();
+}
+
+bool CanOpenBus::isFocusedMode() const
+{
+    return _focusedMode;
+}
+
+/**
+ * @brief focused mode, only frames of cob ids registered by services are received, filtered in kernel when
+ * the driver supports it. Ignored in spy mode.
+ */
+void CanOpenBus::setFocusedMode(bool focusedMode)
+{
+    _focusedMode = focusedMode;
+    updateFilters();
+}
+
 bool CanOpenBus::writeFrame(const QCanBusFrame &frame)
 {
     if (!canWrite())
     {
         return false;
     }
-    _canBusDriver->writeFrame(frame);
-    QCanBusFrame emitFrame = frame;
-    emitFrame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(QDateTime::currentMSecsSinceEpoch() * 1000));
-    emitFrame.setLocalEcho(true);
-    _canFramesLog.append(emitFrame);
-    return true;
+    return _txScheduler->queueFrame(frame);
+}
+
+/**
+ * @brief writes frames to driver, called by the TxScheduler
+ * @return number of frames accepted by the driver
+ */
+int CanOpenBus::sendFrames(const QCanBusFrame *frames, int count)
+{
+    int sent = _canBusDriver->writeFrames(frames, count);
+
+    // with TX echo, sent frames are logged on reception with their true transmission timestamp,
+    // unless the focused mode filter may drop the echo of frames with a cob id not received by services
+    if (!_canBusDriver->hasTxEcho() || _driverFiltered)
+    {
+        QCanBusFrame::TimeStamp timeStamp = QCanBusFrame::TimeStamp::fromMicroSeconds(_txScheduler->currentTimeUs());
+        for (int i = 0; i < sent; i++)
+        {
+            QCanBusFrame emitFrame = frames[i];
+            emitFrame.setTimeStamp(timeStamp);
+            emitFrame.setLocalEcho(true);
+            _canFramesLog.append(emitFrame);
+            _statistics->addFrame(emitFrame);
+        }
+    }
+    return sent;
 }
 
 ServiceDispatcher *CanOpenBus::dispatcher() const
@@ -222,6 +295,26 @@ Sync *CanOpenBus::sync() const
     return _sync;
 }
 
+TxScheduler *CanOpenBus::txScheduler() const
+{
+    return _txScheduler;
+}
+
+PollScheduler *CanOpenBus::pollScheduler() const
+{
+    return _pollScheduler;
+}
+
+BusStatistics *CanOpenBus::statistics() const
+{
+    return _statistics;
+}
+
+EmergencyStore *CanOpenBus::emergencyStore() const
+{
+    return _emergencyStore;
+}
+
 void CanOpenBus::canFrameRec()
 {
     if (_canBusDriver == nullptr)
@@ -232,8 +325,25 @@ void CanOpenBus::canFrameRec()
     QCanBusFrame frame = _canBusDriver->readFrame();
     while (frame.isValid())
     {
-        _serviceDispatcher->parseFrame(frame);
-        _canFramesLog.append(frame);
+        if (frame.hasLocalEcho() && _driverFiltered)
+        {
+            // own frame already logged when sent
+            frame = _canBusDriver->readFrame();
+            continue;
+        }
+
+        _statistics->addFrame(frame);
+        if (frame.hasLocalEcho() || frame.frameType() == QCanBusFrame::ErrorFrame)
+        {
+            // own frame echoed by driver, with its transmission timestamp, or bus error
+            _canFramesLog.append(frame);
+        }
+        else if (!_focusedMode || _spyMode || _serviceDispatcher->hasService(frame.frameId()))
+        {
+            // in focused mode, frames not filtered by driver are dropped
+            _serviceDispatcher->parseFrame(frame);
+            _canFramesLog.append(frame);
+        }
 
         frame = _canBusDriver->readFrame();
     }
@@ -250,5 +360,41 @@ void CanOpenBus::notifyForNewFrames()
 
 void CanOpenBus::updateState()
 {
+    if (isConnected())
+    {
+        updateFilters();
+    }
     emit connectedChanged(isConnected());
 }
+
+void CanOpenBus::scheduleFiltersUpdate()
+{
+    if (!_focusedMode || _filtersUpdateScheduled)
+    {
+        return;
+    }
+    _filtersUpdateScheduled = true;
+    QTimer::singleShot(0, this, &CanOpenBus::updateFilters);
+}
+
+/**
+ * @brief pushes receive filters of registered cob ids to driver in focused mode, all frames otherwise
+ */
+void CanOpenBus::updateFilters()
+{
+    _filtersUpdateScheduled = false;
+    if (_canBusDriver == nullptr)
+    {
+        return;
+    }
+
+    if (_focusedMode && !_spyMode)
+    {
+        _driverFiltered = _canBusDriver->setFilters(_serviceDispatcher->cobIdFilters());
+    }
+    else
+    {
+        _canBusDriver->setFilters(QList<CanBusDriver::Filter>());
+        _driverFiltered = false;
+    }
+}
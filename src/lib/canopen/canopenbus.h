@@ -24,8 +24,12 @@
 #include <QObject>
 
 #include "busdriver/canbusdriver.h"
+#include "busstatistics.h"
+#include "emergencystore.h"
 #include "node.h"
+#include "pollscheduler.h"
 #include "services/services.h"
+#include "txscheduler.h"
 
 #include <QMap>
 
@@ -53,12 +57,22 @@ public:
     void setCanBusDriver(CanBusDriver *canBusDriver);
     bool isConnected() const;
     bool canWrite() const;
+    bool isCanFd() const;
+
+    bool isSpyMode() const;
+    void setSpyMode(bool spyMode);
+    bool isFocusedMode() const;
+    void setFocusedMode(bool focusedMode);
     bool writeFrame(const QCanBusFrame &frame);
 
     const QList<QCanBusFrame> &canFramesLog() const;
 
     ServiceDispatcher *dispatcher() const;
     Sync *sync() const;
+    TxScheduler *txScheduler() const;
+    PollScheduler *pollScheduler() const;
+    BusStatistics *statistics() const;
+    EmergencyStore *emergencyStore() const;
 
 public slots:
     void exploreBus();
@@ -80,9 +94,14 @@ protected slots:
     void canFrameRec();
     void notifyForNewFrames();
     void updateState();
+    void scheduleFiltersUpdate();
+    void updateFilters();
 
 protected:
     friend class CanOpen;
+    friend class TxScheduler;
+    int sendFrames(const QCanBusFrame *frames, int count);
+
     CanOpen *_canOpen;
     quint8 _busId;
 
@@ -96,6 +115,18 @@ protected:
     int _canFrameLogId;
     QTimer *_canFramesLogTimer;
 
+    // bus load and traffic statistics
+    BusStatistics *_statistics;
+
+    // emergency events history
+    EmergencyStore *_emergencyStore;
+
+    // transmit
+    TxScheduler *_txScheduler;
+
+    // periodic SDO polling
+    PollScheduler *_pollScheduler;
+
     // services
     ServiceDispatcher *_serviceDispatcher;
     NodeDiscover *_nodeDiscover;
@@ -104,6 +135,11 @@ protected:
 
     // spy mode
     bool _spyMode;
+
+    // focused mode, only frames of registered services are received
+    bool _focusedMode;
+    bool _filtersUpdateScheduled;
+    bool _driverFiltered;  // echoes of own frames may be filtered out, they are logged when sent
 };
 
 #endif  // CANOPENBUS_H
@@ -0,0 +1,694 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "configurationdownload.h"
+
+#include "node.h"
+#include "nodeodsubscriber.h"
+#include "timerwheel.h"
+
+#include "model/deviceconfiguration.h"
+#include "parser/dcfparser.h"
+#include "parser/edsparser.h"
+#include "utility/configurationapply.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+
+enum
+{
+    TIMEOUT_JOB = 5000  // without answer, SDO::reset() drops queued transfers without notification
+};
+
+class ConfigurationDownloadJob : public NodeOdSubscriber, public TimerWheelClient
+{
+public:
+    ConfigurationDownloadJob(ConfigurationDownload *download, Node *node, const ConfigurationDownload::Configuration &configuration);
+
+    void start();
+    void cancel();
+    bool isRunning() const;
+
+    ConfigurationDownload::NodeReport report;
+
+private:
+    enum State
+    {
+        StateIdle,
+        StateRead,
+        StateWrite,
+        StateStore,
+        StateVerify
+    };
+
+    ConfigurationDownload *_download;
+    Node *_node;
+    ConfigurationDownload::Configuration _configuration;
+    ConfigurationDownload::Configuration _changed;
+    State _state;
+    QHash<quint32, int> _pending;
+    QSet<quint32> _disabling;
+    QElapsedTimer _timer;
+    TimerWheel::Timer _timeoutTimer;
+
+    bool startRead();
+    bool startWrite();
+    bool startStore();
+    bool startVerify();
+    void nextState();
+    void finish();
+    void cancelPending();
+
+    void read(quint32 key);
+    void write(quint16 index, quint8 subIndex, const QVariant &value);
+    QVariant currentValue(quint32 key) const;
+    bool sameValue(quint32 key, const QVariant &target) const;
+    static quint16 pdoCommIndex(quint16 index);
+
+    // NodeOdSubscriber interface
+protected:
+    void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) override;
+
+    // TimerWheelClient interface
+protected:
+    void timerWheelEvent(int timerId) override;
+};
+
+ConfigurationDownloadJob::ConfigurationDownloadJob(ConfigurationDownload *download, Node *node, const ConfigurationDownload::Configuration &configuration)
+    : _download(download)
+    , _node(node)
+    , _configuration(configuration)
+    , _timeoutTimer(this)
+{
+    _state = StateIdle;
+    report = ConfigurationDownload::NodeReport{node, 0, 0, 0, 0, 0, 0, false, false};
+    setNodeInterrest(node);
+    registerFullOd();
+}
+
+void ConfigurationDownloadJob::start()
+{
+    report = ConfigurationDownload::NodeReport{_node, 0, 0, 0, 0, 0, 0, false, false};
+    _changed.clear();
+    _pending.clear();
+    _disabling.clear();
+    _timer.start();
+
+    // only writable objects present in the node od are downloaded
+    for (auto it = _configuration.begin(); it != _configuration.end();)
+    {
+        NodeSubIndex *subIndex = _node->nodeOd()->subIndex(static_cast<quint16>(it.key() >> 8), static_cast<quint8>(it.key() & 0xFF));
+        if (subIndex == nullptr || !subIndex->isWritable())
+        {
+            it = _configuration.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    report.targetCount = _configuration.size();
+
+    // a stopped or unknown node does not answer to SDO
+    if (_node->status() == Node::STOPPED || _node->status() == Node::UNKNOWN)
+    {
+        report.errorCount = report.targetCount;
+        finish();
+        return;
+    }
+
+    _state = StateRead;
+    if (!startRead())
+    {
+        nextState();
+    }
+    if (isRunning())
+    {
+        _timeoutTimer.start(TIMEOUT_JOB);
+    }
+}
+
+void ConfigurationDownloadJob::cancel()
+{
+    cancelPending();
+    _state = StateIdle;
+    _timeoutTimer.stop();
+}
+
+bool ConfigurationDownloadJob::isRunning() const
+{
+    return _state != StateIdle;
+}
+
+bool ConfigurationDownloadJob::startRead()
+{
+    QList<quint32> keys;
+    for (auto it = _configuration.cbegin(); it != _configuration.cend(); ++it)
+    {
+        quint16 index = static_cast<quint16>(it.key() >> 8);
+        if (_download->isReadBeforeDiff() || !currentValue(it.key()).isValid())
+        {
+            keys.append(it.key());
+        }
+
+        // PDO sequencing needs current COB-ID and mapping count
+        quint16 commIndex = pdoCommIndex(index);
+        if (commIndex != 0)
+        {
+            keys.append(ConfigurationDownload::objectKey(commIndex, 1));
+            keys.append(ConfigurationDownload::objectKey(commIndex + 0x200, 0));
+        }
+    }
+
+    for (quint32 key : qAsConst(keys))
+    {
+        if (!_pending.contains(key) && _node->nodeOd()->subIndexExist(static_cast<quint16>(key >> 8), static_cast<quint8>(key & 0xFF)))
+        {
+            read(key);
+        }
+    }
+    return !_pending.isEmpty();
+}
+
+bool ConfigurationDownloadJob::startWrite()
+{
+    QMap<quint16, QList<quint32>> pdoChanges;
+    QList<quint32> generalChanges;
+    for (auto it = _configuration.cbegin(); it != _configuration.cend(); ++it)
+    {
+        if (sameValue(it.key(), it.value()))
+        {
+            continue;
+        }
+        _changed.insert(it.key(), it.value());
+
+        quint16 commIndex = pdoCommIndex(static_cast<quint16>(it.key() >> 8));
+        if (commIndex != 0)
+        {
+            pdoChanges[commIndex].append(it.key());
+        }
+        else
+        {
+            generalChanges.append(it.key());
+        }
+    }
+    report.changedCount = _changed.size();
+
+    for (quint32 key : qAsConst(generalChanges))
+    {
+        write(static_cast<quint16>(key >> 8), static_cast<quint8>(key & 0xFF), _changed.value(key));
+    }
+
+    // PDO state machine order: disable, clear mapping, mapping entries, mapping count, comm params, COB-ID
+    for (auto it = pdoChanges.cbegin(); it != pdoChanges.cend(); ++it)
+    {
+        quint16 commIndex = it.key();
+        quint16 mappingIndex = commIndex + 0x200;
+        quint32 cobIdKey = ConfigurationDownload::objectKey(commIndex, 1);
+        quint32 currentCobId = currentValue(cobIdKey).toUInt();
+        quint32 targetCobId = _configuration.value(cobIdKey, currentCobId).toUInt();
+
+        bool disabled = false;
+        if ((currentCobId & 0x80000000U) == 0)
+        {
+            write(commIndex, 1, currentCobId | 0x80000000U);
+            _disabling.insert(cobIdKey);
+            disabled = true;
+        }
+
+        QList<quint32> mappingChanges;
+        QList<quint32> commChanges;
+        for (quint32 key : it.value())
+        {
+            if ((key >> 8) == mappingIndex)
+            {
+                mappingChanges.append(key);
+            }
+            else if (key != cobIdKey)
+            {
+                commChanges.append(key);
+            }
+        }
+
+        if (!mappingChanges.isEmpty())
+        {
+            quint32 countKey = ConfigurationDownload::objectKey(mappingIndex, 0);
+            quint8 mappingCount = static_cast<quint8>(_configuration.value(countKey, currentValue(countKey)).toUInt());
+            write(mappingIndex, 0, quint8(0));
+            for (quint32 key : qAsConst(mappingChanges))
+            {
+                if (key != countKey)
+                {
+                    write(mappingIndex, static_cast<quint8>(key & 0xFF), _changed.value(key));
+                }
+            }
+            write(mappingIndex, 0, mappingCount);
+        }
+
+        for (quint32 key : qAsConst(commChanges))
+        {
+            write(commIndex, static_cast<quint8>(key & 0xFF), _changed.value(key));
+        }
+
+        if (disabled || targetCobId != currentCobId)
+        {
+            write(commIndex, 1, targetCobId);
+        }
+    }
+
+    return !_pending.isEmpty();
+}
+
+bool ConfigurationDownloadJob::startStore()
+{
+    if (!_download->isStoreEnabled() || _changed.isEmpty() || !_node->nodeOd()->subIndexExist(0x1010, 1))
+    {
+        return false;
+    }
+
+    // "save" signature, store all parameters
+    write(0x1010, 1, quint32(0x65766173));
+    return !_pending.isEmpty();
+}
+
+bool ConfigurationDownloadJob::startVerify()
+{
+    if (!_download->isVerifyEnabled())
+    {
+        return false;
+    }
+
+    for (auto it = _changed.cbegin(); it != _changed.cend(); ++it)
+    {
+        read(it.key());
+    }
+    return !_pending.isEmpty();
+}
+
+void ConfigurationDownloadJob::nextState()
+{
+    while (_state != StateIdle)
+    {
+        switch (_state)
+        {
+            case StateIdle:
+                return;
+
+            case StateRead:
+                _state = StateWrite;
+                if (startWrite())
+                {
+                    return;
+                }
+                break;
+
+            case StateWrite:
+                _state = StateStore;
+                if (startStore())
+                {
+                    return;
+                }
+                break;
+
+            case StateStore:
+                _state = StateVerify;
+                if (startVerify())
+                {
+                    return;
+                }
+                break;
+
+            case StateVerify:
+                if (_download->isVerifyEnabled())
+                {
+                    for (auto it = _changed.cbegin(); it != _changed.cend(); ++it)
+                    {
+                        if (!sameValue(it.key(), it.value()))
+                        {
+                            report.verifyMismatchCount++;
+                        }
+                    }
+                }
+                finish();
+                return;
+        }
+    }
+}
+
+void ConfigurationDownloadJob::finish()
+{
+    _state = StateIdle;
+    _timeoutTimer.stop();
+    report.elapsedMs = _timer.elapsed();
+    report.finished = true;
+    report.success = (report.errorCount == 0) && (report.verifyMismatchCount == 0);
+    _download->jobFinished(this);
+}
+
+/**
+ * @brief removes SDO requests of the job still queued, requests already started are ignored on completion
+ */
+void ConfigurationDownloadJob::cancelPending()
+{
+    bool reading = (_state == StateRead || _state == StateVerify);
+    for (auto it = _pending.cbegin(); it != _pending.cend(); ++it)
+    {
+        quint16 index = static_cast<quint16>(it.key() >> 8);
+        quint8 subIndex = static_cast<quint8>(it.key() & 0xFF);
+        for (int request = 0; request < it.value(); request++)
+        {
+            if (reading)
+            {
+                _node->cancelReadObject(index, subIndex);
+            }
+            else
+            {
+                _node->cancelWriteObject(index, subIndex);
+            }
+        }
+    }
+    _pending.clear();
+    _disabling.clear();
+}
+
+void ConfigurationDownloadJob::read(quint32 key)
+{
+    quint16 index = static_cast<quint16>(key >> 8);
+    quint8 subIndex = static_cast<quint8>(key & 0xFF);
+    if (_node->isReadByPdo(NodeObjectId(index, subIndex)))
+    {
+        // value refreshed by TPDO, no SDO upload
+        return;
+    }
+    _pending[key]++;
+    _node->readObject(index, subIndex);
+}
+
+void ConfigurationDownloadJob::write(quint16 index, quint8 subIndex, const QVariant &value)
+{
+    report.writeCount++;
+    if (!_node->isWrittenByPdo(NodeObjectId(index, subIndex)))
+    {
+        _pending[ConfigurationDownload::objectKey(index, subIndex)]++;
+    }
+    _node->writeObject(index, subIndex, value);
+}
+
+QVariant ConfigurationDownloadJob::currentValue(quint32 key) const
+{
+    return _node->nodeOd()->value(static_cast<quint16>(key >> 8), static_cast<quint8>(key & 0xFF));
+}
+
+bool ConfigurationDownloadJob::sameValue(quint32 key, const QVariant &target) const
+{
+    QVariant current = currentValue(key);
+    if (!current.isValid())
+    {
+        return false;
+    }
+
+    QVariant converted = target;
+    if (converted.type() != current.type() && !converted.convert(static_cast<int>(current.type())))
+    {
+        return false;
+    }
+    return converted == current;
+}
+
+/**
+ * @brief PDO communication index of a PDO communication or mapping index, 0 for other objects
+ */
+quint16 ConfigurationDownloadJob::pdoCommIndex(quint16 index)
+{
+    if ((index >= 0x1400 && index < 0x1600) || (index >= 0x1800 && index < 0x1A00))
+    {
+        return index;
+    }
+    if ((index >= 0x1600 && index < 0x1800) || (index >= 0x1A00 && index < 0x1C00))
+    {
+        return index - 0x200;
+    }
+    return 0;
+}
+
+void ConfigurationDownloadJob::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+{
+    if (_pending.isEmpty())
+    {
+        return;
+    }
+
+    quint32 key = ConfigurationDownload::objectKey(objId.index(), objId.subIndex());
+    auto it = _pending.find(key);
+    if (it == _pending.end())
+    {
+        return;
+    }
+
+    bool reading = (_state == StateRead || _state == StateVerify);
+    int expectedFlag = reading ? NodeOd::Read : NodeOd::Write;
+    if ((flags & (expectedFlag | NodeOd::Error)) == 0)
+    {
+        return;
+    }
+    // the first write of a COB-ID being disabled is the disable itself
+    bool disabling = (_state == StateWrite) && _disabling.remove(key);
+    if ((flags & NodeOd::Error) == NodeOd::Error)
+    {
+        report.errorCount++;
+        if (disabling)
+        {
+            // PDO still enabled, its mapping cannot be written
+            cancel();
+            finish();
+            return;
+        }
+    }
+
+    it.value()--;
+    if (it.value() <= 0)
+    {
+        _pending.erase(it);
+    }
+    if (_pending.isEmpty())
+    {
+        nextState();
+    }
+    if (isRunning())
+    {
+        _timeoutTimer.start(TIMEOUT_JOB);
+    }
+}
+
+/**
+ * @brief no answer during TIMEOUT_JOB, transfers still pending are counted as errors
+ */
+void ConfigurationDownloadJob::timerWheelEvent(int timerId)
+{
+    Q_UNUSED(timerId)
+    if (!isRunning())
+    {
+        return;
+    }
+    for (int count : qAsConst(_pending))
+    {
+        report.errorCount += count;
+    }
+    cancel();
+    finish();
+}
+
+ConfigurationDownload::ConfigurationDownload(QObject *parent)
+    : QObject(parent)
+{
+    _readBeforeDiff = true;
+    _storeEnabled = false;
+    _verifyEnabled = true;
+    _runningJobs = 0;
+}
+
+ConfigurationDownload::~ConfigurationDownload()
+{
+    qDeleteAll(_jobs);
+}
+
+quint32 ConfigurationDownload::objectKey(quint16 index, quint8 subIndex)
+{
+    return (static_cast<quint32>(index) << 8) | subIndex;
+}
+
+/**
+ * @brief loads target values from a dcf file, or from a conf file applied on the node eds
+ */
+bool ConfigurationDownload::loadConfiguration(Node *node, const QString &fileName, Configuration &configuration)
+{
+    DeviceConfiguration *deviceConfiguration = nullptr;
+    if (fileName.endsWith(".conf"))
+    {
+        if (node->edsFileName().isEmpty())
+        {
+            return false;
+        }
+        DeviceDescription *deviceDescription = EdsParser().parse(node->edsFileName());
+        if (deviceDescription == nullptr)
+        {
+            return false;
+        }
+        deviceConfiguration = DeviceConfiguration::fromDeviceDescription(deviceDescription, node->nodeId());
+        delete deviceDescription;
+        if (!ConfigurationApply::apply(deviceConfiguration, fileName))
+        {
+            delete deviceConfiguration;
+            return false;
+        }
+    }
+    else
+    {
+        deviceConfiguration = DcfParser().parse(fileName);
+        if (deviceConfiguration == nullptr)
+        {
+            return false;
+        }
+    }
+
+    configuration.clear();
+    for (Index *index : deviceConfiguration->indexes())
+    {
+        for (SubIndex *subIndex : index->subIndexes())
+        {
+            if (!subIndex->value().isValid())
+            {
+                continue;
+            }
+            QVariant value = subIndex->value();
+            if (subIndex->hasNodeId() && !fileName.endsWith(".conf"))
+            {
+                value = value.toUInt() + node->nodeId();
+            }
+            configuration.insert(objectKey(index->index(), subIndex->subIndex()), value);
+        }
+    }
+    delete deviceConfiguration;
+    return true;
+}
+
+void ConfigurationDownload::addNode(Node *node, const Configuration &configuration)
+{
+    _jobs.append(new ConfigurationDownloadJob(this, node, configuration));
+}
+
+bool ConfigurationDownload::addNode(Node *node, const QString &fileName)
+{
+    Configuration configuration;
+    if (!loadConfiguration(node, fileName, configuration))
+    {
+        return false;
+    }
+    addNode(node, configuration);
+    return true;
+}
+
+void ConfigurationDownload::clear()
+{
+    cancel();
+    qDeleteAll(_jobs);
+    _jobs.clear();
+}
+
+/**
+ * @brief reads all target objects before diff, otherwise values already in od are trusted
+ */
+bool ConfigurationDownload::isReadBeforeDiff() const
+{
+    return _readBeforeDiff;
+}
+
+void ConfigurationDownload::setReadBeforeDiff(bool readBeforeDiff)
+{
+    _readBeforeDiff = readBeforeDiff;
+}
+
+bool ConfigurationDownload::isStoreEnabled() const
+{
+    return _storeEnabled;
+}
+
+void ConfigurationDownload::setStoreEnabled(bool storeEnabled)
+{
+    _storeEnabled = storeEnabled;
+}
+
+bool ConfigurationDownload::isVerifyEnabled() const
+{
+    return _verifyEnabled;
+}
+
+void ConfigurationDownload::setVerifyEnabled(bool verifyEnabled)
+{
+    _verifyEnabled = verifyEnabled;
+}
+
+bool ConfigurationDownload::isRunning() const
+{
+    return _runningJobs > 0;
+}
+
+QList<ConfigurationDownload::NodeReport> ConfigurationDownload::reports() const
+{
+    QList<NodeReport> reports;
+    for (ConfigurationDownloadJob *job : _jobs)
+    {
+        reports.append(job->report);
+    }
+    return reports;
+}
+
+void ConfigurationDownload::start()
+{
+    if (isRunning() || _jobs.isEmpty())
+    {
+        return;
+    }
+
+    _runningJobs = _jobs.count();
+    for (ConfigurationDownloadJob *job : qAsConst(_jobs))
+    {
+        job->start();
+    }
+}
+
+void ConfigurationDownload::cancel()
+{
+    for (ConfigurationDownloadJob *job : qAsConst(_jobs))
+    {
+        job->cancel();
+    }
+    _runningJobs = 0;
+}
+
+void ConfigurationDownload::jobFinished(ConfigurationDownloadJob *job)
+{
+    emit nodeFinished(job->report.node, job->report.success);
+
+    _runningJobs--;
+    if (_runningJobs == 0)
+    {
+        emit finished();
+    }
+}
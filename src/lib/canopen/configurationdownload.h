@@ -0,0 +1,100 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef CONFIGURATIONDOWNLOAD_H
+#define CONFIGURATIONDOWNLOAD_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include <QList>
+#include <QMap>
+#include <QVariant>
+
+class Node;
+class ConfigurationDownloadJob;
+
+/**
+ * @brief Downloads a target configuration to live nodes, writing only the changed sub-indexes
+ *
+ * For each node, target objects are read (or taken from the od), compared to the target and
+ * only differences are written. PDO parameters are written in the PDO state machine order:
+ * disable COB-ID, clear mapping, write mapping entries, set mapping count, then restore the
+ * COB-ID. Nodes are processed concurrently, an optional store (1010h) and verification pass end
+ * each node. A node without answer for 5 s ends with its pending transfers counted as errors.
+ */
+class CANOPEN_EXPORT ConfigurationDownload : public QObject
+{
+    Q_OBJECT
+public:
+    ConfigurationDownload(QObject *parent = nullptr);
+    ~ConfigurationDownload() override;
+
+    // target values, keyed by (index << 8) | subIndex
+    typedef QMap<quint32, QVariant> Configuration;
+    static quint32 objectKey(quint16 index, quint8 subIndex);
+    static bool loadConfiguration(Node *node, const QString &fileName, Configuration &configuration);
+
+    void addNode(Node *node, const Configuration &configuration);
+    bool addNode(Node *node, const QString &fileName);
+    void clear();
+
+    bool isReadBeforeDiff() const;
+    void setReadBeforeDiff(bool readBeforeDiff);
+    bool isStoreEnabled() const;
+    void setStoreEnabled(bool storeEnabled);
+    bool isVerifyEnabled() const;
+    void setVerifyEnabled(bool verifyEnabled);
+
+    bool isRunning() const;
+
+    struct NodeReport
+    {
+        Node *node;
+        int targetCount;
+        int changedCount;
+        int writeCount;  // with PDO sequencing writes
+        int errorCount;
+        int verifyMismatchCount;
+        qint64 elapsedMs;
+        bool finished;
+        bool success;
+    };
+    QList<NodeReport> reports() const;
+
+public slots:
+    void start();
+    void cancel();
+
+signals:
+    void nodeFinished(Node *node, bool success);
+    void finished();
+
+private:
+    friend class ConfigurationDownloadJob;
+    void jobFinished(ConfigurationDownloadJob *job);
+
+    QList<ConfigurationDownloadJob *> _jobs;
+    bool _readBeforeDiff;
+    bool _storeEnabled;
+    bool _verifyEnabled;
+    int _runningJobs;
+};
+
+#endif  // CONFIGURATIONDOWNLOAD_H
@@ -22,23 +22,33 @@
 #include <QFile>
 #include <QTextStream>
 
+#include "canopenbus.h"
 #include "db/odindexdb.h"
 
 DataLogger::DataLogger(QObject *parent)
     : QObject(parent)
 {
-    _timer.setTimerType(Qt::PreciseTimer);
-    connect(&_timer, &QTimer::timeout, this, &DataLogger::readData);
+    _started = false;
+    _periodMs = 0;
+
+    _preTriggerCount = 100;
+    _postTriggerCount = 100;
+    _postTriggerSamples = 0;
+    _autoRearm = false;
+    _triggerState = TriggerOff;
+    _captureHistorySize = 10;
 }
 
 DataLogger::~DataLogger()
 {
+    _started = false;
+    updatePolls();
     removeAllData();
 }
 
 bool DataLogger::isStarted() const
 {
-    return _timer.isActive();
+    return _started;
 }
 
 void DataLogger::addData(const NodeObjectId &objId)
@@ -101,6 +111,10 @@ void DataLogger::removeData(const NodeObjectId &objId)
     _dataList.removeOne(dlData);
     unRegisterObjId(dlData->objectId());
     delete dlData;
+    if (_started)
+    {
+        updatePolls();
+    }
 
     emit dataRemoved();
 }
@@ -128,6 +142,20 @@ DLData *DataLogger::data(const NodeObjectId &objId) const
     return _dataMap.value(objId.key());
 }
 
+void DataLogger::setDataActive(DLData *dlData, bool active)
+{
+    if (dlData->isActive() == active)
+    {
+        return;
+    }
+
+    dlData->setActive(active);
+    if (_started)
+    {
+        updatePolls();
+    }
+}
+
 qreal DataLogger::min() const
 {
     qreal min = std::numeric_limits<int>::max();
@@ -207,6 +235,12 @@ void DataLogger::addDataValue(DLData *dlData, const QVariant &value, const QDate
     }
     valueDouble *= dlData->scale();
 
+    if (_triggerState != TriggerOff)
+    {
+        addTriggeredDataValue(dlData, valueDouble, value.toUInt(), dateTime);
+        return;
+    }
+
     dlData->appendData(valueDouble, dateTime);
 
     emit dataChanged(_dataList.indexOf(dlData));
@@ -267,9 +301,106 @@ void DataLogger::exportCSVData(const QString &fileName)
     file.close();
 }
 
+const DLTrigger &DataLogger::trigger() const
+{
+    return _trigger;
+}
+
+void DataLogger::setTrigger(const DLTrigger &trigger)
+{
+    disarm();
+    _trigger = trigger;
+    if (_trigger.isEnabled())
+    {
+        addData(_trigger.objectId());  // the trigger object has to be logged to be evaluated
+    }
+}
+
+int DataLogger::preTriggerCount() const
+{
+    return _preTriggerCount;
+}
+
+void DataLogger::setPreTriggerCount(int preTriggerCount)
+{
+    _preTriggerCount = qMax(preTriggerCount, 0);
+    for (DLData *dlData : qAsConst(_dataList))
+    {
+        dlData->setRingSize(_preTriggerCount);
+    }
+}
+
+int DataLogger::postTriggerCount() const
+{
+    return _postTriggerCount;
+}
+
+void DataLogger::setPostTriggerCount(int postTriggerCount)
+{
+    _postTriggerCount = qMax(postTriggerCount, 0);
+}
+
+bool DataLogger::isAutoRearm() const
+{
+    return _autoRearm;
+}
+
+void DataLogger::setAutoRearm(bool autoRearm)
+{
+    _autoRearm = autoRearm;
+}
+
+DataLogger::TriggerState DataLogger::triggerState() const
+{
+    return _triggerState;
+}
+
+QString DataLogger::triggerStateStr() const
+{
+    switch (_triggerState)
+    {
+        case DataLogger::TriggerOff:
+            return tr("Off");
+
+        case DataLogger::TriggerArmed:
+            return tr("Waiting for trigger...");
+
+        case DataLogger::TriggerTriggered:
+            return tr("Triggered");
+
+        case DataLogger::TriggerCaptured:
+            return tr("Captured");
+    }
+    return QString();
+}
+
+const QList<DLCapture> &DataLogger::captures() const
+{
+    return _captures;
+}
+
+int DataLogger::captureHistorySize() const
+{
+    return _captureHistorySize;
+}
+
+void DataLogger::setCaptureHistorySize(int captureHistorySize)
+{
+    _captureHistorySize = qMax(captureHistorySize, 1);
+    while (_captures.count() > _captureHistorySize)
+    {
+        _captures.removeFirst();
+    }
+}
+
+void DataLogger::clearCaptures()
+{
+    _captures.clear();
+}
+
 void DataLogger::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
 {
-    if (!_timer.isActive())
+    if (!_started)
     {
         return;
     }
@@ -287,13 +418,21 @@ void DataLogger::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
 
 void DataLogger::start(int ms)
 {
-    _timer.start(ms);
+    // a completed capture is kept in history, the next one needs the trigger armed again
+    if (_trigger.isEnabled() && (_triggerState == TriggerOff || _triggerState == TriggerCaptured))
+    {
+        arm();
+    }
+    _started = true;
+    _periodMs = ms;
+    updatePolls();
     emit startChanged(true);
 }
 
 void DataLogger::stop()
 {
-    _timer.stop();
+    _started = false;
+    updatePolls();
     emit startChanged(false);
 }
 
@@ -308,13 +447,60 @@ void DataLogger::clear()
     }
 }
 
-void DataLogger::readData()
+void DataLogger::arm()
 {
+    if (!_trigger.isEnabled())
+    {
+        return;
+    }
+
+    for (DLData *dlData : qAsConst(_dataList))
+    {
+        dlData->clearRing();
+    }
+    _trigger.reset();
+    _postTriggerSamples = 0;
+    setTriggerState(TriggerArmed);
+}
+
+void DataLogger::disarm()
+{
+    _currentCapture = DLCapture();
+    setTriggerState(TriggerOff);
+}
+
+/**
+ * @brief registers active data to poll schedulers while started, removes all polls otherwise
+ */
+void DataLogger::updatePolls()
+{
+    for (const QPointer<PollScheduler> &pollScheduler : qAsConst(_pollSchedulers))
+    {
+        if (!pollScheduler.isNull())
+        {
+            pollScheduler->removePolls(this);
+        }
+    }
+    _pollSchedulers.clear();
+
+    if (!_started)
+    {
+        return;
+    }
+
     for (DLData *dlData : qAsConst(_dataList))
     {
-        if ((dlData->node() != nullptr) && dlData->isActive())
+        Node *node = dlData->node();
+        if ((node == nullptr) || (node->bus() == nullptr) || !dlData->isActive())
         {
-            dlData->node()->readObject(dlData->objectId());
+            continue;
+        }
+
+        PollScheduler *pollScheduler = node->bus()->pollScheduler();
+        pollScheduler->addPoll(this, node, dlData->objectId(), _periodMs, PollScheduler::PriorityHigh);
+        if (!_pollSchedulers.contains(pollScheduler))
+        {
+            _pollSchedulers.append(pollScheduler);
         }
     }
 }
@@ -325,10 +511,15 @@ void DataLogger::addDlData(const NodeObjectId &mobjId)
     emit dataAboutToBeAdded(_dataList.count());
     DLData *dlData = new DLData(mobjId);
     dlData->setColor(findFreeColor());
+    dlData->setRingSize(_preTriggerCount);
     dlData->setActive(true);
     _dataMap.insert(dlData->key(), dlData);
     _dataList.append(dlData);
     registerObjId(dlData->objectId());
+    if (_started)
+    {
+        updatePolls();
+    }
     emit dataAdded();
 
     connect(dlData->node(),
@@ -361,3 +552,95 @@ bool DataLogger::isColorFree(const QColor &color) const
     }
     return true;
 }
+
+void DataLogger::setTriggerState(TriggerState state)
+{
+    if (state != _triggerState)
+    {
+        _triggerState = state;
+        emit triggerStateChanged(_triggerState);
+    }
+}
+
+void DataLogger::addTriggeredDataValue(DLData *dlData, qreal value, quint32 rawValue, const QDateTime &dateTime)
+{
+    bool isTriggerObject = (dlData->objectId() == _trigger.objectId());
+
+    switch (_triggerState)
+    {
+        case DataLogger::TriggerOff:
+        case DataLogger::TriggerCaptured:
+            break;
+
+        case DataLogger::TriggerArmed:
+            // memory stays bounded while waiting, only the last preTriggerCount samples are kept
+            dlData->appendRingData(value, dateTime);
+            if (isTriggerObject && _trigger.evaluate(value, rawValue))
+            {
+                startCapture(dateTime);
+            }
+            break;
+
+        case DataLogger::TriggerTriggered:
+            _currentCapture.appendData(dlData->objectId(), value, dateTime);
+            if (isTriggerObject)
+            {
+                _postTriggerSamples++;
+                if (_postTriggerSamples >= _postTriggerCount)
+                {
+                    endCapture();
+                }
+            }
+            break;
+    }
+}
+
+void DataLogger::startCapture(const QDateTime &triggerDateTime)
+{
+    _currentCapture = DLCapture(triggerDateTime);
+    for (DLData *dlData : qAsConst(_dataList))
+    {
+        _currentCapture.addChannel(dlData->objectId(), dlData->ringValues(), dlData->ringTimes());
+        dlData->clearRing();
+    }
+    _postTriggerSamples = 0;
+    setTriggerState(TriggerTriggered);
+
+    if (_postTriggerCount == 0)
+    {
+        endCapture();
+    }
+}
+
+void DataLogger::endCapture()
+{
+    _captures.append(_currentCapture);
+    while (_captures.count() > _captureHistorySize)
+    {
+        _captures.removeFirst();
+    }
+
+    // last capture is displayed as logged data
+    for (int dataId = 0; dataId < _dataList.count(); dataId++)
+    {
+        DLData *dlData = _dataList.at(dataId);
+        const DLCapture::Channel *channel = _currentCapture.channel(dlData->objectId());
+        if (channel != nullptr)
+        {
+            dlData->setData(channel->values, channel->times);
+            emit dataChanged(dataId);
+        }
+    }
+    _currentCapture = DLCapture();
+
+    emit captureCompleted(_captures.count() - 1);
+
+    if (_autoRearm)
+    {
+        arm();
+    }
+    else
+    {
+        setTriggerState(TriggerCaptured);
+    }
+}
@@ -23,8 +23,13 @@
 
 #include "nodeodsubscriber.h"
 
+#include "dlcapture.h"
 #include "dldata.h"
+#include "dltrigger.h"
 #include <QMap>
+#include <QPointer>
+
+class PollScheduler;
 
 class CANOPEN_EXPORT DataLogger : public QObject, public NodeOdSubscriber
 {
@@ -42,6 +47,7 @@ public:
     QList<DLData *> &dataList();
     DLData *data(int index) const;
     DLData *data(const NodeObjectId &objId) const;
+    void setDataActive(DLData *dlData, bool active);
 
     qreal min() const;
     qreal max() const;
@@ -54,6 +60,34 @@ public:
 
     void exportCSVData(const QString &fileName);
 
+    // triggered capture
+    const DLTrigger &trigger() const;
+    void setTrigger(const DLTrigger &trigger);
+
+    int preTriggerCount() const;
+    void setPreTriggerCount(int preTriggerCount);
+
+    int postTriggerCount() const;
+    void setPostTriggerCount(int postTriggerCount);
+
+    bool isAutoRearm() const;
+    void setAutoRearm(bool autoRearm);
+
+    enum TriggerState
+    {
+        TriggerOff,
+        TriggerArmed,
+        TriggerTriggered,
+        TriggerCaptured
+    };
+    TriggerState triggerState() const;
+    QString triggerStateStr() const;
+
+    const QList<DLCapture> &captures() const;
+    int captureHistorySize() const;
+    void setCaptureHistorySize(int captureHistorySize);
+    void clearCaptures();
+
 signals:
     void dataChanged(int id);
     void dataAboutToBeAdded(int id);
@@ -63,23 +97,46 @@ signals:
 
     void startChanged(bool);
 
+    void triggerStateChanged(DataLogger::TriggerState state);
+    void captureCompleted(int captureId);
+
 public slots:
     void start(int ms);
     void stop();
     void clear();
 
-protected slots:
-    void readData();
+    void arm();
+    void disarm();
 
 protected:
     void addDlData(const NodeObjectId &mobjId);
     QMap<quint64, DLData *> _dataMap;
     QList<DLData *> _dataList;
-    QTimer _timer;
+    bool _started;
+    int _periodMs;
+
+    // objects are read by the poll scheduler of their bus
+    QList<QPointer<PollScheduler>> _pollSchedulers;
+    void updatePolls();
 
     QColor findFreeColor() const;
     bool isColorFree(const QColor &color) const;
 
+    // triggered capture
+    DLTrigger _trigger;
+    int _preTriggerCount;
+    int _postTriggerCount;
+    int _postTriggerSamples;
+    bool _autoRearm;
+    TriggerState _triggerState;
+    QList<DLCapture> _captures;
+    int _captureHistorySize;
+    DLCapture _currentCapture;
+    void setTriggerState(TriggerState state);
+    void addTriggeredDataValue(DLData *dlData, qreal value, quint32 rawValue, const QDateTime &dateTime);
+    void startCapture(const QDateTime &triggerDateTime);
+    void endCapture();
+
     // NodeOdSubscriber interface
 protected:
     void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) override;
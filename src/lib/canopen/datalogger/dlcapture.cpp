@@ -0,0 +1,73 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "dlcapture.h"
+
+DLCapture::DLCapture(const QDateTime &triggerDateTime)
+    : _triggerDateTime(triggerDateTime)
+{
+}
+
+const QDateTime &DLCapture::triggerDateTime() const
+{
+    return _triggerDateTime;
+}
+
+const QList<DLCapture::Channel> &DLCapture::channels() const
+{
+    return _channels;
+}
+
+const DLCapture::Channel *DLCapture::channel(const NodeObjectId &objectId) const
+{
+    for (const Channel &channel : _channels)
+    {
+        if (channel.objectId == objectId)
+        {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+int DLCapture::channelsCount() const
+{
+    return _channels.count();
+}
+
+void DLCapture::addChannel(const NodeObjectId &objectId, const QList<qreal> &values, const QList<QDateTime> &times)
+{
+    Channel channel;
+    channel.objectId = objectId;
+    channel.values = values;
+    channel.times = times;
+    _channels.append(channel);
+}
+
+void DLCapture::appendData(const NodeObjectId &objectId, qreal value, const QDateTime &dateTime)
+{
+    for (Channel &channel : _channels)
+    {
+        if (channel.objectId == objectId)
+        {
+            channel.values.append(value);
+            channel.times.append(dateTime);
+            return;
+        }
+    }
+}
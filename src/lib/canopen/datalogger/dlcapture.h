@@ -0,0 +1,54 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef DLCAPTURE_H
+#define DLCAPTURE_H
+
+#include "canopen_global.h"
+
+#include "nodeobjectid.h"
+
+#include <QDateTime>
+#include <QList>
+
+class CANOPEN_EXPORT DLCapture
+{
+public:
+    DLCapture(const QDateTime &triggerDateTime = QDateTime());
+
+    const QDateTime &triggerDateTime() const;
+
+    struct Channel
+    {
+        NodeObjectId objectId;
+        QList<qreal> values;
+        QList<QDateTime> times;
+    };
+    const QList<Channel> &channels() const;
+    const Channel *channel(const NodeObjectId &objectId) const;
+    int channelsCount() const;
+
+    void addChannel(const NodeObjectId &objectId, const QList<qreal> &values, const QList<QDateTime> &times);
+    void appendData(const NodeObjectId &objectId, qreal value, const QDateTime &dateTime);
+
+protected:
+    QDateTime _triggerDateTime;
+    QList<Channel> _channels;
+};
+
+#endif  // DLCAPTURE_H
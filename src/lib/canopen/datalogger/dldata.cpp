@@ -32,6 +32,8 @@ DLData::DLData(const NodeObjectId &objectId)
     _active = false;
     _scale = 1.0;
     _q1516 = false;
+    _ringHead = 0;
+    _ringCount = 0;
 
     CanOpenBus *bus = CanOpen::bus(objectId.busId());
     if (bus != nullptr)
@@ -197,6 +199,19 @@ void DLData::appendData(qreal value, const QDateTime &dateTime)
     _max = qMax(_max, value);
 }
 
+void DLData::setData(const QList<qreal> &values, const QList<QDateTime> &times)
+{
+    _values = values;
+    _times = times;
+
+    resetMinMax();
+    for (qreal value : values)
+    {
+        _min = qMin(_min, value);
+        _max = qMax(_max, value);
+    }
+}
+
 void DLData::clear()
 {
     _values.clear();
@@ -209,6 +224,69 @@ bool DLData::isEmpty() const
     return _values.isEmpty();
 }
 
+int DLData::ringSize() const
+{
+    return _ringValues.size();
+}
+
+void DLData::setRingSize(int size)
+{
+    _ringValues.resize(qMax(size, 0));
+    _ringTimes.resize(qMax(size, 0));
+    clearRing();
+}
+
+void DLData::appendRingData(qreal value, const QDateTime &dateTime)
+{
+    if (_ringValues.isEmpty())
+    {
+        return;
+    }
+
+    _ringValues[_ringHead] = value;
+    _ringTimes[_ringHead] = dateTime;
+    _ringHead = (_ringHead + 1) % _ringValues.size();
+    if (_ringCount < _ringValues.size())
+    {
+        _ringCount++;
+    }
+}
+
+void DLData::clearRing()
+{
+    _ringHead = 0;
+    _ringCount = 0;
+}
+
+int DLData::ringCount() const
+{
+    return _ringCount;
+}
+
+QList<qreal> DLData::ringValues() const
+{
+    QList<qreal> values;
+    values.reserve(_ringCount);
+    int tail = (_ringHead - _ringCount + _ringValues.size()) % qMax(_ringValues.size(), 1);
+    for (int i = 0; i < _ringCount; i++)
+    {
+        values.append(_ringValues[(tail + i) % _ringValues.size()]);
+    }
+    return values;
+}
+
+QList<QDateTime> DLData::ringTimes() const
+{
+    QList<QDateTime> times;
+    times.reserve(_ringCount);
+    int tail = (_ringHead - _ringCount + _ringTimes.size()) % qMax(_ringTimes.size(), 1);
+    for (int i = 0; i < _ringCount; i++)
+    {
+        times.append(_ringTimes[(tail + i) % _ringTimes.size()]);
+    }
+    return times;
+}
+
 qreal DLData::min() const
 {
     return _min;
@@ -26,6 +26,7 @@
 #include "node.h"
 
 #include <QColor>
+#include <QVector>
 
 class CANOPEN_EXPORT DLData
 {
@@ -58,9 +59,19 @@ public:
 
     // add / remove dada
     void appendData(qreal value, const QDateTime &dateTime);
+    void setData(const QList<qreal> &values, const QList<QDateTime> &times);
     void clear();
     bool isEmpty() const;
 
+    // pre-trigger ring buffer, fixed size
+    int ringSize() const;
+    void setRingSize(int size);
+    void appendRingData(qreal value, const QDateTime &dateTime);
+    void clearRing();
+    int ringCount() const;
+    QList<qreal> ringValues() const;
+    QList<QDateTime> ringTimes() const;
+
     // stats
     qreal min() const;
     qreal max() const;
@@ -89,6 +100,11 @@ protected:
     QList<qreal> _values;
     QList<QDateTime> _times;
 
+    QVector<qreal> _ringValues;
+    QVector<QDateTime> _ringTimes;
+    int _ringHead;
+    int _ringCount;
+
     qreal _min;
     qreal _max;
 
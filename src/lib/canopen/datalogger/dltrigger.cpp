@@ -0,0 +1,192 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "dltrigger.h"
+
+#include <QCoreApplication>
+
+DLTrigger::DLTrigger()
+{
+    _type = TriggerNone;
+    _level = 0.0;
+    _levelHigh = 0.0;
+    _bitMask = 0;
+    reset();
+}
+
+DLTrigger::Type DLTrigger::type() const
+{
+    return _type;
+}
+
+void DLTrigger::setType(Type type)
+{
+    _type = type;
+    reset();
+}
+
+QString DLTrigger::typeStr(Type type)
+{
+    switch (type)
+    {
+        case DLTrigger::TriggerNone:
+            return QCoreApplication::translate("DLTrigger", "None");
+
+        case DLTrigger::TriggerRisingEdge:
+            return QCoreApplication::translate("DLTrigger", "Rising edge");
+
+        case DLTrigger::TriggerFallingEdge:
+            return QCoreApplication::translate("DLTrigger", "Falling edge");
+
+        case DLTrigger::TriggerAnyEdge:
+            return QCoreApplication::translate("DLTrigger", "Any edge");
+
+        case DLTrigger::TriggerLevelAbove:
+            return QCoreApplication::translate("DLTrigger", "Level above");
+
+        case DLTrigger::TriggerLevelBelow:
+            return QCoreApplication::translate("DLTrigger", "Level below");
+
+        case DLTrigger::TriggerWindowInside:
+            return QCoreApplication::translate("DLTrigger", "Inside window");
+
+        case DLTrigger::TriggerWindowOutside:
+            return QCoreApplication::translate("DLTrigger", "Outside window");
+
+        case DLTrigger::TriggerBitSet:
+            return QCoreApplication::translate("DLTrigger", "Bit set");
+
+        case DLTrigger::TriggerBitCleared:
+            return QCoreApplication::translate("DLTrigger", "Bit cleared");
+    }
+    return QString();
+}
+
+bool DLTrigger::isEnabled() const
+{
+    return (_type != TriggerNone) && _objectId.isASubIndex();
+}
+
+const NodeObjectId &DLTrigger::objectId() const
+{
+    return _objectId;
+}
+
+void DLTrigger::setObjectId(const NodeObjectId &objectId)
+{
+    _objectId = objectId;
+    reset();
+}
+
+qreal DLTrigger::level() const
+{
+    return _level;
+}
+
+void DLTrigger::setLevel(qreal level)
+{
+    _level = level;
+}
+
+qreal DLTrigger::levelHigh() const
+{
+    return _levelHigh;
+}
+
+void DLTrigger::setLevelHigh(qreal levelHigh)
+{
+    _levelHigh = levelHigh;
+}
+
+quint32 DLTrigger::bitMask() const
+{
+    return _bitMask;
+}
+
+void DLTrigger::setBitMask(quint32 bitMask)
+{
+    _bitMask = bitMask;
+}
+
+/**
+ * @brief evaluates the trigger condition with a new sample of the trigger object
+ * @param value scaled value, used by edge, level and window triggers
+ * @param rawValue raw value as received from the device, used by bit triggers
+ * @return true if the trigger condition is met with this sample
+ */
+bool DLTrigger::evaluate(qreal value, quint32 rawValue)
+{
+    bool triggered = false;
+    bool previousBitSet = _hasPrevious && ((_previousRawValue & _bitMask) == _bitMask);
+    bool previousBitCleared = _hasPrevious && ((_previousRawValue & _bitMask) == 0);
+
+    switch (_type)
+    {
+        case DLTrigger::TriggerNone:
+            break;
+
+        case DLTrigger::TriggerRisingEdge:
+            triggered = _hasPrevious && (_previousValue < _level) && (value >= _level);
+            break;
+
+        case DLTrigger::TriggerFallingEdge:
+            triggered = _hasPrevious && (_previousValue > _level) && (value <= _level);
+            break;
+
+        case DLTrigger::TriggerAnyEdge:
+            triggered = _hasPrevious && (((_previousValue < _level) && (value >= _level)) || ((_previousValue > _level) && (value <= _level)));
+            break;
+
+        case DLTrigger::TriggerLevelAbove:
+            triggered = (value > _level);
+            break;
+
+        case DLTrigger::TriggerLevelBelow:
+            triggered = (value < _level);
+            break;
+
+        case DLTrigger::TriggerWindowInside:
+            triggered = (value >= _level) && (value <= _levelHigh);
+            break;
+
+        case DLTrigger::TriggerWindowOutside:
+            triggered = (value < _level) || (value > _levelHigh);
+            break;
+
+        case DLTrigger::TriggerBitSet:
+            triggered = (_bitMask != 0) && ((rawValue & _bitMask) == _bitMask) && _hasPrevious && !previousBitSet;
+            break;
+
+        case DLTrigger::TriggerBitCleared:
+            triggered = (_bitMask != 0) && ((rawValue & _bitMask) == 0) && _hasPrevious && !previousBitCleared;
+            break;
+    }
+
+    _hasPrevious = true;
+    _previousValue = value;
+    _previousRawValue = rawValue;
+
+    return triggered;
+}
+
+void DLTrigger::reset()
+{
+    _hasPrevious = false;
+    _previousValue = 0.0;
+    _previousRawValue = 0;
+}
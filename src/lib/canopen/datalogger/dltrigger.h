@@ -0,0 +1,79 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef DLTRIGGER_H
+#define DLTRIGGER_H
+
+#include "canopen_global.h"
+
+#include "nodeobjectid.h"
+
+#include <QString>
+
+class CANOPEN_EXPORT DLTrigger
+{
+public:
+    DLTrigger();
+
+    enum Type
+    {
+        TriggerNone,
+        TriggerRisingEdge,     // value crosses level upward
+        TriggerFallingEdge,    // value crosses level downward
+        TriggerAnyEdge,        // value crosses level in any direction
+        TriggerLevelAbove,     // value > level
+        TriggerLevelBelow,     // value < level
+        TriggerWindowInside,   // level <= value <= levelHigh
+        TriggerWindowOutside,  // value < level or value > levelHigh
+        TriggerBitSet,         // (raw & bitMask) becomes bitMask, ie statusword bit rising
+        TriggerBitCleared,     // (raw & bitMask) becomes 0, ie statusword bit falling
+    };
+    Type type() const;
+    void setType(Type type);
+    static QString typeStr(Type type);
+    bool isEnabled() const;
+
+    const NodeObjectId &objectId() const;
+    void setObjectId(const NodeObjectId &objectId);
+
+    qreal level() const;
+    void setLevel(qreal level);
+
+    qreal levelHigh() const;
+    void setLevelHigh(qreal levelHigh);
+
+    quint32 bitMask() const;
+    void setBitMask(quint32 bitMask);
+
+    bool evaluate(qreal value, quint32 rawValue);
+    void reset();
+
+protected:
+    NodeObjectId _objectId;
+    Type _type;
+    qreal _level;
+    qreal _levelHigh;
+    quint32 _bitMask;
+
+    // previous sample, used by edge and bit triggers
+    bool _hasPrevious;
+    qreal _previousValue;
+    quint32 _previousRawValue;
+};
+
+#endif  // DLTRIGGER_H
@@ -18,18 +18,43 @@
 
 #include "fastdatalogger.h"
 
-#include <QDataStream>
 #include <QDebug>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace
+{
+template <typename T>
+void decodeBuffer(const uchar *in, int count, qreal factor, qreal *out)
+{
+    for (int i = 0; i < count; i++)
+    {
+        out[i] = static_cast<qreal>(qFromLittleEndian<T>(in + i * static_cast<int>(sizeof(T)))) * factor;
+    }
+}
+
+void decodeFloatBuffer(const uchar *in, int count, qreal factor, qreal *out)
+{
+    for (int i = 0; i < count; i++)
+    {
+        quint32 raw = qFromLittleEndian<quint32>(in + i * 4);
+        float value;
+        memcpy(&value, &raw, sizeof(value));
+        out[i] = static_cast<qreal>(value) * factor;
+    }
+}
+}  // namespace
 
 FastDataLogger::FastDataLogger(Node *node)
     : _node(node)
 {
+    createObjects();
     registerIndex(0x2100);  // register all status objects
     setNodeInterrest(node);
 
-    _dataType1 = SourceDataInvalid;
-    _dataType2 = SourceDataInvalid;
-
+    _pendingChannels = 0;
+    _commitPending = false;
     _status = StatusOff;
 }
 
@@ -59,123 +84,166 @@ void FastDataLogger::stop()
     writeObject(0x2101, 0x01, 0);
 }
 
+/**
+ * @brief writes the configuration to the device, the firmware channel count is read first
+ * to clamp the configured channels and disable the unused ones
+ */
 void FastDataLogger::commitConfig()
 {
-    writeObject(0x2101, 0x02, objIdToU32(_config.data1_objId()));
-    writeObject(0x2101, 0x03, objIdToU32(_config.data2_objId()));
+    _commitPending = true;
+    readObject(0x2100, 0x00);  // read channel count, config is written on its notification
+}
+
+void FastDataLogger::writeConfig()
+{
+    _channels.clear();
+    int firmwareCount = firmwareChannelCount();
+    if (firmwareCount == 0)
+    {
+        firmwareCount = LegacyChannelCount;
+    }
+    for (int channel = 0; channel < firmwareCount; channel++)
+    {
+        NodeObjectId objId = (channel < _config.channelCount()) ? _config.channelObjId(channel) : NodeObjectId();
+        writeObject(0x2101, channelConfigSubIndex(channel), objIdToU32(objId));  // unused channels are disabled with a null object
+
+        if (channel < _config.channelCount())
+        {
+            Channel logChannel;
+            logChannel.objId = objId;
+            logChannel.dataType = typeFromObjId(objId);
+            logChannel.factor = factorFromObjId(objId);
+            _channels.append(logChannel);
+        }
+    }
     writeObject(0x2101, 0x04, _config.frequencyDivider());
     writeObject(0x2101, 0x05, objIdToU32(_config.trigger_objId()));
     writeObject(0x2101, 0x06, (uint8_t)_config.triggerType());
     writeObject(0x2101, 0x07, _config.triggerValue());
 
-    _dataType1 = typeFromObjId(_config.data1_objId());
-    _dataType2 = typeFromObjId(_config.data2_objId());
-
     readObject(0x2100, 0x01);  // trigger read status
 }
 
-const QList<qreal> &FastDataLogger::valuesData1() const
+/**
+ * @brief returns the number of channels exposed by the firmware, 0 if unknown
+ */
+int FastDataLogger::firmwareChannelCount() const
+{
+    bool ok;
+    int highestSubIndex = _node->nodeOd()->value(0x2100, 0x00).toInt(&ok);
+    if (!ok || highestSubIndex < 2)
+    {
+        return 0;
+    }
+    return qMin(highestSubIndex - 1, static_cast<int>(FastDataLoggerConfig::ChannelMaxCount));
+}
+
+int FastDataLogger::channelCount() const
 {
-    return _valuesData1;
+    return _channels.count();
 }
 
-const QList<qreal> &FastDataLogger::valuesData2() const
+const NodeObjectId &FastDataLogger::channelObjId(int channel) const
 {
-    return _valuesData2;
+    return _channels.at(channel).objId;
+}
+
+const QVector<qreal> &FastDataLogger::values(int channel) const
+{
+    return _channels.at(channel).values;
 }
 
 uint32_t FastDataLogger::objIdToU32(const NodeObjectId &objId)
 {
+    if (!objId.isASubIndex())
+    {
+        return 0;
+    }
     return ((uint32_t)objId.index() << 16) + ((uint32_t)objId.subIndex() << 8);
 }
 
 NodeObjectId FastDataLogger::u32ToObjId(uint32_t u32)
 {
-    return NodeObjectId((quint16)u32 >> 16, (quint8)u32 >> 8);
+    return NodeObjectId(static_cast<quint16>(u32 >> 16), static_cast<quint8>(u32 >> 8));
 }
 
-QList<qreal> FastDataLogger::byteArrayToReals(const QByteArray &byteArray, SourceDataType dataType)
+int FastDataLogger::sourceDataSize(SourceDataType dataType)
 {
-    QList<qreal> reals;
+    switch (dataType)
+    {
+        case FastDataLogger::SourceDataInvalid:
+            return 0;
 
-    QDataStream stream(byteArray);
-    stream.setByteOrder(QDataStream::LittleEndian);
+        case FastDataLogger::SourceDataU8:
+        case FastDataLogger::SourceDataI8:
+            return 1;
 
-    while (!stream.atEnd())
-    {
-        qreal valueDouble;
-        switch (dataType)
-        {
-            case FastDataLogger::SourceDataInvalid:
-                return reals;
-
-            case FastDataLogger::SourceDataU8:
-            {
-                uint8_t value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-
-            case FastDataLogger::SourceDataI8:
-            {
-                int8_t value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-
-            case FastDataLogger::SourceDataU16:
-            {
-                uint16_t value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-
-            case FastDataLogger::SourceDataI16:
-            {
-                int16_t value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-
-            case FastDataLogger::SourceDataU32:
-            {
-                uint32_t value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-
-            case FastDataLogger::SourceDataI32:
-            {
-                int32_t value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-
-            case FastDataLogger::SourceDataFloat:
-            {
-                float value;
-                stream >> value;
-                valueDouble = value;
-                break;
-            }
-        }
+        case FastDataLogger::SourceDataU16:
+        case FastDataLogger::SourceDataI16:
+            return 2;
 
-        // if (Q15)
-        //{
-        // valueDouble /= 65536.0;
-        //}
-        valueDouble /= 100.0;
+        case FastDataLogger::SourceDataU32:
+        case FastDataLogger::SourceDataI32:
+        case FastDataLogger::SourceDataFloat:
+            return 4;
+    }
+    return 0;
+}
 
-        reals.append(valueDouble);
+/**
+ * @brief decodes a whole device buffer in one pass into a contiguous array
+ * @param byteArray raw little endian buffer
+ * @param dataType type of each sample
+ * @param factor Q15.16 and scale factor applied to each sample
+ * @param reals output array, resized to the number of samples
+ */
+void FastDataLogger::byteArrayToReals(const QByteArray &byteArray, SourceDataType dataType, qreal factor, QVector<qreal> &reals)
+{
+    int dataSize = sourceDataSize(dataType);
+    if (dataSize == 0)
+    {
+        reals.clear();
+        return;
     }
 
-    return reals;
+    int count = byteArray.size() / dataSize;
+    reals.resize(count);
+    const uchar *in = reinterpret_cast<const uchar *>(byteArray.constData());
+    qreal *out = reals.data();
+
+    switch (dataType)
+    {
+        case FastDataLogger::SourceDataInvalid:
+            break;
+
+        case FastDataLogger::SourceDataU8:
+            decodeBuffer<quint8>(in, count, factor, out);
+            break;
+
+        case FastDataLogger::SourceDataI8:
+            decodeBuffer<qint8>(in, count, factor, out);
+            break;
+
+        case FastDataLogger::SourceDataU16:
+            decodeBuffer<quint16>(in, count, factor, out);
+            break;
+
+        case FastDataLogger::SourceDataI16:
+            decodeBuffer<qint16>(in, count, factor, out);
+            break;
+
+        case FastDataLogger::SourceDataU32:
+            decodeBuffer<quint32>(in, count, factor, out);
+            break;
+
+        case FastDataLogger::SourceDataI32:
+            decodeBuffer<qint32>(in, count, factor, out);
+            break;
+
+        case FastDataLogger::SourceDataFloat:
+            decodeFloatBuffer(in, count, factor, out);
+            break;
+    }
 }
 
 FastDataLogger::Status FastDataLogger::status() const
@@ -245,6 +313,101 @@ FastDataLogger::SourceDataType FastDataLogger::typeFromObjId(const NodeObjectId
     }
 }
 
+qreal FastDataLogger::factorFromObjId(const NodeObjectId &data_objId)
+{
+    NodeSubIndex *subIndex = nodeInterrest()->nodeOd()->subIndex(data_objId);
+    if (subIndex == nullptr)
+    {
+        return 1.0;
+    }
+
+    qreal factor = subIndex->scale();
+    if (subIndex->isQ1516())
+    {
+        factor /= 65536.0;
+    }
+    return factor;
+}
+
+quint8 FastDataLogger::channelConfigSubIndex(int channel)
+{
+    if (channel < 2)
+    {
+        return static_cast<quint8>(0x02 + channel);
+    }
+    return static_cast<quint8>(0x08 + channel - 2);
+}
+
+/**
+ * @brief creates log objects if they are not described in the eds. Data buffers are declared as DOMAIN
+ * to be read with SDO block upload.
+ */
+void FastDataLogger::createObjects()
+{
+    NodeOd *nodeOd = _node->nodeOd();
+    NodeIndex *logIndex = nodeOd->index(0x2100);
+    if (logIndex == nullptr)
+    {
+        logIndex = new NodeIndex(0x2100);
+        logIndex->setName("Logger_status");
+        logIndex->setObjectType(NodeIndex::RECORD);
+        nodeOd->addIndex(logIndex);
+    }
+
+    if (!logIndex->subIndexExist(0))
+    {
+        NodeSubIndex *subIndex = new NodeSubIndex(0);
+        subIndex->setDataType(NodeSubIndex::UNSIGNED8);
+        subIndex->setName("Highest sub-index supported");
+        subIndex->setAccessType(NodeSubIndex::READ);
+        logIndex->addSubIndex(subIndex);
+    }
+
+    if (!logIndex->subIndexExist(1))
+    {
+        NodeSubIndex *subIndex = new NodeSubIndex(1);
+        subIndex->setDataType(NodeSubIndex::INTEGER8);
+        subIndex->setName("Status");
+        subIndex->setAccessType(NodeSubIndex::READ);
+        logIndex->addSubIndex(subIndex);
+    }
+
+    for (int channel = 0; channel < FastDataLoggerConfig::ChannelMaxCount; channel++)
+    {
+        quint8 dataSubIndex = static_cast<quint8>(0x02 + channel);
+        if (!logIndex->subIndexExist(dataSubIndex))
+        {
+            NodeSubIndex *subIndex = new NodeSubIndex(dataSubIndex);
+            subIndex->setDataType(NodeSubIndex::DDOMAIN);
+            subIndex->setName(QString("Data_%1").arg(channel + 1));
+            subIndex->setAccessType(NodeSubIndex::READ);
+            logIndex->addSubIndex(subIndex);
+        }
+    }
+}
+
+/**
+ * @brief queues the upload of all channel buffers at once, the SDO client chains them without waiting
+ * for each notification
+ */
+void FastDataLogger::readChannels()
+{
+    _pendingChannels = 0;
+    for (int channel = 0; channel < _channels.count(); channel++)
+    {
+        if (_channels[channel].dataType != SourceDataInvalid)
+        {
+            readObject(0x2100, static_cast<quint8>(0x02 + channel));
+            _pendingChannels++;
+        }
+    }
+
+    if (_pendingChannels == 0)
+    {
+        emit dataAvailable();
+    }
+}
+
 void FastDataLogger::setStatus(Status status)
 {
     if (status != _status)
@@ -256,41 +419,57 @@ void FastDataLogger::setStatus(Status status)
 
 void FastDataLogger::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
 {
-    if ((flags & NodeOd::Error) != 0)
+    if (objId.index() != 0x2100)
     {
-        // TODO manage errors
         return;
     }
 
-    if (objId.index() == 0x2100)
+    if (objId.subIndex() == 0)  // channel count
     {
-        switch (objId.subIndex())
+        if (_commitPending)
+        {
+            // on error the firmware is assumed to expose the legacy two channels
+            _commitPending = false;
+            writeConfig();
+        }
+        return;
+    }
+
+    if (objId.subIndex() == 1)  // Status
+    {
+        if ((flags & NodeOd::Error) != 0)
+        {
+            // TODO manage errors
+            return;
+        }
+
+        setStatus(static_cast<Status>(_node->nodeOd()->value(objId).toInt()));
+        if (_status == StatusDataReady)
         {
-            case 1:  // Status
-                setStatus(static_cast<Status>(_node->nodeOd()->value(objId).toUInt()));
-
-                if (_status == StatusDataReady)
-                {
-                    readObject(0x2100, 0x02);  // read data 1
-                }
-                break;
-
-            case 2:  // Data 1
-                _valuesData1 = byteArrayToReals(_node->nodeOd()->value(objId).toByteArray(), _dataType1);
-                if (_dataType2 != SourceDataInvalid)
-                {
-                    readObject(0x2100, 0x03);  // read data 2
-                }
-                else
-                {
-                    emit dataAvailable();
-                }
-                break;
-
-            case 3:  // Data 2
-                _valuesData2 = byteArrayToReals(_node->nodeOd()->value(objId).toByteArray(), _dataType2);
-                emit dataAvailable();
-                break;
+            readChannels();
         }
+        return;
+    }
+
+    int channel = objId.subIndex() - 2;
+    if (channel < 0 || channel >= _channels.count() || _pendingChannels == 0)
+    {
+        return;
+    }
+
+    Channel &logChannel = _channels[channel];
+    if ((flags & NodeOd::Error) != 0)
+    {
+        logChannel.values.clear();
+    }
+    else
+    {
+        byteArrayToReals(_node->nodeOd()->value(objId).toByteArray(), logChannel.dataType, logChannel.factor, logChannel.values);
+    }
+
+    _pendingChannels--;
+    if (_pendingChannels == 0)
+    {
+        emit dataAvailable();
     }
 }
@@ -23,10 +23,19 @@
 
 #include "nodeodsubscriber.h"
 #include <QObject>
+#include <QVector>
 
 #include "fastdataloggerconfig.h"
 #include "node.h"
 
+/**
+ * Device side data logger of UniSwarm firmwares.
+ *
+ * 0x2100 : status (sub 1) and one DOMAIN data buffer per channel (sub 2 + channel),
+ *          sub 0 gives the highest sub-index supported, so the number of channels exposed by the firmware.
+ * 0x2101 : configuration, start (sub 1), channel 0 and 1 objects (sub 2, 3), frequency divider (sub 4),
+ *          trigger object, type and value (sub 5, 6, 7), channel 2 to n objects (sub 8 + channel - 2).
+ */
 class CANOPEN_EXPORT FastDataLogger : public QObject, public NodeOdSubscriber
 {
     Q_OBJECT
@@ -43,8 +52,10 @@ public:
 
     void commitConfig();
 
-    const QList<qreal> &valuesData1() const;
-    const QList<qreal> &valuesData2() const;
+    int firmwareChannelCount() const;
+    int channelCount() const;
+    const NodeObjectId &channelObjId(int channel) const;
+    const QVector<qreal> &values(int channel) const;
 
     static uint32_t objIdToU32(const NodeObjectId &objId);
     static NodeObjectId u32ToObjId(uint32_t u32);
@@ -60,7 +71,8 @@ public:
         SourceDataI32,
         SourceDataFloat,
     };
-    QList<qreal> byteArrayToReals(const QByteArray &byteArray, SourceDataType dataType);
+    static int sourceDataSize(SourceDataType dataType);
+    static void byteArrayToReals(const QByteArray &byteArray, SourceDataType dataType, qreal factor, QVector<qreal> &reals);
 
     enum Status
     {
@@ -83,11 +95,27 @@ private:
 
     FastDataLoggerConfig _config;
 
-    QList<qreal> _valuesData1;
-    SourceDataType _dataType1;
-    QList<qreal> _valuesData2;
-    SourceDataType _dataType2;
+    struct Channel
+    {
+        NodeObjectId objId;
+        SourceDataType dataType;
+        qreal factor;  // Q15.16 and scale of the logged object
+        QVector<qreal> values;
+    };
+    QVector<Channel> _channels;
+    int _pendingChannels;
+    bool _commitPending;
+    enum
+    {
+        LegacyChannelCount = 2
+    };
+    void writeConfig();
     SourceDataType typeFromObjId(const NodeObjectId &data_objId);
+    qreal factorFromObjId(const NodeObjectId &data_objId);
+    static quint8 channelConfigSubIndex(int channel);
+
+    void createObjects();
+    void readChannels();
 
     Status _status;
     void setStatus(Status status);
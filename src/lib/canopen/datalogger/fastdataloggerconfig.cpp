@@ -24,34 +24,42 @@ FastDataLoggerConfig::FastDataLoggerConfig()
     _triggerType = TriggerTypeSoftware;
 }
 
-NodeObjectId &FastDataLoggerConfig::data1_objId()
+int FastDataLoggerConfig::channelCount() const
 {
-    return _data1_objId;
+    return _channelObjIds.count();
 }
 
-const NodeObjectId &FastDataLoggerConfig::data1_objId() const
+const QList<NodeObjectId> &FastDataLoggerConfig::channelObjIds() const
 {
-    return _data1_objId;
+    return _channelObjIds;
 }
 
-void FastDataLoggerConfig::setData1_objId(const NodeObjectId &data1_objId)
+NodeObjectId FastDataLoggerConfig::channelObjId(int channel) const
 {
-    _data1_objId = data1_objId;
+    return _channelObjIds.value(channel);
 }
 
-NodeObjectId &FastDataLoggerConfig::data2_objId()
-{
-    return _data2_objId;
-}
-
-const NodeObjectId &FastDataLoggerConfig::data2_objId() const
-{
-    return _data2_objId;
-}
-
-void FastDataLoggerConfig::setData2_objId(const NodeObjectId &data2_objId)
-{
-    _data2_objId = data2_objId;
+/**
+ * @brief sets the object logged on channel, channels are created up to channel if needed
+ * @param channel channel number, starting from 0
+ * @param objId object to log
+ */
+void FastDataLoggerConfig::setChannelObjId(int channel, const NodeObjectId &objId)
+{
+    if (channel < 0 || channel >= ChannelMaxCount)
+    {
+        return;
+    }
+    while (_channelObjIds.count() <= channel)
+    {
+        _channelObjIds.append(NodeObjectId());
+    }
+    _channelObjIds[channel] = objId;
+}
+
+void FastDataLoggerConfig::clearChannels()
+{
+    _channelObjIds.clear();
 }
 
 uint16_t FastDataLoggerConfig::frequencyDivider() const
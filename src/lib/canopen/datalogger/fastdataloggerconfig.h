@@ -23,6 +23,7 @@
 
 #include "nodeobjectid.h"
 
+#include <QList>
 #include <QVariant>
 
 class CANOPEN_EXPORT FastDataLoggerConfig
@@ -30,13 +31,15 @@ class CANOPEN_EXPORT FastDataLoggerConfig
 public:
     FastDataLoggerConfig();
 
-    NodeObjectId &data1_objId();
-    const NodeObjectId &data1_objId() const;
-    void setData1_objId(const NodeObjectId &data1_objId);
-
-    NodeObjectId &data2_objId();
-    const NodeObjectId &data2_objId() const;
-    void setData2_objId(const NodeObjectId &data2_objId);
+    enum
+    {
+        ChannelMaxCount = 8
+    };
+    int channelCount() const;
+    const QList<NodeObjectId> &channelObjIds() const;
+    NodeObjectId channelObjId(int channel) const;
+    void setChannelObjId(int channel, const NodeObjectId &objId);
+    void clearChannels();
 
     uint16_t frequencyDivider() const;
     void setFrequencyDivider(uint16_t frequencyDivider);
@@ -59,8 +62,7 @@ public:
     void setTriggerValue(const QVariant &triggerValue);
 
 private:
-    NodeObjectId _data1_objId;
-    NodeObjectId _data2_objId;
+    QList<NodeObjectId> _channelObjIds;
     uint16_t _frequencyDivider;
     NodeObjectId _trigger_objId;
     TriggerType _triggerType;
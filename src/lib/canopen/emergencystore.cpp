@@ -0,0 +1,254 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "emergencystore.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <limits>
+
+EmergencyStore::EmergencyStore(QObject *parent)
+    : QObject(parent)
+{
+    _nodeCapacity = 256;
+    _eventsCount = 0;
+    clear();
+
+    _pendingNotifyCount = 0;
+    _notifyTimer = new QTimer(this);
+    _notifyTimer->setSingleShot(true);
+    _notifyTimer->setInterval(100);
+    connect(_notifyTimer, &QTimer::timeout, this, &EmergencyStore::notifyEvents);
+}
+
+int EmergencyStore::nodeCapacity() const
+{
+    return _nodeCapacity;
+}
+
+/**
+ * @brief sets the maximum count of events kept by node, clears the history
+ */
+void EmergencyStore::setNodeCapacity(int nodeCapacity)
+{
+    _nodeCapacity = qMax(nodeCapacity, 1);
+    for (NodeRing &ring : _rings)
+    {
+        ring.events.clear();
+        ring.events.squeeze();
+    }
+    clear();
+}
+
+int EmergencyStore::notifyPeriod() const
+{
+    return _notifyTimer->interval();
+}
+
+/**
+ * @brief sets the minimal period in ms between two eventsAdded signals
+ */
+void EmergencyStore::setNotifyPeriod(int notifyPeriod)
+{
+    _notifyTimer->setInterval(notifyPeriod);
+}
+
+void EmergencyStore::addEvent(const EmergencyEvent &event)
+{
+    NodeRing &ring = _rings[event.nodeId & 0x7F];
+    if (ring.events.size() != _nodeCapacity)
+    {
+        ring.events.resize(_nodeCapacity);
+    }
+
+    if (ring.count < _nodeCapacity)
+    {
+        ring.events[(ring.head + ring.count) % _nodeCapacity] = event;
+        ring.count++;
+    }
+    else
+    {
+        ring.events[ring.head] = event;
+        ring.head = (ring.head + 1) % _nodeCapacity;
+        ring.counters.overwrittenCount++;
+    }
+
+    ring.counters.count++;
+    ring.counters.lastErrorCode = event.errorCode;
+    ring.counters.lastErrorRegister = event.errorRegister;
+    ring.counters.lastTimeUs = event.timeUs;
+    _errorCodeCounts[event.errorCode]++;
+    _eventsCount++;
+
+    _pendingNotifyCount++;
+    if (!_notifyTimer->isActive())
+    {
+        _notifyTimer->start();
+    }
+}
+
+void EmergencyStore::clear()
+{
+    for (NodeRing &ring : _rings)
+    {
+        ring.head = 0;
+        ring.count = 0;
+        ring.counters = NodeCounters{0, 0, 0, 0, 0};
+    }
+    _errorCodeCounts.clear();
+    _eventsCount = 0;
+}
+
+EmergencyStore::NodeCounters EmergencyStore::nodeCounters(quint8 nodeId) const
+{
+    return _rings[nodeId & 0x7F].counters;
+}
+
+/**
+ * @brief total count of events received, including the ones overwritten in history
+ */
+quint64 EmergencyStore::eventsCount() const
+{
+    return _eventsCount;
+}
+
+quint64 EmergencyStore::errorCodeCount(quint16 errorCode) const
+{
+    return _errorCodeCounts.value(errorCode, 0);
+}
+
+QList<quint16> EmergencyStore::errorCodes() const
+{
+    QList<quint16> errorCodes = _errorCodeCounts.keys();
+    std::sort(errorCodes.begin(), errorCodes.end());
+    return errorCodes;
+}
+
+EmergencyStore::Query::Query()
+{
+    nodeId = 0;
+    errorCode = 0;
+    errorCodeMask = 0;
+    fromUs = 0;
+    toUs = std::numeric_limits<qint64>::max();
+    maxCount = -1;
+}
+
+/**
+ * @brief events matching query, sorted by time
+ */
+QList<EmergencyEvent> EmergencyStore::events(const Query &query) const
+{
+    QList<EmergencyEvent> events;
+    if (query.nodeId != 0)
+    {
+        appendRange(_rings[query.nodeId & 0x7F], query, events);
+    }
+    else
+    {
+        for (const NodeRing &ring : _rings)
+        {
+            appendRange(ring, query, events);
+        }
+        std::stable_sort(events.begin(), events.end(), [](const EmergencyEvent &a, const EmergencyEvent &b) {
+            return a.timeUs < b.timeUs;
+        });
+    }
+
+    if (query.maxCount >= 0 && events.size() > query.maxCount)
+    {
+        events.erase(events.begin(), events.end() - query.maxCount);
+    }
+    return events;
+}
+
+/**
+ * @brief appends events of ring in query time window, found by binary search as ring is in time order
+ */
+void EmergencyStore::appendRange(const NodeRing &ring, const Query &query, QList<EmergencyEvent> &events) const
+{
+    auto at = [&ring, this](int i) -> const EmergencyEvent & {
+        return ring.events[(ring.head + i) % _nodeCapacity];
+    };
+
+    int low = 0;
+    int high = ring.count;
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        if (at(middle).timeUs < query.fromUs)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    for (int i = low; i < ring.count; i++)
+    {
+        const EmergencyEvent &event = at(i);
+        if (event.timeUs > query.toUs)
+        {
+            break;
+        }
+        if ((event.errorCode & query.errorCodeMask) == (query.errorCode & query.errorCodeMask))
+        {
+            events.append(event);
+        }
+    }
+}
+
+/**
+ * @brief exports events matching query with their frame timestamp, one line by event
+ */
+bool EmergencyStore::exportCSV(const QString &fileName, const Query &query) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << "Time (s);Node;Error code;Error register;Manufacturer data;Description" << '\n';
+    for (const EmergencyEvent &event : events(query))
+    {
+        QByteArray manufacturerData(reinterpret_cast<const char *>(event.manufacturerData), 5);
+        stream << QString("%1.%2").arg(event.timeUs / 1000000).arg(event.timeUs % 1000000, 6, 10, QChar('0')) << ';';
+        stream << event.nodeId << ';';
+        stream << QString("0x%1").arg(event.errorCode, 4, 16, QChar('0')) << ';';
+        stream << QString("0x%1").arg(event.errorRegister, 2, 16, QChar('0')) << ';';
+        stream << manufacturerData.toHex(' ') << ';';
+        stream << Emergency::errorCodeStr(event.errorCode) << '\n';
+    }
+    return true;
+}
+
+void EmergencyStore::notifyEvents()
+{
+    int count = _pendingNotifyCount;
+    _pendingNotifyCount = 0;
+    if (count > 0)
+    {
+        emit eventsAdded(count);
+    }
+}
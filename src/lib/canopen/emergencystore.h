@@ -0,0 +1,103 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef EMERGENCYSTORE_H
+#define EMERGENCYSTORE_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include "services/emergency.h"
+
+#include <QHash>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @brief Bounded history of the emergency events of a bus
+ *
+ * Each node has a ring buffer of the last events, allocated once. Adding an event is O(1)
+ * and notifications are coalesced to at most one signal by notify period.
+ */
+class CANOPEN_EXPORT EmergencyStore : public QObject
+{
+    Q_OBJECT
+public:
+    EmergencyStore(QObject *parent = nullptr);
+
+    int nodeCapacity() const;
+    void setNodeCapacity(int nodeCapacity);
+    int notifyPeriod() const;
+    void setNotifyPeriod(int notifyPeriod);
+
+    void addEvent(const EmergencyEvent &event);
+    void clear();
+
+    struct NodeCounters
+    {
+        quint64 count;
+        quint64 overwrittenCount;
+        quint16 lastErrorCode;
+        quint8 lastErrorRegister;
+        qint64 lastTimeUs;
+    };
+    NodeCounters nodeCounters(quint8 nodeId) const;
+    quint64 eventsCount() const;
+    quint64 errorCodeCount(quint16 errorCode) const;
+    QList<quint16> errorCodes() const;
+
+    struct Query
+    {
+        Query();
+        quint8 nodeId;  // 0 for all nodes
+        quint16 errorCode;
+        quint16 errorCodeMask;  // 0 for all error codes, FF00h for a class
+        qint64 fromUs;
+        qint64 toUs;
+        int maxCount;  // only the most recent ones if not -1
+    };
+    QList<EmergencyEvent> events(const Query &query = Query()) const;
+    bool exportCSV(const QString &fileName, const Query &query = Query()) const;
+
+signals:
+    void eventsAdded(int count);
+
+protected slots:
+    void notifyEvents();
+
+private:
+    struct NodeRing
+    {
+        QVector<EmergencyEvent> events;
+        int head;  // index of the oldest event
+        int count;
+        NodeCounters counters;
+    };
+    NodeRing _rings[128];
+    QHash<quint16, quint64> _errorCodeCounts;
+    quint64 _eventsCount;
+    int _nodeCapacity;
+
+    int _pendingNotifyCount;
+    QTimer *_notifyTimer;
+
+    void appendRange(const NodeRing &ring, const Query &query, QList<EmergencyEvent> &events) const;
+};
+
+#endif  // EMERGENCYSTORE_H
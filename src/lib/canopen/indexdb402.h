@@ -283,8 +283,6 @@ public:
 
     static NodeObjectId getObjectId(OdObject object, uint axis = 0, uint opt2 = 0);
 
-private:
-    static NodeObjectId getObjectIdMs(OdObject object, uint axis = 0, uint opt2 = 0);
     // FUTURE
     //    static QVariant min(const NodeObjectId &nodeObjectId);
     //    static QVariant max(const NodeObjectId &nodeObjectId);
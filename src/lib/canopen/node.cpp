@@ -26,12 +26,15 @@
 #include "profile/p402/nodeprofile402.h"
 #include "services/services.h"
 
+#include <QTimer>
+
 Node::Node(quint8 nodeId, const QString &name, const QString &edsFileName)
     : _nodeId(nodeId)
 {
     _status = UNKNOWN;
     _bus = nullptr;
     _nodeOd = new NodeOd(this);
+    _requestDispatcher = nullptr;
 
     if (name.isEmpty())
     {
@@ -81,6 +84,7 @@ Node::Node(quint8 nodeId, const QString &name, const QString &edsFileName)
 
 Node::~Node()
 {
+    delete _requestDispatcher;
     qDeleteAll(_sdoClients);
     qDeleteAll(_tpdos);
     qDeleteAll(_rpdos);
@@ -211,13 +215,9 @@ void Node::readObject(quint16 index, quint8 subindex, QMetaType::Type dataType)
         return;
     }
 
-    TPDO *tpdoMapped = tpdoMappedObject(NodeObjectId(index, subindex, dataType));
-    if (tpdoMapped != nullptr)
+    if (isReadByPdo(NodeObjectId(index, subindex)))
     {
-        if (tpdoMapped->isEnabled() && _status == STARTED && _bus->sync()->status() == Sync::STARTED)
-        {
-            return;
-        }
+        return;
     }
 
     QMetaType::Type mdataType = dataType;
@@ -251,27 +251,102 @@ void Node::writeObject(quint16 index, quint8 subindex, const QVariant &data)
     }
 
     NodeObjectId object(busId(), nodeId(), index, subindex);
-    if ((rpdoMappedObject(NodeObjectId(index, subindex)) != nullptr) && _status == STARTED && _bus->sync()->status() == Sync::STARTED)
+    if (isWrittenByPdo(object))
     {
-        bool writtenInRpdo = false;
         for (RPDO *rpdo : qAsConst(_rpdos))
         {
             if (rpdo->isMappedObject(object) && rpdo->isEnabled())
             {
                 rpdo->write(object, data);
-                writtenInRpdo = true;
             }
         }
-
-        if (writtenInRpdo)
-        {
-            return;
-        }
+        return;
     }
 
     _sdoClients.at(0)->downloadData(index, subindex, mdata);
 }
 
+/**
+ * @brief removes the queued SDO upload of index/subindex, a read not started yet is abandoned
+ * for all the requesters of the object
+ * @return true if an upload was removed
+ */
+bool Node::cancelReadObject(quint16 index, quint8 subindex)
+{
+    return _sdoClients.at(0)->cancelRequest(index, subindex, true);
+}
+
+/**
+ * @brief removes the last queued SDO download of index/subindex not started yet
+ * @return true if a download was removed
+ */
+bool Node::cancelWriteObject(quint16 index, quint8 subindex)
+{
+    return _sdoClients.at(0)->cancelRequest(index, subindex, false);
+}
+
+/**
+ * @brief reads id asynchronously, the returned request is finished with the value read or an error
+ * @param id object to read, bus and node ids are ignored
+ * @param timeoutMs timeout including the time spent in SDO queue, no timeout if 0
+ */
+ObjectRequest *Node::readObjectAsync(const NodeObjectId &id, int timeoutMs)
+{
+    ObjectRequest *request = new ObjectRequest(ObjectRequest::Read, id, QVariant(), timeoutMs, this);
+    requestDispatcher()->submit(request);
+    return request;
+}
+
+/**
+ * @brief writes data to id asynchronously, the returned request is finished when the write is
+ * acknowledged or failed
+ * @param id object to write, bus and node ids are ignored
+ * @param timeoutMs timeout including the time spent in SDO queue, no timeout if 0
+ */
+ObjectRequest *Node::writeObjectAsync(const NodeObjectId &id, const QVariant &data, int timeoutMs)
+{
+    ObjectRequest *request = new ObjectRequest(ObjectRequest::Write, id, data, timeoutMs, this);
+    requestDispatcher()->submit(request);
+    return request;
+}
+
+/**
+ * @brief submits all accesses at once, in order. Requests are chained by the SDO client without
+ * round trip to the caller
+ * @param accesses list of reads and writes
+ * @param timeoutMs timeout of each request, no timeout if 0
+ */
+ObjectTransaction *Node::transaction(const QList<ObjectAccess> &accesses, int timeoutMs)
+{
+    ObjectTransaction *transaction = new ObjectTransaction(this);
+    if (accesses.isEmpty())
+    {
+        QTimer::singleShot(0, transaction, [transaction]() {
+            transaction->finish();
+        });
+        return transaction;
+    }
+
+    for (const ObjectAccess &access : accesses)
+    {
+        transaction->addRequest(new ObjectRequest(access.type, access.objectId, access.value, timeoutMs, transaction));
+    }
+    for (ObjectRequest *request : transaction->requests())
+    {
+        requestDispatcher()->submit(request);
+    }
+    return transaction;
+}
+
+ObjectRequestDispatcher *Node::requestDispatcher()
+{
+    if (_requestDispatcher == nullptr)
+    {
+        _requestDispatcher = new ObjectRequestDispatcher(this);
+    }
+    return _requestDispatcher;
+}
+
 void Node::loadEds(const QString &fileName)
 {
     _nodeOd->loadEds(fileName);
@@ -351,11 +426,56 @@ TPDO *Node::tpdoMappedObject(const NodeObjectId &object) const
     return nullptr;
 }
 
+/**
+ * @brief returns true if object is refreshed by an enabled TPDO on the running SYNC, readObject() then skips the SDO upload
+ */
+bool Node::isReadByPdo(const NodeObjectId &object) const
+{
+    if (_status != STARTED || _bus == nullptr || _bus->sync()->status() != Sync::STARTED)
+    {
+        return false;
+    }
+
+    for (TPDO *tpdo : _tpdos)
+    {
+        if (tpdo->isMappedObject(object) && tpdo->isEnabled())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief returns true if object is mapped in an enabled RPDO sent on the running SYNC, writeObject() then writes it in the RPDO
+ */
+bool Node::isWrittenByPdo(const NodeObjectId &object) const
+{
+    if (_status != STARTED || _bus == nullptr || _bus->sync()->status() != Sync::STARTED)
+    {
+        return false;
+    }
+
+    for (RPDO *rpdo : _rpdos)
+    {
+        if (rpdo->isMappedObject(object) && rpdo->isEnabled())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 Bootloader *Node::bootloader() const
 {
     return _bootloader;
 }
 
+ErrorControl *Node::errorControl() const
+{
+    return _errorControl;
+}
+
 QList<Service *> Node::services() const
 {
     return _services;
@@ -26,6 +26,7 @@
 #include <QMetaType>
 
 #include "nodeod.h"
+#include "objectrequest.h"
 
 class CanOpenBus;
 
@@ -73,6 +74,13 @@ public:
     void readObject(quint16 index, quint8 subindex, QMetaType::Type dataType = QMetaType::UnknownType);
     void writeObject(const NodeObjectId &id, const QVariant &data);
     void writeObject(quint16 index, quint8 subindex, const QVariant &data);
+    bool cancelReadObject(quint16 index, quint8 subindex);
+    bool cancelWriteObject(quint16 index, quint8 subindex);
+
+    // asynchronous od access
+    ObjectRequest *readObjectAsync(const NodeObjectId &id, int timeoutMs = ObjectRequest::DefaultTimeout);
+    ObjectRequest *writeObjectAsync(const NodeObjectId &id, const QVariant &data, int timeoutMs = ObjectRequest::DefaultTimeout);
+    ObjectTransaction *transaction(const QList<ObjectAccess> &accesses, int timeoutMs = ObjectRequest::DefaultTimeout);
 
     void loadEds(const QString &fileName);
     const QString &edsFileName() const;
@@ -88,8 +96,11 @@ public:
     bool isMappedObjectInPdo(const NodeObjectId &object) const;
     RPDO *rpdoMappedObject(const NodeObjectId &object) const;
     TPDO *tpdoMappedObject(const NodeObjectId &object) const;
+    bool isReadByPdo(const NodeObjectId &object) const;
+    bool isWrittenByPdo(const NodeObjectId &object) const;
 
     Bootloader *bootloader() const;
+    ErrorControl *errorControl() const;
 
     QList<Service *> services() const;
 
@@ -131,6 +142,9 @@ protected:
     QList<NodeProfile *> _nodeProfiles;
 
     NodeOd *_nodeOd;
+
+    ObjectRequestDispatcher *_requestDispatcher;
+    ObjectRequestDispatcher *requestDispatcher();
 };
 
 #endif  // NODE_H
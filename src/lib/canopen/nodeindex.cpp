@@ -183,8 +183,21 @@ NodeSubIndex *NodeIndex::subIndex(uint8_t subIndex) const
  */
 void NodeIndex::addSubIndex(NodeSubIndex *subIndex)
 {
+    // a replaced sub-index hands its subscribers over to the new one
+    NodeSubIndex *oldSubIndex = _nodeSubIndexes.value(subIndex->subIndex(), nullptr);
+    if (oldSubIndex != nullptr && oldSubIndex != subIndex)
+    {
+        subIndex->_subscribers.append(oldSubIndex->_subscribers);
+        oldSubIndex->_subscribers.clear();
+    }
+
     _nodeSubIndexes.insert(subIndex->subIndex(), subIndex);
     subIndex->_nodeIndex = this;
+    if (_nodeOd != nullptr)
+    {
+        _nodeOd->invalidateSlots();
+        _nodeOd->attachSubscribers(subIndex);
+    }
 }
 
 /**
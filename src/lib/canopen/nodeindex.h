@@ -26,6 +26,7 @@
 
 class Node;
 class NodeOd;
+class NodeOdSubscriber;
 
 class CANOPEN_EXPORT NodeIndex
 {
@@ -78,6 +79,8 @@ private:
     ObjectType _objectType;
 
     QMap<quint8, NodeSubIndex *> _nodeSubIndexes;
+
+    QList<NodeOdSubscriber *> _subscribers;  // subscribers to all sub-indexes
 };
 
 #endif  // NODEINDEX_H
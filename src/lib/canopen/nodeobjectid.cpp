@@ -29,6 +29,7 @@ NodeObjectId::NodeObjectId()
     , _index(0xFFFF)
     , _subIndex(0xFF)
     , _dataType(QMetaType::Type::UnknownType)
+    , _slotPosition(-1)
 {
 }
 
@@ -38,6 +39,7 @@ NodeObjectId::NodeObjectId(quint8 busId, quint8 nodeId, quint16 index, quint8 su
     , _index(index)
     , _subIndex(subIndex)
     , _dataType(dataType)
+    , _slotPosition(-1)
 {
 }
 
@@ -47,6 +49,7 @@ NodeObjectId::NodeObjectId(quint16 index, quint8 subIndex, QMetaType::Type dataT
     , _index(index)
     , _subIndex(subIndex)
     , _dataType(dataType)
+    , _slotPosition(-1)
 {
 }
 
@@ -57,6 +60,7 @@ NodeObjectId::NodeObjectId(const NodeObjectId &other)
     _index = other.index();
     _subIndex = other.subIndex();
     _dataType = other.dataType();
+    _slotPosition = other._slotPosition;
 }
 
 bool operator==(const NodeObjectId &a, const NodeObjectId &b)
@@ -162,7 +166,7 @@ NodeSubIndex *NodeObjectId::nodeSubIndex() const
     {
         return nullptr;
     }
-    return node->nodeOd()->subIndex(_index, _subIndex);
+    return node->nodeOd()->subIndex(*this);
 }
 
 QString NodeObjectId::mimeData() const
@@ -252,6 +256,7 @@ NodeObjectId &NodeObjectId::operator=(const NodeObjectId &other)
     _index = other.index();
     _subIndex = other.subIndex();
     _dataType = other.dataType();
+    _slotPosition = other._slotPosition;
     return *this;
 }
 
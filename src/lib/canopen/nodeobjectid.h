@@ -80,6 +80,10 @@ private:
     quint16 _index;
     quint8 _subIndex;
     QMetaType::Type _dataType;
+
+    // position hint in NodeOd flat sub-index table, validated on each use
+    friend class NodeOd;
+    mutable int _slotPosition;
 };
 
 bool CANOPEN_EXPORT operator==(const NodeObjectId &a, const NodeObjectId &b);
@@ -19,30 +19,57 @@
 #include "nodeod.h"
 
 #include "indexdb.h"
+#include "db/odindexdb.h"
 #include "model/deviceconfiguration.h"
 #include "node.h"
+#include "nodeoddcfwriter.h"
 #include "nodeodsubscriber.h"
 #include "parser/edsparser.h"
-#include "writer/dcfwriter.h"
 
 #include <QDebug>
 #include <QFile>
 #include <QFileInfo>
 
+#include <algorithm>
+
+int NodeOd::_coalesceInterval = 33;
+
 NodeOd::NodeOd(Node *node)
     : _node(node)
 {
+    _coalesceTimer = new QTimer(this);
+    _coalesceTimer->setSingleShot(true);
+    connect(_coalesceTimer, &QTimer::timeout, this, &NodeOd::flushCoalescedNotifications);
+
+    _slotsDirty = true;
+
     createMandatoryObjects();
 }
 
 NodeOd::~NodeOd()
 {
     // Remove reference of this instance to all subcriber
-    QMultiMap<quint32, Subscriber>::iterator itSub = _subscribers.begin();
-    while (itSub != _subscribers.end())
+    for (NodeOdSubscriber *subscriber : qAsConst(_fullOdSubscribers))
     {
-        itSub.value().object->_nodeInterrest = nullptr;
-        ++itSub;
+        subscriber->_nodeInterrest = nullptr;
+    }
+    for (NodeOdSubscriber *subscriber : qAsConst(_pendingSubscribers))
+    {
+        subscriber->_nodeInterrest = nullptr;
+    }
+    for (NodeIndex *nodeIndex : qAsConst(_nodeIndexes))
+    {
+        for (NodeOdSubscriber *subscriber : qAsConst(nodeIndex->_subscribers))
+        {
+            subscriber->_nodeInterrest = nullptr;
+        }
+        for (NodeSubIndex *nodeSubIndex : nodeIndex->subIndexes())
+        {
+            for (NodeOdSubscriber *subscriber : qAsConst(nodeSubIndex->_subscribers))
+            {
+                subscriber->_nodeInterrest = nullptr;
+            }
+        }
     }
 
     qDeleteAll(_nodeIndexes);
@@ -114,9 +141,10 @@ bool NodeOd::loadEds(const QString &fileName)
             nodeSubIndex->setHighLimit(odSubIndex->highLimit());
             nodeIndex->addSubIndex(nodeSubIndex);
 
-            nodeSubIndex->setQ1516(IndexDb::isQ1516(nodeSubIndex->objectId(), _node->profileNumber()));
-            nodeSubIndex->setScale(IndexDb::scale(nodeSubIndex->objectId(), _node->profileNumber()));
-            nodeSubIndex->setUnit(IndexDb::unit(nodeSubIndex->objectId(), _node->profileNumber()));
+            const ODIndexDb::Entry *metadata = ODIndexDb::entry(nodeIndex->index(), nodeSubIndex->subIndex(), _node->profileNumber());
+            nodeSubIndex->setQ1516((metadata != nullptr) && metadata->q1516);
+            nodeSubIndex->setScale((metadata != nullptr) ? metadata->scale : 1.0);
+            nodeSubIndex->setUnit(ODIndexDb::unitStr((metadata != nullptr) ? metadata->unit : ODIndexDb::UnitNone));
         }
     }
 
@@ -143,38 +171,8 @@ bool NodeOd::exportDcf(const QString &fileName) const
         mfileName.append(".dcf");
     }
 
-    DeviceConfiguration deviceConfiguration;
-    deviceConfiguration.setNodeId(QString::number(_node->nodeId()));
-    deviceConfiguration.setNodeName(_node->name());
-
-    for (NodeIndex *nodeIndex : _nodeIndexes)
-    {
-        Index *index = new Index(nodeIndex->index());
-        index->setName(nodeIndex->name());
-        index->setObjectType(static_cast<Index::Object>(nodeIndex->objectType()));
-        deviceConfiguration.addIndex(index);
-
-        for (NodeSubIndex *nodeSubIndex : nodeIndex->subIndexes())
-        {
-            SubIndex *subIndex = new SubIndex(nodeSubIndex->subIndex());
-            subIndex->setName(nodeSubIndex->name());
-            subIndex->setAccessType(static_cast<SubIndex::AccessType>(nodeSubIndex->accessType()));
-            subIndex->setDataType(static_cast<SubIndex::DataType>(nodeSubIndex->dataType()));
-            if (nodeSubIndex->error() != 0)
-            {
-                subIndex->setValue(QVariant());
-            }
-            else
-            {
-                subIndex->setValue(nodeSubIndex->value());
-            }
-            index->addSubIndex(subIndex);
-        }
-    }
-
-    DcfWriter dcfWriter;
-    dcfWriter.write(&deviceConfiguration, mfileName);
-    return true;
+    NodeOdDcfWriter dcfWriter;
+    return dcfWriter.write(this, mfileName);
 }
 
 bool NodeOd::exportConf(const QString &fileName) const
@@ -230,8 +228,16 @@ NodeIndex *NodeOd::index(quint16 index) const
  */
 void NodeOd::addIndex(NodeIndex *index)
 {
+    NodeIndex *oldIndex = _nodeIndexes.value(index->index());
+    if (oldIndex != nullptr && oldIndex != index)
+    {
+        detachSubscribers(oldIndex);
+    }
+
     _nodeIndexes.insert(index->index(), index);
     index->_nodeOd = this;
+    invalidateSlots();
+    attachSubscribers(index);
 }
 
 /**
@@ -255,46 +261,93 @@ bool NodeOd::indexExist(const quint16 index) const
 
 NodeSubIndex *NodeOd::subIndex(quint16 index, quint8 subIndex) const
 {
-    NodeIndex *nodeIndex = this->index(index);
-    if (nodeIndex == nullptr)
+    int position = slotPosition((static_cast<quint32>(index) << 8) | subIndex);
+    if (position < 0)
     {
         return nullptr;
     }
+    return _slotSubIndexes.at(position);
+}
 
-    NodeSubIndex *nodeSubIndex = nodeIndex->subIndex(subIndex);
-    if (nodeSubIndex == nullptr)
+/**
+ * @brief returns the sub-index designated by id, the position found in the flat table is kept in
+ * id to skip the search on next calls with the same id
+ */
+NodeSubIndex *NodeOd::subIndex(const NodeObjectId &id) const
+{
+    quint32 key = (static_cast<quint32>(id.index()) << 8) | id.subIndex();
+    updateSlots();
+
+    int position = id._slotPosition;
+    if (position < 0 || position >= _slotKeys.size() || _slotKeys.at(position) != key)
     {
-        return nullptr;
+        position = slotPosition(key);
+        if (position < 0)
+        {
+            return nullptr;
+        }
+        id._slotPosition = position;
     }
+    return _slotSubIndexes.at(position);
+}
 
-    return nodeSubIndex;
+bool NodeOd::subIndexExist(quint16 index, quint8 subIndex) const
+{
+    return slotPosition((static_cast<quint32>(index) << 8) | subIndex) >= 0;
 }
 
-NodeSubIndex *NodeOd::subIndex(const NodeObjectId &id) const
+int NodeOd::subIndexCount() const
 {
-    return subIndex(id.index(), id.subIndex());
+    updateSlots();
+    return _slotKeys.size();
 }
 
-bool NodeOd::subIndexExist(quint16 index, quint8 subIndex) const
+void NodeOd::invalidateSlots()
 {
-    NodeIndex *nodeIndex = this->index(index);
-    if (nodeIndex == nullptr)
+    _slotsDirty = true;
+}
+
+/**
+ * @brief rebuilds the flat sub-index table from indexes map if od changed since last build.
+ * Indexes and sub-indexes maps are already sorted, so keys are appended in order.
+ */
+void NodeOd::updateSlots() const
+{
+    if (!_slotsDirty)
     {
-        return false;
+        return;
     }
 
-    NodeSubIndex *nodeSubIndex = nodeIndex->subIndex(subIndex);
-    return (nodeSubIndex != nullptr);
+    _slotKeys.clear();
+    _slotSubIndexes.clear();
+    for (NodeIndex *nodeIndex : _nodeIndexes)
+    {
+        const QMap<quint8, NodeSubIndex *> &nodeSubIndexes = nodeIndex->subIndexes();
+        for (QMap<quint8, NodeSubIndex *>::const_iterator it = nodeSubIndexes.cbegin(); it != nodeSubIndexes.cend(); ++it)
+        {
+            _slotKeys.append((static_cast<quint32>(nodeIndex->index()) << 8) | it.key());
+            _slotSubIndexes.append(it.value());
+        }
+    }
+    _slotKeys.squeeze();
+    _slotSubIndexes.squeeze();
+    _slotsDirty = false;
 }
 
-int NodeOd::subIndexCount() const
+/**
+ * @brief binary search of key in flat sub-index table
+ * @return position of key in table, -1 if not present
+ */
+int NodeOd::slotPosition(quint32 key) const
 {
-    int count = 0;
-    for (NodeIndex *index : _nodeIndexes)
+    updateSlots();
+
+    QVector<quint32>::const_iterator it = std::lower_bound(_slotKeys.cbegin(), _slotKeys.cend(), key);
+    if (it == _slotKeys.cend() || *it != key)
     {
-        count += index->subIndexesCount();
+        return -1;
     }
-    return count;
+    return static_cast<int>(it - _slotKeys.cbegin());
 }
 
 void NodeOd::setErrorObject(quint16 index, quint8 subIndex, quint32 error) const
@@ -310,7 +363,13 @@ void NodeOd::setErrorObject(quint16 index, quint8 subIndex, quint32 error) const
 
 quint32 NodeOd::errorObject(const NodeObjectId &id) const
 {
-    return errorObject(id.index(), id.subIndex());
+    NodeSubIndex *nodeSubIndex = subIndex(id);
+    if (nodeSubIndex == nullptr)
+    {
+        return 0;
+    }
+
+    return nodeSubIndex->error();
 }
 
 quint32 NodeOd::errorObject(quint16 index, quint8 subIndex) const
@@ -326,7 +385,13 @@ quint32 NodeOd::errorObject(quint16 index, quint8 subIndex) const
 
 QVariant NodeOd::value(const NodeObjectId &id) const
 {
-    return value(id.index(), id.subIndex());
+    NodeSubIndex *nodeSubIndex = subIndex(id);
+    if (nodeSubIndex == nullptr)
+    {
+        return QVariant();
+    }
+
+    return nodeSubIndex->value();
 }
 
 QVariant NodeOd::value(quint16 index, quint8 subIndex) const
@@ -421,7 +486,13 @@ QMetaType::Type NodeOd::dataTypeCiaToQt(NodeSubIndex::DataType type)
 
 QMetaType::Type NodeOd::dataType(const NodeObjectId &id) const
 {
-    return dataType(id.index(), id.subIndex());
+    NodeSubIndex *nodeSubIndex = subIndex(id);
+    if (nodeSubIndex == nullptr)
+    {
+        return QMetaType::UnknownType;
+    }
+
+    return dataTypeCiaToQt(nodeSubIndex->dataType());
 }
 
 QMetaType::Type NodeOd::dataType(quint16 index, quint8 subIndex) const
@@ -437,7 +508,13 @@ QMetaType::Type NodeOd::dataType(quint16 index, quint8 subIndex) const
 
 QDateTime NodeOd::lastModification(const NodeObjectId &id) const
 {
-    return lastModification(id.index(), id.subIndex());
+    NodeSubIndex *nodeSubIndex = subIndex(id);
+    if (nodeSubIndex == nullptr)
+    {
+        return QDateTime();
+    }
+
+    return nodeSubIndex->lastModification();
 }
 
 QDateTime NodeOd::lastModification(quint16 index, quint8 subIndex) const
@@ -453,72 +530,145 @@ QDateTime NodeOd::lastModification(quint16 index, quint8 subIndex) const
 
 void NodeOd::subscribe(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex)
 {
-    Subscriber subscriber;
-    subscriber.object = object;
-    subscriber.notifyIndex = notifyIndex;
-    subscriber.notifySubIndex = notifySubIndex;
+    _subscriberKeys[object].insert((static_cast<quint32>(notifyIndex) << 8) + notifySubIndex);
+
+    if (notifyIndex == 0xFFFFU && notifySubIndex == 0xFFU)
+    {
+        _fullOdSubscribers.append(object);
+        return;
+    }
+
+    NodeIndex *nodeIndex = _nodeIndexes.value(notifyIndex);
+    if (nodeIndex != nullptr)
+    {
+        if (notifySubIndex == 0xFFU)
+        {
+            nodeIndex->_subscribers.append(object);
+            return;
+        }
+        NodeSubIndex *nodeSubIndex = nodeIndex->subIndex(notifySubIndex);
+        if (nodeSubIndex != nullptr)
+        {
+            nodeSubIndex->_subscribers.append(object);
+            return;
+        }
+    }
+
+    // object not present in od, attached when created
     quint32 key = (static_cast<quint32>(notifyIndex) << 8) + notifySubIndex;
-    _subscribers.insert(key, subscriber);
+    _pendingSubscribers.insert(key, object);
 }
 
 void NodeOd::unsubscribe(NodeOdSubscriber *object)
 {
-    QMultiMap<quint32, Subscriber>::iterator itSub = _subscribers.begin();
-    while (itSub != _subscribers.end())
+    // only the objects subscribed by object are visited, not the whole od
+    const QSet<quint32> keys = _subscriberKeys.take(object);
+    for (quint32 key : keys)
     {
-        if (itSub.value().object == object)
-        {
-            itSub = _subscribers.erase(itSub);
-        }
-        else
+        removeSubscriber(object, static_cast<quint16>(key >> 8), static_cast<quint8>(key & 0xFFU));
+    }
+
+    _coalescedNotifications.remove(object);
+}
+
+void NodeOd::unsubscribe(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex)
+{
+    removeCoalescedNotifications(object, notifyIndex, notifySubIndex);
+
+    QHash<NodeOdSubscriber *, QSet<quint32>>::iterator itKeys = _subscriberKeys.find(object);
+    if (itKeys != _subscriberKeys.end())
+    {
+        itKeys.value().remove((static_cast<quint32>(notifyIndex) << 8) + notifySubIndex);
+        if (itKeys.value().isEmpty())
         {
-            ++itSub;
+            _subscriberKeys.erase(itKeys);
         }
     }
+
+    removeSubscriber(object, notifyIndex, notifySubIndex);
 }
 
-void NodeOd::unsubscribe(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex)
+void NodeOd::removeSubscriber(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex)
 {
-    QMultiMap<quint32, Subscriber>::iterator itSub = _subscribers.begin();
-    while (itSub != _subscribers.end())
+    if (notifyIndex == 0xFFFFU && notifySubIndex == 0xFFU)
     {
-        if ((*itSub).object == object && (*itSub).notifyIndex == notifyIndex && (*itSub).notifySubIndex == notifySubIndex)
+        _fullOdSubscribers.removeAll(object);
+        return;
+    }
+
+    NodeIndex *nodeIndex = _nodeIndexes.value(notifyIndex);
+    if (nodeIndex != nullptr)
+    {
+        if (notifySubIndex == 0xFFU)
         {
-            itSub = _subscribers.erase(itSub);
+            nodeIndex->_subscribers.removeAll(object);
+            return;
         }
-        else
+        NodeSubIndex *nodeSubIndex = nodeIndex->subIndex(notifySubIndex);
+        if (nodeSubIndex != nullptr)
         {
-            ++itSub;
+            nodeSubIndex->_subscribers.removeAll(object);
+            return;
         }
     }
+
+    quint32 key = (static_cast<quint32>(notifyIndex) << 8) + notifySubIndex;
+    _pendingSubscribers.remove(key, object);
 }
 
 void NodeOd::updateObjectFromDevice(quint16 indexDevice, quint8 subindexDevice, const QVariant &value, NodeOd::FlagsRequest flags, const QDateTime &modificationDate)
 {
-    if (indexExist(indexDevice))
+    NodeSubIndex *nodeSubIndex = subIndex(indexDevice, subindexDevice);
+    NodeIndex *nodeIndex = (nodeSubIndex != nullptr) ? nodeSubIndex->nodeIndex() : _nodeIndexes.value(indexDevice);
+    if (nodeSubIndex != nullptr)
     {
-        if (index(indexDevice)->subIndexExist(subindexDevice))
+        if ((flags & NodeOd::Error) == 0)
         {
-            if ((flags & NodeOd::Error) == 0)
-            {
-                index(indexDevice)->subIndex(subindexDevice)->clearError();
-                index(indexDevice)->subIndex(subindexDevice)->setValue(value, modificationDate);
-            }
-            else
-            {
-                index(indexDevice)->subIndex(subindexDevice)->setError(static_cast<quint32>(value.toUInt()));
-            }
+            nodeSubIndex->clearError();
+            nodeSubIndex->setValue(value, modificationDate);
+        }
+        else
+        {
+            nodeSubIndex->setError(static_cast<quint32>(value.toUInt()));
         }
     }
 
-    quint32 key = (static_cast<quint32>(indexDevice) << 8) + subindexDevice;
-    notifySubscribers(key, indexDevice, subindexDevice, flags);  // notify subscribers to index/subindex
+    NodeObjectId objId(_node->busId(), _node->nodeId(), indexDevice, subindexDevice);
+    if (nodeSubIndex != nullptr)
+    {
+        notifySubscribers(nodeSubIndex->_subscribers, objId, flags);  // notify subscribers to index/subindex
+    }
+    else if (!_pendingSubscribers.isEmpty())
+    {
+        quint32 key = (static_cast<quint32>(indexDevice) << 8) + subindexDevice;
+        notifySubscribers(_pendingSubscribers.values(key), objId, flags);
+    }
 
-    key = (static_cast<quint32>(indexDevice) << 8) + 0xFFU;
-    notifySubscribers(key, indexDevice, subindexDevice, flags);  // notify subscribers to index with all subindex
+    if (nodeIndex != nullptr)
+    {
+        notifySubscribers(nodeIndex->_subscribers, objId, flags);  // notify subscribers to index with all subindex
+    }
+    else if (!_pendingSubscribers.isEmpty())
+    {
+        quint32 key = (static_cast<quint32>(indexDevice) << 8) + 0xFFU;
+        notifySubscribers(_pendingSubscribers.values(key), objId, flags);
+    }
 
-    key = (static_cast<quint32>(0xFFFFU) << 8) + 0xFFU;
-    notifySubscribers(key, indexDevice, subindexDevice, flags);  // notify subscribers to the full od
+    notifySubscribers(_fullOdSubscribers, objId, flags);  // notify subscribers to the full od
+}
+
+int NodeOd::coalesceInterval()
+{
+    return _coalesceInterval;
+}
+
+/**
+ * @brief sets the period of coalesced notifications delivery, shared by all od
+ * @param ms period in ms, 33 ms (30 Hz) by default
+ */
+void NodeOd::setCoalesceInterval(int ms)
+{
+    _coalesceInterval = qMax(ms, 1);
 }
 
 void NodeOd::store(uint8_t subIndex, uint32_t signature)
@@ -718,15 +868,148 @@ const QMap<QString, QString> &NodeOd::edsFileInfos() const
     return _edsFileInfos;
 }
 
-void NodeOd::notifySubscribers(quint32 key, quint16 notifyIndex, quint8 notifySubIndex, NodeOd::FlagsRequest flags)
+void NodeOd::attachSubscribers(NodeIndex *nodeIndex)
+{
+    if (_pendingSubscribers.isEmpty())
+    {
+        return;
+    }
+
+    quint32 key = (static_cast<quint32>(nodeIndex->index()) << 8) + 0xFFU;
+    QMultiMap<quint32, NodeOdSubscriber *>::iterator itSub = _pendingSubscribers.find(key);
+    while (itSub != _pendingSubscribers.end() && itSub.key() == key)
+    {
+        nodeIndex->_subscribers.append(itSub.value());
+        itSub = _pendingSubscribers.erase(itSub);
+    }
+
+    for (NodeSubIndex *nodeSubIndex : nodeIndex->subIndexes())
+    {
+        attachSubscribers(nodeSubIndex);
+    }
+}
+
+void NodeOd::attachSubscribers(NodeSubIndex *nodeSubIndex)
+{
+    if (_pendingSubscribers.isEmpty())
+    {
+        return;
+    }
+
+    quint32 key = (static_cast<quint32>(nodeSubIndex->index()) << 8) + nodeSubIndex->subIndex();
+    QMultiMap<quint32, NodeOdSubscriber *>::iterator itSub = _pendingSubscribers.find(key);
+    while (itSub != _pendingSubscribers.end() && itSub.key() == key)
+    {
+        nodeSubIndex->_subscribers.append(itSub.value());
+        itSub = _pendingSubscribers.erase(itSub);
+    }
+}
+
+void NodeOd::detachSubscribers(NodeIndex *nodeIndex)
 {
-    QList<Subscriber> interrestedSubscribers = _subscribers.values(key);
-    QList<Subscriber>::const_iterator subscriber = interrestedSubscribers.cbegin();
-    while (subscriber != interrestedSubscribers.cend())
+    quint32 key = (static_cast<quint32>(nodeIndex->index()) << 8) + 0xFFU;
+    for (NodeOdSubscriber *subscriber : qAsConst(nodeIndex->_subscribers))
+    {
+        _pendingSubscribers.insert(key, subscriber);
+    }
+    nodeIndex->_subscribers.clear();
+
+    for (NodeSubIndex *nodeSubIndex : nodeIndex->subIndexes())
     {
-        NodeOdSubscriber *nodeOdSubscriber = (*subscriber).object;
-        NodeObjectId objId(_node->busId(), _node->nodeId(), notifyIndex, notifySubIndex);
-        nodeOdSubscriber->notifySubscriber(objId, flags);
-        ++subscriber;
+        key = (static_cast<quint32>(nodeIndex->index()) << 8) + nodeSubIndex->subIndex();
+        for (NodeOdSubscriber *subscriber : qAsConst(nodeSubIndex->_subscribers))
+        {
+            _pendingSubscribers.insert(key, subscriber);
+        }
+        nodeSubIndex->_subscribers.clear();
+    }
+}
+
+void NodeOd::notifySubscribers(const QList<NodeOdSubscriber *> &subscribers, const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+{
+    if (subscribers.isEmpty())
+    {
+        return;
+    }
+
+    // shallow copy, a subscriber can unregister itself during notification
+    const QList<NodeOdSubscriber *> interrestedSubscribers = subscribers;
+    for (NodeOdSubscriber *nodeOdSubscriber : interrestedSubscribers)
+    {
+        if (nodeOdSubscriber->_coalescedNotify)
+        {
+            // flags of pending notifications are accumulated, a later value update does not hide an error
+            quint32 key = (static_cast<quint32>(objId.index()) << 8) + objId.subIndex();
+            NodeOd::FlagsRequest &pendingFlags = _coalescedNotifications[nodeOdSubscriber][key];
+            pendingFlags = static_cast<NodeOd::FlagsRequest>(pendingFlags | flags);
+            if (!_coalesceTimer->isActive())
+            {
+                _coalesceTimer->start(_coalesceInterval);
+            }
+        }
+        else
+        {
+            nodeOdSubscriber->notifySubscriber(objId, flags);
+        }
+    }
+}
+
+void NodeOd::removeCoalescedNotifications(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex)
+{
+    QHash<NodeOdSubscriber *, QMap<quint32, NodeOd::FlagsRequest>>::iterator itCoalesced = _coalescedNotifications.find(object);
+    if (itCoalesced == _coalescedNotifications.end())
+    {
+        return;
+    }
+
+    QMap<quint32, NodeOd::FlagsRequest> &notifications = itCoalesced.value();
+    QMap<quint32, NodeOd::FlagsRequest>::iterator itNotification = notifications.begin();
+    while (itNotification != notifications.end())
+    {
+        quint16 index = static_cast<quint16>(itNotification.key() >> 8);
+        quint8 subIndex = static_cast<quint8>(itNotification.key() & 0xFFU);
+        bool match = (notifyIndex == 0xFFFFU || notifyIndex == index) && (notifySubIndex == 0xFFU || notifySubIndex == subIndex);
+        if (match)
+        {
+            itNotification = notifications.erase(itNotification);
+        }
+        else
+        {
+            ++itNotification;
+        }
+    }
+
+    if (notifications.isEmpty())
+    {
+        _coalescedNotifications.erase(itCoalesced);
+    }
+}
+
+void NodeOd::flushCoalescedNotifications()
+{
+    // a subscriber can be destroyed by the notification of another one, pointers are only used as keys
+    const QList<NodeOdSubscriber *> subscribers = _coalescedNotifications.keys();
+    for (NodeOdSubscriber *subscriber : subscribers)
+    {
+        QHash<NodeOdSubscriber *, QMap<quint32, NodeOd::FlagsRequest>>::iterator itCoalesced = _coalescedNotifications.find(subscriber);
+        if (itCoalesced == _coalescedNotifications.end())
+        {
+            continue;
+        }
+        const QMap<quint32, NodeOd::FlagsRequest> notifications = itCoalesced.value();
+        _coalescedNotifications.erase(itCoalesced);
+
+        QList<ObjectNotification> changedSet;
+        changedSet.reserve(notifications.count());
+        QMap<quint32, NodeOd::FlagsRequest>::const_iterator itNotification = notifications.cbegin();
+        while (itNotification != notifications.cend())
+        {
+            ObjectNotification notification;
+            notification.objId = NodeObjectId(_node->busId(), _node->nodeId(), static_cast<quint16>(itNotification.key() >> 8), static_cast<quint8>(itNotification.key() & 0xFFU));
+            notification.flags = itNotification.value();
+            changedSet.append(notification);
+            ++itNotification;
+        }
+        subscriber->odNotifyChangedSet(changedSet);
     }
 }
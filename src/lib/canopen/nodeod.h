@@ -23,8 +23,12 @@
 
 #include <QObject>
 
+#include <QHash>
 #include <QMap>
 #include <QMultiMap>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
 
 #include "nodeindex.h"
 #include "nodeobjectid.h"
@@ -97,6 +101,15 @@ public:
     void unsubscribe(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex);
     void updateObjectFromDevice(quint16 index, quint8 subindex, const QVariant &value, NodeOd::FlagsRequest flags, const QDateTime &modificationDate = QDateTime());
 
+    // coalesced notifications, delivered at most once per object and per tick
+    struct ObjectNotification
+    {
+        NodeObjectId objId;
+        NodeOd::FlagsRequest flags;
+    };
+    static int coalesceInterval();
+    static void setCoalesceInterval(int ms);
+
     // store / restore
     void store(uint8_t subIndex, uint32_t signature);
     void restore(uint8_t subIndex, uint32_t signature);
@@ -111,14 +124,32 @@ private:
     QString _edsFileName;
     QMap<QString, QString> _edsFileInfos;
 
-    struct Subscriber
-    {
-        NodeOdSubscriber *object;
-        quint16 notifyIndex;
-        quint8 notifySubIndex;
-    };
-    QMultiMap<quint32, Subscriber> _subscribers;
-    void notifySubscribers(quint32 key, quint16 notifyIndex, quint8 notifySubIndex, NodeOd::FlagsRequest flags);
+    // flat sorted sub-index table, keys are (index << 8 | subIndex), rebuilt lazily after od changes
+    mutable QVector<quint32> _slotKeys;
+    mutable QVector<NodeSubIndex *> _slotSubIndexes;
+    mutable bool _slotsDirty;
+    void invalidateSlots();
+    void updateSlots() const;
+    int slotPosition(quint32 key) const;
+
+    // subscribers to objects are stored on NodeIndex and NodeSubIndex, only full od subscribers and
+    // subscribers to objects not (yet) present in od are stored here
+    friend class NodeIndex;
+    QList<NodeOdSubscriber *> _fullOdSubscribers;
+    QMultiMap<quint32, NodeOdSubscriber *> _pendingSubscribers;
+    // reverse index of subscribed keys (index << 8 | subIndex, 0xFF for all sub-indexes) by subscriber
+    QHash<NodeOdSubscriber *, QSet<quint32>> _subscriberKeys;
+    void removeSubscriber(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex);
+    void attachSubscribers(NodeIndex *nodeIndex);
+    void attachSubscribers(NodeSubIndex *nodeSubIndex);
+    void detachSubscribers(NodeIndex *nodeIndex);
+    void notifySubscribers(const QList<NodeOdSubscriber *> &subscribers, const NodeObjectId &objId, NodeOd::FlagsRequest flags);
+
+    QHash<NodeOdSubscriber *, QMap<quint32, NodeOd::FlagsRequest>> _coalescedNotifications;
+    QTimer *_coalesceTimer;
+    static int _coalesceInterval;
+    void removeCoalescedNotifications(NodeOdSubscriber *object, quint16 notifyIndex, quint8 notifySubIndex);
+    void flushCoalescedNotifications();
 };
 
 #endif  // NODEOD_H
@@ -0,0 +1,172 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "nodeoddcfwriter.h"
+
+#include "node.h"
+#include "nodeod.h"
+#include "writer/deviceiniwriter.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QPair>
+
+NodeOdDcfWriter::NodeOdDcfWriter()
+{
+}
+
+/**
+ * @brief writes current values of nodeOd as a dcf file, values in error are omitted
+ */
+bool NodeOdDcfWriter::write(const NodeOd *nodeOd, const QString &filePath) const
+{
+    QFile dcfFile(filePath);
+    if (!dcfFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QTextStream out(&dcfFile);
+
+    out << "[FileInfo]\r\n";
+    out << "FileName=" << QFileInfo(filePath).fileName() << "\r\n";
+    out << "ModificationDate=" << QDateTime::currentDateTime().toString("MM-dd-yyyy") << "\r\n";
+    out << "ModificationTime=" << QDateTime::currentDateTime().toString("hh:mmAP") << "\r\n";
+    out << "\r\n";
+
+    out << "[DeviceComissioning]\r\n";
+    out << "NodeID=" << nodeOd->node()->nodeId() << "\r\n";
+    out << "NodeName=" << nodeOd->node()->name() << "\r\n";
+    out << "\r\n";
+
+    out << "[DummyUsage]\r\n";
+    out << "\r\n";
+
+    writeObjects(out, nodeOd);
+    return true;
+}
+
+void NodeOdDcfWriter::writeObjects(QTextStream &out, const NodeOd *nodeOd) const
+{
+    QList<NodeIndex *> mandatories;
+    QList<NodeIndex *> optionals;
+    QList<NodeIndex *> manufacturers;
+
+    // od map is already sorted by index
+    for (NodeIndex *index : nodeOd->indexes())
+    {
+        quint16 numIndex = index->index();
+        if (numIndex == 0x1000 || numIndex == 0x1001 || numIndex == 0x1018)
+        {
+            mandatories.append(index);
+        }
+        else if (numIndex >= 0x2000 && numIndex < 0x6000)
+        {
+            manufacturers.append(index);
+        }
+        else
+        {
+            optionals.append(index);
+        }
+    }
+
+    const QList<QPair<const char *, const QList<NodeIndex *> *>> sections = {
+        {"[MandatoryObjects]", &mandatories},
+        {"[OptionalObjects]", &optionals},
+        {"[ManufacturerObjects]", &manufacturers},
+    };
+    for (const auto &section : sections)
+    {
+        out << section.first << "\r\n";
+        writeSupportedIndexes(out, *section.second);
+        out << "\r\n";
+        for (NodeIndex *index : *section.second)
+        {
+            switch (index->objectType())
+            {
+                case NodeIndex::VAR:
+                    writeIndex(out, index);
+                    break;
+
+                case NodeIndex::RECORD:
+                case NodeIndex::ARRAY:
+                    writeRecord(out, index);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void NodeOdDcfWriter::writeSupportedIndexes(QTextStream &out, const QList<NodeIndex *> &indexes) const
+{
+    out << "SupportedObjects=" << indexes.count() << "\r\n";
+
+    int i = 1;
+    for (NodeIndex *index : indexes)
+    {
+        out << i << "=" << DeviceIniWriter::valueToString(index->index(), 16) << "\r\n";
+        i++;
+    }
+}
+
+void NodeOdDcfWriter::writeIndex(QTextStream &out, NodeIndex *index) const
+{
+    NodeSubIndex *subIndex = index->subIndex(0);
+    if (subIndex == nullptr)
+    {
+        return;
+    }
+
+    out << "[" << QString::number(index->index(), 16).toUpper() << "]\r\n";
+    out << "ParameterName=" << index->name() << "\r\n";
+    out << "ObjectType=" << DeviceIniWriter::valueToString(index->objectType(), 16, 1) << "\r\n";
+    writeSubIndex(out, subIndex);
+}
+
+void NodeOdDcfWriter::writeRecord(QTextStream &out, NodeIndex *index) const
+{
+    out << "[" << QString::number(index->index(), 16).toUpper() << "]\r\n";
+    out << "ParameterName=" << index->name() << "\r\n";
+    out << "ObjectType=" << DeviceIniWriter::valueToString(index->objectType(), 16) << "\r\n";
+    out << "SubNumber=" << DeviceIniWriter::valueToString(index->subIndexesCount()) << "\r\n";
+    out << "\r\n";
+
+    for (NodeSubIndex *subIndex : index->subIndexes())
+    {
+        out << "[" << QString::number(index->index(), 16).toUpper() << "sub" << QString::number(subIndex->subIndex(), 16).toUpper() << "]\r\n";
+        out << "ParameterName=" << subIndex->name() << "\r\n";
+        out << "ObjectType=" << DeviceIniWriter::valueToString(NodeIndex::VAR, 16, 1) << "\r\n";
+        writeSubIndex(out, subIndex);
+    }
+}
+
+void NodeOdDcfWriter::writeSubIndex(QTextStream &out, const NodeSubIndex *subIndex) const
+{
+    out << "DataType=" << DeviceIniWriter::valueToString(subIndex->dataType(), 16, 4) << "\r\n";
+    out << "AccessType=" << DeviceIniWriter::accessToString(subIndex->accessType()) << "\r\n";
+    if (subIndex->error() == 0 && subIndex->value().isValid())
+    {
+        out << "DefaultValue=" << DeviceIniWriter::dataToString(subIndex->value()) << "\r\n";
+    }
+    out << "PDOMapping=" << DeviceIniWriter::pdoToString(subIndex->accessType()) << "\r\n";
+    out << "\r\n";
+}
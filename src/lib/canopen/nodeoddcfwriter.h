@@ -0,0 +1,51 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NODEODDCFWRITER_H
+#define NODEODDCFWRITER_H
+
+#include "canopen_global.h"
+
+#include <QTextStream>
+
+class NodeOd;
+class NodeIndex;
+class NodeSubIndex;
+
+/**
+ * @brief Writes a DCF file directly from the live object dictionary of a node
+ *
+ * Produces the same layout as DcfWriter without building a DeviceConfiguration copy of the od,
+ * values are formatted by the DeviceIniWriter helpers.
+ */
+class CANOPEN_EXPORT NodeOdDcfWriter
+{
+public:
+    NodeOdDcfWriter();
+
+    bool write(const NodeOd *nodeOd, const QString &filePath) const;
+
+private:
+    void writeObjects(QTextStream &out, const NodeOd *nodeOd) const;
+    void writeSupportedIndexes(QTextStream &out, const QList<NodeIndex *> &indexes) const;
+    void writeIndex(QTextStream &out, NodeIndex *index) const;
+    void writeRecord(QTextStream &out, NodeIndex *index) const;
+    void writeSubIndex(QTextStream &out, const NodeSubIndex *subIndex) const;
+};
+
+#endif  // NODEODDCFWRITER_H
@@ -26,6 +26,7 @@
 NodeOdSubscriber::NodeOdSubscriber()
 {
     _nodeInterrest = nullptr;
+    _coalescedNotify = false;
 }
 
 NodeOdSubscriber::~NodeOdSubscriber()
@@ -152,6 +153,30 @@ void NodeOdSubscriber::unRegisterFullOd()
     }
 }
 
+bool NodeOdSubscriber::isCoalescedNotify() const
+{
+    return _coalescedNotify;
+}
+
+/**
+ * @brief When enabled, notifications are delivered at most once per object and per tick of
+ * NodeOd::coalesceInterval() with odNotifyChangedSet(). Protocol level subscribers should keep it disabled
+ * to see every update.
+ * @param coalescedNotify
+ */
+void NodeOdSubscriber::setCoalescedNotify(bool coalescedNotify)
+{
+    _coalescedNotify = coalescedNotify;
+}
+
+void NodeOdSubscriber::odNotifyChangedSet(const QList<NodeOd::ObjectNotification> &changedSet)
+{
+    for (const NodeOd::ObjectNotification &notification : changedSet)
+    {
+        this->odNotify(notification.objId, notification.flags);
+    }
+}
+
 QList<NodeObjectId> NodeOdSubscriber::objIdList() const
 {
     return _objIdList;
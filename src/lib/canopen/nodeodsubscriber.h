@@ -61,10 +61,16 @@ protected:
 
     virtual void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) = 0;  // TODO constify flags param
 
+    // coalesced notifications, for display purpose
+    bool isCoalescedNotify() const;
+    void setCoalescedNotify(bool coalescedNotify);
+    virtual void odNotifyChangedSet(const QList<NodeOd::ObjectNotification> &changedSet);
+
 private:
     friend class NodeOd;
 
     Node *_nodeInterrest;
+    bool _coalescedNotify;
     QSet<quint64> _indexSubIndexList;
     QList<NodeObjectId> _objIdList;
     void registerKey(const NodeObjectId &objId);
@@ -29,6 +29,7 @@
 class Node;
 class NodeOd;
 class NodeIndex;
+class NodeOdSubscriber;
 
 class CANOPEN_EXPORT NodeSubIndex
 {
@@ -141,8 +142,11 @@ public:
 
 private:
     friend class NodeIndex;
+    friend class NodeOd;
     NodeIndex *_nodeIndex;
 
+    QList<NodeOdSubscriber *> _subscribers;
+
     quint8 _subIndex;
     QString _name;
     AccessType _accessType;
@@ -0,0 +1,499 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "objectrequest.h"
+
+#include <QTimer>
+
+#include "node.h"
+#include "services/services.h"
+
+ObjectRequest::ObjectRequest(Type type, const NodeObjectId &objectId, const QVariant &value, int timeoutMs, QObject *parent)
+    : QObject(parent)
+{
+    _type = type;
+    _objectId = objectId;
+    _status = Pending;
+    _value = value;
+    _errorCode = 0;
+    _timeoutMs = timeoutMs;
+    _autoDelete = true;
+    _dispatcher = nullptr;
+    _timeoutTimer = new TimerWheel::Timer(this);
+}
+
+ObjectRequest::~ObjectRequest()
+{
+    if (_status == Pending && _dispatcher != nullptr)
+    {
+        _dispatcher->detach(this);
+    }
+    delete _timeoutTimer;
+}
+
+ObjectRequest::Type ObjectRequest::type() const
+{
+    return _type;
+}
+
+const NodeObjectId &ObjectRequest::objectId() const
+{
+    return _objectId;
+}
+
+ObjectRequest::Status ObjectRequest::status() const
+{
+    return _status;
+}
+
+bool ObjectRequest::isFinished() const
+{
+    return _status != Pending;
+}
+
+bool ObjectRequest::isSuccess() const
+{
+    return _status == Done;
+}
+
+/**
+ * @brief value read from the device, or value written for write requests
+ */
+QVariant ObjectRequest::value() const
+{
+    return _value;
+}
+
+/**
+ * @brief SDO abort code of a request finished with Error status
+ */
+quint32 ObjectRequest::errorCode() const
+{
+    return _errorCode;
+}
+
+/**
+ * @brief calls continuation when the request is finished
+ */
+void ObjectRequest::then(const std::function<void(ObjectRequest *)> &continuation)
+{
+    connect(this, &ObjectRequest::finished, this, continuation);
+}
+
+/**
+ * @brief cancels the request. A request still queued is removed from the SDO client, a transfer
+ * already in progress ends on the bus but its result is ignored
+ */
+void ObjectRequest::cancel()
+{
+    if (_status != Pending)
+    {
+        return;
+    }
+    if (_dispatcher != nullptr)
+    {
+        _dispatcher->abort(this, Cancelled);
+    }
+    else
+    {
+        finish(Cancelled);
+    }
+}
+
+void ObjectRequest::timerWheelEvent(int timerId)
+{
+    Q_UNUSED(timerId)
+    if (_status != Pending)
+    {
+        return;
+    }
+    if (_dispatcher != nullptr)
+    {
+        _dispatcher->abort(this, Timeout);
+    }
+    else
+    {
+        finish(Timeout);
+    }
+}
+
+void ObjectRequest::finish(Status status, const QVariant &value, quint32 errorCode)
+{
+    if (_status != Pending)
+    {
+        return;
+    }
+
+    _status = status;
+    if (value.isValid())
+    {
+        _value = value;
+    }
+    _errorCode = errorCode;
+    _dispatcher = nullptr;
+    _timeoutTimer->stop();
+
+    emit finished(this);
+    if (_autoDelete)
+    {
+        deleteLater();
+    }
+}
+
+ObjectAccess ObjectAccess::read(const NodeObjectId &objectId)
+{
+    ObjectAccess access;
+    access.type = ObjectRequest::Read;
+    access.objectId = objectId;
+    return access;
+}
+
+ObjectAccess ObjectAccess::write(const NodeObjectId &objectId, const QVariant &value)
+{
+    ObjectAccess access;
+    access.type = ObjectRequest::Write;
+    access.objectId = objectId;
+    access.value = value;
+    return access;
+}
+
+ObjectTransaction::ObjectTransaction(QObject *parent)
+    : QObject(parent)
+{
+    _pendingCount = 0;
+    _finished = false;
+}
+
+ObjectTransaction::~ObjectTransaction()
+{
+}
+
+const QList<ObjectRequest *> &ObjectTransaction::requests() const
+{
+    return _requests;
+}
+
+ObjectRequest *ObjectTransaction::request(int i) const
+{
+    return _requests.value(i);
+}
+
+int ObjectTransaction::count() const
+{
+    return _requests.count();
+}
+
+bool ObjectTransaction::isFinished() const
+{
+    return _finished;
+}
+
+/**
+ * @brief true if every request of the transaction is done
+ */
+bool ObjectTransaction::isSuccess() const
+{
+    return _finished && errorCount() == 0;
+}
+
+/**
+ * @brief number of finished requests with another status than Done
+ */
+int ObjectTransaction::errorCount() const
+{
+    int count = 0;
+    for (ObjectRequest *request : _requests)
+    {
+        if (request->isFinished() && !request->isSuccess())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief calls continuation when all requests are finished
+ */
+void ObjectTransaction::then(const std::function<void(ObjectTransaction *)> &continuation)
+{
+    connect(this, &ObjectTransaction::finished, this, continuation);
+}
+
+/**
+ * @brief cancels all pending requests of the transaction
+ */
+void ObjectTransaction::cancel()
+{
+    const QList<ObjectRequest *> requests = _requests;
+    for (ObjectRequest *request : requests)
+    {
+        request->cancel();
+    }
+}
+
+void ObjectTransaction::addRequest(ObjectRequest *request)
+{
+    request->_autoDelete = false;
+    _requests.append(request);
+    _pendingCount++;
+    connect(request, &ObjectRequest::finished, this, &ObjectTransaction::requestFinished);
+}
+
+void ObjectTransaction::requestFinished(ObjectRequest *request)
+{
+    Q_UNUSED(request)
+    _pendingCount--;
+    if (_pendingCount <= 0)
+    {
+        finish();
+    }
+}
+
+void ObjectTransaction::finish()
+{
+    if (_finished)
+    {
+        return;
+    }
+
+    _finished = true;
+    emit finished(this);
+    deleteLater();
+}
+
+ObjectRequestDispatcher::ObjectRequestDispatcher(Node *node)
+    : _node(node)
+{
+    setNodeInterrest(node);
+}
+
+ObjectRequestDispatcher::~ObjectRequestDispatcher()
+{
+    for (const QList<Entry> &entries : qAsConst(_pending))
+    {
+        for (const Entry &entry : entries)
+        {
+            if (entry.request != nullptr)
+            {
+                entry.request->_dispatcher = nullptr;
+            }
+        }
+    }
+}
+
+/**
+ * @brief queues the read or write of request on the node, with the same routing as
+ * Node::readObject and Node::writeObject
+ */
+void ObjectRequestDispatcher::submit(ObjectRequest *request)
+{
+    const NodeObjectId &objectId = request->objectId();
+    if (_node->status() == Node::STOPPED || _node->status() == Node::UNKNOWN)
+    {
+        // finished from the event loop, so that the caller can connect to the request first
+        QTimer::singleShot(0, request, [request]() {
+            request->finish(ObjectRequest::Error, QVariant(), SDO::CO_SDO_ABORT_CODE_CANNOT_TRANSFERRED_3);
+        });
+        return;
+    }
+
+    if (request->type() == ObjectRequest::Write && _node->isWrittenByPdo(objectId))
+    {
+        // no acknowledge for RPDO writes, done once the RPDO is updated
+        _node->writeObject(objectId, request->value());
+        QTimer::singleShot(0, request, [request]() {
+            request->finish(ObjectRequest::Done);
+        });
+        return;
+    }
+
+    quint32 key = objectKey(objectId);
+    if (!_pending.contains(key))
+    {
+        registerSubIndex(objectId.index(), objectId.subIndex());
+    }
+    Entry entry;
+    entry.type = request->type();
+    entry.request = request;
+    _pending[key].append(entry);
+
+    request->_dispatcher = this;
+    if (request->_timeoutMs > 0)
+    {
+        request->_timeoutTimer->start(request->_timeoutMs);
+    }
+
+    if (request->type() == ObjectRequest::Read)
+    {
+        // TPDO mapped objects are not uploaded, the request ends with the next TPDO
+        if (!_node->isReadByPdo(objectId))
+        {
+            _node->readObject(objectId);
+        }
+    }
+    else
+    {
+        _node->writeObject(objectId, request->value());
+    }
+}
+
+/**
+ * @brief ends a pending request with Cancelled or Timeout status
+ */
+void ObjectRequestDispatcher::abort(ObjectRequest *request, ObjectRequest::Status status)
+{
+    detach(request);
+    request->finish(status);
+}
+
+/**
+ * @brief removes request from pending requests. Its transfer is removed from the SDO queue when
+ * possible, otherwise its notification is absorbed
+ */
+void ObjectRequestDispatcher::detach(ObjectRequest *request)
+{
+    quint32 key = objectKey(request->objectId());
+    auto it = _pending.find(key);
+    if (it != _pending.end())
+    {
+        QList<Entry> &entries = it.value();
+        int position = -1;
+        bool lastOfType = true;
+        bool otherOfType = false;
+        for (int i = 0; i < entries.count(); i++)
+        {
+            if (entries.at(i).request == request)
+            {
+                position = i;
+            }
+            else if (entries.at(i).type == request->type())
+            {
+                if (position != -1)
+                {
+                    lastOfType = false;
+                }
+                if (entries.at(i).request != nullptr)
+                {
+                    otherOfType = true;
+                }
+            }
+        }
+
+        if (position != -1)
+        {
+            if (request->type() == ObjectRequest::Read)
+            {
+                // uploads are shared by all reads of the object
+                if (!otherOfType)
+                {
+                    _node->cancelReadObject(request->objectId().index(), request->objectId().subIndex());
+                }
+                entries.removeAt(position);
+            }
+            else if (lastOfType && _node->cancelWriteObject(request->objectId().index(), request->objectId().subIndex()))
+            {
+                entries.removeAt(position);
+            }
+            else
+            {
+                entries[position].request = nullptr;
+            }
+
+            if (entries.isEmpty())
+            {
+                removeKey(key);
+            }
+        }
+    }
+    request->_dispatcher = nullptr;
+}
+
+void ObjectRequestDispatcher::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+{
+    quint32 key = objectKey(objId);
+    auto it = _pending.find(key);
+    if (it == _pending.end())
+    {
+        return;
+    }
+
+    // requests are finished after the pending list update, continuations may submit new requests
+    QList<ObjectRequest *> finishedRequests;
+    QList<Entry> &entries = it.value();
+    bool error = ((flags & NodeOd::Error) != 0);
+    if (error || (flags & (NodeOd::Read | NodeOd::Pdo)) != 0)
+    {
+        // a read ends all reads queued before the next write, they share one upload or TPDO
+        if (!entries.isEmpty() && (error || entries.first().type == ObjectRequest::Read))
+        {
+            ObjectRequest::Type type = entries.first().type;
+            do
+            {
+                if (entries.first().request != nullptr)
+                {
+                    finishedRequests.append(entries.first().request);
+                }
+                entries.removeFirst();
+            } while (type == ObjectRequest::Read && !entries.isEmpty() && entries.first().type == ObjectRequest::Read);
+        }
+    }
+    else if ((flags & NodeOd::Write) != 0)
+    {
+        if (!entries.isEmpty() && entries.first().type == ObjectRequest::Write)
+        {
+            if (entries.first().request != nullptr)
+            {
+                finishedRequests.append(entries.first().request);
+            }
+            entries.removeFirst();
+        }
+    }
+    if (entries.isEmpty())
+    {
+        removeKey(key);
+    }
+
+    NodeOd *nodeOd = _node->nodeOd();
+    for (ObjectRequest *request : qAsConst(finishedRequests))
+    {
+        if (error)
+        {
+            request->finish(ObjectRequest::Error, QVariant(), nodeOd->errorObject(objId.index(), objId.subIndex()));
+        }
+        else if (request->type() == ObjectRequest::Read)
+        {
+            request->finish(ObjectRequest::Done, nodeOd->value(objId.index(), objId.subIndex()));
+        }
+        else
+        {
+            request->finish(ObjectRequest::Done);
+        }
+    }
+}
+
+quint32 ObjectRequestDispatcher::objectKey(const NodeObjectId &objectId)
+{
+    return (static_cast<quint32>(objectId.index()) << 8) | objectId.subIndex();
+}
+
+void ObjectRequestDispatcher::removeKey(quint32 key)
+{
+    _pending.remove(key);
+    unRegisterSubIndex(static_cast<quint16>(key >> 8), static_cast<quint8>(key & 0xFF));
+}
@@ -0,0 +1,199 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef OBJECTREQUEST_H
+#define OBJECTREQUEST_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include <QHash>
+#include <QList>
+#include <QVariant>
+
+#include <functional>
+
+#include "nodeobjectid.h"
+#include "nodeodsubscriber.h"
+#include "timerwheel.h"
+
+class Node;
+class ObjectRequestDispatcher;
+
+/**
+ * @brief One asynchronous read or write of a node object, created by Node::readObjectAsync and
+ * Node::writeObjectAsync
+ *
+ * finished() is emitted once with the final status, the request is then deleted with
+ * deleteLater(), except when it belongs to an ObjectTransaction.
+ */
+class CANOPEN_EXPORT ObjectRequest : public QObject, public TimerWheelClient
+{
+    Q_OBJECT
+public:
+    ~ObjectRequest() override;
+
+    enum
+    {
+        DefaultTimeout = 3000
+    };
+
+    enum Type
+    {
+        Read,
+        Write
+    };
+    Type type() const;
+    const NodeObjectId &objectId() const;
+
+    enum Status
+    {
+        Pending,
+        Done,
+        Error,
+        Timeout,
+        Cancelled
+    };
+    Status status() const;
+    bool isFinished() const;
+    bool isSuccess() const;
+
+    QVariant value() const;
+    quint32 errorCode() const;
+
+    void then(const std::function<void(ObjectRequest *)> &continuation);
+
+public slots:
+    void cancel();
+
+signals:
+    void finished(ObjectRequest *request);
+
+protected:
+    void timerWheelEvent(int timerId) override;
+
+private:
+    friend class Node;
+    friend class ObjectRequestDispatcher;
+    friend class ObjectTransaction;
+    ObjectRequest(Type type, const NodeObjectId &objectId, const QVariant &value, int timeoutMs, QObject *parent);
+
+    void finish(Status status, const QVariant &value = QVariant(), quint32 errorCode = 0);
+
+    Type _type;
+    NodeObjectId _objectId;
+    Status _status;
+    QVariant _value;
+    quint32 _errorCode;
+    int _timeoutMs;
+    bool _autoDelete;
+    ObjectRequestDispatcher *_dispatcher;
+    TimerWheel::Timer *_timeoutTimer;
+};
+
+/**
+ * @brief Description of one access of a transaction
+ */
+struct CANOPEN_EXPORT ObjectAccess
+{
+    ObjectRequest::Type type;
+    NodeObjectId objectId;
+    QVariant value;
+
+    static ObjectAccess read(const NodeObjectId &objectId);
+    static ObjectAccess write(const NodeObjectId &objectId, const QVariant &value);
+};
+
+/**
+ * @brief List of reads and writes submitted at once, created by Node::transaction
+ *
+ * All requests are queued together on the SDO client so that transfers are chained without
+ * waiting for the caller between them. Each request keeps its own timeout. finished() is emitted
+ * when every request is finished, the transaction and its requests are then deleted with
+ * deleteLater().
+ */
+class CANOPEN_EXPORT ObjectTransaction : public QObject
+{
+    Q_OBJECT
+public:
+    ~ObjectTransaction() override;
+
+    const QList<ObjectRequest *> &requests() const;
+    ObjectRequest *request(int i) const;
+    int count() const;
+
+    bool isFinished() const;
+    bool isSuccess() const;
+    int errorCount() const;
+
+    void then(const std::function<void(ObjectTransaction *)> &continuation);
+
+public slots:
+    void cancel();
+
+signals:
+    void finished(ObjectTransaction *transaction);
+
+private:
+    friend class Node;
+    ObjectTransaction(QObject *parent);
+
+    void addRequest(ObjectRequest *request);
+    void requestFinished(ObjectRequest *request);
+    void finish();
+
+    QList<ObjectRequest *> _requests;
+    int _pendingCount;
+    bool _finished;
+};
+
+/**
+ * @brief Pending requests of one node, matched in submission order with od notifications
+ *
+ * Owned by Node. Completion of requests is matched per object in the SDO queue order, concurrent
+ * plain Node::writeObject calls on the same object are not distinguished from requests.
+ */
+class ObjectRequestDispatcher : public NodeOdSubscriber
+{
+public:
+    ObjectRequestDispatcher(Node *node);
+    ~ObjectRequestDispatcher() override;
+
+    void submit(ObjectRequest *request);
+    void abort(ObjectRequest *request, ObjectRequest::Status status);
+    void detach(ObjectRequest *request);
+
+protected:
+    void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) override;
+
+private:
+    Node *_node;
+
+    struct Entry
+    {
+        ObjectRequest::Type type;
+        ObjectRequest *request;  // nullptr for aborted requests whose transfer is in progress
+    };
+    QHash<quint32, QList<Entry>> _pending;
+
+    static quint32 objectKey(const NodeObjectId &objectId);
+    void removeKey(quint32 key);
+};
+
+#endif  // OBJECTREQUEST_H
@@ -0,0 +1,329 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "odsnapshot.h"
+
+#include "canopenbus.h"
+#include "node.h"
+#include "nodeodsubscriber.h"
+#include "timerwheel.h"
+
+#include <QDir>
+#include <QSet>
+
+enum
+{
+    TIMEOUT_JOB = 5000  // without answer, SDO::reset() drops queued uploads without notification
+};
+
+class OdSnapshotJob : public NodeOdSubscriber, public TimerWheelClient
+{
+public:
+    OdSnapshotJob(OdSnapshot *snapshot, Node *node);
+
+    void start();
+    void cancel();
+    bool isRunning() const;
+
+    OdSnapshot::NodeReport report;
+
+private:
+    OdSnapshot *_snapshot;
+    Node *_node;
+    QSet<quint32> _pendingObjects;
+    QElapsedTimer _timer;
+    TimerWheel::Timer _timeoutTimer;
+
+    void finish();
+
+    // NodeOdSubscriber interface
+protected:
+    void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) override;
+
+    // TimerWheelClient interface
+protected:
+    void timerWheelEvent(int timerId) override;
+};
+
+OdSnapshotJob::OdSnapshotJob(OdSnapshot *snapshot, Node *node)
+    : _snapshot(snapshot)
+    , _node(node)
+    , _timeoutTimer(this)
+{
+    report = OdSnapshot::NodeReport{node, 0, 0, 0, 0, 0, 0.0, false, QString()};
+    setNodeInterrest(node);
+    registerFullOd();
+}
+
+void OdSnapshotJob::start()
+{
+    report = OdSnapshot::NodeReport{_node, 0, 0, 0, 0, 0, 0.0, false, QString()};
+    _pendingObjects.clear();
+    _timer.start();
+
+    QList<NodeSubIndex *> toRead;
+    for (NodeIndex *nodeIndex : _node->nodeOd()->indexes())
+    {
+        for (NodeSubIndex *nodeSubIndex : nodeIndex->subIndexes())
+        {
+            if (!nodeSubIndex->isReadable())
+            {
+                continue;
+            }
+            report.objectsCount++;
+            if (_node->isReadByPdo(nodeSubIndex->objectId()))
+            {
+                report.pdoSkippedCount++;
+                continue;
+            }
+            toRead.append(nodeSubIndex);
+            _pendingObjects.insert((static_cast<quint32>(nodeIndex->index()) << 8) | nodeSubIndex->subIndex());
+        }
+    }
+
+    // a stopped or unknown node does not answer to SDO
+    if (_node->status() == Node::STOPPED || _node->status() == Node::UNKNOWN)
+    {
+        report.errorCount = _pendingObjects.size();
+        _pendingObjects.clear();
+    }
+
+    if (_pendingObjects.isEmpty())
+    {
+        finish();
+        return;
+    }
+
+    // all uploads queued at once, the SDO client chains them
+    for (NodeSubIndex *nodeSubIndex : qAsConst(toRead))
+    {
+        _node->readObject(nodeSubIndex->index(), nodeSubIndex->subIndex());
+    }
+    _timeoutTimer.start(TIMEOUT_JOB);
+}
+
+/**
+ * @brief removes the uploads still queued, the one in progress completes and is ignored
+ */
+void OdSnapshotJob::cancel()
+{
+    for (quint32 key : qAsConst(_pendingObjects))
+    {
+        _node->cancelReadObject(static_cast<quint16>(key >> 8), static_cast<quint8>(key & 0xFF));
+    }
+    _pendingObjects.clear();
+    _timeoutTimer.stop();
+}
+
+bool OdSnapshotJob::isRunning() const
+{
+    return !_pendingObjects.isEmpty();
+}
+
+void OdSnapshotJob::finish()
+{
+    report.elapsedMs = _timer.elapsed();
+    if (report.elapsedMs > 0)
+    {
+        report.objectsPerSecond = static_cast<qreal>(report.readCount + report.errorCount) * 1000.0 / static_cast<qreal>(report.elapsedMs);
+    }
+    report.finished = true;
+
+    if (!_snapshot->dcfDirectory().isEmpty())
+    {
+        QString fileName = QDir(_snapshot->dcfDirectory()).filePath(QString("%1_node%2.dcf").arg(_node->name()).arg(_node->nodeId()));
+        fileName.replace(' ', '_');
+        if (_node->nodeOd()->exportDcf(fileName))
+        {
+            report.dcfFileName = fileName;
+        }
+    }
+
+    _snapshot->jobFinished(this);
+}
+
+void OdSnapshotJob::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+{
+    if (_pendingObjects.isEmpty())
+    {
+        return;
+    }
+    if ((flags & (NodeOd::Read | NodeOd::Error)) == 0)
+    {
+        return;
+    }
+    if (!_pendingObjects.remove((static_cast<quint32>(objId.index()) << 8) | objId.subIndex()))
+    {
+        return;
+    }
+
+    if ((flags & NodeOd::Error) == NodeOd::Error)
+    {
+        report.errorCount++;
+    }
+    else
+    {
+        report.readCount++;
+    }
+
+    if (_pendingObjects.isEmpty())
+    {
+        _timeoutTimer.stop();
+        finish();
+    }
+    else
+    {
+        _timeoutTimer.start(TIMEOUT_JOB);
+        _snapshot->jobProgress();
+    }
+}
+
+/**
+ * @brief no answer during TIMEOUT_JOB, objects still pending are counted as errors
+ */
+void OdSnapshotJob::timerWheelEvent(int timerId)
+{
+    Q_UNUSED(timerId)
+    if (_pendingObjects.isEmpty())
+    {
+        return;
+    }
+    report.errorCount += _pendingObjects.size();
+    cancel();
+    finish();
+}
+
+OdSnapshot::OdSnapshot(QObject *parent)
+    : QObject(parent)
+{
+    _runningJobs = 0;
+}
+
+OdSnapshot::~OdSnapshot()
+{
+    qDeleteAll(_jobs);
+}
+
+void OdSnapshot::addNode(Node *node)
+{
+    _jobs.append(new OdSnapshotJob(this, node));
+}
+
+void OdSnapshot::addNodes(const QList<Node *> &nodes)
+{
+    for (Node *node : nodes)
+    {
+        addNode(node);
+    }
+}
+
+void OdSnapshot::clear()
+{
+    cancel();
+    qDeleteAll(_jobs);
+    _jobs.clear();
+}
+
+/**
+ * @brief directory where a DCF is written for each node at the end of its snapshot, none if empty
+ */
+const QString &OdSnapshot::dcfDirectory() const
+{
+    return _dcfDirectory;
+}
+
+void OdSnapshot::setDcfDirectory(const QString &dcfDirectory)
+{
+    _dcfDirectory = dcfDirectory;
+}
+
+bool OdSnapshot::isRunning() const
+{
+    return _runningJobs > 0;
+}
+
+QList<OdSnapshot::NodeReport> OdSnapshot::reports() const
+{
+    QList<NodeReport> reports;
+    for (OdSnapshotJob *job : _jobs)
+    {
+        reports.append(job->report);
+    }
+    return reports;
+}
+
+/**
+ * @brief time since start, or total time of the last snapshot once finished
+ */
+qint64 OdSnapshot::elapsedMs() const
+{
+    qint64 elapsed = 0;
+    for (OdSnapshotJob *job : _jobs)
+    {
+        elapsed = qMax(elapsed, job->report.finished ? job->report.elapsedMs : _elapsedTimer.elapsed());
+    }
+    return elapsed;
+}
+
+void OdSnapshot::start()
+{
+    if (isRunning())
+    {
+        return;
+    }
+
+    _elapsedTimer.start();
+    _runningJobs = _jobs.count();
+    for (OdSnapshotJob *job : qAsConst(_jobs))
+    {
+        job->start();
+    }
+}
+
+void OdSnapshot::cancel()
+{
+    for (OdSnapshotJob *job : qAsConst(_jobs))
+    {
+        job->cancel();
+    }
+    _runningJobs = 0;
+}
+
+void OdSnapshot::jobProgress()
+{
+    int done = 0;
+    int total = 0;
+    for (OdSnapshotJob *job : qAsConst(_jobs))
+    {
+        done += job->report.readCount + job->report.errorCount + job->report.pdoSkippedCount;
+        total += job->report.objectsCount;
+    }
+    emit progress(done, total);
+}
+
+void OdSnapshot::jobFinished(OdSnapshotJob *job)
+{
+    jobProgress();
+    emit nodeFinished(job->report.node);
+
+    _runningJobs--;
+    if (_runningJobs == 0)
+    {
+        emit finished();
+    }
+}
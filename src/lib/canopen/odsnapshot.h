@@ -0,0 +1,90 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ODSNAPSHOT_H
+#define ODSNAPSHOT_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include <QElapsedTimer>
+#include <QList>
+
+class Node;
+class OdSnapshotJob;
+
+/**
+ * @brief Reads every readable object of one or many nodes and optionally exports them as DCF
+ *
+ * All uploads of a node are queued at once on its SDO client so that transfers are chained
+ * without gap, nodes run concurrently. Objects refreshed by a running TPDO are not read. A node
+ * without answer for 5 s ends with its pending objects counted as errors.
+ */
+class CANOPEN_EXPORT OdSnapshot : public QObject
+{
+    Q_OBJECT
+public:
+    OdSnapshot(QObject *parent = nullptr);
+    ~OdSnapshot() override;
+
+    void addNode(Node *node);
+    void addNodes(const QList<Node *> &nodes);
+    void clear();
+
+    const QString &dcfDirectory() const;
+    void setDcfDirectory(const QString &dcfDirectory);
+
+    bool isRunning() const;
+
+    struct NodeReport
+    {
+        Node *node;
+        int objectsCount;
+        int readCount;
+        int pdoSkippedCount;
+        int errorCount;
+        qint64 elapsedMs;
+        qreal objectsPerSecond;
+        bool finished;
+        QString dcfFileName;
+    };
+    QList<NodeReport> reports() const;
+    qint64 elapsedMs() const;
+
+public slots:
+    void start();
+    void cancel();
+
+signals:
+    void progress(int done, int total);
+    void nodeFinished(Node *node);
+    void finished();
+
+private:
+    friend class OdSnapshotJob;
+    void jobProgress();
+    void jobFinished(OdSnapshotJob *job);
+
+    QList<OdSnapshotJob *> _jobs;
+    QString _dcfDirectory;
+    QElapsedTimer _elapsedTimer;
+    int _runningJobs;
+};
+
+#endif  // ODSNAPSHOT_H
@@ -0,0 +1,564 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "pdomappingplanner.h"
+
+#include "canopenbus.h"
+#include "configurationdownload.h"
+#include "node.h"
+#include "services/rpdo.h"
+#include "services/tpdo.h"
+
+#include <QCoreApplication>
+#include <QSet>
+#include <QStringList>
+
+#include <algorithm>
+
+enum
+{
+    PDO_COBID_NOT_VALID = 0x80000000U,
+    PDO_TRANSMISSION_SYNC = 0x01
+};
+
+static QString objectName(const NodeObjectId &objectId)
+{
+    return QString("%1h.%2")
+        .arg(QString::number(objectId.index(), 16).rightJustified(4, '0').toUpper())
+        .arg(QString::number(objectId.subIndex(), 16).rightJustified(2, '0').toUpper());
+}
+
+PdoMappingPlanner::PdoMappingPlanner(CanOpenBus *bus)
+    : _bus(bus)
+{
+    _syncPeriodUs = 10000;
+    _loadBudget = 0.5;
+    _unusedPdosDisabled = false;
+}
+
+/**
+ * @brief adds an object read from node, mapped in a TPDO
+ */
+void PdoMappingPlanner::addObserved(Node *node, const NodeObjectId &objectId)
+{
+    Request request;
+    request.node = node;
+    request.objectId = objectId;
+    _observed.append(request);
+}
+
+/**
+ * @brief adds an object written to node, mapped in a RPDO
+ */
+void PdoMappingPlanner::addCommanded(Node *node, const NodeObjectId &objectId)
+{
+    Request request;
+    request.node = node;
+    request.objectId = objectId;
+    _commanded.append(request);
+}
+
+/**
+ * @brief keeps a PDO of node out of the plan, pdoNumber from 0
+ */
+void PdoMappingPlanner::reservePdo(Node *node, bool isTpdo, int pdoNumber)
+{
+    Reservation reservation;
+    reservation.node = node;
+    reservation.isTpdo = isTpdo;
+    reservation.pdoNumber = pdoNumber;
+    _reserved.append(reservation);
+}
+
+/**
+ * @brief removes all objects and reserved PDOs
+ */
+void PdoMappingPlanner::clear()
+{
+    _observed.clear();
+    _commanded.clear();
+    _reserved.clear();
+}
+
+int PdoMappingPlanner::syncPeriodUs() const
+{
+    return _syncPeriodUs;
+}
+
+void PdoMappingPlanner::setSyncPeriodUs(int syncPeriodUs)
+{
+    _syncPeriodUs = syncPeriodUs;
+}
+
+/**
+ * @brief maximal bus load ratio allowed for the planned PDOs and SYNC, 0 to 1
+ */
+qreal PdoMappingPlanner::loadBudget() const
+{
+    return _loadBudget;
+}
+
+void PdoMappingPlanner::setLoadBudget(qreal loadBudget)
+{
+    _loadBudget = loadBudget;
+}
+
+bool PdoMappingPlanner::isUnusedPdosDisabled() const
+{
+    return _unusedPdosDisabled;
+}
+
+/**
+ * @brief disables enabled PDOs not used by the plan on the planned nodes and directions, off by
+ * default as they may carry mappings configured outside of the planner
+ */
+void PdoMappingPlanner::setUnusedPdosDisabled(bool unusedPdosDisabled)
+{
+    _unusedPdosDisabled = unusedPdosDisabled;
+}
+
+PdoMappingPlanner::Plan PdoMappingPlanner::plan() const
+{
+    Plan plan;
+    plan.syncPeriodUs = _syncPeriodUs;
+    plan.loadBudget = _loadBudget;
+
+    for (Node *node : nodesOf(_observed))
+    {
+        planDirection(plan, node, objectsOfNode(_observed, node), true);
+    }
+    for (Node *node : nodesOf(_commanded))
+    {
+        planDirection(plan, node, objectsOfNode(_commanded, node), false);
+    }
+    if (_unusedPdosDisabled)
+    {
+        planDisabledPdos(plan);
+    }
+
+    plan.busTimeNs = frameDurationNs(0x080, 0);  // SYNC
+    for (const PdoPlan &pdoPlan : qAsConst(plan.pdos))
+    {
+        plan.busTimeNs += pdoPlan.frameDurationNs;
+    }
+    plan.busLoad = (_syncPeriodUs > 0) ? static_cast<qreal>(plan.busTimeNs) / (_syncPeriodUs * 1000.0) : 0.0;
+
+    return plan;
+}
+
+/**
+ * @brief first fit decreasing packing of objects in the plannable PDOs of node in one direction
+ */
+void PdoMappingPlanner::planDirection(Plan &plan, Node *node, const QList<NodeObjectId> &objects, bool isTpdo) const
+{
+    struct Bin
+    {
+        int pdoNumber;
+        int maxBitSize;
+        int maxCount;
+        QList<NodeObjectId> objects;
+        int bitSize;
+    };
+    QSet<quint32> requestedKeys;
+    for (const NodeObjectId &objectId : objects)
+    {
+        requestedKeys.insert(objectKey(objectId));
+    }
+
+    // kept PDOs are not bins, the requested objects they map are already served
+    QList<Bin> bins;
+    QSet<quint32> keys;
+    for (PDO *pdo : pdosOf(node, isTpdo))
+    {
+        if (!isPlannable(pdo, node, isTpdo, requestedKeys))
+        {
+            if (pdo->isEnabled())
+            {
+                for (const NodeObjectId &objectId : pdo->currentMappind())
+                {
+                    keys.insert(objectKey(objectId));
+                }
+            }
+            continue;
+        }
+        if (pdo->maxMappingObjectCount() <= 0)
+        {
+            continue;
+        }
+        Bin bin;
+        bin.pdoNumber = pdo->pdoNumber();
+        bin.maxBitSize = pdo->maxMappingBitSize();
+        bin.maxCount = pdo->maxMappingObjectCount();
+        bin.bitSize = 0;
+        bins.append(bin);
+    }
+
+    struct Candidate
+    {
+        NodeObjectId objectId;
+        int bitLength;
+    };
+    QList<Candidate> candidates;
+    for (const NodeObjectId &objectId : objects)
+    {
+        RejectedObject rejected;
+        rejected.node = node;
+        rejected.objectId = objectId;
+
+        NodeSubIndex *nodeSubIndex = node->nodeOd()->subIndex(objectId.index(), objectId.subIndex());
+        if (nodeSubIndex == nullptr)
+        {
+            rejected.reason = QCoreApplication::translate("PdoMappingPlanner", "not in object dictionary");
+            plan.rejected.append(rejected);
+            continue;
+        }
+        if ((isTpdo && !nodeSubIndex->hasTPDOAccess()) || (!isTpdo && !nodeSubIndex->hasRPDOAccess()))
+        {
+            rejected.reason = QCoreApplication::translate("PdoMappingPlanner", "not mappable in %1").arg(isTpdo ? "TPDO" : "RPDO");
+            plan.rejected.append(rejected);
+            continue;
+        }
+        if (nodeSubIndex->bitLength() <= 0)
+        {
+            rejected.reason = QCoreApplication::translate("PdoMappingPlanner", "unsupported data type");
+            plan.rejected.append(rejected);
+            continue;
+        }
+
+        quint32 key = objectKey(objectId);
+        if (keys.contains(key))
+        {
+            continue;
+        }
+        keys.insert(key);
+
+        Candidate candidate;
+        candidate.objectId = NodeObjectId(node->busId(), node->nodeId(), objectId.index(), objectId.subIndex(), NodeOd::dataTypeCiaToQt(nodeSubIndex->dataType()));
+        candidate.bitLength = nodeSubIndex->bitLength();
+        candidates.append(candidate);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.bitLength > b.bitLength;
+    });
+
+    for (const Candidate &candidate : qAsConst(candidates))
+    {
+        bool placed = false;
+        for (Bin &bin : bins)
+        {
+            if (bin.bitSize + candidate.bitLength <= bin.maxBitSize && bin.objects.count() < bin.maxCount)
+            {
+                bin.objects.append(candidate.objectId);
+                bin.bitSize += candidate.bitLength;
+                placed = true;
+                break;
+            }
+        }
+        if (!placed)
+        {
+            RejectedObject rejected;
+            rejected.node = node;
+            rejected.objectId = candidate.objectId;
+            rejected.reason = QCoreApplication::translate("PdoMappingPlanner", "no PDO space left");
+            plan.rejected.append(rejected);
+        }
+    }
+
+    for (const Bin &bin : qAsConst(bins))
+    {
+        if (bin.objects.isEmpty())
+        {
+            continue;
+        }
+
+        PdoPlan pdoPlan;
+        pdoPlan.node = node;
+        pdoPlan.isTpdo = isTpdo;
+        pdoPlan.pdoNumber = bin.pdoNumber;
+        pdoPlan.objects = bin.objects;
+        pdoPlan.bitSize = bin.bitSize;
+
+        // keeps the COB-ID configured on the node, predefined connection set otherwise
+        quint16 commIndex = static_cast<quint16>((isTpdo ? 0x1800 : 0x1400) + bin.pdoNumber);
+        quint32 cobId = node->nodeOd()->value(commIndex, 0x01).toUInt() & 0x7FFU;
+        if (cobId == 0)
+        {
+            cobId = static_cast<quint32>((isTpdo ? 0x180 : 0x200) + 0x100 * bin.pdoNumber + node->nodeId());
+        }
+        pdoPlan.cobId = cobId;
+        pdoPlan.frameDurationNs = frameDurationNs(cobId, bin.bitSize);
+        plan.pdos.append(pdoPlan);
+    }
+}
+
+/**
+ * @brief enabled PDOs of the nodes and directions of the plan which are not planned, kept PDOs
+ * excluded
+ */
+void PdoMappingPlanner::planDisabledPdos(Plan &plan) const
+{
+    QMap<Node *, QSet<int>> usedTpdos;
+    QMap<Node *, QSet<int>> usedRpdos;
+    for (const PdoPlan &pdoPlan : qAsConst(plan.pdos))
+    {
+        if (pdoPlan.isTpdo)
+        {
+            usedTpdos[pdoPlan.node].insert(pdoPlan.pdoNumber);
+        }
+        else
+        {
+            usedRpdos[pdoPlan.node].insert(pdoPlan.pdoNumber);
+        }
+    }
+
+    for (int direction = 0; direction < 2; direction++)
+    {
+        bool isTpdo = (direction == 0);
+        const QMap<Node *, QSet<int>> &used = isTpdo ? usedTpdos : usedRpdos;
+        for (QMap<Node *, QSet<int>>::const_iterator it = used.cbegin(); it != used.cend(); ++it)
+        {
+            Node *node = it.key();
+            QSet<quint32> requestedKeys;
+            for (const NodeObjectId &objectId : objectsOfNode(isTpdo ? _observed : _commanded, node))
+            {
+                requestedKeys.insert(objectKey(objectId));
+            }
+            for (PDO *pdo : pdosOf(node, isTpdo))
+            {
+                int pdoNumber = pdo->pdoNumber();
+                quint16 commIndex = static_cast<quint16>((isTpdo ? 0x1800 : 0x1400) + pdoNumber);
+                if (it.value().contains(pdoNumber) || !node->nodeOd()->subIndexExist(commIndex, 0x01) || !isPlannable(pdo, node, isTpdo, requestedKeys))
+                {
+                    continue;
+                }
+                quint32 cobId = node->nodeOd()->value(commIndex, 0x01).toUInt();
+                if ((cobId & PDO_COBID_NOT_VALID) != 0)
+                {
+                    continue;
+                }
+
+                DisabledPdo disabledPdo;
+                disabledPdo.node = node;
+                disabledPdo.isTpdo = isTpdo;
+                disabledPdo.pdoNumber = pdoNumber;
+                disabledPdo.cobId = cobId;
+                plan.disabledPdos.append(disabledPdo);
+            }
+        }
+    }
+}
+
+bool PdoMappingPlanner::isReserved(Node *node, bool isTpdo, int pdoNumber) const
+{
+    for (const Reservation &reservation : _reserved)
+    {
+        if (reservation.node == node && reservation.isTpdo == isTpdo && reservation.pdoNumber == pdoNumber)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief true if pdo may be remapped by the plan: not reserved, and disabled or only mapping
+ * requested objects
+ */
+bool PdoMappingPlanner::isPlannable(PDO *pdo, Node *node, bool isTpdo, const QSet<quint32> &requestedKeys) const
+{
+    if (isReserved(node, isTpdo, pdo->pdoNumber()))
+    {
+        return false;
+    }
+    if (!pdo->isEnabled())
+    {
+        return true;
+    }
+    for (const NodeObjectId &objectId : pdo->currentMappind())
+    {
+        if (!requestedKeys.contains(objectKey(objectId)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QList<PDO *> PdoMappingPlanner::pdosOf(Node *node, bool isTpdo)
+{
+    QList<PDO *> pdos;
+    if (isTpdo)
+    {
+        for (TPDO *tpdo : node->tpdos())
+        {
+            pdos.append(tpdo);
+        }
+    }
+    else
+    {
+        for (RPDO *rpdo : node->rpdos())
+        {
+            pdos.append(rpdo);
+        }
+    }
+    return pdos;
+}
+
+quint32 PdoMappingPlanner::objectKey(const NodeObjectId &objectId)
+{
+    return (static_cast<quint32>(objectId.index()) << 8) | objectId.subIndex();
+}
+
+/**
+ * @brief duration of a PDO frame of bitSize bits, with the worst case bit stuffing of a zero
+ * payload
+ */
+qint64 PdoMappingPlanner::frameDurationNs(quint32 cobId, int bitSize) const
+{
+    static const int fdLengths[] = {12, 16, 20, 24, 32, 48, 64};
+
+    int length = (bitSize + 7) / 8;
+    bool isFd = (length > 8);
+    if (isFd)
+    {
+        for (int fdLength : fdLengths)
+        {
+            if (length <= fdLength)
+            {
+                length = fdLength;
+                break;
+            }
+        }
+    }
+
+    QCanBusFrame frame(cobId, QByteArray(length, 0));
+    frame.setFlexibleDataRateFormat(isFd);
+    return _bus->statistics()->frameDurationNs(frame);
+}
+
+QList<NodeObjectId> PdoMappingPlanner::objectsOfNode(const QList<Request> &requests, Node *node)
+{
+    QList<NodeObjectId> objects;
+    for (const Request &request : requests)
+    {
+        if (request.node == node)
+        {
+            objects.append(request.objectId);
+        }
+    }
+    return objects;
+}
+
+QList<Node *> PdoMappingPlanner::nodesOf(const QList<Request> &requests)
+{
+    QList<Node *> nodes;
+    for (const Request &request : requests)
+    {
+        if (!nodes.contains(request.node))
+        {
+            nodes.append(request.node);
+        }
+    }
+    return nodes;
+}
+
+bool PdoMappingPlanner::Plan::isWithinBudget() const
+{
+    return busLoad <= loadBudget;
+}
+
+/**
+ * @brief human readable preview of the plan
+ */
+QString PdoMappingPlanner::Plan::report() const
+{
+    QString report;
+    for (const PdoPlan &pdoPlan : pdos)
+    {
+        QStringList objectNames;
+        for (const NodeObjectId &objectId : pdoPlan.objects)
+        {
+            objectNames.append(objectName(objectId));
+        }
+        report += QString("%1 %2%3 (%4h): %5, %6 bits, %7 us\n")
+                      .arg(pdoPlan.node->name())
+                      .arg(pdoPlan.isTpdo ? "TPDO" : "RPDO")
+                      .arg(pdoPlan.pdoNumber + 1)
+                      .arg(QString::number(pdoPlan.cobId, 16).rightJustified(3, '0').toUpper())
+                      .arg(objectNames.join(' '))
+                      .arg(pdoPlan.bitSize)
+                      .arg(pdoPlan.frameDurationNs / 1000.0, 0, 'f', 1);
+    }
+    for (const DisabledPdo &disabledPdo : disabledPdos)
+    {
+        report += QString("%1 %2%3 (%4h): disabled\n")
+                      .arg(disabledPdo.node->name())
+                      .arg(disabledPdo.isTpdo ? "TPDO" : "RPDO")
+                      .arg(disabledPdo.pdoNumber + 1)
+                      .arg(QString::number(disabledPdo.cobId & 0x7FFU, 16).rightJustified(3, '0').toUpper());
+    }
+    for (const RejectedObject &rejectedObject : rejected)
+    {
+        report += QString("%1 %2 not mapped: %3\n").arg(rejectedObject.node->name(), objectName(rejectedObject.objectId), rejectedObject.reason);
+    }
+    report += QString("Bus load: %1 % of %2 us SYNC period, budget %3 %\n")
+                  .arg(busLoad * 100.0, 0, 'f', 1)
+                  .arg(syncPeriodUs)
+                  .arg(loadBudget * 100.0, 0, 'f', 1);
+    return report;
+}
+
+/**
+ * @brief creates a download of the plan, not started. Planned PDOs are set synchronous with
+ * their mapping, PDOs listed in disabledPdos are disabled
+ */
+ConfigurationDownload *PdoMappingPlanner::createDownload(const Plan &plan, QObject *parent)
+{
+    QMap<Node *, ConfigurationDownload::Configuration> configurations;
+    for (const PdoPlan &pdoPlan : plan.pdos)
+    {
+        ConfigurationDownload::Configuration &configuration = configurations[pdoPlan.node];
+        quint16 commIndex = static_cast<quint16>((pdoPlan.isTpdo ? 0x1800 : 0x1400) + pdoPlan.pdoNumber);
+        quint16 mappingIndex = commIndex + 0x200;
+
+        configuration.insert(ConfigurationDownload::objectKey(commIndex, 0x01), pdoPlan.cobId);
+        configuration.insert(ConfigurationDownload::objectKey(commIndex, 0x02), static_cast<quint8>(PDO_TRANSMISSION_SYNC));
+        for (int i = 0; i < pdoPlan.objects.count(); i++)
+        {
+            const NodeObjectId &objectId = pdoPlan.objects.at(i);
+            NodeSubIndex *nodeSubIndex = pdoPlan.node->nodeOd()->subIndex(objectId);
+            quint32 bitLength = (nodeSubIndex != nullptr) ? static_cast<quint32>(nodeSubIndex->bitLength()) : objectId.bitSize();
+            quint32 mapping = (static_cast<quint32>(objectId.index()) << 16) | (static_cast<quint32>(objectId.subIndex()) << 8) | bitLength;
+            configuration.insert(ConfigurationDownload::objectKey(mappingIndex, static_cast<quint8>(i + 1)), mapping);
+        }
+        configuration.insert(ConfigurationDownload::objectKey(mappingIndex, 0x00), static_cast<quint8>(pdoPlan.objects.count()));
+    }
+
+    for (const DisabledPdo &disabledPdo : plan.disabledPdos)
+    {
+        quint16 commIndex = static_cast<quint16>((disabledPdo.isTpdo ? 0x1800 : 0x1400) + disabledPdo.pdoNumber);
+        configurations[disabledPdo.node].insert(ConfigurationDownload::objectKey(commIndex, 0x01), disabledPdo.cobId | PDO_COBID_NOT_VALID);
+    }
+
+    ConfigurationDownload *download = new ConfigurationDownload(parent);
+    for (QMap<Node *, ConfigurationDownload::Configuration>::const_iterator it = configurations.cbegin(); it != configurations.cend(); ++it)
+    {
+        download->addNode(it.key(), it.value());
+    }
+    return download;
+}
@@ -0,0 +1,138 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef PDOMAPPINGPLANNER_H
+#define PDOMAPPINGPLANNER_H
+
+#include "canopen_global.h"
+
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include "nodeobjectid.h"
+
+class CanOpenBus;
+class ConfigurationDownload;
+class Node;
+class PDO;
+class QObject;
+
+/**
+ * @brief Computes a PDO mapping of the objects observed and commanded on the nodes of a bus
+ *
+ * Observed objects are packed in TPDOs, commanded objects in RPDOs, by first fit decreasing
+ * bit size over the PDOs available on each node. All planned PDOs are synchronous (transmitted
+ * every SYNC) and the resulting bus load is computed with the stuffed length of each frame. The
+ * plan can be reviewed before being applied with a ConfigurationDownload. Reserved PDOs and
+ * enabled PDOs mapping objects not requested to the planner are kept, objects they already map are
+ * not planned again. Other PDOs are left untouched unless disabling unused PDOs is enabled.
+ */
+class CANOPEN_EXPORT PdoMappingPlanner
+{
+public:
+    PdoMappingPlanner(CanOpenBus *bus);
+
+    void addObserved(Node *node, const NodeObjectId &objectId);
+    void addCommanded(Node *node, const NodeObjectId &objectId);
+    void reservePdo(Node *node, bool isTpdo, int pdoNumber);
+    void clear();
+
+    int syncPeriodUs() const;
+    void setSyncPeriodUs(int syncPeriodUs);
+
+    qreal loadBudget() const;
+    void setLoadBudget(qreal loadBudget);
+
+    bool isUnusedPdosDisabled() const;
+    void setUnusedPdosDisabled(bool unusedPdosDisabled);
+
+    struct PdoPlan
+    {
+        Node *node;
+        bool isTpdo;
+        int pdoNumber;
+        quint32 cobId;
+        QList<NodeObjectId> objects;
+        int bitSize;
+        qint64 frameDurationNs;
+    };
+    struct DisabledPdo
+    {
+        Node *node;
+        bool isTpdo;
+        int pdoNumber;
+        quint32 cobId;
+    };
+    struct RejectedObject
+    {
+        Node *node;
+        NodeObjectId objectId;
+        QString reason;
+    };
+    struct Plan
+    {
+        QList<PdoPlan> pdos;
+        QList<DisabledPdo> disabledPdos;  // enabled PDOs not in plan, only if unused PDOs are disabled
+        QList<RejectedObject> rejected;   // left to SDO access
+        int syncPeriodUs;
+        qint64 busTimeNs;  // per SYNC period, SYNC frame included
+        qreal busLoad;
+        qreal loadBudget;
+
+        bool isWithinBudget() const;
+        QString report() const;
+    };
+    Plan plan() const;
+
+    static ConfigurationDownload *createDownload(const Plan &plan, QObject *parent = nullptr);
+
+private:
+    CanOpenBus *_bus;
+    int _syncPeriodUs;
+    qreal _loadBudget;
+    bool _unusedPdosDisabled;
+
+    struct Request
+    {
+        Node *node;
+        NodeObjectId objectId;
+    };
+    QList<Request> _observed;
+    QList<Request> _commanded;
+
+    struct Reservation
+    {
+        Node *node;
+        bool isTpdo;
+        int pdoNumber;
+    };
+    QList<Reservation> _reserved;
+
+    void planDirection(Plan &plan, Node *node, const QList<NodeObjectId> &objects, bool isTpdo) const;
+    void planDisabledPdos(Plan &plan) const;
+    bool isReserved(Node *node, bool isTpdo, int pdoNumber) const;
+    bool isPlannable(PDO *pdo, Node *node, bool isTpdo, const QSet<quint32> &requestedKeys) const;
+    static QList<PDO *> pdosOf(Node *node, bool isTpdo);
+    static quint32 objectKey(const NodeObjectId &objectId);
+    qint64 frameDurationNs(quint32 cobId, int bitSize) const;
+    static QList<NodeObjectId> objectsOfNode(const QList<Request> &requests, Node *node);
+    static QList<Node *> nodesOf(const QList<Request> &requests);
+};
+
+#endif  // PDOMAPPINGPLANNER_H
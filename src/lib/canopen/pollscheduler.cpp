@@ -0,0 +1,497 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "pollscheduler.h"
+
+#include "canopenbus.h"
+#include "node.h"
+
+#include <QDateTime>
+#include <QEvent>
+#include <QtMath>
+
+#include <algorithm>
+
+PollScheduler::PollScheduler(CanOpenBus *bus)
+    : QObject(bus),
+      _bus(bus)
+{
+    _budget = 0;
+    _tokens = 0.0;
+    _lastRefillMs = 0;
+    _demand = 0.0;
+    for (qreal &stretch : _stretch)
+    {
+        stretch = 1.0;
+    }
+    _stretchUpdateMs = 0;
+    _stretchDirty = false;
+    resetStats();
+
+    _clock.start();
+    _wakeTimer = new QTimer(this);
+    _wakeTimer->setSingleShot(true);
+    _wakeTimer->setTimerType(Qt::PreciseTimer);
+    connect(_wakeTimer, &QTimer::timeout, this, &PollScheduler::processPolls);
+}
+
+/**
+ * @brief registers a periodic read of objectId on node for owner. Registering again the same
+ * object for the same owner updates its period and priority
+ * @param owner consumer of the value, polls are paused while owner is a hidden widget and removed
+ * when owner is destroyed
+ */
+void PollScheduler::addPoll(QObject *owner, Node *node, const NodeObjectId &objectId, int periodMs, Priority priority)
+{
+    if (owner == nullptr || node == nullptr || periodMs <= 0)
+    {
+        return;
+    }
+
+    if (!_owners.contains(owner))
+    {
+        bool active = true;
+        if (owner->isWidgetType())
+        {
+            owner->installEventFilter(this);
+            active = owner->property("visible").toBool();
+        }
+        _owners.insert(owner, active);
+        connect(owner, &QObject::destroyed, this, &PollScheduler::ownerDestroyed);
+    }
+    connect(node, &QObject::destroyed, this, &PollScheduler::nodeDestroyed, Qt::UniqueConnection);
+
+    quint32 key = pollKey(node, objectId);
+    QHash<quint32, Poll>::iterator it = _polls.find(key);
+    if (it == _polls.end())
+    {
+        Poll poll;
+        poll.node = node;
+        poll.objectId = NodeObjectId(node->busId(), node->nodeId(), objectId.index(), objectId.subIndex(), objectId.dataType());
+        poll.periodMs = 0;
+        poll.priority = PriorityLow;
+        poll.nextDueMs = 0;
+        it = _polls.insert(key, poll);
+    }
+
+    Registration registration;
+    registration.periodMs = periodMs;
+    registration.priority = priority;
+    it.value().registrations.insert(owner, registration);
+    updatePoll(it.value());
+}
+
+void PollScheduler::removePoll(QObject *owner, Node *node, const NodeObjectId &objectId)
+{
+    QHash<quint32, Poll>::iterator it = _polls.find(pollKey(node, objectId));
+    if (it == _polls.end() || !it.value().registrations.contains(owner))
+    {
+        return;
+    }
+
+    it.value().registrations.remove(owner);
+    if (it.value().registrations.isEmpty())
+    {
+        _polls.erase(it);
+        _stretchDirty = true;
+    }
+    else
+    {
+        updatePoll(it.value());
+    }
+}
+
+/**
+ * @brief removes all polls of owner
+ */
+void PollScheduler::removePolls(QObject *owner)
+{
+    if (!_owners.contains(owner))
+    {
+        return;
+    }
+
+    if (owner->isWidgetType())
+    {
+        owner->removeEventFilter(this);
+    }
+    disconnect(owner, &QObject::destroyed, this, &PollScheduler::ownerDestroyed);
+    removeRegistrations(owner);
+}
+
+bool PollScheduler::isOwnerActive(QObject *owner) const
+{
+    return _owners.value(owner, false);
+}
+
+/**
+ * @brief pauses or resumes polls of owner, called automatically on show and hide for widgets
+ */
+void PollScheduler::setOwnerActive(QObject *owner, bool active)
+{
+    QHash<QObject *, bool>::iterator ownerIt = _owners.find(owner);
+    if (ownerIt == _owners.end() || ownerIt.value() == active)
+    {
+        return;
+    }
+
+    ownerIt.value() = active;
+    for (Poll &poll : _polls)
+    {
+        if (poll.registrations.contains(owner))
+        {
+            updatePoll(poll);
+        }
+    }
+}
+
+int PollScheduler::budget() const
+{
+    return _budget;
+}
+
+/**
+ * @brief sets the budget of SDO reads per second shared by all polls, 0 for unlimited (default)
+ */
+void PollScheduler::setBudget(int readsPerSecond)
+{
+    _budget = qMax(0, readsPerSecond);
+    _stretchDirty = true;
+    scheduleWake(0);
+}
+
+int PollScheduler::pollCount() const
+{
+    return _polls.count();
+}
+
+int PollScheduler::activePollCount() const
+{
+    int count = 0;
+    for (const Poll &poll : _polls)
+    {
+        if (poll.periodMs > 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief SDO reads per second requested by active polls not refreshed by PDO
+ */
+qreal PollScheduler::demand() const
+{
+    return _demand;
+}
+
+/**
+ * @brief current period multiplier of polls of priority, 1.0 when the budget is not exceeded
+ */
+qreal PollScheduler::stretch(Priority priority) const
+{
+    return _stretch[priority];
+}
+
+/**
+ * @brief period actually applied to objectId on node, 0 if not polled or paused
+ */
+int PollScheduler::effectivePeriod(Node *node, const NodeObjectId &objectId) const
+{
+    QHash<quint32, Poll>::const_iterator it = _polls.constFind(pollKey(node, objectId));
+    if (it == _polls.constEnd() || it.value().periodMs == 0)
+    {
+        return 0;
+    }
+    return qRound(it.value().periodMs * _stretch[it.value().priority]);
+}
+
+const PollScheduler::Stats &PollScheduler::stats() const
+{
+    return _stats;
+}
+
+void PollScheduler::resetStats()
+{
+    _stats.readCount = 0;
+    _stats.pdoSkipCount = 0;
+    _stats.freshSkipCount = 0;
+    _stats.deferredCount = 0;
+}
+
+bool PollScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Show)
+    {
+        setOwnerActive(watched, true);
+    }
+    else if (event->type() == QEvent::Hide)
+    {
+        setOwnerActive(watched, false);
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void PollScheduler::processPolls()
+{
+    qint64 now = _clock.elapsed();
+    if (_stretchDirty || now - _stretchUpdateMs >= STRETCH_UPDATE_MS)
+    {
+        // PDO and node states change without notice, stretch is updated periodically
+        updateStretch();
+        _stretchUpdateMs = now;
+    }
+
+    if (_budget > 0)
+    {
+        _tokens += static_cast<qreal>(now - _lastRefillMs) * _budget / 1000.0;
+        _tokens = qMin(_tokens, qMax(1.0, _budget / 10.0));
+    }
+    _lastRefillMs = now;
+
+    QList<Poll *> duePolls;
+    for (Poll &poll : _polls)
+    {
+        if (poll.periodMs > 0 && poll.nextDueMs <= now)
+        {
+            duePolls.append(&poll);
+        }
+    }
+    std::sort(duePolls.begin(), duePolls.end(), [](const Poll *a, const Poll *b) {
+        if (a->priority != b->priority)
+        {
+            return a->priority > b->priority;
+        }
+        return a->nextDueMs < b->nextDueMs;
+    });
+
+    bool congested = _bus->txScheduler()->isCongested(TxScheduler::LaneSdo);
+    bool deferred = false;
+    QDateTime currentDateTime = QDateTime::currentDateTime();
+    for (int i = 0; i < duePolls.count(); i++)
+    {
+        Poll *poll = duePolls.at(i);
+        qint64 periodMs = qRound64(poll->periodMs * _stretch[poll->priority]);
+
+        Node::Status status = poll->node->status();
+        if (status != Node::PREOP && status != Node::STARTED)
+        {
+            poll->nextDueMs = now + periodMs;
+            continue;
+        }
+
+        if (poll->node->isReadByPdo(poll->objectId))
+        {
+            _stats.pdoSkipCount++;
+            poll->nextDueMs = now + periodMs;
+            continue;
+        }
+
+        // value updated recently by another consumer, an event TPDO or a write
+        QDateTime lastModification = poll->node->nodeOd()->lastModification(poll->objectId);
+        if (lastModification.isValid())
+        {
+            qint64 age = lastModification.msecsTo(currentDateTime);
+            if (age >= 0 && age < periodMs / 2)
+            {
+                _stats.freshSkipCount++;
+                poll->nextDueMs = now + periodMs - age;
+                continue;
+            }
+        }
+
+        if (congested || (_budget > 0 && _tokens < 1.0))
+        {
+            // remaining polls keep their due time and are served first on next wake
+            _stats.deferredCount += static_cast<quint64>(duePolls.count() - i);
+            deferred = true;
+            break;
+        }
+
+        poll->node->readObject(poll->objectId);
+        _tokens -= 1.0;
+        _stats.readCount++;
+        poll->nextDueMs += periodMs;
+        if (poll->nextDueMs <= now)
+        {
+            poll->nextDueMs = now + periodMs;
+        }
+    }
+
+    if (deferred)
+    {
+        if (congested || _budget == 0)
+        {
+            scheduleWake(CONGESTION_RETRY_MS);
+        }
+        else
+        {
+            scheduleWake(qMax(1, qCeil((1.0 - _tokens) * 1000.0 / _budget)));
+        }
+        return;
+    }
+
+    qint64 nextDueMs = -1;
+    for (const Poll &poll : qAsConst(_polls))
+    {
+        if (poll.periodMs > 0 && (nextDueMs < 0 || poll.nextDueMs < nextDueMs))
+        {
+            nextDueMs = poll.nextDueMs;
+        }
+    }
+    if (nextDueMs >= 0)
+    {
+        scheduleWake(qMax<qint64>(0, nextDueMs - now));
+    }
+}
+
+void PollScheduler::ownerDestroyed(QObject *owner)
+{
+    removeRegistrations(owner);
+}
+
+void PollScheduler::nodeDestroyed(QObject *node)
+{
+    QHash<quint32, Poll>::iterator it = _polls.begin();
+    while (it != _polls.end())
+    {
+        if (static_cast<QObject *>(it.value().node) == node)
+        {
+            it = _polls.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    _stretchDirty = true;
+}
+
+quint32 PollScheduler::pollKey(Node *node, const NodeObjectId &objectId)
+{
+    return (static_cast<quint32>(node->nodeId()) << 24) | (static_cast<quint32>(objectId.index()) << 8) | objectId.subIndex();
+}
+
+/**
+ * @brief updates period and priority of poll from its active owners
+ */
+void PollScheduler::updatePoll(Poll &poll)
+{
+    int periodMs = 0;
+    Priority priority = PriorityLow;
+    for (QHash<QObject *, Registration>::const_iterator it = poll.registrations.cbegin(); it != poll.registrations.cend(); ++it)
+    {
+        if (!_owners.value(it.key(), false))
+        {
+            continue;
+        }
+        if (periodMs == 0 || it.value().periodMs < periodMs)
+        {
+            periodMs = it.value().periodMs;
+        }
+        priority = qMax(priority, it.value().priority);
+    }
+
+    if (poll.periodMs == 0 && periodMs != 0)
+    {
+        // new or resumed poll, read as soon as possible
+        poll.nextDueMs = _clock.elapsed();
+    }
+    poll.periodMs = periodMs;
+    poll.priority = priority;
+    _stretchDirty = true;
+    scheduleWake(0);
+}
+
+void PollScheduler::removeRegistrations(QObject *owner)
+{
+    _owners.remove(owner);
+
+    QHash<quint32, Poll>::iterator it = _polls.begin();
+    while (it != _polls.end())
+    {
+        if (it.value().registrations.remove(owner) == 0)
+        {
+            ++it;
+            continue;
+        }
+
+        if (it.value().registrations.isEmpty())
+        {
+            it = _polls.erase(it);
+        }
+        else
+        {
+            updatePoll(it.value());
+            ++it;
+        }
+    }
+    _stretchDirty = true;
+}
+
+/**
+ * @brief shares the budget between priorities, from the highest to the lowest. Periods of a
+ * priority which does not fit in the remaining budget are stretched, up to STRETCH_MAX
+ */
+void PollScheduler::updateStretch()
+{
+    qreal demand[PriorityCount] = {0.0, 0.0, 0.0};
+    _demand = 0.0;
+    for (const Poll &poll : qAsConst(_polls))
+    {
+        if (poll.periodMs > 0 && !poll.node->isReadByPdo(poll.objectId))
+        {
+            demand[poll.priority] += 1000.0 / poll.periodMs;
+            _demand += 1000.0 / poll.periodMs;
+        }
+    }
+
+    bool changed = false;
+    qreal remaining = _budget;
+    for (int priority = PriorityCount - 1; priority >= 0; priority--)
+    {
+        qreal stretch = 1.0;
+        if (_budget > 0 && demand[priority] > remaining)
+        {
+            stretch = (remaining > 0.0) ? qMin<qreal>(demand[priority] / remaining, STRETCH_MAX) : STRETCH_MAX;
+        }
+        remaining = qMax(0.0, remaining - demand[priority] / stretch);
+
+        if (!qFuzzyCompare(stretch, _stretch[priority]))
+        {
+            _stretch[priority] = stretch;
+            changed = true;
+        }
+    }
+    _stretchDirty = false;
+
+    if (changed)
+    {
+        emit stretchChanged();
+    }
+}
+
+void PollScheduler::scheduleWake(qint64 delayMs)
+{
+    if (_wakeTimer->isActive() && _wakeTimer->remainingTime() <= delayMs)
+    {
+        return;
+    }
+    _wakeTimer->start(static_cast<int>(delayMs));
+}
@@ -0,0 +1,141 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
+
+#include "nodeobjectid.h"
+
+class CanOpenBus;
+class Node;
+
+/**
+ * @brief Periodic SDO polling of node objects, shared by all consumers of a bus
+ *
+ * Consumers register objects with a period and a priority. An object requested by several
+ * consumers is read once at the shortest period. Objects refreshed by a running TPDO, or recently
+ * updated by any other way, are not read. When a budget of SDO reads per second is set and the
+ * total demand exceeds it, periods are stretched starting from the lowest priority. Polls of a
+ * widget owner are paused while the widget is hidden.
+ */
+class CANOPEN_EXPORT PollScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    PollScheduler(CanOpenBus *bus);
+
+    enum Priority
+    {
+        PriorityLow,
+        PriorityNormal,
+        PriorityHigh,
+        PriorityCount
+    };
+
+    void addPoll(QObject *owner, Node *node, const NodeObjectId &objectId, int periodMs, Priority priority = PriorityNormal);
+    void removePoll(QObject *owner, Node *node, const NodeObjectId &objectId);
+    void removePolls(QObject *owner);
+
+    bool isOwnerActive(QObject *owner) const;
+    void setOwnerActive(QObject *owner, bool active);
+
+    int budget() const;
+    void setBudget(int readsPerSecond);
+
+    int pollCount() const;
+    int activePollCount() const;
+    qreal demand() const;
+    qreal stretch(Priority priority) const;
+    int effectivePeriod(Node *node, const NodeObjectId &objectId) const;
+
+    struct Stats
+    {
+        quint64 readCount;
+        quint64 pdoSkipCount;
+        quint64 freshSkipCount;
+        quint64 deferredCount;
+    };
+    const Stats &stats() const;
+    void resetStats();
+
+signals:
+    void stretchChanged();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+protected slots:
+    void processPolls();
+    void ownerDestroyed(QObject *owner);
+    void nodeDestroyed(QObject *node);
+
+private:
+    enum
+    {
+        STRETCH_MAX = 16,
+        STRETCH_UPDATE_MS = 500,
+        CONGESTION_RETRY_MS = 5
+    };
+
+    struct Registration
+    {
+        int periodMs;
+        Priority priority;
+    };
+    struct Poll
+    {
+        Node *node;
+        NodeObjectId objectId;
+        QHash<QObject *, Registration> registrations;
+        int periodMs;  // shortest period of active owners, 0 if paused
+        Priority priority;
+        qint64 nextDueMs;
+    };
+
+    CanOpenBus *_bus;
+    QHash<quint32, Poll> _polls;
+    QHash<QObject *, bool> _owners;
+
+    int _budget;  // SDO reads per second, 0 for unlimited
+    qreal _tokens;
+    qint64 _lastRefillMs;
+    qreal _demand;
+    qreal _stretch[PriorityCount];
+    qint64 _stretchUpdateMs;
+    bool _stretchDirty;
+    Stats _stats;
+
+    QElapsedTimer _clock;
+    QTimer *_wakeTimer;
+
+    static quint32 pollKey(Node *node, const NodeObjectId &objectId);
+    void updatePoll(Poll &poll);
+    void removeRegistrations(QObject *owner);
+    void updateStretch();
+    void scheduleWake(qint64 delayMs);
+};
+
+#endif  // POLLSCHEDULER_H
@@ -0,0 +1,251 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "axisgroup.h"
+
+#include "canopenbus.h"
+#include "mode.h"
+#include "node.h"
+#include "nodeprofile402.h"
+
+AxisGroup::AxisGroup(CanOpenBus *bus, QObject *parent)
+    : QObject(parent)
+{
+    _bus = bus;
+    _hasPendingTargets = false;
+    _stats = Stats();
+
+    connect(_bus->sync(), &Sync::commitBeforeSync, this, &AxisGroup::commit);
+    connect(_bus->sync(), &Sync::syncEmitted, this, &AxisGroup::checkSent);
+}
+
+AxisGroup::~AxisGroup()
+{
+}
+
+CanOpenBus *AxisGroup::bus() const
+{
+    return _bus;
+}
+
+/**
+ * @brief adds an axis to the group, the node of the axis has to be on the group bus
+ */
+void AxisGroup::addAxis(NodeProfile402 *axis)
+{
+    if (axis == nullptr || _axes.contains(axis) || axis->node()->bus() != _bus)
+    {
+        return;
+    }
+
+    _axes.append(axis);
+    _targets.append({0, false});
+    connect(axis, &QObject::destroyed, this, &AxisGroup::removeDestroyedAxis);
+}
+
+void AxisGroup::removeAxis(NodeProfile402 *axis)
+{
+    int axisId = _axes.indexOf(axis);
+    if (axisId < 0)
+    {
+        return;
+    }
+
+    disconnect(axis, &QObject::destroyed, this, &AxisGroup::removeDestroyedAxis);
+    _axes.removeAt(axisId);
+    _targets.remove(axisId);
+    for (int i = _committed.size() - 1; i >= 0; i--)
+    {
+        if (_committed.at(i).axis == axis)
+        {
+            _committed.removeAt(i);
+        }
+    }
+}
+
+const QList<NodeProfile402 *> &AxisGroup::axes() const
+{
+    return _axes;
+}
+
+int AxisGroup::axisCount() const
+{
+    return _axes.count();
+}
+
+/**
+ * @brief sets the target of one axis of the group for the next SYNC, a newer target
+ * of the same axis replaces the held one until commit
+ */
+void AxisGroup::setTarget(NodeProfile402 *axis, qint32 target)
+{
+    int axisId = _axes.indexOf(axis);
+    if (axisId < 0)
+    {
+        return;
+    }
+
+    if (_bus->sync()->status() != Sync::STARTED)
+    {
+        axis->setTarget(target);
+        miss(axis, MissSyncStopped);
+        return;
+    }
+
+    _targets[axisId] = {target, true};
+    _hasPendingTargets = true;
+}
+
+/**
+ * @brief sets the targets of all axes for the next SYNC, in axes() order
+ */
+void AxisGroup::setTargets(const QList<qint32> &targets)
+{
+    int count = qMin(targets.count(), _axes.count());
+    for (int axisId = 0; axisId < count; axisId++)
+    {
+        setTarget(_axes.at(axisId), targets.at(axisId));
+    }
+}
+
+bool AxisGroup::hasPendingTargets() const
+{
+    return _hasPendingTargets;
+}
+
+/**
+ * @brief returns true if a target of this axis is sent with a RPDO on the SYNC,
+ * the axis node has to be started and the current mode target mapped in an enabled RPDO
+ */
+bool AxisGroup::isSyncCoherent(NodeProfile402 *axis) const
+{
+    return (axis->node()->status() == Node::STARTED) && (rpdoCobId(axis) != 0);
+}
+
+const AxisGroup::Stats &AxisGroup::stats() const
+{
+    return _stats;
+}
+
+void AxisGroup::resetStats()
+{
+    _stats = Stats();
+}
+
+/**
+ * @brief writes all held targets in RPDOs on the commit phase, RPDOs are sent right after in the same TX batch
+ */
+void AxisGroup::commit()
+{
+    if (!_hasPendingTargets)
+    {
+        return;
+    }
+    _hasPendingTargets = false;
+
+    for (int axisId = 0; axisId < _axes.count(); axisId++)
+    {
+        PendingTarget &pendingTarget = _targets[axisId];
+        if (!pendingTarget.pending)
+        {
+            continue;
+        }
+        pendingTarget.pending = false;
+
+        NodeProfile402 *axis = _axes.at(axisId);
+        if (axis->node()->status() != Node::STARTED || axis->actualMode() == NodeProfile402::NoMode)
+        {
+            miss(axis, MissNotStarted);
+            continue;
+        }
+
+        quint32 cobId = rpdoCobId(axis);
+        axis->setTarget(pendingTarget.target);
+        if (cobId == 0)
+        {
+            miss(axis, MissNotMapped);
+            continue;
+        }
+        _committed.append({axis, cobId});
+        _stats.setpoints++;
+    }
+
+    _stats.commits++;
+    emit committed();
+}
+
+/**
+ * @brief on SYNC, reports committed setpoints whose RPDO frame has not left the TX queue before it
+ */
+void AxisGroup::checkSent()
+{
+    if (_committed.isEmpty())
+    {
+        return;
+    }
+
+    TxScheduler *txScheduler = _bus->txScheduler();
+    for (const CommittedSetpoint &setpoint : qAsConst(_committed))
+    {
+        if (txScheduler->isFramePending(setpoint.cobId))
+        {
+            miss(setpoint.axis, MissLate);
+        }
+    }
+    _committed.clear();
+}
+
+void AxisGroup::removeDestroyedAxis(QObject *object)
+{
+    for (NodeProfile402 *axis : qAsConst(_axes))
+    {
+        if (axis == object)
+        {
+            removeAxis(axis);
+            return;
+        }
+    }
+}
+
+quint32 AxisGroup::rpdoCobId(NodeProfile402 *axis) const
+{
+    if (axis->actualMode() == NodeProfile402::NoMode)
+    {
+        return 0;
+    }
+    Mode *mode = axis->mode(axis->actualMode());
+    if (mode == nullptr || !mode->targetObjectId().isASubIndex())
+    {
+        return 0;
+    }
+
+    for (RPDO *rpdo : axis->node()->rpdos())
+    {
+        if (rpdo->isEnabled() && rpdo->isMappedObject(mode->targetObjectId()))
+        {
+            return rpdo->cobId();
+        }
+    }
+    return 0;
+}
+
+void AxisGroup::miss(NodeProfile402 *axis, MissReason reason)
+{
+    _stats.missed++;
+    emit setpointMissed(axis, reason);
+}
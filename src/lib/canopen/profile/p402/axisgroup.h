@@ -0,0 +1,107 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef AXISGROUP_H
+#define AXISGROUP_H
+
+#include "canopen_global.h"
+
+#include <QList>
+#include <QObject>
+#include <QVector>
+
+class CanOpenBus;
+class NodeProfile402;
+
+/**
+ * @brief Group of 402 axes, possibly on different nodes of a bus, whose targets are applied on the same SYNC
+ *
+ * Targets set on the group are held and committed together in the RPDOs of all axes on the
+ * commitBeforeSync() phase of the bus SYNC, RPDOs then send them in one TX batch before the SYNC.
+ */
+class CANOPEN_EXPORT AxisGroup : public QObject
+{
+    Q_OBJECT
+public:
+    AxisGroup(CanOpenBus *bus, QObject *parent = nullptr);
+    ~AxisGroup() override;
+
+    CanOpenBus *bus() const;
+
+    void addAxis(NodeProfile402 *axis);
+    void removeAxis(NodeProfile402 *axis);
+    const QList<NodeProfile402 *> &axes() const;
+    int axisCount() const;
+
+    void setTarget(NodeProfile402 *axis, qint32 target);
+    void setTargets(const QList<qint32> &targets);
+    bool hasPendingTargets() const;
+
+    bool isSyncCoherent(NodeProfile402 *axis) const;
+
+    enum MissReason
+    {
+        MissNotStarted,   // node not started or axis without mode, target not written
+        MissNotMapped,    // target not mapped in an enabled RPDO, written with SDO out of SYNC
+        MissSyncStopped,  // no SYNC running, target written immediately
+        MissLate          // RPDO frame still in TX queue when the SYNC was sent
+    };
+
+    struct Stats
+    {
+        quint32 commits;
+        quint32 setpoints;
+        quint32 missed;
+    };
+    const Stats &stats() const;
+    void resetStats();
+
+signals:
+    void committed();
+    void setpointMissed(NodeProfile402 *axis, AxisGroup::MissReason reason);
+
+protected slots:
+    void commit();
+    void checkSent();
+    void removeDestroyedAxis(QObject *object);
+
+private:
+    CanOpenBus *_bus;
+    QList<NodeProfile402 *> _axes;
+
+    struct PendingTarget
+    {
+        qint32 target;
+        bool pending;
+    };
+    QVector<PendingTarget> _targets;
+
+    struct CommittedSetpoint
+    {
+        NodeProfile402 *axis;
+        quint32 cobId;
+    };
+    QList<CommittedSetpoint> _committed;
+    bool _hasPendingTargets;
+    Stats _stats;
+
+    quint32 rpdoCobId(NodeProfile402 *axis) const;
+    void miss(NodeProfile402 *axis, MissReason reason);
+};
+
+#endif  // AXISGROUP_H
@@ -0,0 +1,401 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "iptrajectorystreamer.h"
+
+#include "canopenbus.h"
+#include "modeip.h"
+#include "node.h"
+#include "nodeprofile402.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+enum
+{
+    SENT_RING_SIZE = 64,
+    LOOKAHEAD_MAX = SENT_RING_SIZE / 2
+};
+
+IpTrajectoryStreamer::IpTrajectoryStreamer(NodeProfile402 *nodeProfile402, QObject *parent)
+    : QObject(parent)
+{
+    _nodeProfile402 = nodeProfile402;
+    _modeIp = dynamic_cast<ModeIp *>(_nodeProfile402->mode(NodeProfile402::OperationMode::IP));
+
+    _durationUs = 0;
+    _pointCursor = 0;
+    _lookahead = 1;
+    _feedbackDelay = 1;
+    _status = Idle;
+    _periodUs = 0;
+    _rpdoStreaming = false;
+    _nextSetpoint = 0;
+    _lastSetpoint = -1;
+    _sdoInFlight = 0;
+    _sent.resize(SENT_RING_SIZE);
+    _squareErrorSum = 0.0;
+    _stats = Stats();
+
+    setNodeInterrest(_nodeProfile402->node());
+    if (_modeIp != nullptr)
+    {
+        registerObjId(_modeIp->targetObjectId());
+        registerObjId(_modeIp->positionActualValueObjectId());
+    }
+}
+
+IpTrajectoryStreamer::~IpTrajectoryStreamer()
+{
+    if (_status == Streaming)
+    {
+        disconnect(_nodeProfile402->node()->bus()->sync(), nullptr, this, nullptr);
+    }
+}
+
+/**
+ * @brief sets the path as a list of (time, position) points, linearly interpolated at each SYNC,
+ * times must be increasing and the first point is taken at start
+ */
+void IpTrajectoryStreamer::setPath(const QList<PathPoint> &points)
+{
+    if (_status == Streaming)
+    {
+        return;
+    }
+    _path = nullptr;
+    _points = points;
+    _durationUs = _points.isEmpty() ? 0 : _points.last().timeUs;
+}
+
+/**
+ * @brief sets the path as a function of the time in us since start, evaluated once per SYNC up to durationUs
+ */
+void IpTrajectoryStreamer::setPath(const std::function<qint32(qint64)> &path, qint64 durationUs)
+{
+    if (_status == Streaming)
+    {
+        return;
+    }
+    _points.clear();
+    _path = path;
+    _durationUs = durationUs;
+}
+
+qint64 IpTrajectoryStreamer::durationUs() const
+{
+    return _durationUs;
+}
+
+int IpTrajectoryStreamer::lookahead() const
+{
+    return _lookahead;
+}
+
+/**
+ * @brief number of setpoints kept in advance in the device buffer when streaming with SDO,
+ * a mapped RPDO holds only one setpoint per SYNC
+ */
+void IpTrajectoryStreamer::setLookahead(int cycles)
+{
+    _lookahead = qBound(1, cycles, static_cast<int>(LOOKAHEAD_MAX));
+}
+
+int IpTrajectoryStreamer::feedbackDelay() const
+{
+    return _feedbackDelay;
+}
+
+/**
+ * @brief number of SYNC between the device consuming a setpoint and the position actual value feedback
+ * reflecting it, used to align following error computation
+ */
+void IpTrajectoryStreamer::setFeedbackDelay(int cycles)
+{
+    _feedbackDelay = qBound(0, cycles, static_cast<int>(LOOKAHEAD_MAX));
+}
+
+IpTrajectoryStreamer::Status IpTrajectoryStreamer::status() const
+{
+    return _status;
+}
+
+qint64 IpTrajectoryStreamer::periodUs() const
+{
+    return _periodUs;
+}
+
+bool IpTrajectoryStreamer::isRpdoStreaming() const
+{
+    return _rpdoStreaming;
+}
+
+const IpTrajectoryStreamer::Stats &IpTrajectoryStreamer::stats() const
+{
+    return _stats;
+}
+
+/**
+ * @brief encodes periodUs as interpolation time period units * 10^index s
+ * @return false if the period cannot be represented with an 8 bits units value
+ */
+bool IpTrajectoryStreamer::timePeriodEncoding(qint64 periodUs, quint8 *units, qint8 *index)
+{
+    if (periodUs <= 0)
+    {
+        return false;
+    }
+
+    qint64 scaleUs = 1000;  // 10^-3 s
+    for (qint8 periodIndex = -3; periodIndex >= -6; periodIndex--)
+    {
+        if ((periodUs % scaleUs) == 0 && (periodUs / scaleUs) <= 255)
+        {
+            *units = static_cast<quint8>(periodUs / scaleUs);
+            *index = periodIndex;
+            return true;
+        }
+        scaleUs /= 10;
+    }
+    return false;
+}
+
+/**
+ * @brief starts streaming on the SYNC currently produced on the bus, the interpolation time period
+ * is set to the SYNC period, the device buffer is cleared and primed before enabling interpolation
+ * @return false if the axis has no IP mode, no path is set, the node is not started or no SYNC is running
+ */
+bool IpTrajectoryStreamer::start()
+{
+    Node *node = _nodeProfile402->node();
+    if (_status == Streaming || _modeIp == nullptr)
+    {
+        return false;
+    }
+    if ((!_path && _points.isEmpty()) || node->status() != Node::STARTED)
+    {
+        return false;
+    }
+
+    Sync *sync = node->bus()->sync();
+    if (sync->syncPeriod() <= 0)
+    {
+        return false;
+    }
+
+    _periodUs = static_cast<qint64>(sync->syncPeriod()) * 1000;
+    _rpdoStreaming = (node->rpdoMappedObject(_modeIp->targetObjectId()) != nullptr);
+    _pointCursor = 0;
+    _nextSetpoint = 0;
+    _lastSetpoint = (_durationUs + _periodUs - 1) / _periodUs;
+    _sdoInFlight = 0;
+    _squareErrorSum = 0.0;
+    _stats = Stats();
+
+    writeTimePeriod();
+    _modeIp->bufferClear();
+    node->writeObject(_modeIp->bufferClearObjectId(), QVariant(static_cast<quint8>(1)));
+    if (_nodeProfile402->actualMode() != NodeProfile402::OperationMode::IP)
+    {
+        _nodeProfile402->setMode(NodeProfile402::OperationMode::IP);
+    }
+
+    fillSetpoints();
+    _modeIp->setEnableRamp(true);
+
+    connect(sync, &Sync::syncEmitted, this, &IpTrajectoryStreamer::sync);
+    _status = Streaming;
+    emit started();
+    return true;
+}
+
+/**
+ * @brief stops streaming and disables interpolation, the axis holds its last setpoint
+ */
+void IpTrajectoryStreamer::stop()
+{
+    if (_status != Streaming)
+    {
+        return;
+    }
+    end(Aborted);
+}
+
+void IpTrajectoryStreamer::sync()
+{
+    if (_status != Streaming)
+    {
+        return;
+    }
+
+    if (_nodeProfile402->currentState() == NodeProfile402::STATE_Fault)
+    {
+        end(Aborted);
+        return;
+    }
+
+    // setpoint _stats.syncCount - 1 was consumed by the device on this SYNC
+    _stats.syncCount++;
+    if (static_cast<qint64>(_stats.syncCount) > _lastSetpoint + _feedbackDelay)
+    {
+        end(Finished);
+        return;
+    }
+
+    // the device consumes setpoint syncCount - 1 now, a setpoint still held behind the SDO queue
+    // would be consumed late and shift the rest of the path
+    if (_nextSetpoint <= _lastSetpoint && _nextSetpoint < static_cast<qint64>(_stats.syncCount))
+    {
+        end(Aborted);
+        return;
+    }
+
+    fillSetpoints();
+}
+
+qint32 IpTrajectoryStreamer::positionAt(qint64 timeUs)
+{
+    if (_path)
+    {
+        return _path(qMin(timeUs, _durationUs));
+    }
+
+    // setpoints are evaluated at increasing times, the cursor only moves forward
+    while (_pointCursor + 1 < _points.size() && _points.at(_pointCursor + 1).timeUs <= timeUs)
+    {
+        _pointCursor++;
+    }
+
+    const PathPoint &from = _points.at(_pointCursor);
+    if (_pointCursor + 1 >= _points.size() || timeUs <= from.timeUs)
+    {
+        return from.position;
+    }
+
+    const PathPoint &to = _points.at(_pointCursor + 1);
+    qreal ratio = static_cast<qreal>(timeUs - from.timeUs) / static_cast<qreal>(to.timeUs - from.timeUs);
+    return from.position + qRound(ratio * (static_cast<qreal>(to.position) - from.position));
+}
+
+/**
+ * @brief sends setpoints up to the lookahead, with SDO the next setpoint is held while the SDO queue
+ * is full and sent as soon as a write completes
+ */
+void IpTrajectoryStreamer::fillSetpoints()
+{
+    qint64 ahead = static_cast<qint64>(_stats.syncCount) + (_rpdoStreaming ? 1 : _lookahead);
+    while (_nextSetpoint <= _lastSetpoint && _nextSetpoint < ahead)
+    {
+        if (!_rpdoStreaming && _sdoInFlight >= _lookahead)
+        {
+            _stats.sdoHeld++;
+            return;
+        }
+        sendSetpoint();
+    }
+}
+
+void IpTrajectoryStreamer::sendSetpoint()
+{
+    qint32 setpoint = positionAt(_nextSetpoint * _periodUs);
+    _sent[static_cast<int>(_nextSetpoint % SENT_RING_SIZE)] = setpoint;
+    _nextSetpoint++;
+
+    if (_rpdoStreaming)
+    {
+        _stats.rpdoSetpoints++;
+    }
+    else
+    {
+        _sdoInFlight++;
+        _stats.sdoSetpoints++;
+    }
+    _modeIp->setTarget(setpoint);
+}
+
+void IpTrajectoryStreamer::writeTimePeriod()
+{
+    quint8 units;
+    qint8 index;
+    if (!timePeriodEncoding(_periodUs, &units, &index))
+    {
+        return;
+    }
+
+    Node *node = _nodeProfile402->node();
+    node->writeObject(_modeIp->timePeriodUnitsObjectId(), QVariant(units));
+    node->writeObject(_modeIp->timePeriodIndexObjectId(), QVariant(index));
+}
+
+void IpTrajectoryStreamer::end(Status status)
+{
+    disconnect(_nodeProfile402->node()->bus()->sync(), nullptr, this, nullptr);
+    _modeIp->setEnableRamp(false);
+    _status = status;
+    if (status == Finished)
+    {
+        emit finished();
+    }
+    else
+    {
+        emit aborted();
+    }
+}
+
+void IpTrajectoryStreamer::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+{
+    if (_modeIp == nullptr || _status != Streaming)
+    {
+        return;
+    }
+
+    if (objId == _modeIp->targetObjectId())
+    {
+        if (!_rpdoStreaming && (flags & (NodeOd::Write | NodeOd::Error)) != 0 && _sdoInFlight > 0)
+        {
+            _sdoInFlight--;
+            if ((flags & NodeOd::Error) != 0)
+            {
+                _stats.sdoErrors++;
+            }
+            fillSetpoints();
+        }
+        return;
+    }
+
+    // feedback is expected from a TPDO, SDO reads are accepted as well
+    if (objId == _modeIp->positionActualValueObjectId() && (flags & (NodeOd::Read | NodeOd::Pdo)) != 0 && (flags & NodeOd::Error) == 0)
+    {
+        qint64 setpoint = static_cast<qint64>(_stats.syncCount) - 1 - _feedbackDelay;
+        if (setpoint < 0 || setpoint >= _nextSetpoint || setpoint <= _nextSetpoint - SENT_RING_SIZE)
+        {
+            return;
+        }
+
+        qint32 actual = _nodeProfile402->node()->nodeOd()->value(objId).toInt();
+        qint32 followingError = _sent.at(static_cast<int>(setpoint % SENT_RING_SIZE)) - actual;
+
+        _stats.feedbackSamples++;
+        _stats.followingError = followingError;
+        _stats.maxFollowingError = qMax(_stats.maxFollowingError, qAbs(followingError));
+        _squareErrorSum += static_cast<qreal>(followingError) * followingError;
+        _stats.rmsFollowingError = qSqrt(_squareErrorSum / _stats.feedbackSamples);
+        emit followingErrorUpdated(followingError);
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef IPTRAJECTORYSTREAMER_H
+#define IPTRAJECTORYSTREAMER_H
+
+#include "canopen_global.h"
+
+#include "nodeodsubscriber.h"
+
+#include <QList>
+#include <QObject>
+#include <QVector>
+
+#include <functional>
+
+class ModeIp;
+class NodeProfile402;
+
+/**
+ * @brief Streams a time-parameterised position path to a 402 axis in interpolated position mode,
+ * one setpoint per SYNC, and tracks the following error on the position actual value feedback
+ */
+class CANOPEN_EXPORT IpTrajectoryStreamer : public QObject, public NodeOdSubscriber
+{
+    Q_OBJECT
+public:
+    IpTrajectoryStreamer(NodeProfile402 *nodeProfile402, QObject *parent = nullptr);
+    ~IpTrajectoryStreamer() override;
+
+    struct PathPoint
+    {
+        qint64 timeUs;
+        qint32 position;
+    };
+
+    void setPath(const QList<PathPoint> &points);
+    void setPath(const std::function<qint32(qint64)> &path, qint64 durationUs);
+    qint64 durationUs() const;
+
+    int lookahead() const;
+    void setLookahead(int cycles);
+
+    int feedbackDelay() const;
+    void setFeedbackDelay(int cycles);
+
+    enum Status
+    {
+        Idle,
+        Streaming,
+        Finished,
+        Aborted
+    };
+    Status status() const;
+
+    qint64 periodUs() const;
+    bool isRpdoStreaming() const;
+
+    struct Stats
+    {
+        quint32 syncCount;
+        quint32 rpdoSetpoints;
+        quint32 sdoSetpoints;
+        quint32 sdoHeld;
+        quint32 sdoErrors;
+        quint32 feedbackSamples;
+        qint32 followingError;
+        qint32 maxFollowingError;
+        qreal rmsFollowingError;
+    };
+    const Stats &stats() const;
+
+    static bool timePeriodEncoding(qint64 periodUs, quint8 *units, qint8 *index);
+
+public slots:
+    bool start();
+    void stop();
+
+signals:
+    void started();
+    void finished();
+    void aborted();
+    void followingErrorUpdated(qint32 followingError);
+
+protected slots:
+    void sync();
+
+protected:
+    NodeProfile402 *_nodeProfile402;
+    ModeIp *_modeIp;
+
+    QList<PathPoint> _points;
+    std::function<qint32(qint64)> _path;
+    qint64 _durationUs;
+    int _pointCursor;
+
+    int _lookahead;
+    int _feedbackDelay;
+    Status _status;
+    qint64 _periodUs;
+    bool _rpdoStreaming;
+
+    qint64 _nextSetpoint;
+    qint64 _lastSetpoint;
+    int _sdoInFlight;
+
+    // ring of the last sent setpoints, indexed by setpoint number
+    QVector<qint32> _sent;
+    qreal _squareErrorSum;
+    Stats _stats;
+
+    qint32 positionAt(qint64 timeUs);
+    void fillSetpoints();
+    void sendSetpoint();
+    void writeTimePeriod();
+    void end(Status status);
+
+    // NodeOdSubscriber interface
+public:
+    void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) override;
+};
+
+#endif  // IPTRAJECTORYSTREAMER_H
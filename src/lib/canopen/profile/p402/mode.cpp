@@ -31,8 +31,28 @@ Mode::Mode(NodeProfile402 *nodeProfile402)
     _controlWordObjectId.setBusIdNodeId(_nodeProfile402->busId(), _nodeProfile402->nodeId());
 }
 
+/**
+ * @brief object written by setTarget(), invalid for modes without target
+ */
+const NodeObjectId &Mode::targetObjectId() const
+{
+    return _targetObjectId;
+}
+
+/**
+ * @brief objects refreshed periodically while the mode is active
+ */
+QList<NodeObjectId> Mode::realTimeObjects() const
+{
+    return QList<NodeObjectId>();
+}
+
 void Mode::readRealTimeObjects()
 {
+    for (const NodeObjectId &objectId : realTimeObjects())
+    {
+        _nodeProfile402->node()->readObject(objectId);
+    }
 }
 
 void Mode::readAllObjects()
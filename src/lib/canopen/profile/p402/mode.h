@@ -35,13 +35,17 @@ public:
     virtual quint16 getSpecificCwFlag() = 0;
     virtual void setCwDefaultflag() = 0;
 
-    virtual void readRealTimeObjects();
+    virtual QList<NodeObjectId> realTimeObjects() const;
+    void readRealTimeObjects();
     virtual void readAllObjects();
     virtual void reset();
 
+    const NodeObjectId &targetObjectId() const;
+
 protected:
     NodeProfile402 *_nodeProfile402;
     NodeObjectId _controlWordObjectId;
+    NodeObjectId _targetObjectId;
 
     NodeProfile402::OperationMode _mode;
 };
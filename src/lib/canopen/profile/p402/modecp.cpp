@@ -58,11 +58,6 @@ bool ModeCp::isAbsRel() const
     return ((_cmdControlWordFlag & CW_PP_AbsRel) >> 6) != 0;
 }
 
-const NodeObjectId &ModeCp::targetObjectId() const
-{
-    return _targetObjectId;
-}
-
 void ModeCp::setTarget(qint32 target)
 {
     _nodeProfile402->node()->writeObject(_targetObjectId, QVariant(target));
@@ -32,17 +32,12 @@ public:
     void setAbsRel(bool ok);  // bit 6 of controlWord
     bool isAbsRel() const;    // bit 6 of controlWord
 
-    // ObjectID
-    const NodeObjectId &targetObjectId() const;
-
 signals:
     void absRelEvent(bool ok);
 
 private:
     quint16 _cmdControlWordFlag;
 
-    NodeObjectId _targetObjectId;
-
     // Mode interface
 public:
     void setTarget(qint32 target) override;
@@ -45,10 +45,9 @@ void ModeCstca::setCwDefaultflag()
     _cmdControlWordFlag = 0;
 }
 
-void ModeCstca::readRealTimeObjects()
+QList<NodeObjectId> ModeCstca::realTimeObjects() const
 {
-    _nodeProfile402->node()->readObject(_torqueDemandObjectId);
-    _nodeProfile402->node()->readObject(_torqueActualValueObjectId);
+    return QList<NodeObjectId>() << _torqueDemandObjectId << _torqueActualValueObjectId;
 }
 
 void ModeCstca::readAllObjects()
@@ -65,11 +65,6 @@ bool ModeDty::isEnableRamp() const
     return ((_cmdControlWordFlag & CW_DTY_EnableRamp) >> 4) != 0;
 }
 
-const NodeObjectId &ModeDty::targetObjectId() const
-{
-    return _targetObjectId;
-}
-
 const NodeObjectId &ModeDty::demandObjectId() const
 {
     return _demandObjectId;
@@ -100,9 +95,9 @@ void ModeDty::setCwDefaultflag()
     _cmdControlWordFlag = 0;
 }
 
-void ModeDty::readRealTimeObjects()
+QList<NodeObjectId> ModeDty::realTimeObjects() const
 {
-    _nodeProfile402->node()->readObject(_demandObjectId);
+    return QList<NodeObjectId>() << _demandObjectId;
 }
 
 void ModeDty::readAllObjects()
@@ -36,7 +36,6 @@ public:
     bool isEnableRamp() const;
 
     // ObjectID
-    const NodeObjectId &targetObjectId() const;
     const NodeObjectId &demandObjectId() const;
     const NodeObjectId &slopeObjectId() const;
     const NodeObjectId &maxObjectId() const;
@@ -45,7 +44,6 @@ signals:
     void isAppliedTarget();
 
 private:
-    NodeObjectId _targetObjectId;
     quint16 _cmdControlWordFlag;
 
     NodeObjectId _demandObjectId;
@@ -57,7 +55,7 @@ public:
     void setTarget(qint32 target) override;
     quint16 getSpecificCwFlag() override;
     void setCwDefaultflag() override;
-    void readRealTimeObjects() override;
+    QList<NodeObjectId> realTimeObjects() const override;
     void readAllObjects() override;
     void reset() override;
 
@@ -76,11 +76,6 @@ void ModeIp::bufferClear()
     _nodeProfile402->node()->writeObject(_bufferClearObjectId, QVariant(value));
 }
 
-const NodeObjectId &ModeIp::targetObjectId() const
-{
-    return _targetObjectId;
-}
-
 const NodeObjectId &ModeIp::bufferClearObjectId() const
 {
     return _bufferClearObjectId;
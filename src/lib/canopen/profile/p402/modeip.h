@@ -36,7 +36,6 @@ public:
     bool isEnableRamp() const;
 
     // ObjectID
-    const NodeObjectId &targetObjectId() const;
     const NodeObjectId &bufferClearObjectId() const;
     const NodeObjectId &timePeriodUnitsObjectId() const;
     const NodeObjectId &timePeriodIndexObjectId() const;
@@ -50,7 +49,6 @@ signals:
 private:
     quint16 _cmdControlWordFlag;
 
-    NodeObjectId _targetObjectId;
     NodeObjectId _bufferClearObjectId;
 
     NodeObjectId _timePeriodUnitObjectId;
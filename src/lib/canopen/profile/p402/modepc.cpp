@@ -150,10 +150,9 @@ void ModePc::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
     Q_UNUSED(flags)
 }
 
-void ModePc::readRealTimeObjects()
+QList<NodeObjectId> ModePc::realTimeObjects() const
 {
-    _nodeProfile402->node()->readObject(_positionDemandValueObjectId);
-    _nodeProfile402->node()->readObject(_positionActualValueObjectId);
+    return QList<NodeObjectId>() << _positionDemandValueObjectId << _positionActualValueObjectId;
 }
 
 void ModePc::readAllObjects()
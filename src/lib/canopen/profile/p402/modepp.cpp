@@ -111,11 +111,6 @@ bool ModePp::isChangeOnSetPoint() const
     return ((_cmdControlWordFlag & CW_PP_ChangeOnSetPoint) >> 9) != 0;
 }
 
-const NodeObjectId &ModePp::targetObjectId() const
-{
-    return _targetObjectId;
-}
-
 void ModePp::setAbsRel(bool ok)
 {
     if (ok)
@@ -41,9 +41,6 @@ public:
     void setChangeOnSetPoint(bool ok);  // bit 9 of controlWord
     bool isChangeOnSetPoint() const;    // bit 9 of controlWord
 
-    // ObjectID
-    const NodeObjectId &targetObjectId() const;
-
 signals:
     void changeNewSetPoint(bool ok);
     void changeSetImmediatelyEvent(bool ok);
@@ -53,8 +50,6 @@ signals:
 private:
     quint16 _cmdControlWordFlag;
 
-    NodeObjectId _targetObjectId;
-
     // Mode interface
 public:
     void setTarget(qint32 target) override;
@@ -53,11 +53,6 @@ ModeTc::ModeTc(NodeProfile402 *nodeProfile402)
     _motorRatedTorqueObjectId.setBusIdNodeId(_nodeProfile402->node()->busId(), _nodeProfile402->node()->nodeId());
 }
 
-const NodeObjectId &ModeTc::targetObjectId() const
-{
-    return _targetObjectId;
-}
-
 const NodeObjectId &ModeTc::torqueDemandObjectId() const
 {
     return _torqueDemandObjectId;
@@ -104,10 +99,9 @@ void ModeTc::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
     Q_UNUSED(flags)
 }
 
-void ModeTc::readRealTimeObjects()
+QList<NodeObjectId> ModeTc::realTimeObjects() const
 {
-    _nodeProfile402->node()->readObject(_torqueDemandObjectId);
-    _nodeProfile402->node()->readObject(_torqueActualValueObjectId);
+    return QList<NodeObjectId>() << _torqueDemandObjectId << _torqueActualValueObjectId;
 }
 
 void ModeTc::readAllObjects()
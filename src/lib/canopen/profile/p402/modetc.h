@@ -32,7 +32,6 @@ public:
     ModeTc(NodeProfile402 *nodeProfile402);
 
     // ObjectId
-    const NodeObjectId &targetObjectId() const;
     const NodeObjectId &torqueDemandObjectId() const;
     const NodeObjectId &torqueActualValueObjectId() const;
     const NodeObjectId &commutationAngleObjectId() const;
@@ -43,8 +42,6 @@ public:
     const NodeObjectId &motorRatedTorqueObjectId() const;
 
 protected:
-    NodeObjectId _targetObjectId;
-
     NodeObjectId _torqueDemandObjectId;
     NodeObjectId _torqueActualValueObjectId;
 
@@ -63,7 +60,7 @@ protected:
 
     // Mode interface
 public:
-    void readRealTimeObjects() override;
+    QList<NodeObjectId> realTimeObjects() const override;
     void readAllObjects() override;
 };
 
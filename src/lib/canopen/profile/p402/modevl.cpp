@@ -136,11 +136,6 @@ bool ModeVl::isReferenceRamp() const
     return ((_cmdControlWordFlag & CW_VL_ReferenceRamp) >> 6) != 0;
 }
 
-const NodeObjectId &ModeVl::targetObjectId() const
-{
-    return _targetObjectId;
-}
-
 const NodeObjectId &ModeVl::velocityDemandObjectId() const
 {
     return _velocityDemandObjectId;
@@ -226,10 +221,9 @@ void ModeVl::setCwDefaultflag()
     _cmdControlWordFlag = CW_VL_EnableRamp | CW_VL_UnlockRamp | CW_VL_ReferenceRamp;
 }
 
-void ModeVl::readRealTimeObjects()
+QList<NodeObjectId> ModeVl::realTimeObjects() const
 {
-    _nodeProfile402->node()->readObject(_velocityDemandObjectId);
-    _nodeProfile402->node()->readObject(_velocityActualObjectId);
+    return QList<NodeObjectId>() << _velocityDemandObjectId << _velocityActualObjectId;
 }
 
 void ModeVl::readAllObjects()
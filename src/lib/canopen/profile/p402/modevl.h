@@ -42,7 +42,6 @@ public:
     bool isReferenceRamp() const;
 
     // ObjectID
-    const NodeObjectId &targetObjectId() const;
     const NodeObjectId &velocityDemandObjectId() const;
     const NodeObjectId &velocityActualObjectId() const;
     const NodeObjectId &minVelocityMinMaxAmountObjectId() const;
@@ -66,8 +65,6 @@ signals:
 private:
     quint16 _cmdControlWordFlag;
 
-    NodeObjectId _targetObjectId;
-
     NodeObjectId _velocityDemandObjectId;
     NodeObjectId _velocityActualObjectId;
 
@@ -89,7 +86,7 @@ public:
     void setTarget(qint32 target) override;
     quint16 getSpecificCwFlag() override;
     void setCwDefaultflag() override;
-    void readRealTimeObjects() override;
+    QList<NodeObjectId> realTimeObjects() const override;
     void readAllObjects() override;
     void reset() override;
 
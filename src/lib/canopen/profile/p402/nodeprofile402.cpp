@@ -18,6 +18,7 @@
 
 #include "nodeprofile402.h"
 
+#include "canopenbus.h"
 #include "indexdb402.h"
 #include "modecp.h"
 #include "modecstca.h"
@@ -110,8 +111,7 @@ NodeProfile402::NodeProfile402(Node *node, quint8 axis)
     _stateMachineCurrent = State402::STATE_NotReadyToSwitchOn;
 
     _nodeProfileState = State::NODEPROFILE_STOPED;
-
-    connect(&_nodeProfleTimer, &QTimer::timeout, this, &NodeProfile402::readRealTimeObjects);
+    _pollPeriodMs = 0;
 
     setNodeInterrest(node);
 
@@ -901,16 +901,20 @@ void NodeProfile402::readModeOfOperationDisplay()
     _node->readObject(_modesOfOperationDisplayObjectId);
 }
 
+/**
+ * @brief polls statusword and real time objects of the current mode every msec with the bus poll scheduler
+ */
 void NodeProfile402::start(int msec)
 {
-    _nodeProfleTimer.start(msec);
+    _pollPeriodMs = msec;
     _nodeProfileState = State::NODEPROFILE_STARTED;
+    updatePolls();
 }
 
 void NodeProfile402::stop()
 {
-    _nodeProfleTimer.stop();
     _nodeProfileState = State::NODEPROFILE_STOPED;
+    updatePolls();
 }
 
 bool NodeProfile402::status() const
@@ -918,6 +922,33 @@ bool NodeProfile402::status() const
     return true;
 }
 
+/**
+ * @brief registers polls of the current mode objects, or removes all polls when stopped
+ */
+void NodeProfile402::updatePolls()
+{
+    if (_node->bus() == nullptr)
+    {
+        return;
+    }
+
+    PollScheduler *pollScheduler = _node->bus()->pollScheduler();
+    pollScheduler->removePolls(this);
+    if (_nodeProfileState != State::NODEPROFILE_STARTED || _pollPeriodMs <= 0)
+    {
+        return;
+    }
+
+    pollScheduler->addPoll(this, _node, _statusWordObjectId, _pollPeriodMs);
+    if (_modeCurrent != OperationMode::NoMode && _modes.contains(_modeCurrent))
+    {
+        for (const NodeObjectId &objectId : _modes[_modeCurrent]->realTimeObjects())
+        {
+            pollScheduler->addPoll(this, _node, objectId, _pollPeriodMs);
+        }
+    }
+}
+
 void NodeProfile402::readRealTimeObjects() const
 {
     _node->readObject(_statusWordObjectId);
@@ -1007,6 +1038,7 @@ void NodeProfile402::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest fl
         if (_modeCurrent != mode)
         {
             _modeCurrent = mode;
+            updatePolls();
             emit modeChanged(_axisId, _modeCurrent);
         }
 
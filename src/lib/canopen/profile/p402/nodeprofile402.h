@@ -170,7 +170,7 @@ private:
 
     // STATE
     State _nodeProfileState;
-    QTimer _nodeProfleTimer;
+    int _pollPeriodMs;
 
     enum StateState
     {
@@ -196,6 +196,7 @@ private:
 
     void initializeObjectsId();
     void statusNodeChanged(Node::Status status);
+    void updatePolls();
     void changeStateMachine(State402 state);
 
     void decodeEventStatusWord(quint16 statusWord);
@@ -19,6 +19,89 @@
 #include "emergency.h"
 #include "canopenbus.h"
 
+#include <QCoreApplication>
+#include <QStringList>
+
+namespace
+{
+struct ErrorCodeName
+{
+    quint16 code;
+    quint16 mask;
+    const char *name;
+};
+
+// CiA 301 and CiA 402 error codes and classes, the matching entry with the widest mask is the most specific
+const ErrorCodeName errorCodeNames[] = {
+    {0x0000, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Error reset or no error")},
+    {0x1000, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Generic error")},
+    {0x2000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Current")},
+    {0x2100, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Current, device input side")},
+    {0x2200, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Current inside the device")},
+    {0x2300, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Current, device output side")},
+    {0x2310, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Continuous over current")},
+    {0x2311, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Continuous over current no 1")},
+    {0x2312, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Continuous over current no 2")},
+    {0x2320, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Short circuit/earth leakage")},
+    {0x2330, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Earth leakage")},
+    {0x2340, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Short circuit")},
+    {0x3000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Voltage")},
+    {0x3100, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Mains voltage")},
+    {0x3110, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Mains over-voltage")},
+    {0x3120, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Mains under-voltage")},
+    {0x3130, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Phase failure")},
+    {0x3200, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Voltage inside the device")},
+    {0x3210, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "DC link over-voltage")},
+    {0x3220, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "DC link under-voltage")},
+    {0x3300, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Output voltage")},
+    {0x4000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Temperature")},
+    {0x4100, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Ambient temperature")},
+    {0x4200, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Device temperature")},
+    {0x4210, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Excess temperature device")},
+    {0x4300, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Drive temperature")},
+    {0x4310, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Excess temperature drive")},
+    {0x5000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Device hardware")},
+    {0x5400, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Power section")},
+    {0x5441, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Contact 1, enable missing")},
+    {0x6000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Device software")},
+    {0x6100, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Internal software")},
+    {0x6200, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "User software")},
+    {0x6300, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Data set")},
+    {0x6320, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Parameter error")},
+    {0x7000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Additional modules")},
+    {0x7100, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Power")},
+    {0x7110, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Brake chopper")},
+    {0x7120, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Motor")},
+    {0x7121, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Motor blocked")},
+    {0x7300, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Sensor")},
+    {0x7305, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Incremental sensor 1 fault")},
+    {0x7306, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Incremental sensor 2 fault")},
+    {0x7310, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Speed")},
+    {0x7320, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Position")},
+    {0x8000, 0xF000, QT_TRANSLATE_NOOP("Emergency", "Monitoring")},
+    {0x8100, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Communication")},
+    {0x8110, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "CAN overrun (objects lost)")},
+    {0x8120, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "CAN in error passive mode")},
+    {0x8130, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Life guard error or heartbeat error")},
+    {0x8140, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Recovered from bus off")},
+    {0x8150, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "CAN-ID collision")},
+    {0x8200, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Protocol error")},
+    {0x8210, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "PDO not processed due to length error")},
+    {0x8220, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "PDO length exceeded")},
+    {0x8230, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "DAM MPDO not processed, destination object not available")},
+    {0x8240, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Unexpected SYNC data length")},
+    {0x8250, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "RPDO timeout")},
+    {0x8400, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Velocity speed controller")},
+    {0x8500, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Position controller")},
+    {0x8600, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Positioning controller")},
+    {0x8611, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Following error")},
+    {0x8612, 0xFFFF, QT_TRANSLATE_NOOP("Emergency", "Reference limit")},
+    {0x9000, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "External error")},
+    {0xF000, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Additional functions")},
+    {0xFF00, 0xFF00, QT_TRANSLATE_NOOP("Emergency", "Device specific")},
+};
+}  // namespace
+
 Emergency::Emergency(Node *node)
     : Service(node)
 {
@@ -38,5 +121,87 @@ QString Emergency::type() const
 
 void Emergency::parseFrame(const QCanBusFrame &frame)
 {
-    Q_UNUSED(frame)
+    EmergencyEvent event;
+    if (!decodeFrame(frame, event))
+    {
+        return;
+    }
+
+    if (bus() != nullptr)
+    {
+        bus()->emergencyStore()->addEvent(event);
+    }
+}
+
+/**
+ * @brief decodes an EMCY frame: error code, error register and manufacturer specific bytes
+ * @return false if frame is not a valid EMCY
+ */
+bool Emergency::decodeFrame(const QCanBusFrame &frame, EmergencyEvent &event)
+{
+    const QByteArray payload = frame.payload();
+    if (frame.frameType() != QCanBusFrame::DataFrame || payload.size() < 3)
+    {
+        return false;
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(payload.constData());
+    event.timeUs = frame.timeStamp().seconds() * 1000000 + frame.timeStamp().microSeconds();
+    event.nodeId = static_cast<quint8>(frame.frameId() & 0x7F);
+    event.errorCode = static_cast<quint16>(data[0] | (data[1] << 8));
+    event.errorRegister = data[2];
+    for (int i = 0; i < 5; i++)
+    {
+        event.manufacturerData[i] = (i + 3 < payload.size()) ? data[i + 3] : 0;
+    }
+    return true;
+}
+
+/**
+ * @brief name of an error code from CiA 301 and CiA 402, the most specific one known
+ */
+QString Emergency::errorCodeStr(quint16 errorCode)
+{
+    const ErrorCodeName *bestName = nullptr;
+    for (const ErrorCodeName &errorCodeName : errorCodeNames)
+    {
+        if ((errorCode & errorCodeName.mask) != errorCodeName.code)
+        {
+            continue;
+        }
+        if (bestName == nullptr || errorCodeName.mask > bestName->mask)
+        {
+            bestName = &errorCodeName;
+        }
+    }
+
+    if (bestName == nullptr)
+    {
+        return QCoreApplication::translate("Emergency", "Unknown error 0x%1").arg(errorCode, 4, 16, QChar('0'));
+    }
+    return QCoreApplication::translate("Emergency", bestName->name);
+}
+
+QString Emergency::errorRegisterStr(quint8 errorRegister)
+{
+    static const char *const bitNames[] = {
+        QT_TRANSLATE_NOOP("Emergency", "Generic"),
+        QT_TRANSLATE_NOOP("Emergency", "Current"),
+        QT_TRANSLATE_NOOP("Emergency", "Voltage"),
+        QT_TRANSLATE_NOOP("Emergency", "Temperature"),
+        QT_TRANSLATE_NOOP("Emergency", "Communication"),
+        QT_TRANSLATE_NOOP("Emergency", "Device profile"),
+        QT_TRANSLATE_NOOP("Emergency", "Reserved"),
+        QT_TRANSLATE_NOOP("Emergency", "Manufacturer"),
+    };
+
+    QStringList names;
+    for (int bit = 0; bit < 8; bit++)
+    {
+        if ((errorRegister & (1 << bit)) != 0)
+        {
+            names.append(QCoreApplication::translate("Emergency", bitNames[bit]));
+        }
+    }
+    return names.join(", ");
 }
@@ -23,6 +23,15 @@
 
 #include "service.h"
 
+struct EmergencyEvent
+{
+    qint64 timeUs;  // frame timestamp
+    quint16 errorCode;
+    quint8 errorRegister;
+    quint8 nodeId;
+    quint8 manufacturerData[5];
+};
+
 class CANOPEN_EXPORT Emergency : public Service
 {
     Q_OBJECT
@@ -35,6 +44,10 @@ public:
 
     void parseFrame(const QCanBusFrame &frame) override;
 
+    static bool decodeFrame(const QCanBusFrame &frame, EmergencyEvent &event);
+    static QString errorCodeStr(quint16 errorCode);
+    static QString errorRegisterStr(quint8 errorRegister);
+
 private:
     uint32_t _cobId;
 };
@@ -24,92 +24,222 @@
 
 ErrorControl::ErrorControl(Node *node)
     : Service(node)
+    , _heartbeatTimer(this, TimerHeartbeat)
+    , _guardTimer(this, TimerGuard)
+    , _lifeTimeTimer(this, TimerLifeTime)
 {
     _cobId = 0x700;
     _cobIds.append(_cobId + node->nodeId());
-    _oldToggleBit = false;
+    _expectedToggleBit = false;
+    _lost = false;
+    resetCounters();
 
-    _guardTimeTimer = new QTimer();
-    _lifeTimeTimer = new QTimer();
-    connect(_guardTimeTimer, &QTimer::timeout, this, &ErrorControl::sendNodeGuarding);
-    connect(_lifeTimeTimer, &QTimer::timeout, this, &ErrorControl::lifeGuardingEvent);
+    _guardTimeIndex = 0x100C;
+    _lifeTimeFactorIndex = 0x100D;
+    _heartbeatProducerIndex = 0x1017;
 
-    _guardTime = 0x100C;
-    _lifeTime = 0x100D;
+    _heartbeatConsumerTime = 0;
+    _heartbeatProducerTime = 0;
+    _guardTime = 0;
+    _lifeTimeFactor = 0;
+    _guardingRequestPending = false;
 
-    registerObjId({_guardTime, 0});
+    registerObjId({_guardTimeIndex, 0});
+    registerObjId({_lifeTimeFactorIndex, 0});
+    registerObjId({_heartbeatProducerIndex, 0});
     setNodeInterrest(node);
 }
 
+ErrorControl::~ErrorControl()
+{
+}
+
+uint32_t ErrorControl::cobId()
+{
+    return _cobId;
+}
+
 QString ErrorControl::type() const
 {
     return QLatin1String("ErrorControl");
 }
 
+void ErrorControl::reset()
+{
+    _heartbeatTimer.stop();
+    _guardTimer.stop();
+    _lifeTimeTimer.stop();
+    _guardingRequestPending = false;
+    _expectedToggleBit = false;
+    _lost = false;
+}
+
 void ErrorControl::parseFrame(const QCanBusFrame &frame)
 {
-    if (frame.payload().size() == 1)
+    if (frame.frameType() != QCanBusFrame::DataFrame || frame.payload().size() != 1)
     {
-        if (static_cast<uint8_t>(frame.payload().at(0)) == 0x0)
-        {
-            // BootUp
-            _node->setStatus(Node::Status::PREOP);
-            _node->reset();
-            _oldToggleBit = false;
-            return;
-        }
+        return;
     }
 
-    /*if (_node->nodeOd()->indexExist(_lifeTime))
+    if (static_cast<uint8_t>(frame.payload().at(0)) == 0x0)
     {
-        qint32 timer;
-        if (_node->nodeOd()->value(_lifeTime, 0).toUInt() != 0)
-        {
-            timer = (_node->nodeOd()->value(_lifeTime, 0).toInt()) * _node->nodeOd()->value(_guardTime, 0).toInt();
-            _lifeTimeTimer->start(timer);
-        }
-        else
+        // BootUp
+        _counters.bootUpCount++;
+        _node->setStatus(Node::Status::PREOP);
+        _node->reset();
+        _expectedToggleBit = false;
+        emit bootUp();
+
+        // boot up is the first heartbeat of the node
+        if (heartbeatConsumerTime() > 0)
         {
-            timer = _node->nodeOd()->value(_guardTime, 0).toInt();
-            _lifeTimeTimer->start(timer + (timer / 2));
+            _heartbeatTimer.start(heartbeatConsumerTime());
         }
-    }*/
+        updateNodeGuarding();
+        return;
+    }
+
+    if (_guardingRequestPending)
+    {
+        receiveNodeGuarding(frame);
+    }
+    else
+    {
+        receiveHeartBeat(frame);
+    }
     manageErrorControl(frame);
 }
 
-void ErrorControl::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+/**
+ * @brief consumer time in ms, the configured one or 150 % of the node producer time (1017h)
+ */
+int ErrorControl::heartbeatConsumerTime() const
 {
-    if ((objId.index() == _guardTime) && _node->nodeOd()->indexExist(_guardTime))
+    if (_heartbeatConsumerTime > 0)
     {
-        if ((flags != NodeOd::FlagsRequest::Error) && (_node->nodeOd()->value(_guardTime, 0).toUInt() != 0))
-        {
-            //_guardTimeTimer->start(_node->nodeOd()->value(_guardTime, 0).toInt());
-        }
-        else
-        {
-            _guardTimeTimer->stop();
-            _lifeTimeTimer->stop();
-        }
+        return _heartbeatConsumerTime;
+    }
+    return _heartbeatProducerTime + _heartbeatProducerTime / 2;
+}
+
+/**
+ * @brief sets the heartbeat consumer time in ms, 0 to derive it from node producer time
+ */
+void ErrorControl::setHeartbeatConsumerTime(int consumerTimeMs)
+{
+    _heartbeatConsumerTime = qMax(consumerTimeMs, 0);
+    if (heartbeatConsumerTime() == 0)
+    {
+        _heartbeatTimer.stop();
+    }
+}
+
+bool ErrorControl::isHeartbeatMonitored() const
+{
+    return _heartbeatTimer.isActive();
+}
+
+int ErrorControl::guardTime() const
+{
+    return _guardTime;
+}
+
+int ErrorControl::lifeTimeFactor() const
+{
+    return _lifeTimeFactor;
+}
+
+/**
+ * @brief sets node guarding parameters, guard time in ms, disabled if one is 0
+ */
+void ErrorControl::setNodeGuarding(int guardTime, int lifeTimeFactor)
+{
+    _guardTime = qMax(guardTime, 0);
+    _lifeTimeFactor = qMax(lifeTimeFactor, 0);
+    updateNodeGuarding();
+}
+
+bool ErrorControl::isNodeGuardingActive() const
+{
+    return _guardTimer.isActive();
+}
+
+/**
+ * @brief true if heartbeat or node guarding detected the node loss
+ */
+bool ErrorControl::isLost() const
+{
+    return _lost;
+}
+
+const ErrorControl::Counters &ErrorControl::counters() const
+{
+    return _counters;
+}
+
+void ErrorControl::resetCounters()
+{
+    _counters = Counters{0, 0, 0, 0, 0, 0, 0};
+}
+
+void ErrorControl::receiveHeartBeat(const QCanBusFrame &frame)
+{
+    Q_UNUSED(frame)
+
+    _counters.heartbeatCount++;
+    setLost(false);
+
+    // monitoring starts at the first heartbeat received
+    if (heartbeatConsumerTime() > 0)
+    {
+        _heartbeatTimer.start(heartbeatConsumerTime());
     }
 }
 
-void ErrorControl::receiveHeartBeat()
+void ErrorControl::receiveNodeGuarding(const QCanBusFrame &frame)
 {
-    if (!bus()->canWrite())
+    _guardingRequestPending = false;
+    _counters.guardingResponseCount++;
+
+    bool actualToggleBit = (static_cast<uint8_t>(frame.payload().at(0)) & 0x80) != 0;
+    if (_expectedToggleBit != actualToggleBit)
     {
+        // response of a lost request, the node life time is not refreshed
+        _counters.toggleErrorCount++;
+        _expectedToggleBit = !actualToggleBit;
         return;
     }
+    _expectedToggleBit = !actualToggleBit;
 
-    // heartbeat consumers
-    QCanBusFrame frameNodeGuarding;
-    frameNodeGuarding.setFrameId(_cobId + _node->nodeId());
-    frameNodeGuarding.setFrameType(QCanBusFrame::RemoteRequestFrame);
-    bus()->writeFrame(frameNodeGuarding);
+    setLost(false);
+    _lifeTimeTimer.start(_guardTime * _lifeTimeFactor);
+}
+
+void ErrorControl::manageErrorControl(const QCanBusFrame &frame)
+{
+    switch (frame.payload().at(0) & 0x7F)
+    {
+        case 4:  // Stopped
+            _node->setStatus(Node::Status::STOPPED);
+            break;
+
+        case 5:  // Operational
+            _node->setStatus(Node::Status::STARTED);
+            break;
+
+        case 127:  // Pre-operational
+            _node->setStatus(Node::Status::PREOP);
+            break;
+
+        default:
+            // qDebug() << "Error control : error state" << QString::number(frame.frameId(), 16).toUpper() << frame.payload().toHex().toUpper();
+            break;
+    }
 }
 
 void ErrorControl::sendNodeGuarding()
 {
-    if (!bus()->canWrite())
+    if (bus() == nullptr || !bus()->canWrite())
     {
         return;
     }
@@ -117,43 +247,104 @@ void ErrorControl::sendNodeGuarding()
     QCanBusFrame frameNodeGuarding;
     frameNodeGuarding.setFrameId(_cobId + _node->nodeId());
     frameNodeGuarding.setFrameType(QCanBusFrame::RemoteRequestFrame);
-    bus()->writeFrame(frameNodeGuarding);
+    if (bus()->writeFrame(frameNodeGuarding))
+    {
+        _guardingRequestPending = true;
+        _counters.guardingRequestCount++;
+    }
 }
 
-void ErrorControl::lifeGuardingEvent()
+void ErrorControl::setLost(bool lost)
 {
-    // qDebug() << ">>ErrorControl::lifeGuardingEvent : node error, dont answer";
+    if (lost == _lost)
+    {
+        return;
+    }
+    _lost = lost;
+    if (_lost)
+    {
+        _node->setStatus(Node::Status::UNKNOWN);
+    }
+    else
+    {
+        emit errorControlResumed();
+    }
 }
 
-void ErrorControl::manageErrorControl(const QCanBusFrame &frame)
+/**
+ * @brief starts or stops node guarding, only used when the node does not produce heartbeat
+ */
+void ErrorControl::updateNodeGuarding()
 {
-    if (frame.payload().size() == 1)
+    bool guarding = (_guardTime > 0) && (_lifeTimeFactor > 0) && (_heartbeatProducerTime == 0);
+    if (!guarding)
     {
-        bool actualToggleBit = (frame.payload().at(0) >> 7) != 0;
-        if (_oldToggleBit == actualToggleBit)
-        {
-            // ERROR TogleBit -> connection lost
-            // return;
-        }
-        _oldToggleBit = actualToggleBit;
+        _guardTimer.stop();
+        _lifeTimeTimer.stop();
+        _guardingRequestPending = false;
+        return;
+    }
 
-        switch (frame.payload().at(0) & 0x7F)
+    if (!_guardTimer.isActive())
+    {
+        _guardTimer.start(_guardTime);
+        _lifeTimeTimer.start(_guardTime * _lifeTimeFactor);
+    }
+}
+
+void ErrorControl::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
+{
+    if ((flags & NodeOd::FlagsRequest::Error) == NodeOd::FlagsRequest::Error)
+    {
+        return;
+    }
+
+    if (objId.index() == _guardTimeIndex)
+    {
+        _guardTime = _node->nodeOd()->value(_guardTimeIndex, 0).toInt();
+        updateNodeGuarding();
+    }
+    else if (objId.index() == _lifeTimeFactorIndex)
+    {
+        _lifeTimeFactor = _node->nodeOd()->value(_lifeTimeFactorIndex, 0).toInt();
+        updateNodeGuarding();
+    }
+    else if (objId.index() == _heartbeatProducerIndex)
+    {
+        _heartbeatProducerTime = _node->nodeOd()->value(_heartbeatProducerIndex, 0).toInt();
+        if (heartbeatConsumerTime() == 0)
         {
-            case 4:  // Stopped
-                _node->setStatus(Node::Status::STOPPED);
-                break;
+            _heartbeatTimer.stop();
+        }
+        updateNodeGuarding();
+    }
+}
 
-            case 5:  // Operational
-                _node->setStatus(Node::Status::STARTED);
-                break;
+void ErrorControl::timerWheelEvent(int timerId)
+{
+    switch (timerId)
+    {
+        case TimerHeartbeat:
+            _counters.heartbeatLostCount++;
+            setLost(true);
+            emit heartbeatLost();
+            break;
 
-            case 127:  // Pre-operational
-                _node->setStatus(Node::Status::PREOP);
-                break;
+        case TimerGuard:
+            if (_guardingRequestPending)
+            {
+                // no response during the guard time, next request keeps the toggle
+                _guardingRequestPending = false;
+            }
+            sendNodeGuarding();
+            _guardTimer.start(_guardTime);
+            break;
 
-            default:
-                // qDebug() << "Error control : error state" << QString::number(frame.frameId(), 16).toUpper() << frame.payload().toHex().toUpper();
-                break;
-        }
+        case TimerLifeTime:
+            _counters.guardingLostCount++;
+            setLost(true);
+            emit nodeGuardingLost();
+            _expectedToggleBit = false;
+            break;
     }
 }
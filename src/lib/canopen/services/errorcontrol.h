@@ -23,40 +23,98 @@
 
 #include "nodeodsubscriber.h"
 #include "service.h"
+#include "timerwheel.h"
 
 #include "nodeod.h"
 
-class CANOPEN_EXPORT ErrorControl : public Service, public NodeOdSubscriber
+class CANOPEN_EXPORT ErrorControl : public Service, public NodeOdSubscriber, public TimerWheelClient
 {
     Q_OBJECT
 public:
     ErrorControl(Node *node);
+    ~ErrorControl() override;
 
     uint32_t cobId();
 
     QString type() const override;
 
+    void reset() override;
+
     void parseFrame(const QCanBusFrame &frame) override;
 
-private slots:
-    void sendNodeGuarding();
-    void lifeGuardingEvent();
+    // heartbeat consumer, same semantic as a 1016h entry of the master
+    int heartbeatConsumerTime() const;
+    void setHeartbeatConsumerTime(int consumerTimeMs);
+    bool isHeartbeatMonitored() const;
+
+    // node guarding, from 100Ch guard time and 100Dh life time factor of the node
+    int guardTime() const;
+    int lifeTimeFactor() const;
+    void setNodeGuarding(int guardTime, int lifeTimeFactor);
+    bool isNodeGuardingActive() const;
+
+    bool isLost() const;
+
+    struct Counters
+    {
+        quint32 heartbeatCount;
+        quint32 heartbeatLostCount;
+        quint32 guardingRequestCount;
+        quint32 guardingResponseCount;
+        quint32 guardingLostCount;
+        quint32 toggleErrorCount;
+        quint32 bootUpCount;
+    };
+    const Counters &counters() const;
+    void resetCounters();
+
+signals:
+    void bootUp();
+    void heartbeatLost();
+    void nodeGuardingLost();
+    void errorControlResumed();
 
 private:
-    void receiveHeartBeat();
+    enum TimerId
+    {
+        TimerHeartbeat,
+        TimerGuard,
+        TimerLifeTime
+    };
+
+    void receiveHeartBeat(const QCanBusFrame &frame);
+    void receiveNodeGuarding(const QCanBusFrame &frame);
     void manageErrorControl(const QCanBusFrame &frame);
+    void sendNodeGuarding();
+    void setLost(bool lost);
+    void updateNodeGuarding();
 
     uint32_t _cobId;
-    bool _oldToggleBit;
+    bool _expectedToggleBit;
+    bool _lost;
+    Counters _counters;
+
+    quint16 _guardTimeIndex;
+    quint16 _lifeTimeFactorIndex;
+    quint16 _heartbeatProducerIndex;
 
-    quint16 _guardTime;
-    quint16 _lifeTime;
-    QTimer *_guardTimeTimer;
-    QTimer *_lifeTimeTimer;
+    int _heartbeatConsumerTime;
+    int _heartbeatProducerTime;
+    TimerWheel::Timer _heartbeatTimer;
+
+    int _guardTime;
+    int _lifeTimeFactor;
+    bool _guardingRequestPending;
+    TimerWheel::Timer _guardTimer;
+    TimerWheel::Timer _lifeTimeTimer;
 
     // NodeOdSubscriber interface
 public:
     void odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags) override;
+
+    // TimerWheelClient interface
+protected:
+    void timerWheelEvent(int timerId) override;
 };
 
 #endif  // ERRORCONTROL_H
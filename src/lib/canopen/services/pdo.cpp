@@ -144,7 +144,10 @@ bool PDO::canInsertObjectAtBitPos(const QList<NodeObjectId> &objectList, const N
 
 int PDO::maxMappingBitSize() const
 {
-    // TODO add CAN Fd mode case
+    if (_bus != nullptr && _bus->isCanFd())
+    {
+        return 512;
+    }
     return 64;
 }
 
@@ -216,24 +219,20 @@ void PDO::readMapping()
 
 void PDO::writeMapping(const QList<NodeObjectId> &objectList)
 {
-    quint8 size = 0;
-    for (const NodeObjectId &objectId : qAsConst(objectList))
-    {
-        size += objectId.bitSize();
-        if (size > 64)
-        {
-            setError(ERROR_EXCEED_PDO_LENGTH);
-            return;
-        }
-    }
-    _objectToMap = objectList;
-    for (NodeObjectId &objectId : _objectToMap)
+    QList<NodeObjectId> objectToMap = objectList;
+    for (NodeObjectId &objectId : objectToMap)
     {
         if (objectId.dataType() == QMetaType::Type::UnknownType)
         {
             objectId.setDataType(_node->nodeOd()->dataType(objectId));
         }
     }
+    if (objectToMap.count() > maxMappingObjectCount() || mappingBitSize(objectToMap) > maxMappingBitSize())
+    {
+        setError(ERROR_EXCEED_PDO_LENGTH);
+        return;
+    }
+    _objectToMap = objectToMap;
 
     _statusPdo = STATE_WRITE;
     _stateMapping = STATE_FREE;
@@ -499,7 +498,7 @@ void PDO::managementRespProcessMapping(const NodeObjectId &objId, NodeOd::FlagsR
                 return;
             }
             _objectIdFsm++;
-            if (_objectIdFsm == 8)
+            if (_objectIdFsm >= maxMappingObjectCount())
             {
                 _stateMapping = STATE_MODIFY;
             }
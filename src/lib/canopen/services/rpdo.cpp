@@ -19,8 +19,10 @@
 #include "rpdo.h"
 
 #include "canopenbus.h"
-#include <QDataStream>
 #include <QDebug>
+#include <QtEndian>
+
+#include <cstring>
 
 RPDO::RPDO(Node *node, quint8 number)
     : PDO(node, number)
@@ -39,6 +41,11 @@ RPDO::RPDO(Node *node, quint8 number)
                        {_node->busId(), _node->nodeId(), _objectCommId, PDO_COMM_TRANSMISSION_TYPE},
                        {_node->busId(), _node->nodeId(), _objectCommId, PDO_COMM_INHIBIT_TIME},
                        {_node->busId(), _node->nodeId(), _objectCommId, PDO_COMM_EVENT_TIMER}};
+
+    _payloadSize = 0;
+    _writtenMask = 0;
+    memset(_stagingBuffer, 0, RPDO_STAGING_SIZE);
+    connect(this, &PDO::mappingChanged, this, &RPDO::compileEncodePlan);
 }
 
 QString RPDO::type() const
@@ -53,11 +60,32 @@ void RPDO::parseFrame(const QCanBusFrame &frame)
 
 void RPDO::odNotify(const NodeObjectId &objId, NodeOd::FlagsRequest flags)
 {
+    if ((objId.index() != _objectCommId) && (objId.index() != _objectMappingId))
+    {
+        // mapped object updated from device, refresh staging payload if not overridden by write()
+        int entryId = encodeEntryId(objId);
+        if ((entryId >= 0) && ((flags & NodeOd::Error) == 0) && ((_writtenMask & (Q_UINT64_C(1) << entryId)) == 0))
+        {
+            const EncodeEntry &entry = _encodePlan.at(entryId);
+            if (entry.nodeSubIndex != nullptr)
+            {
+                encodeVariant(entry, entry.nodeSubIndex->value());
+            }
+        }
+        return;
+    }
+
     if ((objId.index() == _objectCommId) && (objId.subIndex() == 0x01))
     {
         emit enabledChanged(isEnabled());
     }
 
+    if ((objId.index() == _objectCommId) && (objId.subIndex() == PDO_COMM_INHIBIT_TIME) && (bus() != nullptr))
+    {
+        // inhibit time in multiple of 100 µs
+        bus()->txScheduler()->setInhibitTime(_cobId, static_cast<int>(_node->nodeOd()->value(objId).toUInt() * 100));
+    }
+
     if (_statusPdo == STATE_NONE && objId.index() == _objectMappingId)
     {
         if (!_objectCommList.empty())
@@ -114,168 +142,436 @@ quint8 RPDO::transmissionType()
 
 void RPDO::receiveSync()
 {
-    if ((_currentMappedObjectsId.isEmpty()) || (!isEnabled()))
+    if ((_encodePlan.isEmpty()) || (!isEnabled()))
     {
         return;
     }
 
-    // Update data of object in NodeOd after a sync
-    for (const NodeObjectId &objectIterator : qAsConst(_currentMappedObjectsId))
+    // Update data of written objects in NodeOd after a sync
+    for (int entryId = 0; entryId < _encodePlan.size(); entryId++)
     {
-        if (_dataObjectCurrentMapped.contains(objectIterator.key()) && _node->nodeOd()->indexExist(objectIterator.index())
-            && _node->nodeOd()->subIndexExist(objectIterator.index(), objectIterator.subIndex()))
+        const EncodeEntry &entry = _encodePlan.at(entryId);
+        if (((_writtenMask & (Q_UINT64_C(1) << entryId)) != 0) && (entry.nodeSubIndex != nullptr))
         {
-            _node->nodeOd()->index(objectIterator.index())->subIndex(objectIterator.subIndex())->setValue(_dataObjectCurrentMapped.value(objectIterator.key()));
+            entry.nodeSubIndex->setValue(decodeEntry(entry));
         }
     }
 }
 
 /**
- * @brief Save data of object before send
- * @param index
- * @param subindex
+ * @brief Save data of object before send, encoded in place in the staging payload
+ * @param object mapped object
  * @param data
  */
 void RPDO::write(const NodeObjectId &object, const QVariant &data)
 {
-    if ((_currentMappedObjectsId.isEmpty()) || (!isEnabled()))
+    if (!isEnabled())
     {
         return;
     }
-
-    for (const NodeObjectId &objectIterator : qAsConst(_currentMappedObjectsId))
+    int entryId = encodeEntryId(object);
+    if (entryId < 0)
     {
-        if (objectIterator.index() == object.index() && objectIterator.subIndex() == object.subIndex())
-        {
-            if (_dataObjectCurrentMapped.contains(objectIterator.key()))
-            {
-                _dataObjectCurrentMapped.remove(objectIterator.key());
-            }
-            _dataObjectCurrentMapped.insert(object.key(), data);
-            return;
-        }
+        return;
     }
+
+    encodeVariant(_encodePlan.at(entryId), data);
+    _writtenMask |= (Q_UINT64_C(1) << entryId);
+}
+
+void RPDO::write(const NodeObjectId &object, qint8 value)
+{
+    writeTyped(object, value);
+}
+
+void RPDO::write(const NodeObjectId &object, quint8 value)
+{
+    writeTyped(object, value);
+}
+
+void RPDO::write(const NodeObjectId &object, qint16 value)
+{
+    writeTyped(object, value);
+}
+
+void RPDO::write(const NodeObjectId &object, quint16 value)
+{
+    writeTyped(object, value);
+}
+
+void RPDO::write(const NodeObjectId &object, qint32 value)
+{
+    writeTyped(object, value);
+}
+
+void RPDO::write(const NodeObjectId &object, quint32 value)
+{
+    writeTyped(object, value);
+}
+
+void RPDO::write(const NodeObjectId &object, float value)
+{
+    writeTyped(object, value);
 }
 
 /**
- * @brief Clear list data waiting
+ * @brief Clear list data waiting, staging payload is reloaded from NodeOd values
  */
 void RPDO::clearDataWaiting()
 {
-    _dataObjectCurrentMapped.clear();
+    _writtenMask = 0;
+    for (const EncodeEntry &entry : qAsConst(_encodePlan))
+    {
+        if (entry.nodeSubIndex != nullptr)
+        {
+            encodeVariant(entry, entry.nodeSubIndex->value());
+        }
+    }
 }
 
 /**
- * @brief Prepares the data before the sync signal
+ * @brief Sends the staging payload before the sync signal
  */
 void RPDO::prepareAndSendData()
 {
-    if ((_currentMappedObjectsId.isEmpty()) || (!isEnabled()) || _node->status() != Node::STARTED)
+    if ((_encodePlan.isEmpty()) || (!isEnabled()) || _node->status() != Node::STARTED)
     {
         return;
     }
 
-    QDataStream request(&_rpdoDataToSendReqPayload, QIODevice::WriteOnly);
-    request.setByteOrder(QDataStream::LittleEndian);
+    sendData();
+}
 
+/**
+ * @brief Compiles the current mapping into an encode plan with fixed offsets.
+ * Called once per mapping change, write() and prepareAndSendData() then only patch or copy the staging payload.
+ */
+void RPDO::compileEncodePlan()
+{
+    for (const EncodeEntry &entry : qAsConst(_encodePlan))
+    {
+        unRegisterObjId({entry.index, entry.subIndex});
+    }
+    _encodePlan.clear();
+    _payloadSize = 0;
+    _writtenMask = 0;
+    memset(_stagingBuffer, 0, RPDO_STAGING_SIZE);
+
+    int maxByteSize = qMin(maxMappingBitSize() / 8, static_cast<int>(RPDO_STAGING_SIZE));
+    _encodePlan.reserve(_currentMappedObjectsId.size());
     for (const NodeObjectId &objectIterator : qAsConst(_currentMappedObjectsId))
     {
-        quint8 size = static_cast<quint8>(QMetaType::sizeOf(objectIterator.dataType()));
-        if (size > 8)
+        NodeSubIndex *nodeSubIndex = nullptr;
+        if (_node->nodeOd()->subIndexExist(objectIterator.index(), objectIterator.subIndex()))
         {
-            setError(ERROR_EXCEED_PDO_LENGTH);
+            nodeSubIndex = _node->nodeOd()->index(objectIterator.index())->subIndex(objectIterator.subIndex());
         }
-        if (_dataObjectCurrentMapped.contains(objectIterator.key()))
+
+        EncodeEntry entry;
+        entry.index = objectIterator.index();
+        entry.subIndex = objectIterator.subIndex();
+        entry.offset = static_cast<quint8>(_payloadSize);
+        entry.nodeSubIndex = nodeSubIndex;
+        int size;
+        if (nodeSubIndex != nullptr)
         {
-            convertQVariantToQDataStream(request, _dataObjectCurrentMapped.value(objectIterator.key()), _node->nodeOd()->dataType(objectIterator));
+            entry.type = encodeType(nodeSubIndex->dataType());
+            size = nodeSubIndex->byteLength();
         }
         else
         {
-            convertQVariantToQDataStream(request, _node->nodeOd()->value(objectIterator), _node->nodeOd()->dataType(objectIterator));
+            entry.type = EncodeInvalid;
+            size = QMetaType::sizeOf(objectIterator.dataType());
+        }
+        if (size <= 0 || _payloadSize + size > maxByteSize || _encodePlan.size() >= 64)
+        {
+            setError(ERROR_EXCEED_PDO_LENGTH);
+            break;
+        }
+        entry.size = static_cast<quint8>(size);
+
+        if (nodeSubIndex != nullptr)
+        {
+            encodeVariant(entry, nodeSubIndex->value());
         }
+        _encodePlan.append(entry);
+        _payloadSize += size;
+
+        // keep staging payload in sync with values read from device
+        registerObjId({entry.index, entry.subIndex});
     }
-    sendData();
 }
 
-/**
- * @brief Send data on bus
- */
-bool RPDO::sendData()
+int RPDO::encodeEntryId(const NodeObjectId &object) const
 {
-    if (!bus()->canWrite())
+    for (int entryId = 0; entryId < _encodePlan.size(); entryId++)
     {
-        return false;
+        const EncodeEntry &entry = _encodePlan.at(entryId);
+        if (entry.index == object.index() && entry.subIndex == object.subIndex())
+        {
+            return entryId;
+        }
     }
+    return -1;
+}
 
-    QCanBusFrame frame;
-    frame.setFrameId(_cobId);
-    frame.setPayload(_rpdoDataToSendReqPayload);
-    return bus()->writeFrame(frame);
+RPDO::EncodeType RPDO::encodeType(NodeSubIndex::DataType dataType)
+{
+    switch (dataType)
+    {
+        case NodeSubIndex::BOOLEAN:
+        case NodeSubIndex::UNSIGNED8:
+            return EncodeU8;
+
+        case NodeSubIndex::INTEGER8:
+            return EncodeI8;
+
+        case NodeSubIndex::UNSIGNED16:
+            return EncodeU16;
+
+        case NodeSubIndex::INTEGER16:
+            return EncodeI16;
+
+        case NodeSubIndex::UNSIGNED32:
+            return EncodeU32;
+
+        case NodeSubIndex::INTEGER32:
+            return EncodeI32;
+
+        case NodeSubIndex::REAL32:
+            return EncodeFloat;
+
+        case NodeSubIndex::UNSIGNED24:
+        case NodeSubIndex::UNSIGNED40:
+        case NodeSubIndex::UNSIGNED48:
+        case NodeSubIndex::UNSIGNED56:
+        case NodeSubIndex::UNSIGNED64:
+            return EncodeU64;
+
+        case NodeSubIndex::INTEGER24:
+        case NodeSubIndex::INTEGER40:
+        case NodeSubIndex::INTEGER48:
+        case NodeSubIndex::INTEGER56:
+        case NodeSubIndex::INTEGER64:
+            return EncodeI64;
+
+        case NodeSubIndex::REAL64:
+            return EncodeDouble;
+
+        default:
+            return EncodeInvalid;
+    }
 }
 
-/**
- * @brief Convert QVariant To QDataStream
- * @param request -> value converted
- * @param data value to convert
- * @param data QMetaType
- */
-void RPDO::convertQVariantToQDataStream(QDataStream &request, const QVariant &data, QMetaType::Type type)
+void RPDO::encodeVariant(const EncodeEntry &entry, const QVariant &data)
 {
-    switch (type)
+    switch (entry.type)
     {
-        case QMetaType::Long:
-        case QMetaType::LongLong:
-        case QMetaType::Int:
-            request << data.value<int>();
+        case EncodeU8:
+        case EncodeU16:
+        case EncodeU32:
+        case EncodeU64:
+            encodeNumber(entry, data.toULongLong());
+            break;
+
+        case EncodeI8:
+        case EncodeI16:
+        case EncodeI32:
+        case EncodeI64:
+            encodeNumber(entry, data.toLongLong());
             break;
 
-        case QMetaType::ULong:
-        case QMetaType::ULongLong:
-        case QMetaType::UInt:
-            request << data.value<unsigned int>();
+        case EncodeFloat:
+        case EncodeDouble:
+            encodeNumber(entry, data.toDouble());
+            break;
+
+        case EncodeInvalid:
+        {
+            // raw bytes (strings, domains), zero padded
+            const QByteArray bytes = data.toByteArray();
+            int size = qMin(bytes.size(), static_cast<int>(entry.size));
+            memcpy(_stagingBuffer + entry.offset, bytes.constData(), static_cast<size_t>(size));
+            memset(_stagingBuffer + entry.offset + size, 0, static_cast<size_t>(entry.size - size));
+            break;
+        }
+    }
+}
+
+QVariant RPDO::decodeEntry(const EncodeEntry &entry) const
+{
+    const quint8 *src = _stagingBuffer + entry.offset;
+    switch (entry.type)
+    {
+        case EncodeU8:
+            return QVariant(static_cast<uint>(*src));
+
+        case EncodeI8:
+            return QVariant(static_cast<int>(static_cast<qint8>(*src)));
+
+        case EncodeU16:
+            return QVariant(static_cast<uint>(qFromLittleEndian<quint16>(src)));
+
+        case EncodeI16:
+            return QVariant(static_cast<int>(qFromLittleEndian<qint16>(src)));
+
+        case EncodeU32:
+            return QVariant(qFromLittleEndian<quint32>(src));
+
+        case EncodeI32:
+            return QVariant(qFromLittleEndian<qint32>(src));
+
+        case EncodeFloat:
+        {
+            quint32 raw = qFromLittleEndian<quint32>(src);
+            float value;
+            memcpy(&value, &raw, sizeof(value));
+            return QVariant(value);
+        }
+
+        case EncodeU64:
+        case EncodeI64:
+        {
+            quint8 bytes[8] = {0};
+            memcpy(bytes, src, entry.size);
+            if (entry.type == EncodeI64 && entry.size < 8 && (bytes[entry.size - 1] & 0x80) != 0)
+            {
+                memset(bytes + entry.size, 0xFF, static_cast<size_t>(8 - entry.size));
+            }
+            if (entry.type == EncodeI64)
+            {
+                return QVariant(qFromLittleEndian<qint64>(bytes));
+            }
+            return QVariant(qFromLittleEndian<quint64>(bytes));
+        }
+
+        case EncodeDouble:
+        {
+            quint64 raw = qFromLittleEndian<quint64>(src);
+            double value;
+            memcpy(&value, &raw, sizeof(value));
+            return QVariant(value);
+        }
+
+        case EncodeInvalid:
             break;
+    }
+    return QVariant(QByteArray(reinterpret_cast<const char *>(src), entry.size));
+}
 
-        case QMetaType::Double:
-            request << data.value<double>();
+template <typename T>
+void RPDO::writeTyped(const NodeObjectId &object, T value)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    int entryId = encodeEntryId(object);
+    if (entryId < 0)
+    {
+        return;
+    }
+
+    encodeNumber(_encodePlan.at(entryId), value);
+    _writtenMask |= (Q_UINT64_C(1) << entryId);
+}
+
+template <typename T>
+void RPDO::encodeNumber(const EncodeEntry &entry, T value)
+{
+    quint8 *dest = _stagingBuffer + entry.offset;
+    switch (entry.type)
+    {
+        case EncodeU8:
+            *dest = static_cast<quint8>(value);
             break;
 
-        case QMetaType::Short:
-            request << data.value<short>();
+        case EncodeI8:
+            *dest = static_cast<quint8>(static_cast<qint8>(value));
             break;
 
-        case QMetaType::Char:
-            request << data.value<char>();
+        case EncodeU16:
+            qToLittleEndian<quint16>(static_cast<quint16>(value), dest);
             break;
 
-        case QMetaType::UShort:
-            request << data.value<unsigned short>();
+        case EncodeI16:
+            qToLittleEndian<qint16>(static_cast<qint16>(value), dest);
             break;
 
-        case QMetaType::UChar:
-            request << data.value<unsigned char>();
+        case EncodeU32:
+            qToLittleEndian<quint32>(static_cast<quint32>(value), dest);
             break;
 
-        case QMetaType::Float:
-            request << data.value<float>();
+        case EncodeI32:
+            qToLittleEndian<qint32>(static_cast<qint32>(value), dest);
             break;
 
-        case QMetaType::SChar:
-            request << data.value<signed char>();
+        case EncodeFloat:
+        {
+            float floatValue = static_cast<float>(value);
+            quint32 raw;
+            memcpy(&raw, &floatValue, sizeof(raw));
+            qToLittleEndian<quint32>(raw, dest);
             break;
+        }
 
-        case QMetaType::QString:
-            request << data;
+        case EncodeU64:
+        case EncodeI64:
+        {
+            // 24 to 64 bits integers, truncated to the mapped size
+            quint8 bytes[8];
+            if (entry.type == EncodeI64)
+            {
+                qToLittleEndian<qint64>(static_cast<qint64>(value), bytes);
+            }
+            else
+            {
+                qToLittleEndian<quint64>(static_cast<quint64>(value), bytes);
+            }
+            memcpy(dest, bytes, entry.size);
             break;
+        }
 
-        case QMetaType::QByteArray:
-            request << data;
+        case EncodeDouble:
+        {
+            double doubleValue = static_cast<double>(value);
+            quint64 raw;
+            memcpy(&raw, &doubleValue, sizeof(raw));
+            qToLittleEndian<quint64>(raw, dest);
             break;
+        }
 
-        default:
+        case EncodeInvalid:
             break;
     }
 }
 
+/**
+ * @brief Send data on bus
+ */
+bool RPDO::sendData()
+{
+    if (!bus()->canWrite())
+    {
+        return false;
+    }
+
+    QCanBusFrame frame;
+    frame.setFrameId(_cobId);
+    if (_payloadSize > 8)
+    {
+        // CAN FD frame, padded with zeros after the mapped objects
+        frame.setPayload(QByteArray(reinterpret_cast<const char *>(_stagingBuffer), CanBusDriver::canFdPayloadSize(_payloadSize)));
+        frame.setFlexibleDataRateFormat(true);
+        frame.setBitrateSwitch(true);
+    }
+    else
+    {
+        frame.setPayload(QByteArray(reinterpret_cast<const char *>(_stagingBuffer), _payloadSize));
+    }
+    return bus()->writeFrame(frame);
+}
+
 bool RPDO::isTPDO() const
 {
     return false;
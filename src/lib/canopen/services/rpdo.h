@@ -26,6 +26,9 @@
 #include "nodeobjectid.h"
 #include "nodeod.h"
 #include "nodeodsubscriber.h"
+#include "nodesubindex.h"
+
+#include <QVector>
 
 class CANOPEN_EXPORT RPDO : public PDO
 {
@@ -44,17 +47,64 @@ public:
     quint8 transmissionType();
 
     void write(const NodeObjectId &object, const QVariant &data);
+    void write(const NodeObjectId &object, qint8 value);
+    void write(const NodeObjectId &object, quint8 value);
+    void write(const NodeObjectId &object, qint16 value);
+    void write(const NodeObjectId &object, quint16 value);
+    void write(const NodeObjectId &object, qint32 value);
+    void write(const NodeObjectId &object, quint32 value);
+    void write(const NodeObjectId &object, float value);
     void clearDataWaiting() override;
 
 protected slots:
     void receiveSync();
     void prepareAndSendData();
+    void compileEncodePlan();
 
 private:
-    QMap<quint64, QVariant> _dataObjectCurrentMapped;
-    QByteArray _rpdoDataToSendReqPayload;
+    // encode plan, compiled once per mapping change
+    enum EncodeType : quint8
+    {
+        EncodeInvalid,
+        EncodeU8,
+        EncodeI8,
+        EncodeU16,
+        EncodeI16,
+        EncodeU32,
+        EncodeI32,
+        EncodeFloat,
+        EncodeU64,
+        EncodeI64,
+        EncodeDouble
+    };
+    struct EncodeEntry
+    {
+        quint16 index;
+        quint8 subIndex;
+        quint8 offset;
+        quint8 size;
+        EncodeType type;
+        NodeSubIndex *nodeSubIndex;
+    };
+    enum
+    {
+        RPDO_STAGING_SIZE = 64  // CAN FD max payload
+    };
+    QVector<EncodeEntry> _encodePlan;
+    quint8 _stagingBuffer[RPDO_STAGING_SIZE];
+    int _payloadSize;
+    quint64 _writtenMask;  // entries written by write(), up to 64 entries
+
+    int encodeEntryId(const NodeObjectId &object) const;
+    static EncodeType encodeType(NodeSubIndex::DataType dataType);
+    void encodeVariant(const EncodeEntry &entry, const QVariant &data);
+    QVariant decodeEntry(const EncodeEntry &entry) const;
+    template <typename T>
+    void writeTyped(const NodeObjectId &object, T value);
+    template <typename T>
+    void encodeNumber(const EncodeEntry &entry, T value);
+
     bool sendData();
-    void convertQVariantToQDataStream(QDataStream &request, const QVariant &data, QMetaType::Type type);
 
     // Service interface
 public:
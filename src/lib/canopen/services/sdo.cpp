@@ -40,8 +40,7 @@ SDO::SDO(Node *node)
     _cobIds.append(_cobIdClientToServer + _nodeId);
     _cobIds.append(_cobIdServerToClient + _nodeId);
 
-    _timeoutTimer = new QTimer(this);
-    connect(_timeoutTimer, &QTimer::timeout, this, &SDO::timeout);
+    _timeoutTimer = new TimerWheel::Timer(this);
 
     _subBlockDownloadTimer = new QTimer(this);
     connect(_subBlockDownloadTimer, &QTimer::timeout, this, &SDO::sdoBlockDownloadSubBlock);
@@ -95,6 +94,7 @@ void SDO::reset()
     _timeoutTimer->stop();
     qDeleteAll(_requestQueue);
     _requestQueue.clear();
+    _queuedUploads.clear();
     _status = SDO_STATE_FREE;
 }
 
@@ -266,17 +266,11 @@ QString SDO::sdoAbort(quint32 error) const
  */
 bool SDO::uploadData(quint16 index, quint8 subindex, QMetaType::Type dataType)
 {
-    bool existing = false;
-    for (RequestSdo *req : qAsConst(_requestQueue))
-    {
-        if (req->index == index && req->subIndex == subindex)
-        {
-            existing = true;
-        }
-    }
-
-    if (!existing)
+    // an upload already queued for this object is not duplicated
+    quint32 key = (static_cast<quint32>(index) << 8) | subindex;
+    if (!_queuedUploads.contains(key))
     {
+        _queuedUploads.insert(key);
         RequestSdo *request = new RequestSdo();
         request->index = index;
         request->subIndex = subindex;
@@ -325,6 +319,39 @@ bool SDO::downloadData(quint16 index, quint8 subindex, const QVariant &data)
     return true;
 }
 
+/**
+ * @brief Removes the last queued request on index/subindex that was not started yet
+ * @param index
+ * @param subindex
+ * @param upload true to remove an upload request, false for a download request
+ * @return true if a request was removed, false if none was queued or if a transfer of this
+ * object is in progress
+ */
+bool SDO::cancelRequest(quint16 index, quint8 subindex, bool upload)
+{
+    if (_status == SDO_STATE_NOT_FREE && _requestCurrent != nullptr && _requestCurrent->index == index && _requestCurrent->subIndex == subindex)
+    {
+        return false;
+    }
+
+    RequestState state = upload ? STATE_UPLOAD : STATE_DOWNLOAD;
+    for (int i = _requestQueue.size() - 1; i >= 0; i--)
+    {
+        RequestSdo *request = _requestQueue.at(i);
+        if (request->index == index && request->subIndex == subindex && request->state == state)
+        {
+            if (upload)
+            {
+                _queuedUploads.remove((static_cast<quint32>(index) << 8) | subindex);
+            }
+            _requestQueue.removeAt(i);
+            delete request;
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Dispatched of SDO Upload protocol (Expedited/Segmented/Block)
  * @return 0->ok 1->nok
@@ -904,6 +931,12 @@ void SDO::sdoBlockDownloadSubBlock()
         return;
     }
 
+    // back-pressure, segments are sent at next timer tick when the SDO lane is congested
+    if (bus()->txScheduler()->isCongested(TxScheduler::LaneSdo))
+    {
+        return;
+    }
+
     if (_requestCurrent->seqno <= _requestCurrent->blksize)
     {
         seek = _requestCurrent->size - _requestCurrent->stay;
@@ -1019,6 +1052,7 @@ void SDO::nextRequest()
         _requestCurrent = _requestQueue.dequeue();
         if (_requestCurrent->state == STATE_UPLOAD)
         {
+            _queuedUploads.remove((static_cast<quint32>(_requestCurrent->index) << 8) | _requestCurrent->subIndex);
             _status = SDO_STATE_NOT_FREE;
             uploadDispatcher();
         }
@@ -1034,6 +1068,12 @@ void SDO::nextRequest()
     }
 }
 
+void SDO::timerWheelEvent(int timerId)
+{
+    Q_UNUSED(timerId)
+    timeout();
+}
+
 /**
  * @brief Management timeout, send SDO TIMEOUT on device
  */
@@ -24,11 +24,13 @@
 #include "service.h"
 
 #include <QQueue>
+#include <QSet>
 #include <QTimer>
 
 #include "nodeindex.h"
+#include "timerwheel.h"
 
-class CANOPEN_EXPORT SDO : public Service
+class CANOPEN_EXPORT SDO : public Service, public TimerWheelClient
 {
     Q_OBJECT
 public:
@@ -51,6 +53,7 @@ public:
 
     bool uploadData(quint16 index, quint8 subindex, QMetaType::Type dataType);
     bool downloadData(quint16 index, quint8 subindex, const QVariant &data);
+    bool cancelRequest(quint16 index, quint8 subindex, bool upload);
 
     enum Status
     {
@@ -156,6 +159,7 @@ private:
 
     RequestSdo *_requestCurrent;
     QQueue<RequestSdo *> _requestQueue;
+    QSet<quint32> _queuedUploads;
     Status _status;
 
     bool uploadDispatcher();
@@ -166,7 +170,7 @@ private:
     void endRequest();
     void nextRequest();
 
-    QTimer *_timeoutTimer;
+    TimerWheel::Timer *_timeoutTimer;
     void timeout();
 
     QTimer *_subBlockDownloadTimer;
@@ -266,6 +270,10 @@ private:
         BLOCK_BLOCK_SIZE = 0x7F,     // size max by block
         BLOCK_SEQNO_MASK = 0x7F      // Max segment by sub-block
     };
+
+    // TimerWheelClient interface
+protected:
+    void timerWheelEvent(int timerId) override;
 };
 
 #endif  // SDO_H
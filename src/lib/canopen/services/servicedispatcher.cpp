@@ -21,6 +21,7 @@
 #include "canopen.h"
 #include "node.h"
 #include <QDebug>
+#include <QSet>
 
 ServiceDispatcher::ServiceDispatcher(CanOpenBus *bus)
     : Service(bus)
@@ -42,6 +43,7 @@ void ServiceDispatcher::addService(Service *service)
     {
         _servicesMap.insert(cobId, service);
     }
+    emit servicesChanged();
 }
 
 void ServiceDispatcher::removeService(Service *service)
@@ -50,6 +52,7 @@ void ServiceDispatcher::removeService(Service *service)
     {
         _servicesMap.remove(cobId, service);
     }
+    emit servicesChanged();
 }
 
 void ServiceDispatcher::parseFrame(const QCanBusFrame &frame)
@@ -62,3 +65,112 @@ void ServiceDispatcher::parseFrame(const QCanBusFrame &frame)
         ++service;
     }
 }
+
+bool ServiceDispatcher::hasService(quint32 cobId) const
+{
+    return _servicesMap.contains(cobId);
+}
+
+/**
+ * @brief computes a minimal set of id/mask filters matching exactly the registered cob ids
+ *
+ * Prime implicants of the cob id set are built by merging ids differing by one bit (Quine-McCluskey),
+ * then greedily selected to cover all ids. No filter accepts an unregistered cob id.
+ */
+QList<CanBusDriver::Filter> ServiceDispatcher::cobIdFilters() const
+{
+    // implicant coded as mask << 16 | id, 11 bits ids
+    QSet<quint32> current;
+    const QList<quint32> cobIds = _servicesMap.uniqueKeys();
+    for (quint32 cobId : cobIds)
+    {
+        current.insert((0x7FFU << 16) | (cobId & 0x7FFU));
+    }
+
+    QSet<quint32> primes;
+    while (!current.isEmpty())
+    {
+        QSet<quint32> next;
+        QSet<quint32> merged;
+        for (quint32 implicant : qAsConst(current))
+        {
+            quint32 mask = implicant >> 16;
+            quint32 id = implicant & 0x7FFU;
+            for (quint32 bit = 1; bit <= 0x400U; bit <<= 1)
+            {
+                if ((mask & bit) == 0)
+                {
+                    continue;
+                }
+                quint32 neighbour = (mask << 16) | (id ^ bit);
+                if (current.contains(neighbour))
+                {
+                    next.insert(((mask & ~bit) << 16) | (id & ~bit));
+                    merged.insert(implicant);
+                }
+            }
+        }
+        for (quint32 implicant : qAsConst(current))
+        {
+            if (!merged.contains(implicant))
+            {
+                primes.insert(implicant);
+            }
+        }
+        current = next;
+    }
+
+    QList<CanBusDriver::Filter> filters;
+    QSet<quint32> uncovered;
+    for (quint32 cobId : cobIds)
+    {
+        uncovered.insert(cobId & 0x7FFU);
+    }
+    while (!uncovered.isEmpty())
+    {
+        quint32 bestImplicant = 0;
+        int bestCount = 0;
+        for (quint32 implicant : qAsConst(primes))
+        {
+            quint32 mask = implicant >> 16;
+            quint32 id = implicant & 0x7FFU;
+            int count = 0;
+            for (quint32 cobId : qAsConst(uncovered))
+            {
+                if ((cobId & mask) == id)
+                {
+                    count++;
+                }
+            }
+            if (count > bestCount)
+            {
+                bestCount = count;
+                bestImplicant = implicant;
+            }
+        }
+        if (bestCount == 0)
+        {
+            break;
+        }
+
+        CanBusDriver::Filter filter;
+        filter.id = bestImplicant & 0x7FFU;
+        filter.mask = bestImplicant >> 16;
+        filters.append(filter);
+        primes.remove(bestImplicant);
+
+        QSet<quint32>::iterator it = uncovered.begin();
+        while (it != uncovered.end())
+        {
+            if ((*it & filter.mask) == filter.id)
+            {
+                it = uncovered.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    return filters;
+}
@@ -39,6 +39,12 @@ public:
 
     void parseFrame(const QCanBusFrame &frame) override;
 
+    bool hasService(quint32 cobId) const;
+    QList<CanBusDriver::Filter> cobIdFilters() const;
+
+signals:
+    void servicesChanged();
+
 protected:
     QMultiMap<quint32, Service *> _servicesMap;
 };
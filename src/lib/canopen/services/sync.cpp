@@ -35,7 +35,8 @@ Sync::Sync(CanOpenBus *bus)
 
     _signalBeforeSync = new QTimer();
     _signalBeforeSync->setTimerType(Qt::PreciseTimer);
-    connect(_signalBeforeSync, &QTimer::timeout, this, &Sync::signalBeforeSync);
+    _signalBeforeSync->setSingleShot(true);
+    connect(_signalBeforeSync, &QTimer::timeout, this, &Sync::sendBeforeSync);
 }
 
 Sync::~Sync()
@@ -68,6 +69,18 @@ Sync::Status Sync::status()
     return _status;
 }
 
+/**
+ * @brief SYNC period in ms of the started cyclic SYNC, 0 if not started
+ */
+int Sync::syncPeriod() const
+{
+    if (_status != STARTED || !_syncTimer->isActive())
+    {
+        return 0;
+    }
+    return _syncTimer->interval();
+}
+
 void Sync::sendSync()
 {
     if (!bus()->canWrite())
@@ -78,9 +91,24 @@ void Sync::sendSync()
     QCanBusFrame frameSync;
     frameSync.setFrameId(_syncCobId);
     bus()->writeFrame(frameSync);
+    if (_syncTimer->isActive())
+    {
+        // before sync phase at 3/4 of each period, re-armed on each SYNC to stay in phase with it
+        _signalBeforeSync->start((_syncTimer->interval() * 3) / 4);
+    }
     emit syncEmitted();
 }
 
+/**
+ * @brief before sync phase, setpoints are first committed in RPDOs with commitBeforeSync(),
+ * then RPDOs send their payload on signalBeforeSync(), all in the same TX batch
+ */
+void Sync::sendBeforeSync()
+{
+    emit commitBeforeSync();
+    emit signalBeforeSync();
+}
+
 void Sync::sendSyncOneTimeout()
 {
     sendSync();
@@ -94,7 +122,7 @@ void Sync::sendSyncOne()
         return;
     }
     _status = STARTED;
-    emit signalBeforeSync();
+    sendBeforeSync();
     QTimer::singleShot(ONE_SHOT_TIMER, this, &Sync::sendSyncOneTimeout);
 }
 
@@ -42,6 +42,7 @@ public:
     };
 
     Status status();
+    int syncPeriod() const;
     QString type() const override;
 
     void parseFrame(const QCanBusFrame &frame) override;
@@ -51,10 +52,12 @@ public slots:
 
 private slots:
     void sendSync();
+    void sendBeforeSync();
     void sendSyncOneTimeout();
 
 signals:
     void syncEmitted();
+    void commitBeforeSync();
     void signalBeforeSync();
     void syncOneRequested();
 
@@ -0,0 +1,300 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "timerwheel.h"
+
+/**
+ * @brief process wide timer wheel, never destroyed to stay valid for late timer destructors
+ */
+TimerWheel *TimerWheel::instance()
+{
+    static TimerWheel *timerWheel = nullptr;
+    if (timerWheel == nullptr)
+    {
+        timerWheel = new TimerWheel();
+    }
+    return timerWheel;
+}
+
+TimerWheel::TimerWheel()
+{
+    for (Link &slot : _level0)
+    {
+        linkInit(&slot);
+    }
+    for (Link &slot : _level1)
+    {
+        linkInit(&slot);
+    }
+    for (Link &slot : _level2)
+    {
+        linkInit(&slot);
+    }
+    _upperLevelCount = 0;
+    _activeCount = 0;
+    _processing = false;
+
+    _clock.start();
+    _currentTick = 0;
+    _wakeTick = 0;
+
+    _wakeTimer = new QTimer(this);
+    _wakeTimer->setSingleShot(true);
+    _wakeTimer->setTimerType(Qt::PreciseTimer);
+    connect(_wakeTimer, &QTimer::timeout, this, &TimerWheel::processExpiries);
+}
+
+qint64 TimerWheel::currentTimeMs() const
+{
+    return _clock.elapsed();
+}
+
+int TimerWheel::activeTimersCount() const
+{
+    return _activeCount;
+}
+
+void TimerWheel::processExpiries()
+{
+    qint64 now = _clock.elapsed();
+    if (_activeCount == 0)
+    {
+        _currentTick = now;
+        return;
+    }
+
+    _processing = true;
+    while (_currentTick < now)
+    {
+        _currentTick++;
+
+        // upper levels slots are moved down when lower levels wrap
+        if ((_currentTick & (LEVEL0_SIZE - 1)) == 0)
+        {
+            qint64 level1Index = _currentTick >> LEVEL0_BITS;
+            if ((level1Index & (LEVEL_SIZE - 1)) == 0)
+            {
+                cascade(&_level2[(level1Index >> LEVEL_BITS) & (LEVEL_SIZE - 1)]);
+            }
+            cascade(&_level1[level1Index & (LEVEL_SIZE - 1)]);
+        }
+
+        Link *slot = &_level0[_currentTick & (LEVEL0_SIZE - 1)];
+        if (slot->next == slot)
+        {
+            continue;
+        }
+
+        // expired timers are detached first, a callback can start or stop any timer
+        Link expired;
+        linkInit(&expired);
+        expired.next = slot->next;
+        expired.prev = slot->prev;
+        expired.next->prev = &expired;
+        expired.prev->next = &expired;
+        linkInit(slot);
+
+        while (expired.next != &expired)
+        {
+            Timer *timer = static_cast<Timer *>(expired.next);
+            remove(timer);
+            timer->_client->timerWheelEvent(timer->_timerId);
+        }
+    }
+    _processing = false;
+
+    scheduleWake();
+}
+
+void TimerWheel::insert(Timer *timer)
+{
+    qint64 delta = timer->_expiryMs - _currentTick;
+    if (delta < LEVEL0_SIZE)
+    {
+        timer->_level = 0;
+        linkAppend(&_level0[timer->_expiryMs & (LEVEL0_SIZE - 1)], timer);
+    }
+    else if (delta < (LEVEL0_SIZE << LEVEL_BITS))
+    {
+        timer->_level = 1;
+        linkAppend(&_level1[(timer->_expiryMs >> LEVEL0_BITS) & (LEVEL_SIZE - 1)], timer);
+    }
+    else
+    {
+        // far timers are clamped to the last level 2 slot and cascaded again
+        qint64 level2Index = timer->_expiryMs >> (LEVEL0_BITS + LEVEL_BITS);
+        if (delta >= (LEVEL0_SIZE << (2 * LEVEL_BITS)))
+        {
+            level2Index = (_currentTick >> (LEVEL0_BITS + LEVEL_BITS)) + LEVEL_SIZE - 1;
+        }
+        timer->_level = 2;
+        linkAppend(&_level2[level2Index & (LEVEL_SIZE - 1)], timer);
+    }
+
+    if (timer->_level != 0)
+    {
+        _upperLevelCount++;
+    }
+}
+
+void TimerWheel::remove(Timer *timer)
+{
+    linkRemove(timer);
+    if (timer->_level != 0)
+    {
+        _upperLevelCount--;
+    }
+    _activeCount--;
+}
+
+void TimerWheel::cascade(Link *slot)
+{
+    Link *link = slot->next;
+    linkInit(slot);
+    while (link != slot)
+    {
+        Link *next = link->next;
+        Timer *timer = static_cast<Timer *>(link);
+        _upperLevelCount--;
+        insert(timer);
+        link = next;
+    }
+}
+
+/**
+ * @brief arms the wake timer on the next non empty level 0 slot, or on the next level 1 boundary
+ */
+void TimerWheel::scheduleWake()
+{
+    if (_activeCount == 0)
+    {
+        _wakeTimer->stop();
+        return;
+    }
+
+    qint64 delay = LEVEL0_SIZE;
+    for (qint64 i = 1; i < LEVEL0_SIZE; i++)
+    {
+        const Link *slot = &_level0[(_currentTick + i) & (LEVEL0_SIZE - 1)];
+        if (slot->next != slot)
+        {
+            delay = i;
+            break;
+        }
+    }
+    if (_upperLevelCount > 0)
+    {
+        delay = qMin(delay, LEVEL0_SIZE - (_currentTick & (LEVEL0_SIZE - 1)));
+    }
+
+    _wakeTick = _currentTick + delay;
+    _wakeTimer->start(static_cast<int>(qMax(_wakeTick - _clock.elapsed(), Q_INT64_C(0))));
+}
+
+void TimerWheel::linkInit(Link *link)
+{
+    link->prev = link;
+    link->next = link;
+}
+
+void TimerWheel::linkAppend(Link *head, Link *link)
+{
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+void TimerWheel::linkRemove(Link *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = nullptr;
+    link->next = nullptr;
+}
+
+TimerWheel::Timer::Timer(TimerWheelClient *client, int timerId)
+    : _client(client)
+    , _timerId(timerId)
+{
+    prev = nullptr;
+    next = nullptr;
+    _expiryMs = 0;
+    _level = 0;
+}
+
+TimerWheel::Timer::~Timer()
+{
+    stop();
+}
+
+/**
+ * @brief starts or restarts the timer as a single shot of intervalMs
+ */
+void TimerWheel::Timer::start(int intervalMs)
+{
+    TimerWheel *wheel = TimerWheel::instance();
+    if (isActive())
+    {
+        wheel->remove(this);
+    }
+    if (wheel->_activeCount == 0 && !wheel->_processing)
+    {
+        // idle wheel catches up the clock without walking the elapsed ticks
+        wheel->_currentTick = wheel->_clock.elapsed();
+    }
+
+    _expiryMs = qMax(wheel->_clock.elapsed() + qMax(intervalMs, 0), wheel->_currentTick + 1);
+    wheel->insert(this);
+    wheel->_activeCount++;
+
+    if (!wheel->_processing && (!wheel->_wakeTimer->isActive() || _expiryMs < wheel->_wakeTick))
+    {
+        wheel->_wakeTick = _expiryMs;
+        wheel->_wakeTimer->start(static_cast<int>(qMax(_expiryMs - wheel->_clock.elapsed(), Q_INT64_C(0))));
+    }
+}
+
+void TimerWheel::Timer::stop()
+{
+    if (isActive())
+    {
+        TimerWheel::instance()->remove(this);
+    }
+}
+
+bool TimerWheel::Timer::isActive() const
+{
+    return (next != nullptr);
+}
+
+/**
+ * @brief remaining time in ms before expiry, -1 if inactive
+ */
+int TimerWheel::Timer::remainingTime() const
+{
+    if (!isActive())
+    {
+        return -1;
+    }
+    return static_cast<int>(qMax(_expiryMs - TimerWheel::instance()->currentTimeMs(), Q_INT64_C(0)));
+}
+
+TimerWheelClient::~TimerWheelClient()
+{
+}
@@ -0,0 +1,120 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+class TimerWheelClient;
+
+/**
+ * @brief Hierarchical timer wheel with 1 ms resolution, shared by all protocol timeouts
+ *
+ * Three levels of 256 x 1 ms, 64 x 256 ms and 64 x 16.4 s slots. Starting and stopping a
+ * timer is O(1) and does not allocate, expiries are dispatched from one precise QTimer
+ * armed on the next non empty slot.
+ */
+class CANOPEN_EXPORT TimerWheel : public QObject
+{
+    Q_OBJECT
+public:
+    static TimerWheel *instance();
+
+    qint64 currentTimeMs() const;
+    int activeTimersCount() const;
+
+    struct Link
+    {
+        Link *prev;
+        Link *next;
+    };
+
+    class CANOPEN_EXPORT Timer : private Link
+    {
+    public:
+        Timer(TimerWheelClient *client, int timerId = 0);
+        ~Timer();
+
+        void start(int intervalMs);
+        void stop();
+        bool isActive() const;
+        int remainingTime() const;
+
+    private:
+        friend class TimerWheel;
+        TimerWheelClient *_client;
+        int _timerId;
+        qint64 _expiryMs;
+        int _level;
+
+        Q_DISABLE_COPY(Timer)
+    };
+
+protected slots:
+    void processExpiries();
+
+private:
+    TimerWheel();
+
+    enum
+    {
+        LEVEL0_BITS = 8,
+        LEVEL_BITS = 6,
+        LEVEL0_SIZE = 1 << LEVEL0_BITS,
+        LEVEL_SIZE = 1 << LEVEL_BITS
+    };
+
+    Link _level0[LEVEL0_SIZE];
+    Link _level1[LEVEL_SIZE];
+    Link _level2[LEVEL_SIZE];
+    int _upperLevelCount;
+    int _activeCount;
+
+    QElapsedTimer _clock;
+    qint64 _currentTick;
+    qint64 _wakeTick;
+    QTimer *_wakeTimer;
+    bool _processing;
+
+    void insert(Timer *timer);
+    void remove(Timer *timer);
+    void cascade(Link *slot);
+    void scheduleWake();
+
+    static void linkInit(Link *link);
+    static void linkAppend(Link *head, Link *link);
+    static void linkRemove(Link *link);
+};
+
+class CANOPEN_EXPORT TimerWheelClient
+{
+public:
+    virtual ~TimerWheelClient();
+
+protected:
+    friend class TimerWheel;
+    virtual void timerWheelEvent(int timerId) = 0;
+};
+
+#endif  // TIMERWHEEL_H
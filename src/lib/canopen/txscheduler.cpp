@@ -0,0 +1,605 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "txscheduler.h"
+
+#include "canopenbus.h"
+
+#include <QDateTime>
+
+TxScheduler::TxScheduler(CanOpenBus *bus)
+    : QObject(bus),
+      _bus(bus)
+{
+    for (LaneQueue &lane : _lanes)
+    {
+        lane.capacity = 256;
+        lane.budget = 0;
+        lane.tokens = 0;
+        lane.lastRefillNs = 0;
+        lane.congested = false;
+    }
+    _lanes[LaneSdo].capacity = 1024;
+    resetStats();
+
+    _clock.start();
+    _epochOffsetUs = QDateTime::currentMSecsSinceEpoch() * 1000;
+    _sequence = 0;
+    _retryCount = 0;
+    _processing = false;
+
+    _wakeTimer = new QTimer(this);
+    _wakeTimer->setSingleShot(true);
+    _wakeTimer->setTimerType(Qt::PreciseTimer);
+    connect(_wakeTimer, &QTimer::timeout, this, &TxScheduler::processQueue);
+}
+
+TxScheduler::Lane TxScheduler::laneForFrame(const QCanBusFrame &frame)
+{
+    if (frame.hasExtendedFrameFormat())
+    {
+        return LaneOther;
+    }
+
+    quint32 cobId = frame.frameId();
+    if (cobId == 0x000)
+    {
+        return LaneNmt;
+    }
+    if (cobId == 0x080)
+    {
+        return LaneSync;
+    }
+    if (cobId < 0x100)
+    {
+        return LaneEmergency;
+    }
+    if (cobId == 0x100)
+    {
+        return LaneTime;
+    }
+    if (cobId >= 0x180 && cobId < 0x580)
+    {
+        return LanePdo;
+    }
+    if (cobId >= 0x580 && cobId < 0x680)
+    {
+        return LaneSdo;
+    }
+    return LaneOther;
+}
+
+QString TxScheduler::laneStr(Lane lane)
+{
+    switch (lane)
+    {
+        case TxScheduler::LaneNmt:
+            return tr("NMT");
+
+        case TxScheduler::LaneSync:
+            return tr("SYNC");
+
+        case TxScheduler::LaneEmergency:
+            return tr("EMCY");
+
+        case TxScheduler::LaneTime:
+            return tr("TIME");
+
+        case TxScheduler::LanePdo:
+            return tr("PDO");
+
+        case TxScheduler::LaneSdo:
+            return tr("SDO");
+
+        case TxScheduler::LaneOther:
+            return tr("Other");
+
+        case TxScheduler::LaneCount:
+            break;
+    }
+    return QString();
+}
+
+/**
+ * @brief sends frame immediately if nothing is pending, queues it in its lane otherwise
+ * @return false if the lane is full and the frame dropped
+ */
+bool TxScheduler::queueFrame(const QCanBusFrame &frame)
+{
+    Lane laneId = laneForFrame(frame);
+    LaneQueue &lane = _lanes[laneId];
+    qint64 now = _clock.nsecsElapsed();
+
+    // with an inhibit time, a newer frame of the same cob id replaces the pending one
+    if (_inhibitTimesNs.contains(frame.frameId()))
+    {
+        for (PendingFrame &pending : lane.frames)
+        {
+            if (pending.frame.frameId() == frame.frameId())
+            {
+                pending.frame = frame;
+                lane.stats.coalesced++;
+                return true;
+            }
+        }
+    }
+
+    if (sendNow(laneId, frame, now))
+    {
+        return true;
+    }
+
+    if (lane.frames.count() >= lane.capacity)
+    {
+        lane.stats.dropped++;
+        return false;
+    }
+
+    lane.frames.append({frame, now, _sequence++});
+    lane.stats.queued++;
+    if (lane.frames.count() >= lane.capacity / 2)
+    {
+        lane.congested = true;
+    }
+
+    // frames queued during the same event loop tick are sent in one batch,
+    // while the driver refuses frames the retry timer drives the queue
+    if (_retryCount == 0 && (!_wakeTimer->isActive() || _wakeTimer->remainingTime() > 0))
+    {
+        _wakeTimer->start(0);
+    }
+    return true;
+}
+
+void TxScheduler::clear()
+{
+    for (int laneId = 0; laneId < LaneCount; laneId++)
+    {
+        _lanes[laneId].stats.dropped += static_cast<quint64>(_lanes[laneId].frames.count());
+        _lanes[laneId].frames.clear();
+        frameRemoved(static_cast<Lane>(laneId));
+    }
+    _wakeTimer->stop();
+    _retryCount = 0;
+}
+
+int TxScheduler::laneCapacity(Lane lane) const
+{
+    return _lanes[lane].capacity;
+}
+
+void TxScheduler::setLaneCapacity(Lane lane, int capacity)
+{
+    _lanes[lane].capacity = qMax(capacity, 1);
+}
+
+int TxScheduler::laneBudget(Lane lane) const
+{
+    return _lanes[lane].budget;
+}
+
+/**
+ * @brief sets the bandwidth budget of a lane
+ * @param bitsPerSecond budget in bits per second on the bus, 0 for unlimited
+ */
+void TxScheduler::setLaneBudget(Lane lane, int bitsPerSecond)
+{
+    _lanes[lane].budget = qMax(bitsPerSecond, 0);
+    _lanes[lane].tokens = 0;
+    _lanes[lane].lastRefillNs = _clock.nsecsElapsed();
+}
+
+int TxScheduler::inhibitTime(quint32 cobId) const
+{
+    return static_cast<int>(_inhibitTimesNs.value(cobId, 0) / 1000);
+}
+
+/**
+ * @brief sets the minimal time between two frames of cobId
+ * @param us inhibit time in µs, 0 to disable
+ */
+void TxScheduler::setInhibitTime(quint32 cobId, int us)
+{
+    if (us <= 0)
+    {
+        _inhibitTimesNs.remove(cobId);
+        _lastSentNs.remove(cobId);
+        return;
+    }
+    _inhibitTimesNs.insert(cobId, static_cast<qint64>(us) * 1000);
+}
+
+int TxScheduler::pendingCount(Lane lane) const
+{
+    return _lanes[lane].frames.count();
+}
+
+/**
+ * @brief returns true when producers of this lane should pause, laneReady() is emitted once drained
+ */
+bool TxScheduler::isCongested(Lane lane) const
+{
+    return _lanes[lane].congested;
+}
+
+/**
+ * @brief returns true if a frame with this cob id is still waiting in its lane
+ */
+bool TxScheduler::isFramePending(quint32 cobId) const
+{
+    for (const LaneQueue &lane : _lanes)
+    {
+        for (const PendingFrame &pending : lane.frames)
+        {
+            if (pending.frame.frameId() == cobId)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+const TxScheduler::LaneStats &TxScheduler::laneStats(Lane lane) const
+{
+    return _lanes[lane].stats;
+}
+
+void TxScheduler::resetStats()
+{
+    for (LaneQueue &lane : _lanes)
+    {
+        lane.stats = LaneStats{0, 0, 0, 0, 0, 0};
+    }
+}
+
+/**
+ * @brief monotonic time since epoch in µs, used to stamp sent frames
+ */
+qint64 TxScheduler::currentTimeUs() const
+{
+    return _epochOffsetUs + _clock.nsecsElapsed() / 1000;
+}
+
+/**
+ * @brief sends pending frames in priority order, in batches written with one driver call
+ */
+void TxScheduler::processQueue()
+{
+    if (_processing)
+    {
+        return;
+    }
+    _processing = true;
+
+    qint64 wakeNs = -1;
+    bool sending = true;
+    while (sending)
+    {
+        sending = false;
+        qint64 now = _clock.nsecsElapsed();
+
+        // frames are taken out of lanes as if sent, unsent ones are restored
+        _batch.clear();
+        _batchFrames.clear();
+        while (_batch.size() < BATCH_MAX_SIZE)
+        {
+            int laneId = 0;
+            int frameIndex = -1;
+            for (; laneId < LaneCount; laneId++)
+            {
+                frameIndex = nextFrameIndex(_lanes[laneId], now, wakeNs);
+                if (frameIndex >= 0)
+                {
+                    break;
+                }
+            }
+            if (frameIndex < 0)
+            {
+                break;
+            }
+
+            LaneQueue &lane = _lanes[laneId];
+            BatchEntry entry;
+            entry.lane = static_cast<Lane>(laneId);
+            entry.pending = lane.frames.takeAt(frameIndex);
+            entry.previousSentNs = _lastSentNs.value(entry.pending.frame.frameId(), -1);
+            if (lane.budget > 0)
+            {
+                lane.tokens -= frameBitCount(entry.pending.frame);
+            }
+            if (_inhibitTimesNs.contains(entry.pending.frame.frameId()))
+            {
+                _lastSentNs.insert(entry.pending.frame.frameId(), now);
+            }
+            _batch.append(entry);
+            _batchFrames.append(entry.pending.frame);
+        }
+        if (_batch.isEmpty())
+        {
+            break;
+        }
+
+        int sent = _batch.size();
+        if (_bus->isConnected())
+        {
+            sent = _bus->sendFrames(_batchFrames.constData(), _batchFrames.size());
+        }
+        for (int i = 0; i < sent; i++)
+        {
+            const BatchEntry &entry = _batch.at(i);
+            LaneStats &stats = _lanes[entry.lane].stats;
+            if (!_bus->isConnected())
+            {
+                stats.dropped++;
+            }
+            else
+            {
+                qint64 latencyUs = (now - entry.pending.queuedTimeNs) / 1000;
+                stats.sent++;
+                stats.totalLatencyUs += latencyUs;
+                stats.maxLatencyUs = qMax(stats.maxLatencyUs, latencyUs);
+            }
+            frameRemoved(entry.lane);
+        }
+        if (sent == _batch.size())
+        {
+            _retryCount = 0;
+            sending = true;
+            continue;
+        }
+
+        // driver TX queue full, restore unsent frames in order and retry later
+        _retryCount++;
+        bool dropFirst = (_retryCount > RETRY_MAX_COUNT);
+        for (int i = _batch.size() - 1; i >= sent; i--)
+        {
+            const BatchEntry &entry = _batch.at(i);
+            LaneQueue &lane = _lanes[entry.lane];
+            if (lane.budget > 0)
+            {
+                lane.tokens += frameBitCount(entry.pending.frame);
+            }
+            if (entry.previousSentNs >= 0)
+            {
+                _lastSentNs.insert(entry.pending.frame.frameId(), entry.previousSentNs);
+            }
+            else
+            {
+                _lastSentNs.remove(entry.pending.frame.frameId());
+            }
+
+            if (dropFirst && i == sent)
+            {
+                lane.stats.dropped++;
+                frameRemoved(entry.lane);
+                continue;
+            }
+            lane.frames.prepend(entry.pending);
+        }
+        if (dropFirst)
+        {
+            _retryCount = 0;
+            sending = true;
+            continue;
+        }
+
+        _wakeTimer->start(RETRY_INTERVAL_MS);
+        _processing = false;
+        return;
+    }
+
+    if (wakeNs >= 0)
+    {
+        _wakeTimer->start(static_cast<int>(qMax((wakeNs - _clock.nsecsElapsed() + 999999) / 1000000, Q_INT64_C(0))));
+    }
+    _processing = false;
+}
+
+/**
+ * @brief writes frame to the driver without queuing when no frame is pending and the lane budget
+ * and the inhibit time of its cob id allow it
+ * @return true if the driver accepted the frame
+ */
+bool TxScheduler::sendNow(Lane laneId, const QCanBusFrame &frame, qint64 now)
+{
+    if (_processing || _retryCount != 0 || !_bus->isConnected())
+    {
+        return false;
+    }
+    for (const LaneQueue &lane : _lanes)
+    {
+        if (!lane.frames.isEmpty())
+        {
+            return false;
+        }
+    }
+
+    LaneQueue &lane = _lanes[laneId];
+    if (lane.budget > 0)
+    {
+        refillTokens(lane, now);
+        if (lane.tokens < frameBitCount(frame))
+        {
+            return false;
+        }
+    }
+    qint64 inhibitNs = _inhibitTimesNs.value(frame.frameId(), 0);
+    if (inhibitNs > 0 && _lastSentNs.contains(frame.frameId()) && _lastSentNs.value(frame.frameId()) + inhibitNs > now)
+    {
+        return false;
+    }
+
+    if (_bus->sendFrames(&frame, 1) != 1)
+    {
+        return false;
+    }
+
+    if (lane.budget > 0)
+    {
+        lane.tokens -= frameBitCount(frame);
+    }
+    if (inhibitNs > 0)
+    {
+        _lastSentNs.insert(frame.frameId(), now);
+    }
+    lane.stats.queued++;
+    lane.stats.sent++;
+    return true;
+}
+
+/**
+ * @brief returns the index of the first frame of lane allowed to be sent now, or -1
+ * wakeNs is lowered to the time when a blocked frame will be allowed
+ */
+int TxScheduler::nextFrameIndex(LaneQueue &lane, qint64 now, qint64 &wakeNs)
+{
+    if (lane.frames.isEmpty())
+    {
+        return -1;
+    }
+
+    // an NMT command waits for the frames queued before it for the same node, sent from lower lanes
+    if (&lane == &_lanes[LaneNmt])
+    {
+        return isNmtBlocked(lane.frames.first()) ? -1 : 0;
+    }
+
+    if (lane.budget > 0)
+    {
+        refillTokens(lane, now);
+        int bits = frameBitCount(lane.frames.first().frame);
+        if (lane.tokens < bits)
+        {
+            qint64 readyNs = now + (bits - lane.tokens) * Q_INT64_C(1000000000) / lane.budget;
+            wakeNs = (wakeNs < 0) ? readyNs : qMin(wakeNs, readyNs);
+            return -1;
+        }
+    }
+
+    if (_inhibitTimesNs.isEmpty())
+    {
+        return 0;
+    }
+
+    // frames of an inhibited cob id are skipped, order per cob id is kept
+    for (int i = 0; i < lane.frames.count(); i++)
+    {
+        quint32 cobId = lane.frames.at(i).frame.frameId();
+        qint64 inhibitNs = _inhibitTimesNs.value(cobId, 0);
+        if (inhibitNs == 0 || !_lastSentNs.contains(cobId))
+        {
+            return i;
+        }
+        qint64 readyNs = _lastSentNs.value(cobId) + inhibitNs;
+        if (readyNs <= now)
+        {
+            return i;
+        }
+        wakeNs = (wakeNs < 0) ? readyNs : qMin(wakeNs, readyNs);
+    }
+    return -1;
+}
+
+/**
+ * @brief returns true if a frame queued before the nmt command is still pending for its node,
+ * all nodes for a broadcast command
+ */
+bool TxScheduler::isNmtBlocked(const PendingFrame &nmt) const
+{
+    int nmtNodeId = frameNodeId(nmt.frame);
+    for (int laneId = LaneNmt + 1; laneId < LaneCount; laneId++)
+    {
+        for (const PendingFrame &pending : _lanes[laneId].frames)
+        {
+            if (pending.sequence > nmt.sequence)
+            {
+                break;  // lanes are in queuing order
+            }
+            int nodeId = frameNodeId(pending.frame);
+            if (nodeId > 0 && (nmtNodeId == 0 || nodeId == nmtNodeId))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief node addressed by frame, 0 for an NMT broadcast, -1 for a frame not addressed to a node
+ */
+int TxScheduler::frameNodeId(const QCanBusFrame &frame)
+{
+    if (frame.hasExtendedFrameFormat())
+    {
+        return -1;
+    }
+
+    quint32 cobId = frame.frameId();
+    if (cobId == 0x000)
+    {
+        return (frame.payload().size() >= 2) ? static_cast<quint8>(frame.payload().at(1)) : -1;
+    }
+    if ((cobId >= 0x180 && cobId < 0x580) || (cobId > 0x600 && cobId < 0x680))
+    {
+        // default PDO cob ids and SDO requests
+        int nodeId = static_cast<int>(cobId & 0x7F);
+        return (nodeId > 0) ? nodeId : -1;
+    }
+    return -1;
+}
+
+void TxScheduler::refillTokens(LaneQueue &lane, qint64 now)
+{
+    qint64 burst = qMax(static_cast<qint64>(lane.budget / 10), Q_INT64_C(1000));  // 100 ms of budget
+    qint64 elapsedNs = qMin(now - lane.lastRefillNs, Q_INT64_C(1000000000));
+    qint64 gained = elapsedNs * lane.budget / Q_INT64_C(1000000000);
+    if (gained <= 0)
+    {
+        return;
+    }
+
+    // fractional tokens are kept by only consuming the time converted in tokens
+    lane.tokens += gained;
+    lane.lastRefillNs += gained * Q_INT64_C(1000000000) / lane.budget;
+    if (lane.tokens >= burst || lane.lastRefillNs < now - Q_INT64_C(1000000000))
+    {
+        lane.tokens = qMin(lane.tokens, burst);
+        lane.lastRefillNs = now;
+    }
+}
+
+void TxScheduler::frameRemoved(Lane laneId)
+{
+    LaneQueue &lane = _lanes[laneId];
+    if (lane.congested && lane.frames.count() <= lane.capacity / 4)
+    {
+        lane.congested = false;
+        emit laneReady(laneId);
+    }
+}
+
+/**
+ * @brief approximated bit count of frame on the bus, without bit stuffing
+ */
+int TxScheduler::frameBitCount(const QCanBusFrame &frame)
+{
+    int overhead = frame.hasExtendedFrameFormat() ? 67 : 47;
+    return overhead + 8 * frame.payload().size();
+}
@@ -0,0 +1,157 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TXSCHEDULER_H
+#define TXSCHEDULER_H
+
+#include "canopen_global.h"
+
+#include <QObject>
+
+#include "busdriver/qcanbusframe.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QVector>
+
+class CanOpenBus;
+
+/**
+ * @brief Transmit scheduler between services and the bus driver
+ *
+ * Frames are queued in priority lanes following CAN arbitration order of CANopen services.
+ * Lower lanes are always sent first, PDO inhibit times and per lane bandwidth budgets are
+ * honoured. A frame queued while nothing is pending is written to the driver at once, otherwise
+ * pending frames are written in batches at next event loop tick, frames refused by the driver
+ * (full TX queue) are kept and retried. An NMT command never overtakes frames queued before it
+ * for the same node.
+ */
+class CANOPEN_EXPORT TxScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    TxScheduler(CanOpenBus *bus);
+
+    enum Lane
+    {
+        LaneNmt,        // 000h NMT commands
+        LaneSync,       // 080h SYNC
+        LaneEmergency,  // 081h-0FFh EMCY
+        LaneTime,       // 100h TIME
+        LanePdo,        // 180h-57Fh PDO
+        LaneSdo,        // 580h-67Fh SDO
+        LaneOther,      // 700h error control, LSS and non CANopen ids
+        LaneCount
+    };
+    static Lane laneForFrame(const QCanBusFrame &frame);
+    static QString laneStr(Lane lane);
+
+    bool queueFrame(const QCanBusFrame &frame);
+    void clear();
+
+    int laneCapacity(Lane lane) const;
+    void setLaneCapacity(Lane lane, int capacity);
+
+    int laneBudget(Lane lane) const;
+    void setLaneBudget(Lane lane, int bitsPerSecond);
+
+    int inhibitTime(quint32 cobId) const;
+    void setInhibitTime(quint32 cobId, int us);
+
+    // back-pressure
+    int pendingCount(Lane lane) const;
+    bool isCongested(Lane lane) const;
+    bool isFramePending(quint32 cobId) const;
+
+    struct LaneStats
+    {
+        quint64 queued;
+        quint64 sent;
+        quint64 dropped;
+        quint64 coalesced;
+        qint64 maxLatencyUs;
+        qint64 totalLatencyUs;
+    };
+    const LaneStats &laneStats(Lane lane) const;
+    void resetStats();
+
+    qint64 currentTimeUs() const;
+
+signals:
+    void laneReady(TxScheduler::Lane lane);
+
+protected slots:
+    void processQueue();
+
+private:
+    struct PendingFrame
+    {
+        QCanBusFrame frame;
+        qint64 queuedTimeNs;
+        quint64 sequence;
+    };
+    struct LaneQueue
+    {
+        QList<PendingFrame> frames;
+        int capacity;
+        int budget;  // bits per second, 0 for unlimited
+        qint64 tokens;
+        qint64 lastRefillNs;
+        bool congested;
+        LaneStats stats;
+    };
+    struct BatchEntry
+    {
+        Lane lane;
+        PendingFrame pending;
+        qint64 previousSentNs;
+    };
+    enum
+    {
+        RETRY_INTERVAL_MS = 1,
+        RETRY_MAX_COUNT = 50,
+        BATCH_MAX_SIZE = 32
+    };
+
+    CanOpenBus *_bus;
+    LaneQueue _lanes[LaneCount];
+    QHash<quint32, qint64> _inhibitTimesNs;
+    QHash<quint32, qint64> _lastSentNs;
+
+    QVector<BatchEntry> _batch;
+    QVector<QCanBusFrame> _batchFrames;
+
+    QElapsedTimer _clock;
+    qint64 _epochOffsetUs;
+    quint64 _sequence;
+    QTimer *_wakeTimer;
+    int _retryCount;
+    bool _processing;
+
+    bool sendNow(Lane laneId, const QCanBusFrame &frame, qint64 now);
+    int nextFrameIndex(LaneQueue &lane, qint64 now, qint64 &wakeNs);
+    bool isNmtBlocked(const PendingFrame &nmt) const;
+    static int frameNodeId(const QCanBusFrame &frame);
+    void refillTokens(LaneQueue &lane, qint64 now);
+    void frameRemoved(Lane lane);
+    static int frameBitCount(const QCanBusFrame &frame);
+};
+
+#endif  // TXSCHEDULER_H
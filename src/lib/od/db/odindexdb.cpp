@@ -18,321 +18,142 @@
 
 #include "odindexdb.h"
 
-bool ODIndexDb::isQ1516(quint16 index, quint8 subIndex, quint16 profileNumber)
-{
-    if (index < 0x2000 || index >= 0x6000)
-    {
-        return false;
-    }
-    if (profileNumber == 402)
-    {
-        if (index == 0x2A00)
-        {
-            if (subIndex == 2 || subIndex == 3)
-            {
-                return true;
-            }
-        }
-        if (index == 0x2A01)
-        {
-            if (subIndex >= 2 && subIndex <= 5)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4006)
-        {
-            if (subIndex == 3 || subIndex == 4 || subIndex == 5)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4007)
-        {
-            if (subIndex == 6 || subIndex == 8)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4020 || (index & (quint16)0xF1FF) == 0x4040 || (index & (quint16)0xF1FF) == 0x4060)
-        {
-            if (subIndex >= 1 && subIndex <= 4)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4021 || (index & (quint16)0xF1FF) == 0x4041 || (index & (quint16)0xF1FF) == 0x4061)
-        {
-            if (subIndex >= 1 && subIndex <= 6)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4022 || (index & (quint16)0xF1FF) == 0x4042 || (index & (quint16)0xF1FF) == 0x4062)
-        {
-            if (subIndex == 1 || subIndex == 3)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4024 || (index & (quint16)0xF1FF) == 0x4044 || (index & (quint16)0xF1FF) == 0x4064)
-        {
-            if (subIndex >= 2 && subIndex <= 5)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4025 || (index & (quint16)0xF1FF) == 0x4045 || (index & (quint16)0xF1FF) == 0x4065)
-        {
-            if (subIndex >= 1 && subIndex <= 7)
-            {
-                return true;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4081)
-        {
-            if (subIndex == 2)
-            {
-                return true;
-            }
-        }
-    }
-    return false;
-}
+#include <algorithm>
 
-double ODIndexDb::scale(quint16 index, quint8 subIndex, quint16 profileNumber)
+namespace
 {
-    if ((index >= 0x1400 && index <= 0x15FF) || (index >= 0x1800 && index <= 0x19FF))  // RPDO TPDO
-    {
-        if (subIndex == 3)  // Inhibit Time
-        {
-            return 0.1;
-        }
-    }
+// metadata table, sorted by index
+// {index, mask, subIndexMin, subIndexMax, profileNumber, q1516, scale, unit}
+constexpr ODIndexDb::Entry entries[] = {
+    {0x100C, 0xFFFF,   0,   0,   0, false, 1.0, ODIndexDb::UnitMs},             // Guard time
+    {0x1017, 0xFFFF,   0,   0,   0, false, 1.0, ODIndexDb::UnitMs},             // Producer heartbeat time
+    {0x1400, 0xFE00,   3,   3,   0, false, 0.1, ODIndexDb::UnitMs},             // RPDO inhibit time
+    {0x1400, 0xFE00,   5,   5,   0, false, 1.0, ODIndexDb::UnitMs},             // RPDO event timer
+    {0x1800, 0xFE00,   3,   3,   0, false, 0.1, ODIndexDb::UnitMs},             // TPDO inhibit time
+    {0x1800, 0xFE00,   5,   5,   0, false, 1.0, ODIndexDb::UnitMs},             // TPDO event timer
+    {0x2000, 0xFFFF,   1, 255,   0, false, 1 / 100.0, ODIndexDb::UnitV},              // board voltages
+    {0x2020, 0xFFFF,   1, 255,   0, false, 1 / 10.0, ODIndexDb::UnitCelsius},        // cpu temperatures
+    {0x2023, 0xFFFF,   1, 255,   0, false, 1.0, ODIndexDb::UnitUs},             // cpu stats us
+    {0x2024, 0xFFFF,   1, 255,   0, false, 1.0, ODIndexDb::UnitUs},
+    {0x2025, 0xFFFF,   1, 255,   0, false, 1.0, ODIndexDb::UnitUs},
+    {0x2041, 0xFFFF,   1, 255, 402, false, 1 / 100.0, ODIndexDb::UnitV},              // Board under/overvoltage
+    {0x2801, 0xFFFF,   1, 255, 402, false, 1 / 10.0, ODIndexDb::UnitCelsius},        // bridge temperatures
+    {0x2802, 0xFFFF,   1, 255, 402, false, 1 / 100.0, ODIndexDb::UnitA},              // bridge currents
+    {0x2803, 0xFFFF,   1, 255, 402, false, 1 / 100.0, ODIndexDb::UnitA},
+    {0x2805, 0xFFFF,   1, 255, 402, false, 1 / 10.0, ODIndexDb::UnitV},              // bridge bemf voltages
+    {0x2810, 0xFFFF,   1,   2, 402, false, 1 / 10.0, ODIndexDb::UnitCelsius},        // driver temperature protection
+    {0x2A00, 0xFFFF,   2,   3, 402, true , 1.0, ODIndexDb::UnitNone},           // synchro status
+    {0x2A01, 0xFFFF,   2,   5, 402, true , 1.0, ODIndexDb::UnitNone},           // synchro config
+    {0x4006, 0xF1FF,   2,   2, 402, false, 1 / 100.0, ODIndexDb::UnitA},              // Motor status, motor current
+    {0x4006, 0xF1FF,   3,   5, 402, true , 1.0, ODIndexDb::UnitNone},           // Motor status, torque, velocity, position
+    {0x4006, 0xF1FF,   7,   7, 402, false, 1 / 10.0, ODIndexDb::UnitCelsius},        // Motor status, motor temperature
+    {0x4007, 0xF1FF,   2,   3, 402, false, 1 / 100.0, ODIndexDb::UnitA},              // Motor config, motor current limits
+    {0x4007, 0xF1FF,   4,   4, 402, false, 1.0, ODIndexDb::UnitMs},             // Motor config, burst duration
+    {0x4007, 0xF1FF,   5,   5, 402, false, 1 / 100.0, ODIndexDb::UnitA},              // Motor config, sustained current
+    {0x4007, 0xF1FF,   6,   6, 402, true , 1.0, ODIndexDb::UnitNmPerA},         // Motor config, current constant
+    {0x4007, 0xF1FF,   7,   7, 402, false, 1.0, ODIndexDb::UnitRpm},            // Motor config, maximum velocity
+    {0x4007, 0xF1FF,   8,   8, 402, true , 1.0, ODIndexDb::UnitRpmPerV},        // Motor config, velocity constant
+    {0x4008, 0xF1FF,   3,   3, 402, false, 1.0, ODIndexDb::UnitDegree},         // BLDC status, electrical angle
+    {0x4020, 0xF1FF,   1,   4, 402, true , 1.0, ODIndexDb::UnitNone},           // torque PID status
+    {0x4021, 0xF1FF,   1,   6, 402, true , 1.0, ODIndexDb::UnitNone},           // torque PID config
+    {0x4022, 0xF1FF,   1,   1, 402, true , 1.0, ODIndexDb::UnitNone},           // torque sensor status
+    {0x4022, 0xF1FF,   3,   3, 402, true , 1.0, ODIndexDb::UnitNone},
+    {0x4024, 0xF1FF,   2,   5, 402, true , 1.0, ODIndexDb::UnitNone},           // torque sensor filter
+    {0x4025, 0xF1FF,   1,   7, 402, true , 1.0, ODIndexDb::UnitNone},           // torque sensor conditioning
+    {0x4040, 0xF1FF,   1,   4, 402, true , 1.0, ODIndexDb::UnitNone},           // velocity PID status
+    {0x4041, 0xF1FF,   1,   6, 402, true , 1.0, ODIndexDb::UnitNone},           // velocity PID config
+    {0x4042, 0xF1FF,   1,   1, 402, true , 1.0, ODIndexDb::UnitNone},           // velocity sensor status
+    {0x4042, 0xF1FF,   3,   3, 402, true , 1.0, ODIndexDb::UnitNone},
+    {0x4044, 0xF1FF,   2,   5, 402, true , 1.0, ODIndexDb::UnitNone},           // velocity sensor filter
+    {0x4045, 0xF1FF,   1,   7, 402, true , 1.0, ODIndexDb::UnitNone},           // velocity sensor conditioning
+    {0x4060, 0xF1FF,   1,   4, 402, true , 1.0, ODIndexDb::UnitNone},           // position PID status
+    {0x4061, 0xF1FF,   1,   6, 402, true , 1.0, ODIndexDb::UnitNone},           // position PID config
+    {0x4062, 0xF1FF,   1,   1, 402, true , 1.0, ODIndexDb::UnitNone},           // position sensor status
+    {0x4062, 0xF1FF,   3,   3, 402, true , 1.0, ODIndexDb::UnitNone},
+    {0x4064, 0xF1FF,   2,   5, 402, true , 1.0, ODIndexDb::UnitNone},           // position sensor filter
+    {0x4065, 0xF1FF,   1,   7, 402, true , 1.0, ODIndexDb::UnitNone},           // position sensor conditioning
+    {0x4081, 0xF1FF,   2,   2, 402, true , 1.0, ODIndexDb::UnitNone},           // motor temperature sensor constant
+    {0x4081, 0xF1FF,   3,   4, 402, false, 1 / 10.0, ODIndexDb::UnitCelsius},        // motor temperature protection ST
+    {0x4082, 0xF1FF,   2,   2, 402, false, 1.0, ODIndexDb::UnitMs},             // Brake excitation time
+};
 
-    if (index < 0x2000 || index >= 0x6000)
-    {
-        return 1.0;
-    }
+constexpr int entriesCount = sizeof(entries) / sizeof(entries[0]);
 
-    if (index == 0x2000)  // board voltages
-    {
-        if (subIndex > 0)
-        {
-            return 1 / 100.0;
-        }
-    }
-    if (index == 0x2020)  // cpu temperatures
-    {
-        if (subIndex > 0)
-        {
-            return 1 / 10.0;
-        }
-    }
+constexpr bool isSorted(int i)
+{
+    return (i + 1 >= entriesCount) || ((entries[i].index <= entries[i + 1].index) && isSorted(i + 1));
+}
+static_assert(isSorted(0), "ODIndexDb entries must be sorted by index");
 
-    if (profileNumber == 402)
+// exact indexes, per axis indexes (axis stride 0x200), PDO communication ranges
+constexpr quint16 masks[] = {0xFFFF, 0xF1FF, 0xFE00};
+}  // namespace
+
+/**
+ * @brief metadata entry of a sub-index, binary search for each mask in the sorted table
+ * @return entry or nullptr if the sub-index has no metadata
+ */
+const ODIndexDb::Entry *ODIndexDb::entry(quint16 index, quint8 subIndex, quint16 profileNumber)
+{
+    const Entry *end = entries + entriesCount;
+    for (quint16 mask : masks)
     {
-        if (index == 0x2041)  // Board under/overvoltage
-        {
-            if (subIndex > 0)
-            {
-                return 1 / 100.0;
-            }
-        }
-        if (index == 0x2801)  // bridge temperatures
-        {
-            if (subIndex > 0)
-            {
-                return 1 / 10.0;
-            }
-        }
-        if (index == 0x2802 || index == 0x2803)  // bridge currents
-        {
-            if (subIndex > 0)
-            {
-                return 1 / 100.0;
-            }
-        }
-        if (index == 0x2805)  // bridge bemf voltages
-        {
-            if (subIndex > 0)
-            {
-                return 1 / 10.0;
-            }
-        }
-        if (index == 0x2810)  // driver temperature protection
-        {
-            if (subIndex == 1 || subIndex == 2)
-            {
-                return 1 / 10.0;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4006)  // Motor status
-        {
-            if (subIndex == 2)  // motor current
-            {
-                return 1 / 100.0;
-            }
-            if (subIndex == 7)  // motor temperature
-            {
-                return 1 / 10.0;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4007)  // Motor config
-        {
-            if (subIndex == 2 || subIndex == 3 || subIndex == 5)  // motor current limits
-            {
-                return 1 / 100.0;
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4081)
+        quint16 key = index & mask;
+        const Entry *it = std::lower_bound(entries,
+                                           end,
+                                           key,
+                                           [](const Entry &tableEntry, quint16 tableKey)
+                                           {
+                                               return tableEntry.index < tableKey;
+                                           });
+        for (; it != end && it->index == key; ++it)
         {
-            if (subIndex == 3 || subIndex == 4)  // motor temperature protection ST
+            if (it->mask == mask && subIndex >= it->subIndexMin && subIndex <= it->subIndexMax
+                && (it->profileNumber == 0 || it->profileNumber == profileNumber))
             {
-                return 1 / 10.0;
+                return it;
             }
         }
     }
-    return 1.0;
+    return nullptr;
+}
+
+bool ODIndexDb::isQ1516(quint16 index, quint8 subIndex, quint16 profileNumber)
+{
+    const Entry *metadata = entry(index, subIndex, profileNumber);
+    return (metadata != nullptr) && metadata->q1516;
+}
+
+double ODIndexDb::scale(quint16 index, quint8 subIndex, quint16 profileNumber)
+{
+    const Entry *metadata = entry(index, subIndex, profileNumber);
+    return (metadata != nullptr) ? metadata->scale : 1.0;
 }
 
 QString ODIndexDb::unit(quint16 index, quint8 subIndex, quint16 profileNumber)
 {
-    if (index == 0x100C)  // Guard time
-    {
-        if (subIndex == 0)
-        {
-            return QString(" ms");
-        }
-    }
-    if (index == 0x1017)  // Producer heartbeat time
-    {
-        if (subIndex == 0)
-        {
-            return QString(" ms");
-        }
-    }
-    if ((index >= 0x1400 && index <= 0x15FF) || (index >= 0x1800 && index <= 0x19FF))  // RPDO TPDO
-    {
-        if (subIndex == 3 || subIndex == 5)  // Inhibit Time and Event Timer
-        {
-            return QString(" ms");
-        }
-    }
-    if (index == 0x2000)  // board voltages
-    {
-        if (subIndex > 0)
-        {
-            return QString(" V");
-        }
-    }
-    if (index == 0x2020)  // cpu temps
-    {
-        if (subIndex > 0)
-        {
-            return QString(" °C");
-        }
-    }
-    if (index == 0x2023 || index == 0x2024 || index == 0x2025)  // cpu stats us
-    {
-        if (subIndex > 0)
-        {
-            return QString(" µs");
-        }
-    }
+    const Entry *metadata = entry(index, subIndex, profileNumber);
+    return unitStr((metadata != nullptr) ? metadata->unit : UnitNone);
+}
 
-    if (profileNumber == 402)
+/**
+ * @brief interned unit string, shared by all sub-indexes with this unit
+ */
+const QString &ODIndexDb::unitStr(Unit unit)
+{
+    static const QString units[] = {QString(),
+                                    QString(" ms"),
+                                    QString(" µs"),
+                                    QString(" V"),
+                                    QString(" A"),
+                                    QString(" °C"),
+                                    QString(" °"),
+                                    QString(" Nm/A"),
+                                    QString(" rpm"),
+                                    QString(" rpm/V")};
+    if (unit > UnitRpmPerV)
     {
-        if (index == 0x2041)  // Board under/overvoltage
-        {
-            if (subIndex > 0)
-            {
-                return QString(" V");
-            }
-        }
-        if (index == 0x2801)  // bridge temps
-        {
-            if (subIndex > 0)
-            {
-                return QString(" °C");
-            }
-        }
-        if (index == 0x2802 || index == 0x2803)  // bridge currents
-        {
-            if (subIndex > 0)
-            {
-                return QString(" A");
-            }
-        }
-        if (index == 0x2805)  // bridge bemf voltages
-        {
-            if (subIndex > 0)
-            {
-                return QString(" V");
-            }
-        }
-        if (index == 0x2810)  // driver temperature protection
-        {
-            if (subIndex == 1 || subIndex == 2)
-            {
-                return QString(" °C");
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4006)  // Motor status
-        {
-            if (subIndex == 2)  // motor current
-            {
-                return QString(" A");
-            }
-            if (subIndex == 7)  // motor temperature
-            {
-                return QString(" °C");
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4007)  // Motor config
-        {
-            if (subIndex == 2 || subIndex == 3 || subIndex == 5)  // motor current limits
-            {
-                return QString(" A");
-            }
-            if (subIndex == 4)  // motor current limits
-            {
-                return QString(" ms");
-            }
-            if (subIndex == 6)  // current constant
-            {
-                return QString(" Nm/A");
-            }
-            if (subIndex == 7)  // maximum velocity
-            {
-                return QString(" rpm");
-            }
-            if (subIndex == 8)  // velocity constant
-            {
-                return QString(" rpm/V");
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4008)  // BLDC status
-        {
-            if (subIndex == 3)  // electrical angle
-            {
-                return QString(" °");
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4081)
-        {
-            if (subIndex == 3 || subIndex == 4)  // motor temperature protection ST
-            {
-                return QString(" °C");
-            }
-        }
-        if ((index & (quint16)0xF1FF) == 0x4082)
-        {
-            if (subIndex == 2)  // Brake_excitation_time_ms
-            {
-                return QString(" ms");
-            }
-        }
+        return units[UnitNone];
     }
-    return QString();
+    return units[unit];
 }
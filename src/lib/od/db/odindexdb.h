@@ -26,9 +26,41 @@
 class OD_EXPORT ODIndexDb
 {
 public:
+    enum Unit : quint8
+    {
+        UnitNone,
+        UnitMs,
+        UnitUs,
+        UnitV,
+        UnitA,
+        UnitCelsius,
+        UnitDegree,
+        UnitNmPerA,
+        UnitRpm,
+        UnitRpmPerV
+    };
+
+    /**
+     * @brief metadata of a sub-index range, index matches when (objIndex & mask) == index
+     */
+    struct Entry
+    {
+        quint16 index;
+        quint16 mask;
+        quint8 subIndexMin;
+        quint8 subIndexMax;
+        quint16 profileNumber;  // 0 for all profiles
+        bool q1516;
+        double scale;
+        Unit unit;
+    };
+
+    static const Entry *entry(quint16 index, quint8 subIndex, quint16 profileNumber = 0);
+
     static bool isQ1516(quint16 index, quint8 subIndex, quint16 profileNumber = 0);
     static double scale(quint16 index, quint8 subIndex, quint16 profileNumber = 0);
     static QString unit(quint16 index, quint8 subIndex, quint16 profileNumber = 0);
+    static const QString &unitStr(Unit unit);
 };
 
 #endif  // ODINDEXDB_H
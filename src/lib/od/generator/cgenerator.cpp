@@ -23,13 +23,19 @@
 #include <QFileInfo>
 #include <QList>
 #include <QMap>
+#include <QPair>
 #include <QRegularExpression>
+#include <QVector>
+
+#include <algorithm>
 
 /**
  * @brief default constructor
  */
 CGenerator::CGenerator()
 {
+    _lookupEnabled = false;
+    _layoutOptimized = false;
 }
 
 /**
@@ -143,7 +149,8 @@ bool CGenerator::generateH(DeviceConfiguration *deviceConfiguration, const QStri
     out << "{"
         << "\n";
 
-    for (Index *index : indexes)
+    const QList<Index *> ramIndexes = ramOrder(indexes, _layoutOptimized);
+    for (Index *index : ramIndexes)
     {
         writeIndexH(index, out);
     }
@@ -152,6 +159,19 @@ bool CGenerator::generateH(DeviceConfiguration *deviceConfiguration, const QStri
         << "\n";
     out << "\n";
 
+    if (_layoutOptimized)
+    {
+        int hostRamSize = ramSize(indexes, 8, true);
+        if (hostRamSize > 0)
+        {
+            out << "// sizeof(struct sOD_RAM) on a host with natural alignment, see OD_LAYOUT_CHECK"
+                << "\n";
+            out << "#define OD_RAM_SIZE_HOST " << hostRamSize << "u"
+                << "\n";
+            out << "\n";
+        }
+    }
+
     // TODO declararion of FLASH memory
     out << "// extern declaration for RAM and FLASH struct"
         << "\n";
@@ -182,6 +202,12 @@ bool CGenerator::generateH(DeviceConfiguration *deviceConfiguration, const QStri
     out << "void od_setNodeId(uint8_t nodeId);"
         << "\n";
     out << "\n";
+
+    if (_lookupEnabled)
+    {
+        writeLookupH(deviceConfiguration, out);
+    }
+
     out << "#endif // OD_DATA_H";
     out << "\n";
 
@@ -224,6 +250,17 @@ bool CGenerator::generateC(DeviceConfiguration *deviceConfiguration, const QStri
     out << "#include \"od_data.h\""
         << "\n"
         << "\n";
+    if (_lookupEnabled || _layoutOptimized)
+    {
+        out << "#include <stddef.h>"
+            << "\n";
+        if (_layoutOptimized)
+        {
+            out << "#include <string.h>"
+                << "\n";
+        }
+        out << "\n";
+    }
 
     out << "#define STRINGIZE(x) #x"
         << "\n";
@@ -239,6 +276,12 @@ bool CGenerator::generateC(DeviceConfiguration *deviceConfiguration, const QStri
 
     QMap<uint16_t, Index *> indexes = deviceConfiguration->indexes();
 
+    _stringNames.clear();
+    _stringAliases.clear();
+    _defaultBlobs.clear();
+    _stringBytes[0] = _stringBytes[1] = 0;
+    _subEntriesCount = 0;
+    _defaultBlobsCount[0] = _defaultBlobsCount[1] = 0;
     for (Index *index : indexes)
     {
         if (index->maxSubIndex() > 0)
@@ -258,6 +301,11 @@ bool CGenerator::generateC(DeviceConfiguration *deviceConfiguration, const QStri
 
     out << "\n";
 
+    if (_layoutOptimized)
+    {
+        writeDefaultBlobsC(indexes, out);
+    }
+
     QList<Index *> commIndexes;  // Communication profile area
     QList<Index *> msIndexes;    // Manufacturer-specific profile area
     QList<Index *> appIndexes;   // Standardized profile area
@@ -337,6 +385,18 @@ bool CGenerator::generateC(DeviceConfiguration *deviceConfiguration, const QStri
 
     writeSetNodeId(deviceConfiguration, out);
 
+    if (_lookupEnabled)
+    {
+        writeLookupC(deviceConfiguration, out);
+        writePdoMappableC(deviceConfiguration, out);
+        writeLookupSelfTestC(out);
+    }
+
+    if (_layoutOptimized)
+    {
+        writeLayoutReportC(deviceConfiguration, out);
+    }
+
     if (_errorStr.isEmpty())
     {
         cFile.close();
@@ -381,7 +441,8 @@ bool CGenerator::generateHStruct(DeviceConfiguration *deviceConfiguration, const
         << "\n";
 
     QMap<uint16_t, Index *> indexes = deviceConfiguration->indexes();
-    for (Index *index : indexes)
+    const QList<Index *> ramIndexes = ramOrder(indexes, _layoutOptimized);
+    for (Index *index : ramIndexes)
     {
         if (index->index() >= min && index->index() <= max)
         {
@@ -403,6 +464,40 @@ bool CGenerator::generateHStruct(DeviceConfiguration *deviceConfiguration, const
     return false;
 }
 
+/**
+ * @brief lookup mode, also generates an O(1) two level index lookup (od_lookup) and a table of
+ * PDO mappable sub-indexes with their byte offset in OD_RAM
+ */
+bool CGenerator::isLookupEnabled() const
+{
+    return _lookupEnabled;
+}
+
+void CGenerator::setLookupEnabled(bool lookupEnabled)
+{
+    _lookupEnabled = lookupEnabled;
+}
+
+/**
+ * @brief optimized layout mode, sorts OD_RAM members and record fields by alignment to
+ * reduce padding (OD_ accessor macros are unchanged), shares identical const strings,
+ * sub-entry lists and array default values, and appends a size report to the .c file
+ */
+bool CGenerator::isLayoutOptimized() const
+{
+    return _layoutOptimized;
+}
+
+void CGenerator::setLayoutOptimized(bool layoutOptimized)
+{
+    _layoutOptimized = layoutOptimized;
+}
+
+const QString &CGenerator::layoutReport() const
+{
+    return _layoutReport;
+}
+
 /**
  * @brief converts a data type to a string
  * @param data type
@@ -504,14 +599,14 @@ QString CGenerator::structNameToString(const QString &name)
  * @param sub-index which contains data
  * @return data to C hexadecimal format
  */
-QString CGenerator::dataToString(const SubIndex *subIndex)
+QString CGenerator::dataToString(const SubIndex *subIndex) const
 {
     switch (subIndex->dataType())
     {
         case SubIndex::OCTET_STRING:
         case SubIndex::VISIBLE_STRING:
         case SubIndex::UNICODE_STRING:
-            return stringNameToString(subIndex);
+            return _stringAliases.value(stringNameToString(subIndex), stringNameToString(subIndex));
 
         case SubIndex::REAL32:
             return QString::number(subIndex->value().toReal(), 'f', 7) + QStringLiteral("f");
@@ -720,23 +815,8 @@ void CGenerator::writeRecordDefinitionH(Index *index, QTextStream &hFile)
     hFile << "typedef struct"
           << "  // 0x" << QString::number(index->index(), 16).toUpper() << "\n{\n";
 
-    QList<SubIndex *> recordFields;
-    for (SubIndex *subIndex : index->subIndexes())
-    {
-        QString dataType = typeToString(subIndex->dataType());
-        if (dataType.isEmpty())
-        {
-            continue;
-        }
-        recordFields.append(subIndex);
-    }
-    /*std::sort(recordFields.begin(),
-              recordFields.end(),
-              [](const SubIndex *a, const SubIndex *b) -> bool
-              {
-                  return a->length() > b->length();
-              });*/
-    for (SubIndex *subIndex : recordFields)
+    const QList<SubIndex *> fields = recordFields(index, _layoutOptimized);
+    for (SubIndex *subIndex : fields)
     {
         hFile << "    _od_align " << typeToString(subIndex->dataType()) << " " << varNameToString(subIndex->name()) << ";  // sub" << subIndex->subIndex() << "\n";
     }
@@ -760,10 +840,18 @@ void CGenerator::writeArrayDefinitionH(Index *index, QTextStream &hFile)
 
     hFile << "typedef struct"
           << "  // 0x" << QString::number(index->index(), 16).toUpper() << "\n{\n";
-    hFile << "    _od_align uint8_t sub0;"
-          << "\n";
+    if (!_layoutOptimized)
+    {
+        hFile << "    _od_align uint8_t sub0;"
+              << "\n";
+    }
     hFile << "    _od_align " << typeToString(index->subIndex(1)->dataType()) << " data[" << index->subIndexesCount() - 1 << "];"
           << "\n";
+    if (_layoutOptimized)
+    {
+        hFile << "    _od_align uint8_t sub0;"
+              << "\n";
+    }
     hFile << "} " << structName << ";\n\n";
 }
 
@@ -865,6 +953,21 @@ int CGenerator::writeRamLineC(Index *index, QTextStream &cFile)
             break;
 
         case Index::Object::ARRAY:
+            if (_defaultBlobs.contains(index->index()))
+            {
+                if (index->subIndex(0)->value().isValid())
+                {
+                    cFile << "    OD_RAM." << varNameToString(index->name()) << ".sub0 = " << dataToString(index->subIndex(0)) << ";";
+                    cFile << "  // 0x" << QString::number(index->index(), 16).toUpper() << ".0"
+                          << "\n";
+                    written++;
+                }
+                cFile << "    memcpy(OD_RAM." << varNameToString(index->name()) << ".data, " << _defaultBlobs.value(index->index()) << ", sizeof(OD_RAM."
+                      << varNameToString(index->name()) << ".data));";
+                cFile << "  // 0x" << QString::number(index->index(), 16).toUpper() << ".1-" << index->subIndexesCount() - 1 << "\n";
+                written++;
+                break;
+            }
             for (int i = 0; i < index->subIndexesCount(); i++)
             {
                 if (!index->subIndexExist(i))
@@ -906,10 +1009,10 @@ int CGenerator::writeRamLineC(Index *index, QTextStream &cFile)
  * @param index
  * @param .c file
  */
-void CGenerator::writeSubentriesList(Index *index, QTextStream &cFile)
+void CGenerator::writeSubentriesList(Index *index, QTextStream &out)
 {
-    cFile << "static const OD_entrySubIndex_t const od_Sub" << QString::number(index->index(), 16).toUpper().toUpper() << "[] =\n";
-    cFile << "{\n";
+    QString list;
+    QTextStream cFile(&list);
 
     switch (index->objectType())
     {
@@ -941,8 +1044,14 @@ void CGenerator::writeSubentriesList(Index *index, QTextStream &cFile)
         default:
             break;
     }
+    cFile.flush();
 
-    cFile << "};\n\n";
+    _subEntriesCount += list.count('\n');
+
+    out << "static const OD_entrySubIndex_t const od_Sub" << QString::number(index->index(), 16).toUpper() << "[] =\n";
+    out << "{\n";
+    out << list;
+    out << "};\n\n";
 }
 
 void CGenerator::writeSubentry(const SubIndex *subIndex, QTextStream &cFile)
@@ -964,7 +1073,7 @@ void CGenerator::writeSubentry(const SubIndex *subIndex, QTextStream &cFile)
         case Index::VAR:
             if (subIndex->dataType() == SubIndex::VISIBLE_STRING || subIndex->dataType() == SubIndex::OCTET_STRING || subIndex->dataType() == SubIndex::UNICODE_STRING)
             {
-                cFile << "(void*)" << varNameToString(subIndex->name()) << "Str";
+                cFile << "(void*)" << _stringAliases.value(stringNameToString(subIndex), stringNameToString(subIndex));
             }
             else
             {
@@ -1041,8 +1150,6 @@ void CGenerator::writeCharLineC(const SubIndex *subIndex, QTextStream &cFile)
     {
         case SubIndex::VISIBLE_STRING:
         case SubIndex::OCTET_STRING:
-            cFile << "static const char " << stringNameToString(subIndex) << "[]"
-                  << " = ";
             value = subIndex->value().toString();
             if (value.startsWith("__") && value.endsWith("__") && value.size() > 4)  // value contain preprocessor value
             {
@@ -1051,7 +1158,22 @@ void CGenerator::writeCharLineC(const SubIndex *subIndex, QTextStream &cFile)
             else
             {
                 value = "\"" + value + "\"";
+                _stringBytes[0] += subIndex->value().toString().toUtf8().size() + 1;
+                if (_layoutOptimized)
+                {
+                    // identical const strings are shared
+                    QString alias = _stringNames.value(value);
+                    if (!alias.isEmpty())
+                    {
+                        _stringAliases.insert(stringNameToString(subIndex), alias);
+                        break;
+                    }
+                    _stringNames.insert(value, stringNameToString(subIndex));
+                }
+                _stringBytes[1] += subIndex->value().toString().toUtf8().size() + 1;
             }
+            cFile << "static const char " << stringNameToString(subIndex) << "[]"
+                  << " = ";
             cFile << value << ";\n";
             break;
 
@@ -1180,3 +1302,760 @@ void CGenerator::writeSetNodeId(DeviceConfiguration *deviceConfiguration, QTextS
 
     cFile << "}\n";
 }
+
+/**
+ * @brief indexes written in OD[] table, in the same order
+ */
+QList<Index *> CGenerator::odEntries(const QMap<uint16_t, Index *> &indexes)
+{
+    QList<Index *> entries;
+    for (Index *index : indexes)
+    {
+        if (index->subIndexExist(0))
+        {
+            entries.append(index);
+        }
+    }
+    return entries;
+}
+
+/**
+ * @brief PDO mappable sub-indexes stored in OD_RAM, sorted by index and sub-index
+ */
+QList<CGenerator::PdoMappableEntry> CGenerator::pdoMappableEntries(const QMap<uint16_t, Index *> &indexes)
+{
+    QList<PdoMappableEntry> entries;
+    for (Index *index : indexes)
+    {
+        QString name = varNameToString(index->name());
+        for (SubIndex *subIndex : index->subIndexes())
+        {
+            if ((subIndex->accessType() & (SubIndex::TPDO | SubIndex::RPDO)) == 0)
+            {
+                continue;
+            }
+            if (typeToString(subIndex->dataType()).isEmpty() || subIndex->dataType() == SubIndex::VISIBLE_STRING
+                || subIndex->dataType() == SubIndex::OCTET_STRING || subIndex->dataType() == SubIndex::DDOMAIN)
+            {
+                continue;
+            }
+
+            PdoMappableEntry entry;
+            entry.subIndex = subIndex;
+            switch (index->objectType())
+            {
+                case Index::VAR:
+                    if (subIndex->subIndex() != 0)
+                    {
+                        continue;
+                    }
+                    entry.member = name;
+                    entry.offset = "offsetof(struct sOD_RAM, " + name + ")";
+                    break;
+
+                case Index::ARRAY:
+                    if (subIndex->subIndex() == 0)
+                    {
+                        entry.member = name + ".sub0";
+                        entry.offset = "offsetof(struct sOD_RAM, " + name + ".sub0)";
+                    }
+                    else
+                    {
+                        entry.member = name + ".data[" + QString::number(subIndex->subIndex() - 1) + "]";
+                        entry.offset = "offsetof(struct sOD_RAM, " + name + ".data) + " + QString::number(subIndex->subIndex() - 1) + " * sizeof(OD_RAM." + name
+                                     + ".data[0])";
+                    }
+                    break;
+
+                case Index::RECORD:
+                    entry.member = name + "." + varNameToString(subIndex->name());
+                    entry.offset = "offsetof(struct sOD_RAM, " + entry.member + ")";
+                    break;
+
+                default:
+                    continue;
+            }
+            entries.append(entry);
+        }
+    }
+    return entries;
+}
+
+/**
+ * @brief writes lookup types and functions declarations in .h file
+ * @param device configuration model
+ * @param .h file
+ */
+void CGenerator::writeLookupH(DeviceConfiguration *deviceConfiguration, QTextStream &hFile)
+{
+    hFile << "// ============== O(1) lookup ================"
+          << "\n";
+    hFile << "typedef struct"
+          << "\n{\n";
+    hFile << "    uint16_t index;"
+          << "\n";
+    hFile << "    uint8_t subIndex;"
+          << "\n";
+    hFile << "    uint8_t access;"
+          << "\n";
+    hFile << "    uint8_t bitLength;"
+          << "\n";
+    hFile << "    uint16_t ramOffset;  // byte offset in OD_RAM"
+          << "\n";
+    hFile << "} OD_pdoMappable_t;"
+          << "\n";
+    hFile << "\n";
+
+    int count = pdoMappableEntries(deviceConfiguration->indexes()).count();
+    hFile << "#define OD_PDO_MAPPABLE_COUNT " << count << "\n";
+    if (count > 0)
+    {
+        hFile << "extern const OD_pdoMappable_t OD_pdoMappable[OD_PDO_MAPPABLE_COUNT];"
+              << "\n";
+    }
+    hFile << "\n";
+    hFile << "const OD_entry_t *od_lookup(uint16_t index);"
+          << "\n";
+    hFile << "const OD_pdoMappable_t *od_lookupPdoMappable(uint16_t index, uint8_t subIndex);"
+          << "\n";
+    hFile << "\n";
+    hFile << "#ifdef OD_LOOKUP_SELFTEST"
+          << "\n";
+    hFile << "int od_lookupSelfTest(void);"
+          << "\n";
+    hFile << "void od_lookupBenchmark(uint32_t loops, uint32_t *lookupClocks, uint32_t *searchClocks);"
+          << "\n";
+    hFile << "#endif"
+          << "\n";
+    hFile << "\n";
+}
+
+/**
+ * @brief writes a collision free two level lookup of OD[] entries in .c file
+ *
+ * First level is indexed by the index high byte and gives a page, each page holds the OD[]
+ * positions of the low byte range it covers. Lookup costs three table reads.
+ * @param device configuration model
+ * @param .c file
+ */
+void CGenerator::writeLookupC(DeviceConfiguration *deviceConfiguration, QTextStream &cFile)
+{
+    const QList<Index *> entries = odEntries(deviceConfiguration->indexes());
+
+    // pages of used high bytes, with low byte range
+    QMap<uint8_t, QPair<uint8_t, uint8_t>> pages;
+    for (Index *index : entries)
+    {
+        uint8_t high = static_cast<uint8_t>(index->index() >> 8);
+        uint8_t low = static_cast<uint8_t>(index->index() & 0xFF);
+        auto it = pages.find(high);
+        if (it == pages.end())
+        {
+            pages.insert(high, qMakePair(low, low));
+        }
+        else
+        {
+            it.value().first = qMin(it.value().first, low);
+            it.value().second = qMax(it.value().second, low);
+        }
+    }
+
+    QMap<uint8_t, int> pageIds;
+    QMap<uint8_t, int> pageOffsets;
+    int slotCount = 0;
+    for (auto it = pages.cbegin(); it != pages.cend(); ++it)
+    {
+        pageIds.insert(it.key(), pageIds.count());
+        pageOffsets.insert(it.key(), slotCount);
+        slotCount += it.value().second - it.value().first + 1;
+    }
+    QVector<int> lookupSlots(slotCount, -1);
+    for (int position = 0; position < entries.count(); position++)
+    {
+        uint16_t index = entries.at(position)->index();
+        uint8_t high = static_cast<uint8_t>(index >> 8);
+        lookupSlots[pageOffsets.value(high) + (index & 0xFF) - pages.value(high).first] = position;
+    }
+
+    cFile << "\n";
+    cFile << "// ==================== O(1) lookup ======================="
+          << "\n";
+    cFile << "#define OD_LOOKUP_NONE 0xFFFFu"
+          << "\n";
+    cFile << "#define OD_LOOKUP_ENTRIES_COUNT " << entries.count() << "u"
+          << "\n";
+    cFile << "\n";
+    cFile << "typedef struct"
+          << "\n{\n";
+    cFile << "    uint16_t slotOffset;"
+          << "\n";
+    cFile << "    uint8_t lowMin;"
+          << "\n";
+    cFile << "    uint8_t lowMax;"
+          << "\n";
+    cFile << "} OD_lookupPage_t;"
+          << "\n";
+    cFile << "\n";
+
+    // first level, page id by high byte
+    cFile << "static const uint8_t OD_lookupPageId[256] ="
+          << "\n";
+    cFile << "{";
+    for (int high = 0; high < 256; high++)
+    {
+        if (high % 16 == 0)
+        {
+            cFile << "\n    ";
+        }
+        cFile << "0x" << QString::number(pageIds.value(static_cast<uint8_t>(high), 0xFF), 16).toUpper().rightJustified(2, '0') << ",";
+        if (high % 16 != 15)
+        {
+            cFile << " ";
+        }
+    }
+    cFile << "\n};\n\n";
+
+    cFile << "static const OD_lookupPage_t OD_lookupPages[" << qMax(1, pages.count()) << "] ="
+          << "\n";
+    cFile << "{"
+          << "\n";
+    cFile << "//  {slotOffset, lowMin, lowMax}"
+          << "\n";
+    for (auto it = pages.cbegin(); it != pages.cend(); ++it)
+    {
+        cFile << "    {" << QString::number(pageOffsets.value(it.key())).rightJustified(4, ' ') << ", 0x" << QString::number(it.value().first, 16).toUpper().rightJustified(2, '0')
+              << ", 0x" << QString::number(it.value().second, 16).toUpper().rightJustified(2, '0') << "},  // 0x"
+              << QString::number(it.key(), 16).toUpper().rightJustified(2, '0') << "xx\n";
+    }
+    if (pages.isEmpty())
+    {
+        cFile << "    {0, 0xFF, 0x00},"
+              << "\n";
+    }
+    cFile << "};\n\n";
+
+    // second level, OD[] position by low byte
+    cFile << "static const uint16_t OD_lookupSlots[" << qMax(1, slotCount) << "] ="
+          << "\n";
+    cFile << "{";
+    for (int slot = 0; slot < lookupSlots.count(); slot++)
+    {
+        if (slot % 8 == 0)
+        {
+            cFile << "\n    ";
+        }
+        if (lookupSlots.at(slot) < 0)
+        {
+            cFile << "OD_LOOKUP_NONE,";
+        }
+        else
+        {
+            cFile << QString::number(lookupSlots.at(slot)).rightJustified(14, ' ') << ",";
+        }
+        if (slot % 8 != 7)
+        {
+            cFile << " ";
+        }
+    }
+    if (lookupSlots.isEmpty())
+    {
+        cFile << "\n    OD_LOOKUP_NONE";
+    }
+    cFile << "\n};\n\n";
+
+    cFile << "const OD_entry_t *od_lookup(uint16_t index)"
+          << "\n";
+    cFile << "{"
+          << "\n";
+    cFile << "    uint8_t pageId = OD_lookupPageId[index >> 8];"
+          << "\n";
+    cFile << "    if (pageId == 0xFFu)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        return NULL;"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    const OD_lookupPage_t *page = &OD_lookupPages[pageId];"
+          << "\n";
+    cFile << "    uint8_t low = (uint8_t)(index & 0xFFu);"
+          << "\n";
+    cFile << "    if (low < page->lowMin || low > page->lowMax)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        return NULL;"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    uint16_t slot = OD_lookupSlots[page->slotOffset + (uint16_t)(low - page->lowMin)];"
+          << "\n";
+    cFile << "    if (slot == OD_LOOKUP_NONE)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        return NULL;"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    return &OD[slot];"
+          << "\n";
+    cFile << "}"
+          << "\n";
+}
+
+/**
+ * @brief writes PDO mappable sub-indexes table with their OD_RAM byte offset, and its lookup function
+ * @param device configuration model
+ * @param .c file
+ */
+void CGenerator::writePdoMappableC(DeviceConfiguration *deviceConfiguration, QTextStream &cFile)
+{
+    const QList<PdoMappableEntry> entries = pdoMappableEntries(deviceConfiguration->indexes());
+
+    cFile << "\n";
+    cFile << "// ================= PDO mappable objects =================="
+          << "\n";
+    if (!entries.isEmpty())
+    {
+        cFile << "const OD_pdoMappable_t OD_pdoMappable[OD_PDO_MAPPABLE_COUNT] ="
+              << "\n";
+        cFile << "{"
+              << "\n";
+        cFile << "//  {index, subIndex, access, bitLength, ramOffset}"
+              << "\n";
+        for (const PdoMappableEntry &entry : entries)
+        {
+            cFile << "    {0x" << QString::number(entry.subIndex->index()->index(), 16).toUpper() << ", " << entry.subIndex->subIndex() << ", "
+                  << accessToEnumString(entry.subIndex->accessType()) << ", (uint8_t)(sizeof(OD_RAM." << entry.member << ") * 8u), (uint16_t)(" << entry.offset
+                  << ")},\n";
+        }
+        cFile << "};\n\n";
+    }
+
+    cFile << "const OD_pdoMappable_t *od_lookupPdoMappable(uint16_t index, uint8_t subIndex)"
+          << "\n";
+    cFile << "{"
+          << "\n";
+    if (entries.isEmpty())
+    {
+        cFile << "    (void)index;"
+              << "\n";
+        cFile << "    (void)subIndex;"
+              << "\n";
+        cFile << "    return NULL;"
+              << "\n";
+        cFile << "}"
+              << "\n";
+        return;
+    }
+    cFile << "    uint32_t key = ((uint32_t)index << 8) | subIndex;"
+          << "\n";
+    cFile << "    uint16_t min = 0;"
+          << "\n";
+    cFile << "    uint16_t max = OD_PDO_MAPPABLE_COUNT;"
+          << "\n";
+    cFile << "    while (min < max)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        uint16_t mid = (uint16_t)((min + max) >> 1);"
+          << "\n";
+    cFile << "        uint32_t midKey = ((uint32_t)OD_pdoMappable[mid].index << 8) | OD_pdoMappable[mid].subIndex;"
+          << "\n";
+    cFile << "        if (midKey == key)"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            return &OD_pdoMappable[mid];"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "        if (midKey < key)"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            min = mid + 1;"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "        else"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            max = mid;"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    return NULL;"
+          << "\n";
+    cFile << "}"
+          << "\n";
+}
+
+/**
+ * @brief writes host side self test and benchmark of od_lookup against a linear search of OD[]
+ * @param .c file
+ */
+void CGenerator::writeLookupSelfTestC(QTextStream &cFile)
+{
+    cFile << "\n";
+    cFile << "#ifdef OD_LOOKUP_SELFTEST"
+          << "\n";
+    cFile << "#include <time.h>"
+          << "\n";
+    cFile << "\n";
+    cFile << "static const OD_entry_t *od_searchLinear(uint16_t index)"
+          << "\n";
+    cFile << "{"
+          << "\n";
+    cFile << "    uint16_t i;"
+          << "\n";
+    cFile << "    for (i = 0; i < OD_LOOKUP_ENTRIES_COUNT; i++)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        if (OD[i].index == index)"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            return &OD[i];"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    return NULL;"
+          << "\n";
+    cFile << "}"
+          << "\n";
+    cFile << "\n";
+    cFile << "// returns the count of indexes where od_lookup differs from a linear search"
+          << "\n";
+    cFile << "int od_lookupSelfTest(void)"
+          << "\n";
+    cFile << "{"
+          << "\n";
+    cFile << "    int errors = 0;"
+          << "\n";
+    cFile << "    uint32_t index;"
+          << "\n";
+    cFile << "    for (index = 0; index <= 0xFFFFu; index++)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        if (od_lookup((uint16_t)index) != od_searchLinear((uint16_t)index))"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            errors++;"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    return errors;"
+          << "\n";
+    cFile << "}"
+          << "\n";
+    cFile << "\n";
+    cFile << "// clocks spent to look up all OD[] indexes loops times, with od_lookup and linear search"
+          << "\n";
+    cFile << "void od_lookupBenchmark(uint32_t loops, uint32_t *lookupClocks, uint32_t *searchClocks)"
+          << "\n";
+    cFile << "{"
+          << "\n";
+    cFile << "    const OD_entry_t *volatile entry;"
+          << "\n";
+    cFile << "    uint32_t loop;"
+          << "\n";
+    cFile << "    uint16_t i;"
+          << "\n";
+    cFile << "    clock_t start = clock();"
+          << "\n";
+    cFile << "    for (loop = 0; loop < loops; loop++)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        for (i = 0; i < OD_LOOKUP_ENTRIES_COUNT; i++)"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            entry = od_lookup(OD[i].index);"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    *lookupClocks = (uint32_t)(clock() - start);"
+          << "\n";
+    cFile << "\n";
+    cFile << "    start = clock();"
+          << "\n";
+    cFile << "    for (loop = 0; loop < loops; loop++)"
+          << "\n";
+    cFile << "    {"
+          << "\n";
+    cFile << "        for (i = 0; i < OD_LOOKUP_ENTRIES_COUNT; i++)"
+          << "\n";
+    cFile << "        {"
+          << "\n";
+    cFile << "            entry = od_searchLinear(OD[i].index);"
+          << "\n";
+    cFile << "        }"
+          << "\n";
+    cFile << "    }"
+          << "\n";
+    cFile << "    *searchClocks = (uint32_t)(clock() - start);"
+          << "\n";
+    cFile << "    (void)entry;"
+          << "\n";
+    cFile << "}"
+          << "\n";
+    cFile << "#endif  // OD_LOOKUP_SELFTEST"
+          << "\n";
+}
+
+/**
+ * @brief sequential layout of members, size rounded to the struct alignment
+ * @param members layout
+ * @param maxAlign maximal alignment of the target
+ */
+CGenerator::MemberLayout CGenerator::structLayout(const QList<MemberLayout> &members, int maxAlign)
+{
+    MemberLayout layout{0, 1};
+    for (const MemberLayout &member : members)
+    {
+        if (member.size == 0)
+        {
+            return MemberLayout{0, 1};
+        }
+        int align = qMin(member.align, maxAlign);
+        layout.size = (layout.size + align - 1) / align * align + member.size;
+        layout.align = qMax(layout.align, align);
+    }
+    layout.size = (layout.size + layout.align - 1) / layout.align * layout.align;
+    return layout;
+}
+
+/**
+ * @brief layout of the OD_RAM member of an index, size is 0 for unknown size (domain, string) or no member
+ */
+CGenerator::MemberLayout CGenerator::indexLayout(Index *index, int maxAlign, bool optimized)
+{
+    QList<MemberLayout> members;
+    int size;
+    switch (index->objectType())
+    {
+        case Index::VAR:
+            if (!index->subIndexExist(0) || typeToString(index->subIndex(0)->dataType()).isEmpty())
+            {
+                break;
+            }
+            if (index->subIndex(0)->dataType() == SubIndex::VISIBLE_STRING || index->subIndex(0)->dataType() == SubIndex::OCTET_STRING)
+            {
+                break;  // const string, not in OD_RAM
+            }
+            size = index->subIndex(0)->length();
+            return MemberLayout{size, qMin(qMax(size, 1), maxAlign)};
+
+        case Index::ARRAY:
+            if (!index->subIndexExist(1))
+            {
+                break;
+            }
+            size = index->subIndex(1)->length();
+            members.append(MemberLayout{size * (index->subIndexesCount() - 1), qMax(size, 1)});
+            if (optimized)
+            {
+                members.append(MemberLayout{1, 1});
+            }
+            else
+            {
+                members.prepend(MemberLayout{1, 1});
+            }
+            return structLayout(members, maxAlign);
+
+        case Index::RECORD:
+            for (SubIndex *subIndex : recordFields(index, optimized))
+            {
+                size = subIndex->length();
+                members.append(MemberLayout{size, qMax(size, 1)});
+            }
+            return structLayout(members, maxAlign);
+
+        default:
+            break;
+    }
+    return MemberLayout{0, 0};
+}
+
+/**
+ * @brief record fields written in record struct, sorted by decreasing size in optimized layout
+ */
+QList<SubIndex *> CGenerator::recordFields(Index *index, bool optimized)
+{
+    QList<SubIndex *> fields;
+    for (SubIndex *subIndex : index->subIndexes())
+    {
+        QString dataType = typeToString(subIndex->dataType());
+        if (dataType.isEmpty())
+        {
+            continue;
+        }
+        fields.append(subIndex);
+    }
+    if (optimized)
+    {
+        std::stable_sort(fields.begin(),
+                         fields.end(),
+                         [](const SubIndex *a, const SubIndex *b) -> bool
+                         {
+                             return a->length() > b->length();
+                         });
+    }
+    return fields;
+}
+
+/**
+ * @brief OD_RAM members order, OD order or sorted by decreasing alignment in optimized layout
+ */
+QList<Index *> CGenerator::ramOrder(const QMap<uint16_t, Index *> &indexes, bool optimized)
+{
+    QList<Index *> order = indexes.values();
+    if (optimized)
+    {
+        QMap<Index *, int> aligns;
+        for (Index *index : order)
+        {
+            aligns.insert(index, indexLayout(index, 8, true).align);
+        }
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&aligns](Index *a, Index *b) -> bool
+                         {
+                             return aligns.value(a) > aligns.value(b);
+                         });
+    }
+    return order;
+}
+
+/**
+ * @brief computed sizeof(struct sOD_RAM) for a target max alignment, 0 if a member size is unknown
+ */
+int CGenerator::ramSize(const QMap<uint16_t, Index *> &indexes, int maxAlign, bool optimized)
+{
+    QList<MemberLayout> members;
+    for (Index *index : ramOrder(indexes, optimized))
+    {
+        MemberLayout layout = indexLayout(index, maxAlign, optimized);
+        if (layout.align == 0)
+        {
+            continue;  // no member
+        }
+        members.append(layout);
+    }
+    return structLayout(members, maxAlign).size;
+}
+
+/**
+ * @brief writes arrays default values as const blobs, identical blobs are shared
+ * @param indexes
+ * @param .c file
+ */
+void CGenerator::writeDefaultBlobsC(const QMap<uint16_t, Index *> &indexes, QTextStream &cFile)
+{
+    QMap<QString, QString> blobNames;
+    for (Index *index : indexes)
+    {
+        if (index->objectType() != Index::ARRAY || index->subIndexesCount() < 3 || !index->subIndexExist(1))
+        {
+            continue;
+        }
+
+        // all data sub-indexes need a default value
+        QString type = typeToString(index->subIndex(1)->dataType());
+        QStringList values;
+        for (int i = 1; i < index->subIndexesCount(); i++)
+        {
+            if (!index->subIndexExist(i) || !index->subIndex(i)->value().isValid() || index->subIndex(i)->dataType() == SubIndex::DDOMAIN
+                || index->subIndex(i)->hasNodeId())
+            {
+                values.clear();
+                break;
+            }
+            values.append(dataToString(index->subIndex(i)));
+        }
+        if (values.isEmpty() || type.isEmpty())
+        {
+            continue;
+        }
+
+        QString blob = type + "[" + QString::number(values.count()) + "] = {" + values.join(", ") + "}";
+        QString name = blobNames.value(blob);
+        if (name.isEmpty())
+        {
+            name = "od_Default" + QString::number(index->index(), 16).toUpper();
+            blobNames.insert(blob, name);
+            cFile << "static const " << type << " " << name << "[" << values.count() << "] = {" << values.join(", ") << "};\n";
+        }
+        _defaultBlobs.insert(index->index(), name);
+        _defaultBlobsCount[0]++;
+    }
+    _defaultBlobsCount[1] = blobNames.count();
+    if (!blobNames.isEmpty())
+    {
+        cFile << "\n";
+    }
+}
+
+/**
+ * @brief writes layout size report and host layout check in .c file
+ *
+ * Sizes are computed with natural alignment bounded by the target alignment, _od_align is expected
+ * to add no alignment. Flash sizes are estimated for 6 bytes sub-entry descriptors (16-bit target).
+ * @param device configuration model
+ * @param .c file
+ */
+void CGenerator::writeLayoutReportC(DeviceConfiguration *deviceConfiguration, QTextStream &cFile)
+{
+    const QMap<uint16_t, Index *> indexes = deviceConfiguration->indexes();
+    const int subEntrySize = 6;
+
+    QString report;
+    QTextStream out(&report);
+    out << "OD_RAM bytes, 16-bit target: " << ramSize(indexes, 2, false) << " -> " << ramSize(indexes, 2, true) << "\n";
+    out << "OD_RAM bytes, 32-bit target: " << ramSize(indexes, 4, false) << " -> " << ramSize(indexes, 4, true) << "\n";
+    out << "sub-entry descriptors: " << _subEntriesCount << "\n";
+    out << "const strings bytes: " << _stringBytes[0] << " -> " << _stringBytes[1] << "\n";
+    out << "FLASH bytes (descriptors and strings): " << _subEntriesCount * subEntrySize + _stringBytes[0] << " -> "
+        << _subEntriesCount * subEntrySize + _stringBytes[1] << "\n";
+    out << "arrays initialized from default blobs: " << _defaultBlobsCount[0] << " (" << _defaultBlobsCount[1] << " distinct blobs)"
+        << "\n";
+    out.flush();
+    _layoutReport = report;
+
+    cFile << "\n";
+    cFile << "// ==================== layout report ======================"
+          << "\n";
+    for (const QString &line : report.split('\n', QString::SkipEmptyParts))
+    {
+        cFile << "// " << line << "\n";
+    }
+
+    if (ramSize(indexes, 8, true) > 0)
+    {
+        cFile << "\n";
+        cFile << "#ifdef OD_LAYOUT_CHECK"
+              << "\n";
+        cFile << "// host check of the computed layout, fails to compile on mismatch"
+              << "\n";
+        cFile << "typedef char od_layoutCheck[(sizeof(struct sOD_RAM) == OD_RAM_SIZE_HOST) ? 1 : -1];"
+              << "\n";
+        cFile << "#endif  // OD_LAYOUT_CHECK"
+              << "\n";
+    }
+}
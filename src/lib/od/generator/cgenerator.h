@@ -23,6 +23,8 @@
 
 #include "generator/generator.h"
 
+#include <QList>
+#include <QMap>
 #include <QSet>
 #include <QString>
 #include <QTextStream>
@@ -45,11 +47,18 @@ public:
 
     bool generateHStruct(DeviceConfiguration *deviceConfiguration, const QString &filePath, uint16_t min, uint16_t max, const QString &structName);
 
+    bool isLookupEnabled() const;
+    void setLookupEnabled(bool lookupEnabled);
+
+    bool isLayoutOptimized() const;
+    void setLayoutOptimized(bool layoutOptimized);
+    const QString &layoutReport() const;
+
 private:
     static QString typeToString(SubIndex::DataType type);
     static QString varNameToString(const QString &name);
     static QString structNameToString(const QString &name);
-    static QString dataToString(const SubIndex *index);
+    QString dataToString(const SubIndex *index) const;
     static QString objectTypeToEnumString(uint16_t objectType);
     static QString dataTypeToEnumString(uint16_t dataType);
     static QString accessToEnumString(uint8_t acces);
@@ -70,7 +79,44 @@ private:
 
     void writeSetNodeId(DeviceConfiguration *deviceConfiguration, QTextStream &cFile);
 
+    // O(1) lookup and PDO mappable tables
+    struct PdoMappableEntry
+    {
+        const SubIndex *subIndex;
+        QString member;
+        QString offset;
+    };
+    static QList<Index *> odEntries(const QMap<uint16_t, Index *> &indexes);
+    static QList<PdoMappableEntry> pdoMappableEntries(const QMap<uint16_t, Index *> &indexes);
+    void writeLookupH(DeviceConfiguration *deviceConfiguration, QTextStream &hFile);
+    void writeLookupC(DeviceConfiguration *deviceConfiguration, QTextStream &cFile);
+    void writePdoMappableC(DeviceConfiguration *deviceConfiguration, QTextStream &cFile);
+    void writeLookupSelfTestC(QTextStream &cFile);
+
+    // optimized layout
+    struct MemberLayout
+    {
+        int size;   // 0 if unknown
+        int align;
+    };
+    static MemberLayout structLayout(const QList<MemberLayout> &members, int maxAlign);
+    static MemberLayout indexLayout(Index *index, int maxAlign, bool optimized);
+    static QList<SubIndex *> recordFields(Index *index, bool optimized);
+    static QList<Index *> ramOrder(const QMap<uint16_t, Index *> &indexes, bool optimized);
+    static int ramSize(const QMap<uint16_t, Index *> &indexes, int maxAlign, bool optimized);
+    void writeDefaultBlobsC(const QMap<uint16_t, Index *> &indexes, QTextStream &cFile);
+    void writeLayoutReportC(DeviceConfiguration *deviceConfiguration, QTextStream &cFile);
+
     QSet<QString> _typeSetTable;
+    bool _lookupEnabled;
+    bool _layoutOptimized;
+    QString _layoutReport;
+    QMap<QString, QString> _stringNames;     // value -> first string name
+    QMap<QString, QString> _stringAliases;   // string name -> shared string name
+    QMap<uint16_t, QString> _defaultBlobs;
+    int _stringBytes[2];        // before, after dedup
+    int _subEntriesCount;
+    int _defaultBlobsCount[2];  // arrays initialized with a blob, distinct blobs
 };
 
 #endif  // CGENERATOR_H
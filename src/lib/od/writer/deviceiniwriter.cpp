@@ -325,7 +325,7 @@ void DeviceIniWriter::writeStringMap(const QMap<QString, QString> &map) const
  * @param base, 16 or 10
  * @return formated string
  */
-QString DeviceIniWriter::valueToString(int value, int base, int width) const
+QString DeviceIniWriter::valueToString(int value, int base, int width)
 {
     switch (base)
     {
@@ -349,7 +349,7 @@ QString DeviceIniWriter::valueToString(int value, int base, int width) const
  * @param access code
  * @return formated string
  */
-QString DeviceIniWriter::accessToString(int access) const
+QString DeviceIniWriter::accessToString(int access)
 {
     switch (access)
     {
@@ -383,7 +383,7 @@ QString DeviceIniWriter::accessToString(int access) const
  * @param QVariant
  * @return string
  */
-QString DeviceIniWriter::dataToString(const QVariant &value) const
+QString DeviceIniWriter::dataToString(const QVariant &value)
 {
     if (value.type() == QVariant::String)
     {
@@ -397,7 +397,7 @@ QString DeviceIniWriter::dataToString(const QVariant &value) const
  * @param 8 bits access type code
  * @return 1 or 0 as a string
  */
-QString DeviceIniWriter::pdoToString(uint8_t accessType) const
+QString DeviceIniWriter::pdoToString(uint8_t accessType)
 {
     if ((accessType & SubIndex::TPDO) == SubIndex::TPDO || (accessType & SubIndex::RPDO) == SubIndex::RPDO)
     {
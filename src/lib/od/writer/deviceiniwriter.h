@@ -25,7 +25,7 @@
 
 #include "model/devicemodel.h"
 
-class DeviceIniWriter
+class OD_EXPORT DeviceIniWriter
 {
 public:
     DeviceIniWriter(QTextStream *file);
@@ -47,12 +47,13 @@ public:
     bool isDescription() const;
     void setDescription(bool description);
 
+    static QString valueToString(int value, int base = 10, int width = 0);
+    static QString accessToString(int access);
+    static QString dataToString(const QVariant &value);
+    static QString pdoToString(uint8_t accessType);
+
 private:
     QString defaultValue(const SubIndex *subIndex) const;
-    QString valueToString(int value, int base = 10, int width = 0) const;
-    QString accessToString(int access) const;
-    QString dataToString(const QVariant &value) const;
-    QString pdoToString(uint8_t accessType) const;
 
     QTextStream *_file;
     bool _isDescription;
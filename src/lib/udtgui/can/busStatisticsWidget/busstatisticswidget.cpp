@@ -0,0 +1,193 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "busstatisticswidget.h"
+
+#include "canopenbus.h"
+
+#include <QFontMetrics>
+#include <QFormLayout>
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+BusStatisticsWidget::BusStatisticsWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    createWidgets();
+    setBus(nullptr);
+}
+
+CanOpenBus *BusStatisticsWidget::bus() const
+{
+    return _bus;
+}
+
+void BusStatisticsWidget::setBus(CanOpenBus *bus)
+{
+    if (_bus != nullptr)
+    {
+        disconnect(_bus->statistics(), &BusStatistics::snapshotPublished, this, &BusStatisticsWidget::updateStatistics);
+    }
+
+    _bus = bus;
+    if (_bus != nullptr)
+    {
+        connect(_bus->statistics(), &BusStatistics::snapshotPublished, this, &BusStatisticsWidget::updateStatistics);
+    }
+    updateStatistics();
+}
+
+void BusStatisticsWidget::updateStatistics()
+{
+    if (_bus == nullptr)
+    {
+        _busLoadBar->setValue(0);
+        _peakLoadLabel->setText("-");
+        _framesRateLabel->setText("-");
+        _framesCountLabel->setText("-");
+        _errorFramesLabel->setText("-");
+        _cobIdTable->setRowCount(0);
+        return;
+    }
+    if (!isVisible())
+    {
+        return;
+    }
+
+    BusStatistics::Snapshot snapshot = _bus->statistics()->snapshot();
+    _busLoadBar->setValue(qRound(snapshot.busLoad * 1000.0));
+    _busLoadBar->setFormat(QString("%1 %").arg(snapshot.busLoad * 100.0, 0, 'f', 1));
+    _peakLoadLabel->setText(QString("%1 %").arg(snapshot.peakBusLoad * 100.0, 0, 'f', 1));
+    _framesRateLabel->setText(tr("%1 frames/s").arg(snapshot.framesPerSecond, 0, 'f', 0));
+    _framesCountLabel->setText(tr("%1 (%2 sent)").arg(snapshot.framesCount).arg(snapshot.txFramesCount));
+    _errorFramesLabel->setText(QString::number(snapshot.errorFramesCount));
+
+    // busiest cob ids first
+    QVector<const BusStatistics::CobIdStats *> cobIds;
+    cobIds.reserve(snapshot.cobIds.size());
+    for (const BusStatistics::CobIdStats &stats : snapshot.cobIds)
+    {
+        cobIds.append(&stats);
+    }
+    int rowCount = qMin(cobIds.size(), static_cast<int>(TOP_COB_ID_COUNT));
+    std::partial_sort(cobIds.begin(), cobIds.begin() + rowCount, cobIds.end(), [](const BusStatistics::CobIdStats *a, const BusStatistics::CobIdStats *b) {
+        return a->rate > b->rate;
+    });
+
+    _cobIdTable->setRowCount(rowCount);
+    for (int row = 0; row < rowCount; row++)
+    {
+        const BusStatistics::CobIdStats *stats = cobIds.at(row);
+        const QStringList texts = {QString("0x%1").arg(stats->cobId, 3, 16, QChar('0')),
+                                   serviceStr(stats->cobId),
+                                   QString::number(stats->cobId & 0x7F),
+                                   QString::number(stats->rate, 'f', 1),
+                                   QString::number(static_cast<qreal>(stats->meanIntervalUs) / 1000.0, 'f', 2),
+                                   QString::number(static_cast<qreal>(stats->jitterUs) / 1000.0, 'f', 2),
+                                   QString::number(stats->count)};
+        for (int column = 0; column < ColumnColumnCount; column++)
+        {
+            QTableWidgetItem *item = _cobIdTable->item(row, column);
+            if (item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                item->setTextAlignment((column == ColumnService) ? (Qt::AlignLeft | Qt::AlignVCenter) : (Qt::AlignRight | Qt::AlignVCenter));
+                _cobIdTable->setItem(row, column, item);
+            }
+            item->setText(texts.at(column));
+        }
+    }
+}
+
+void BusStatisticsWidget::createWidgets()
+{
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->setContentsMargins(2, 2, 2, 2);
+
+    QFormLayout *formLayout = new QFormLayout();
+    _busLoadBar = new QProgressBar();
+    _busLoadBar->setRange(0, 1000);
+    formLayout->addRow(tr("Bus load:"), _busLoadBar);
+
+    _peakLoadLabel = new QLabel();
+    formLayout->addRow(tr("Peak load:"), _peakLoadLabel);
+
+    _framesRateLabel = new QLabel();
+    formLayout->addRow(tr("Frames rate:"), _framesRateLabel);
+
+    _framesCountLabel = new QLabel();
+    formLayout->addRow(tr("Frames:"), _framesCountLabel);
+
+    _errorFramesLabel = new QLabel();
+    formLayout->addRow(tr("Error frames:"), _errorFramesLabel);
+    layout->addLayout(formLayout);
+
+    _cobIdTable = new QTableWidget(0, ColumnColumnCount);
+    _cobIdTable->setHorizontalHeaderLabels({tr("CobId"), tr("Service"), tr("Node"), tr("Frames/s"), tr("Period (ms)"), tr("Jitter (ms)"), tr("Count")});
+    _cobIdTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _cobIdTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    _cobIdTable->verticalHeader()->hide();
+    _cobIdTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    _cobIdTable->verticalHeader()->setDefaultSectionSize(QFontMetrics(font()).height() * 3 / 2);
+    _cobIdTable->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(_cobIdTable);
+
+    setLayout(layout);
+}
+
+QString BusStatisticsWidget::serviceStr(quint32 cobId)
+{
+    switch (cobId >> 7)
+    {
+        case 0x0:
+            return (cobId == 0) ? QString("NMT") : QString();
+
+        case 0x1:
+            return (cobId == 0x80) ? QString("SYNC") : QString("EMCY");
+
+        case 0x2:
+            return (cobId == 0x100) ? QString("TIME") : QString();
+
+        case 0x3:
+        case 0x5:
+        case 0x7:
+        case 0x9:
+            return QString("TPDO%1").arg(((cobId >> 7) - 1) / 2);
+
+        case 0x4:
+        case 0x6:
+        case 0x8:
+        case 0xA:
+            return QString("RPDO%1").arg(((cobId >> 7) - 2) / 2);
+
+        case 0xB:
+            return QString("SDO tx");
+
+        case 0xC:
+            return QString("SDO rx");
+
+        case 0xE:
+            return QString("NMT EC");
+
+        case 0xF:
+            return (cobId == 0x7E4 || cobId == 0x7E5) ? QString("LSS") : QString();
+    }
+    return QString();
+}
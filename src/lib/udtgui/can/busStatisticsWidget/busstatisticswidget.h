@@ -0,0 +1,75 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef BUSSTATISTICSWIDGET_H
+#define BUSSTATISTICSWIDGET_H
+
+#include "../../udtgui_global.h"
+
+#include <QWidget>
+
+#include <QLabel>
+#include <QPointer>
+#include <QProgressBar>
+#include <QTableWidget>
+
+class CanOpenBus;
+
+class UDTGUI_EXPORT BusStatisticsWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    BusStatisticsWidget(QWidget *parent = nullptr);
+
+    CanOpenBus *bus() const;
+    void setBus(CanOpenBus *bus);
+
+public slots:
+    void updateStatistics();
+
+protected:
+    enum Column
+    {
+        ColumnCobId,
+        ColumnService,
+        ColumnNode,
+        ColumnRate,
+        ColumnInterval,
+        ColumnJitter,
+        ColumnCount,
+        ColumnColumnCount
+    };
+    enum
+    {
+        TOP_COB_ID_COUNT = 32
+    };
+
+    QPointer<CanOpenBus> _bus;
+
+    void createWidgets();
+    QProgressBar *_busLoadBar;
+    QLabel *_peakLoadLabel;
+    QLabel *_framesRateLabel;
+    QLabel *_framesCountLabel;
+    QLabel *_errorFramesLabel;
+    QTableWidget *_cobIdTable;
+
+    static QString serviceStr(quint32 cobId);
+};
+
+#endif  // BUSSTATISTICSWIDGET_H
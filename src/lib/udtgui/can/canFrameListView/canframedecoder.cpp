@@ -0,0 +1,350 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "canframedecoder.h"
+
+#include "canframefilter.h"
+#include "canopenbus.h"
+
+#include <QStringList>
+
+#include <cstring>
+
+namespace
+{
+QString objectStr(quint16 index, quint8 subIndex)
+{
+    return QString("0x%1.%2").arg(QString::number(index, 16).toUpper().rightJustified(4, '0')).arg(QString::number(subIndex, 16).toUpper().rightJustified(2, '0'));
+}
+
+quint64 readLittleEndian(const QByteArray &data, int offset, int size)
+{
+    quint64 value = 0;
+    for (int i = size - 1; i >= 0; i--)
+    {
+        value = (value << 8) | static_cast<quint8>(data.at(offset + i));
+    }
+    return value;
+}
+
+QString valueStr(const QByteArray &data, int offset, int size, QMetaType::Type type)
+{
+    quint64 raw = readLittleEndian(data, offset, size);
+    switch (type)
+    {
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::Short:
+        case QMetaType::Int:
+        case QMetaType::Long:
+        case QMetaType::LongLong:
+        {
+            // sign extension from size bytes
+            int shift = 64 - size * 8;
+            qint64 value = static_cast<qint64>(raw << shift) >> shift;
+            return QString::number(value);
+        }
+
+        case QMetaType::Float:
+        {
+            quint32 raw32 = static_cast<quint32>(raw);
+            float value;
+            memcpy(&value, &raw32, sizeof(value));
+            return QString::number(static_cast<double>(value));
+        }
+
+        case QMetaType::Double:
+        {
+            double value;
+            memcpy(&value, &raw, sizeof(value));
+            return QString::number(value);
+        }
+
+        default:
+            return QString("0x%1").arg(QString::number(raw, 16).toUpper());
+    }
+}
+}  // namespace
+
+CanFrameDecoder::CanFrameDecoder()
+{
+    _bus = nullptr;
+}
+
+CanOpenBus *CanFrameDecoder::bus() const
+{
+    return _bus;
+}
+
+/**
+ * @brief sets the bus used to decode PDO with the current mapping of its nodes
+ */
+void CanFrameDecoder::setBus(CanOpenBus *bus)
+{
+    _bus = bus;
+}
+
+QString CanFrameDecoder::decode(const QCanBusFrame &frame) const
+{
+    if (frame.frameType() != QCanBusFrame::DataFrame)
+    {
+        return QString();
+    }
+
+    CanFrameFilter::Service service = CanFrameFilter::serviceOf(frame);
+    switch (service)
+    {
+        case CanFrameFilter::ServiceNmt:
+            return decodeNmt(frame);
+
+        case CanFrameFilter::ServiceEmcy:
+            return decodeEmcy(frame);
+
+        case CanFrameFilter::ServiceTpdo:
+            return decodePdo(frame, true);
+
+        case CanFrameFilter::ServiceRpdo:
+            return decodePdo(frame, false);
+
+        case CanFrameFilter::ServiceSdoTx:
+            return decodeSdo(frame, true);
+
+        case CanFrameFilter::ServiceSdoRx:
+            return decodeSdo(frame, false);
+
+        case CanFrameFilter::ServiceHeartbeat:
+            return decodeHeartbeat(frame);
+
+        case CanFrameFilter::ServiceOther:
+            return QString();
+
+        default:
+            return CanFrameFilter::serviceStr(service);
+    }
+}
+
+QString CanFrameDecoder::decodeNmt(const QCanBusFrame &frame) const
+{
+    const QByteArray &payload = frame.payload();
+    if (payload.size() < 2)
+    {
+        return QStringLiteral("NMT");
+    }
+
+    QString command;
+    switch (static_cast<quint8>(payload.at(0)))
+    {
+        case 0x01:
+            command = QStringLiteral("start");
+            break;
+        case 0x02:
+            command = QStringLiteral("stop");
+            break;
+        case 0x80:
+            command = QStringLiteral("pre-operational");
+            break;
+        case 0x81:
+            command = QStringLiteral("reset node");
+            break;
+        case 0x82:
+            command = QStringLiteral("reset communication");
+            break;
+        default:
+            command = QString("0x%1").arg(QString::number(static_cast<quint8>(payload.at(0)), 16));
+            break;
+    }
+
+    quint8 nodeId = static_cast<quint8>(payload.at(1));
+    if (nodeId == 0)
+    {
+        return QString("NMT %1 all").arg(command);
+    }
+    return QString("NMT %1 node %2").arg(command).arg(nodeId);
+}
+
+QString CanFrameDecoder::decodeEmcy(const QCanBusFrame &frame) const
+{
+    const QByteArray &payload = frame.payload();
+    if (payload.size() < 3)
+    {
+        return QStringLiteral("EMCY");
+    }
+    quint16 errorCode = static_cast<quint16>(readLittleEndian(payload, 0, 2));
+    return QString("EMCY 0x%1 reg 0x%2")
+        .arg(QString::number(errorCode, 16).toUpper().rightJustified(4, '0'))
+        .arg(QString::number(static_cast<quint8>(payload.at(2)), 16).toUpper().rightJustified(2, '0'));
+}
+
+/**
+ * @brief decodes mapped values with the current mapping of the PDO, frames logged
+ * before a mapping change are decoded with the new mapping
+ */
+QString CanFrameDecoder::decodePdo(const QCanBusFrame &frame, bool tpdo) const
+{
+    quint8 pdoNumber = static_cast<quint8>((frame.frameId() - 0x180) / 0x100 + 1);
+    QString pdoStr = QString("%1%2").arg(tpdo ? "TPDO" : "RPDO").arg(pdoNumber);
+    if (_bus == nullptr)
+    {
+        return pdoStr;
+    }
+
+    Node *node = _bus->node(static_cast<quint8>(frame.frameId() & 0x7F));
+    if (node == nullptr)
+    {
+        return pdoStr;
+    }
+
+    PDO *pdo = nullptr;
+    if (tpdo)
+    {
+        for (TPDO *nodeTpdo : node->tpdos())
+        {
+            if (nodeTpdo->cobId() == frame.frameId())
+            {
+                pdo = nodeTpdo;
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (RPDO *nodeRpdo : node->rpdos())
+        {
+            if (nodeRpdo->cobId() == frame.frameId())
+            {
+                pdo = nodeRpdo;
+                break;
+            }
+        }
+    }
+    if (pdo == nullptr || !pdo->hasMappedObject())
+    {
+        return pdoStr;
+    }
+
+    QStringList values;
+    const QByteArray &payload = frame.payload();
+    int offset = 0;
+    for (const NodeObjectId &objectId : pdo->currentMappind())
+    {
+        QMetaType::Type type = node->nodeOd()->dataType(objectId.index(), objectId.subIndex());
+        int size = QMetaType::sizeOf(type);
+        if (size <= 0 || size > 8 || offset + size > payload.size())
+        {
+            break;
+        }
+        values.append(QString("%1=%2").arg(objectStr(objectId.index(), objectId.subIndex()), valueStr(payload, offset, size, type)));
+        offset += size;
+    }
+    return QString("%1 %2").arg(pdoStr, values.join(' '));
+}
+
+QString CanFrameDecoder::decodeSdo(const QCanBusFrame &frame, bool fromServer) const
+{
+    const QByteArray &payload = frame.payload();
+    QString sdoStr = fromServer ? QStringLiteral("SDO tx") : QStringLiteral("SDO rx");
+    if (payload.size() < 8)
+    {
+        return sdoStr;
+    }
+
+    quint8 cmd = static_cast<quint8>(payload.at(0));
+    quint8 cs = cmd >> 5;
+    quint16 index = static_cast<quint16>(readLittleEndian(payload, 1, 2));
+    quint8 subIndex = static_cast<quint8>(payload.at(3));
+    QString object = objectStr(index, subIndex);
+
+    // expedited transfer with size indicated, value in bytes 4 to 7
+    bool expedited = ((cmd & 0x02) != 0);
+    int expeditedSize = ((cmd & 0x01) != 0) ? (4 - ((cmd >> 2) & 0x03)) : 4;
+    QString expeditedValue = valueStr(payload, 4, expeditedSize, QMetaType::UnknownType);
+
+    if (cs == 4)
+    {
+        quint32 abortCode = static_cast<quint32>(readLittleEndian(payload, 4, 4));
+        return QString("%1 abort %2 0x%3").arg(sdoStr, object, QString::number(abortCode, 16).toUpper().rightJustified(8, '0'));
+    }
+
+    if (fromServer)
+    {
+        switch (cs)
+        {
+            case 0:
+                return QString("%1 upload segment").arg(sdoStr);
+            case 1:
+                return QString("%1 download segment ack").arg(sdoStr);
+            case 2:
+                if (expedited)
+                {
+                    return QString("%1 upload %2 = %3").arg(sdoStr, object, expeditedValue);
+                }
+                return QString("%1 upload %2 size %3").arg(sdoStr, object).arg(readLittleEndian(payload, 4, 4));
+            case 3:
+                return QString("%1 download ack %2").arg(sdoStr, object);
+            case 5:
+                return QString("%1 block download").arg(sdoStr);
+            case 6:
+                return QString("%1 block upload").arg(sdoStr);
+        }
+    }
+    else
+    {
+        switch (cs)
+        {
+            case 0:
+                return QString("%1 download segment").arg(sdoStr);
+            case 1:
+                if (expedited)
+                {
+                    return QString("%1 download %2 = %3").arg(sdoStr, object, expeditedValue);
+                }
+                return QString("%1 download %2 size %3").arg(sdoStr, object).arg(readLittleEndian(payload, 4, 4));
+            case 2:
+                return QString("%1 upload %2").arg(sdoStr, object);
+            case 3:
+                return QString("%1 upload segment").arg(sdoStr);
+            case 5:
+                return QString("%1 block upload").arg(sdoStr);
+            case 6:
+                return QString("%1 block download").arg(sdoStr);
+        }
+    }
+    return sdoStr;
+}
+
+QString CanFrameDecoder::decodeHeartbeat(const QCanBusFrame &frame) const
+{
+    const QByteArray &payload = frame.payload();
+    if (payload.isEmpty())
+    {
+        return QStringLiteral("HB");
+    }
+
+    switch (static_cast<quint8>(payload.at(0)) & 0x7F)
+    {
+        case 0x00:
+            return QStringLiteral("HB boot-up");
+        case 0x04:
+            return QStringLiteral("HB stopped");
+        case 0x05:
+            return QStringLiteral("HB operational");
+        case 0x7F:
+            return QStringLiteral("HB pre-operational");
+    }
+    return QString("HB 0x%1").arg(QString::number(static_cast<quint8>(payload.at(0)), 16));
+}
@@ -0,0 +1,54 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef CANFRAMEDECODER_H
+#define CANFRAMEDECODER_H
+
+#include "../../udtgui_global.h"
+
+#include "busdriver/qcanbusframe.h"
+
+#include <QString>
+
+class CanOpenBus;
+
+/**
+ * @brief Decodes the CANopen meaning of a frame: NMT command, SDO command and object,
+ * EMCY code, heartbeat state and PDO mapped values
+ */
+class UDTGUI_EXPORT CanFrameDecoder
+{
+public:
+    CanFrameDecoder();
+
+    CanOpenBus *bus() const;
+    void setBus(CanOpenBus *bus);
+
+    QString decode(const QCanBusFrame &frame) const;
+
+protected:
+    CanOpenBus *_bus;
+
+    QString decodeNmt(const QCanBusFrame &frame) const;
+    QString decodeEmcy(const QCanBusFrame &frame) const;
+    QString decodePdo(const QCanBusFrame &frame, bool tpdo) const;
+    QString decodeSdo(const QCanBusFrame &frame, bool fromServer) const;
+    QString decodeHeartbeat(const QCanBusFrame &frame) const;
+};
+
+#endif  // CANFRAMEDECODER_H
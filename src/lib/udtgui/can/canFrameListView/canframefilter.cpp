@@ -0,0 +1,472 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "canframefilter.h"
+
+#include <QCoreApplication>
+#include <QRegularExpression>
+#include <QStringList>
+
+namespace
+{
+bool parseNumber(const QString &text, quint32 *value)
+{
+    bool ok;
+    if (text.startsWith(QLatin1String("0x"), Qt::CaseInsensitive))
+    {
+        *value = text.mid(2).toUInt(&ok, 16);
+    }
+    else
+    {
+        *value = text.toUInt(&ok, 10);
+    }
+    return ok;
+}
+
+bool parseRange(const QString &text, quint32 *min, quint32 *max)
+{
+    int sep = text.indexOf('-');
+    if (sep < 0)
+    {
+        if (!parseNumber(text, min))
+        {
+            return false;
+        }
+        *max = *min;
+        return true;
+    }
+    return parseNumber(text.left(sep), min) && parseNumber(text.mid(sep + 1), max) && (*min <= *max);
+}
+
+bool parseTime(const QString &text, qint64 *timeUs)
+{
+    bool ok;
+    double seconds = text.toDouble(&ok);
+    *timeUs = static_cast<qint64>(seconds * 1000000.0);
+    return ok && (seconds >= 0);
+}
+}  // namespace
+
+CanFrameFilter::CanFrameFilter()
+{
+    _nodeId = -1;
+    _services = 0;
+    _idMin = 1;
+    _idMax = 0;
+    _timeFromUs = -1;
+    _timeToUs = -1;
+}
+
+CanFrameFilter::Service CanFrameFilter::serviceOf(const QCanBusFrame &frame)
+{
+    if (frame.hasExtendedFrameFormat())
+    {
+        return ServiceOther;
+    }
+
+    quint32 cobId = frame.frameId();
+    if (cobId == 0x000)
+    {
+        return ServiceNmt;
+    }
+    if (cobId == 0x080)
+    {
+        return ServiceSync;
+    }
+    if (cobId > 0x080 && cobId <= 0x0FF)
+    {
+        return ServiceEmcy;
+    }
+    if (cobId == 0x100)
+    {
+        return ServiceTime;
+    }
+    if (cobId >= 0x180 && cobId <= 0x57F)
+    {
+        return (((cobId - 0x180) / 0x80) % 2 == 0) ? ServiceTpdo : ServiceRpdo;
+    }
+    if (cobId >= 0x580 && cobId <= 0x5FF)
+    {
+        return ServiceSdoTx;
+    }
+    if (cobId >= 0x600 && cobId <= 0x67F)
+    {
+        return ServiceSdoRx;
+    }
+    if (cobId >= 0x700 && cobId <= 0x77F)
+    {
+        return ServiceHeartbeat;
+    }
+    if (cobId == 0x7E4 || cobId == 0x7E5)
+    {
+        return ServiceLss;
+    }
+    return ServiceOther;
+}
+
+/**
+ * @brief node id concerned by the frame, from the cob id or the NMT command, -1 if none
+ */
+int CanFrameFilter::nodeOf(const QCanBusFrame &frame)
+{
+    int nodeId = -1;
+    switch (serviceOf(frame))
+    {
+        case ServiceEmcy:
+        case ServiceTpdo:
+        case ServiceRpdo:
+        case ServiceSdoTx:
+        case ServiceSdoRx:
+        case ServiceHeartbeat:
+            nodeId = static_cast<int>(frame.frameId() & 0x7F);
+            break;
+
+        case ServiceNmt:
+            if (frame.payload().size() >= 2)
+            {
+                nodeId = static_cast<quint8>(frame.payload().at(1));
+            }
+            break;
+
+        default:
+            break;
+    }
+    return ((nodeId > 0) && (nodeId < 128)) ? nodeId : -1;
+}
+
+QString CanFrameFilter::serviceStr(Service service)
+{
+    switch (service)
+    {
+        case ServiceNmt:
+            return QStringLiteral("NMT");
+        case ServiceSync:
+            return QStringLiteral("SYNC");
+        case ServiceEmcy:
+            return QStringLiteral("EMCY");
+        case ServiceTime:
+            return QStringLiteral("TIME");
+        case ServiceTpdo:
+            return QStringLiteral("TPDO");
+        case ServiceRpdo:
+            return QStringLiteral("RPDO");
+        case ServiceSdoTx:
+            return QStringLiteral("SDO tx");
+        case ServiceSdoRx:
+            return QStringLiteral("SDO rx");
+        case ServiceHeartbeat:
+            return QStringLiteral("HB");
+        case ServiceLss:
+            return QStringLiteral("LSS");
+        case ServiceOther:
+        case ServiceCount:
+            break;
+    }
+    return QCoreApplication::translate("CanFrameFilter", "Other");
+}
+
+bool CanFrameFilter::isEmpty() const
+{
+    return (_nodeId < 0) && (_services == 0) && !hasIdRange() && _byteMatches.isEmpty() && !hasTimeWindow();
+}
+
+int CanFrameFilter::nodeId() const
+{
+    return _nodeId;
+}
+
+void CanFrameFilter::setNodeId(int nodeId)
+{
+    _nodeId = nodeId;
+}
+
+quint32 CanFrameFilter::services() const
+{
+    return _services;
+}
+
+void CanFrameFilter::setServices(quint32 serviceMask)
+{
+    _services = serviceMask;
+}
+
+bool CanFrameFilter::hasService(Service service) const
+{
+    return (_services & (1U << service)) != 0;
+}
+
+int CanFrameFilter::serviceCount() const
+{
+    int count = 0;
+    for (int service = 0; service < ServiceCount; service++)
+    {
+        if (hasService(static_cast<Service>(service)))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+quint32 CanFrameFilter::idMin() const
+{
+    return _idMin;
+}
+
+quint32 CanFrameFilter::idMax() const
+{
+    return _idMax;
+}
+
+bool CanFrameFilter::hasIdRange() const
+{
+    return _idMin <= _idMax;
+}
+
+void CanFrameFilter::setIdRange(quint32 idMin, quint32 idMax)
+{
+    _idMin = idMin;
+    _idMax = idMax;
+}
+
+const QList<CanFrameFilter::ByteMatch> &CanFrameFilter::byteMatches() const
+{
+    return _byteMatches;
+}
+
+void CanFrameFilter::addByteMatch(int pos, quint8 value, quint8 mask)
+{
+    _byteMatches.append({pos, static_cast<quint8>(value & mask), mask});
+}
+
+qint64 CanFrameFilter::timeFromUs() const
+{
+    return _timeFromUs;
+}
+
+qint64 CanFrameFilter::timeToUs() const
+{
+    return _timeToUs;
+}
+
+bool CanFrameFilter::hasTimeWindow() const
+{
+    return (_timeFromUs >= 0) || (_timeToUs >= 0);
+}
+
+/**
+ * @brief sets the time window, in us from the first frame of the log, -1 for an open bound
+ */
+void CanFrameFilter::setTimeWindow(qint64 timeFromUs, qint64 timeToUs)
+{
+    _timeFromUs = timeFromUs;
+    _timeToUs = timeToUs;
+}
+
+/**
+ * @brief evaluates all terms of the filter on one frame
+ * @param timeUs frame time in us from the first frame of the log
+ */
+bool CanFrameFilter::matches(const QCanBusFrame &frame, qint64 timeUs) const
+{
+    if (hasIdRange() && (frame.frameId() < _idMin || frame.frameId() > _idMax))
+    {
+        return false;
+    }
+    if (_services != 0 && !hasService(serviceOf(frame)))
+    {
+        return false;
+    }
+    if (_nodeId >= 0 && nodeOf(frame) != _nodeId)
+    {
+        return false;
+    }
+    if ((_timeFromUs >= 0 && timeUs < _timeFromUs) || (_timeToUs >= 0 && timeUs > _timeToUs))
+    {
+        return false;
+    }
+
+    const QByteArray &payload = frame.payload();
+    for (const ByteMatch &byteMatch : _byteMatches)
+    {
+        if (byteMatch.pos >= payload.size() || (static_cast<quint8>(payload.at(byteMatch.pos)) & byteMatch.mask) != byteMatch.value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief parses a filter expression, an empty expression gives an empty filter that matches all frames
+ * @param ok set to false if a term cannot be parsed
+ */
+CanFrameFilter CanFrameFilter::parse(const QString &expression, bool *ok)
+{
+    static const QRegularExpression dataTermRegExp(QStringLiteral("^data\\[(\\d+)\\]$"));
+
+    CanFrameFilter filter;
+    filter._expression = expression.simplified();
+    bool valid = true;
+
+    const QStringList terms = filter._expression.split(' ', QString::SkipEmptyParts);
+    for (const QString &term : terms)
+    {
+        int sep = term.indexOf(':');
+        if (sep <= 0)
+        {
+            valid = false;
+            break;
+        }
+        QString key = term.left(sep).toLower();
+        QString value = term.mid(sep + 1);
+
+        if (key == QLatin1String("node"))
+        {
+            quint32 nodeId;
+            valid = parseNumber(value, &nodeId) && (nodeId > 0) && (nodeId < 128);
+            filter._nodeId = static_cast<int>(nodeId);
+        }
+        else if (key == QLatin1String("service"))
+        {
+            const QStringList serviceNames = value.toLower().split(',', QString::SkipEmptyParts);
+            for (const QString &serviceName : serviceNames)
+            {
+                if (serviceName == QLatin1String("nmt"))
+                {
+                    filter._services |= (1U << ServiceNmt);
+                }
+                else if (serviceName == QLatin1String("sync"))
+                {
+                    filter._services |= (1U << ServiceSync);
+                }
+                else if (serviceName == QLatin1String("emcy"))
+                {
+                    filter._services |= (1U << ServiceEmcy);
+                }
+                else if (serviceName == QLatin1String("time"))
+                {
+                    filter._services |= (1U << ServiceTime);
+                }
+                else if (serviceName == QLatin1String("pdo"))
+                {
+                    filter._services |= (1U << ServiceTpdo) | (1U << ServiceRpdo);
+                }
+                else if (serviceName == QLatin1String("tpdo"))
+                {
+                    filter._services |= (1U << ServiceTpdo);
+                }
+                else if (serviceName == QLatin1String("rpdo"))
+                {
+                    filter._services |= (1U << ServiceRpdo);
+                }
+                else if (serviceName == QLatin1String("sdo"))
+                {
+                    filter._services |= (1U << ServiceSdoTx) | (1U << ServiceSdoRx);
+                }
+                else if (serviceName == QLatin1String("sdotx"))
+                {
+                    filter._services |= (1U << ServiceSdoTx);
+                }
+                else if (serviceName == QLatin1String("sdorx"))
+                {
+                    filter._services |= (1U << ServiceSdoRx);
+                }
+                else if (serviceName == QLatin1String("hb") || serviceName == QLatin1String("heartbeat"))
+                {
+                    filter._services |= (1U << ServiceHeartbeat);
+                }
+                else if (serviceName == QLatin1String("lss"))
+                {
+                    filter._services |= (1U << ServiceLss);
+                }
+                else if (serviceName == QLatin1String("other"))
+                {
+                    filter._services |= (1U << ServiceOther);
+                }
+                else
+                {
+                    valid = false;
+                }
+            }
+        }
+        else if (key == QLatin1String("id"))
+        {
+            valid = parseRange(value, &filter._idMin, &filter._idMax);
+        }
+        else if (key == QLatin1String("time"))
+        {
+            int sepTime = value.indexOf('-');
+            if (sepTime < 0)
+            {
+                valid = parseTime(value, &filter._timeFromUs);
+            }
+            else
+            {
+                QString from = value.left(sepTime);
+                QString to = value.mid(sepTime + 1);
+                valid = (from.isEmpty() || parseTime(from, &filter._timeFromUs)) && (to.isEmpty() || parseTime(to, &filter._timeToUs));
+            }
+        }
+        else
+        {
+            QRegularExpressionMatch match = dataTermRegExp.match(key);
+            quint32 byteValue = 0;
+            quint32 byteMask = 0xFF;
+            int sepMask = value.indexOf('/');
+            if (!match.hasMatch() || match.captured(1).toInt() >= 64)
+            {
+                valid = false;
+            }
+            else if (sepMask < 0)
+            {
+                valid = parseNumber(value, &byteValue) && (byteValue <= 0xFF);
+            }
+            else
+            {
+                valid = parseNumber(value.left(sepMask), &byteValue) && parseNumber(value.mid(sepMask + 1), &byteMask) && (byteValue <= 0xFF) && (byteMask <= 0xFF);
+            }
+            if (valid)
+            {
+                filter.addByteMatch(match.captured(1).toInt(), static_cast<quint8>(byteValue), static_cast<quint8>(byteMask));
+            }
+        }
+
+        if (!valid)
+        {
+            break;
+        }
+    }
+
+    if (ok != nullptr)
+    {
+        *ok = valid;
+    }
+    if (!valid)
+    {
+        CanFrameFilter emptyFilter;
+        emptyFilter._expression = filter._expression;
+        return emptyFilter;
+    }
+    return filter;
+}
+
+const QString &CanFrameFilter::expression() const
+{
+    return _expression;
+}
@@ -0,0 +1,104 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef CANFRAMEFILTER_H
+#define CANFRAMEFILTER_H
+
+#include "../../udtgui_global.h"
+
+#include "busdriver/qcanbusframe.h"
+
+#include <QList>
+#include <QString>
+
+/**
+ * @brief Filter on CAN frames of the frame log
+ *
+ * Expression syntax, terms separated by spaces, all terms have to match:
+ * node:5  service:sdo,emcy  id:0x580-0x5FF  data[1]:0x40  data[0]:0x20/0xE0  time:1.5-3
+ */
+class UDTGUI_EXPORT CanFrameFilter
+{
+public:
+    CanFrameFilter();
+
+    enum Service
+    {
+        ServiceNmt,
+        ServiceSync,
+        ServiceEmcy,
+        ServiceTime,
+        ServiceTpdo,
+        ServiceRpdo,
+        ServiceSdoTx,  // server to client, 580h
+        ServiceSdoRx,  // client to server, 600h
+        ServiceHeartbeat,
+        ServiceLss,
+        ServiceOther,
+        ServiceCount
+    };
+    static Service serviceOf(const QCanBusFrame &frame);
+    static int nodeOf(const QCanBusFrame &frame);
+    static QString serviceStr(Service service);
+
+    bool isEmpty() const;
+
+    int nodeId() const;
+    void setNodeId(int nodeId);
+
+    quint32 services() const;
+    void setServices(quint32 serviceMask);
+    bool hasService(Service service) const;
+    int serviceCount() const;
+
+    quint32 idMin() const;
+    quint32 idMax() const;
+    bool hasIdRange() const;
+    void setIdRange(quint32 idMin, quint32 idMax);
+
+    struct ByteMatch
+    {
+        int pos;
+        quint8 value;
+        quint8 mask;
+    };
+    const QList<ByteMatch> &byteMatches() const;
+    void addByteMatch(int pos, quint8 value, quint8 mask = 0xFF);
+
+    qint64 timeFromUs() const;
+    qint64 timeToUs() const;
+    bool hasTimeWindow() const;
+    void setTimeWindow(qint64 timeFromUs, qint64 timeToUs);
+
+    bool matches(const QCanBusFrame &frame, qint64 timeUs) const;
+
+    static CanFrameFilter parse(const QString &expression, bool *ok = nullptr);
+    const QString &expression() const;
+
+protected:
+    int _nodeId;
+    quint32 _services;
+    quint32 _idMin;
+    quint32 _idMax;
+    QList<ByteMatch> _byteMatches;
+    qint64 _timeFromUs;
+    qint64 _timeToUs;
+    QString _expression;
+};
+
+#endif  // CANFRAMEFILTER_H
@@ -0,0 +1,283 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "canframeindex.h"
+
+#include <algorithm>
+
+CanFrameIndex::CanFrameIndex()
+{
+    clear();
+}
+
+void CanFrameIndex::clear()
+{
+    _cobIdRows.clear();
+    for (QVector<int> &rows : _nodeRows)
+    {
+        rows.clear();
+    }
+    for (QVector<int> &rows : _serviceRows)
+    {
+        rows.clear();
+    }
+    _timesUs.clear();
+    _startTimeUs = 0;
+    _timeSorted = true;
+}
+
+/**
+ * @brief indexes the next frame of the log, its row is the previous count()
+ */
+void CanFrameIndex::append(const QCanBusFrame &frame)
+{
+    int row = _timesUs.count();
+    qint64 frameTimeUs = frame.timeStamp().seconds() * 1000000 + frame.timeStamp().microSeconds();
+    if (row == 0)
+    {
+        _startTimeUs = frameTimeUs;
+    }
+    qint64 timeUs = frameTimeUs - _startTimeUs;
+    if (row > 0 && timeUs < _timesUs.last())
+    {
+        _timeSorted = false;
+    }
+    _timesUs.append(timeUs);
+
+    _cobIdRows[frame.frameId()].append(row);
+    _serviceRows[CanFrameFilter::serviceOf(frame)].append(row);
+    int nodeId = CanFrameFilter::nodeOf(frame);
+    if (nodeId >= 0)
+    {
+        _nodeRows[nodeId].append(row);
+    }
+}
+
+int CanFrameIndex::count() const
+{
+    return _timesUs.count();
+}
+
+/**
+ * @brief time of the frame at row, in us from the first frame of the log
+ */
+qint64 CanFrameIndex::timeUs(int row) const
+{
+    return _timesUs.at(row);
+}
+
+/**
+ * @brief rows of frames matching filter, from fromRow to the end of the index
+ */
+QVector<int> CanFrameIndex::select(const CanFrameFilter &filter, const QList<QCanBusFrame> &frames, int fromRow) const
+{
+    QVector<int> selected;
+    int toRow = count();
+    rowRange(filter, &fromRow, &toRow);
+    if (fromRow >= toRow)
+    {
+        return selected;
+    }
+
+    QVector<int> merged;
+    const QVector<int> *rows = candidates(filter, fromRow, toRow, &merged);
+    if (rows == nullptr)
+    {
+        for (int row = fromRow; row < toRow; row++)
+        {
+            if (filter.matches(frames.at(row), _timesUs.at(row)))
+            {
+                selected.append(row);
+            }
+        }
+        return selected;
+    }
+
+    auto it = std::lower_bound(rows->cbegin(), rows->cend(), fromRow);
+    for (; it != rows->cend() && *it < toRow; ++it)
+    {
+        if (filter.matches(frames.at(*it), _timesUs.at(*it)))
+        {
+            selected.append(*it);
+        }
+    }
+    return selected;
+}
+
+/**
+ * @brief row of the next frame after row (or before row if backward) matching filter
+ * @return -1 if no frame matches
+ */
+int CanFrameIndex::findNext(const CanFrameFilter &filter, const QList<QCanBusFrame> &frames, int row, bool backward) const
+{
+    int fromRow = 0;
+    int toRow = count();
+    rowRange(filter, &fromRow, &toRow);
+    if (backward)
+    {
+        toRow = qMin(toRow, row);
+    }
+    else
+    {
+        fromRow = qMax(fromRow, row + 1);
+    }
+    if (fromRow >= toRow)
+    {
+        return -1;
+    }
+
+    QVector<int> merged;
+    const QVector<int> *rows = candidates(filter, fromRow, toRow, &merged);
+    if (rows == nullptr)
+    {
+        for (int i = 0; i < toRow - fromRow; i++)
+        {
+            int frameRow = backward ? (toRow - 1 - i) : (fromRow + i);
+            if (filter.matches(frames.at(frameRow), _timesUs.at(frameRow)))
+            {
+                return frameRow;
+            }
+        }
+        return -1;
+    }
+
+    auto begin = std::lower_bound(rows->cbegin(), rows->cend(), fromRow);
+    auto end = std::lower_bound(begin, rows->cend(), toRow);
+    if (backward)
+    {
+        for (auto it = end; it != begin;)
+        {
+            --it;
+            if (filter.matches(frames.at(*it), _timesUs.at(*it)))
+            {
+                return *it;
+            }
+        }
+    }
+    else
+    {
+        for (auto it = begin; it != end; ++it)
+        {
+            if (filter.matches(frames.at(*it), _timesUs.at(*it)))
+            {
+                return *it;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief narrows [fromRow, toRow[ to the time window of filter, when frames are in time order
+ */
+void CanFrameIndex::rowRange(const CanFrameFilter &filter, int *fromRow, int *toRow) const
+{
+    if (!_timeSorted)
+    {
+        return;
+    }
+    if (filter.timeFromUs() >= 0)
+    {
+        int timeFromRow = static_cast<int>(std::lower_bound(_timesUs.cbegin(), _timesUs.cend(), filter.timeFromUs()) - _timesUs.cbegin());
+        *fromRow = qMax(*fromRow, timeFromRow);
+    }
+    if (filter.timeToUs() >= 0)
+    {
+        int timeToRow = static_cast<int>(std::upper_bound(_timesUs.cbegin(), _timesUs.cend(), filter.timeToUs()) - _timesUs.cbegin());
+        *toRow = qMin(*toRow, timeToRow);
+    }
+}
+
+/**
+ * @brief smallest sorted candidate row list for filter, from the cob id, node or service indexes
+ * @param merged storage for candidates merged from several lists
+ * @return nullptr if no index is more selective than the row range itself
+ */
+const QVector<int> *CanFrameIndex::candidates(const CanFrameFilter &filter, int fromRow, int toRow, QVector<int> *merged) const
+{
+    const QVector<int> *best = nullptr;
+    int bestSize = toRow - fromRow;
+
+    if (filter.nodeId() >= 0 && _nodeRows[filter.nodeId()].size() < bestSize)
+    {
+        best = &_nodeRows[filter.nodeId()];
+        bestSize = best->size();
+    }
+
+    QList<const QVector<int> *> lists;
+    int listsSize = 0;
+    if (filter.hasIdRange())
+    {
+        for (auto it = _cobIdRows.cbegin(); it != _cobIdRows.cend(); ++it)
+        {
+            if (it.key() >= filter.idMin() && it.key() <= filter.idMax())
+            {
+                lists.append(&it.value());
+                listsSize += it.value().size();
+            }
+        }
+        if (lists.isEmpty())
+        {
+            // no frame with this cob id
+            merged->clear();
+            return merged;
+        }
+    }
+    if (filter.services() != 0 && (lists.isEmpty() || listsSize > bestSize))
+    {
+        QList<const QVector<int> *> serviceLists;
+        int serviceListsSize = 0;
+        for (int service = 0; service < CanFrameFilter::ServiceCount; service++)
+        {
+            if (filter.hasService(static_cast<CanFrameFilter::Service>(service)))
+            {
+                serviceLists.append(&_serviceRows[service]);
+                serviceListsSize += _serviceRows[service].size();
+            }
+        }
+        if (lists.isEmpty() || serviceListsSize < listsSize)
+        {
+            lists = serviceLists;
+            listsSize = serviceListsSize;
+        }
+    }
+
+    if (lists.isEmpty() || listsSize >= bestSize)
+    {
+        return best;
+    }
+    if (lists.count() == 1)
+    {
+        return lists.first();
+    }
+
+    // several lists, only the part in [fromRow, toRow[ is merged
+    merged->clear();
+    for (const QVector<int> *rows : qAsConst(lists))
+    {
+        auto begin = std::lower_bound(rows->cbegin(), rows->cend(), fromRow);
+        auto end = std::lower_bound(begin, rows->cend(), toRow);
+        int middle = merged->size();
+        for (auto it = begin; it != end; ++it)
+        {
+            merged->append(*it);
+        }
+        std::inplace_merge(merged->begin(), merged->begin() + middle, merged->end());
+    }
+    return merged;
+}
@@ -0,0 +1,71 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef CANFRAMEINDEX_H
+#define CANFRAMEINDEX_H
+
+#include "../../udtgui_global.h"
+
+#include "busdriver/qcanbusframe.h"
+
+#include "canframefilter.h"
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+/**
+ * @brief Incremental indexes over a frame log, by cob id, node, service and time
+ *
+ * Frames are indexed once when appended, filters are then evaluated on the smallest
+ * candidate row list given by the indexes instead of rescanning the whole log.
+ */
+class UDTGUI_EXPORT CanFrameIndex
+{
+public:
+    CanFrameIndex();
+
+    void clear();
+    void append(const QCanBusFrame &frame);
+    int count() const;
+
+    qint64 timeUs(int row) const;
+
+    QVector<int> select(const CanFrameFilter &filter, const QList<QCanBusFrame> &frames, int fromRow = 0) const;
+    int findNext(const CanFrameFilter &filter, const QList<QCanBusFrame> &frames, int row, bool backward = false) const;
+
+protected:
+    enum
+    {
+        NODE_COUNT = 128
+    };
+
+    QHash<quint32, QVector<int>> _cobIdRows;
+    QVector<int> _nodeRows[NODE_COUNT];
+    QVector<int> _serviceRows[CanFrameFilter::ServiceCount];
+
+    // frame times in us from the first frame
+    QVector<qint64> _timesUs;
+    qint64 _startTimeUs;
+    bool _timeSorted;
+
+    void rowRange(const CanFrameFilter &filter, int *fromRow, int *toRow) const;
+    const QVector<int> *candidates(const CanFrameFilter &filter, int fromRow, int toRow, QVector<int> *merged) const;
+};
+
+#endif  // CANFRAMEINDEX_H
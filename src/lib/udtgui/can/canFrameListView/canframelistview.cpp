@@ -24,7 +24,9 @@
 #include <QDebug>
 #include <QFontMetrics>
 #include <QHeaderView>
+#include <QInputDialog>
 #include <QMenu>
+#include <QMessageBox>
 #include <QScrollBar>
 
 CanFrameListView::CanFrameListView(QWidget *parent)
@@ -47,6 +49,7 @@ CanFrameListView::CanFrameListView(QWidget *parent)
     fontMono.setStyleHint(QFont::Monospace);
     int w1 = QFontMetrics(fontMono).horizontalAdvance("00 ");
     horizontalHeader()->resizeSection(CanFrameModel::DataByte, 9 * w1);
+    horizontalHeader()->resizeSection(CanFrameModel::Decoded, 36 * w0);
 
     // rows height
     verticalHeader()->hide();
@@ -95,6 +98,96 @@ void CanFrameListView::copy()
     QApplication::clipboard()->setText(text);
 }
 
+/**
+ * @brief shows only frames matching a filter expression, see CanFrameFilter for the syntax
+ * @return false if the expression cannot be parsed, the current filter is then kept
+ */
+bool CanFrameListView::setFilter(const QString &expression)
+{
+    bool ok;
+    CanFrameFilter filter = CanFrameFilter::parse(expression, &ok);
+    if (!ok)
+    {
+        return false;
+    }
+    _canModel->setFilter(filter);
+    _clearFilterAction->setEnabled(_canModel->isFiltered());
+    return true;
+}
+
+/**
+ * @brief selects the next frame after the current one matching a filter expression
+ * @return false if the expression cannot be parsed or no frame matches
+ */
+bool CanFrameListView::find(const QString &expression, bool backward)
+{
+    bool ok;
+    CanFrameFilter filter = CanFrameFilter::parse(expression, &ok);
+    if (!ok || filter.isEmpty())
+    {
+        return false;
+    }
+    _findFilter = filter;
+    _findNextAction->setEnabled(true);
+    _findPreviousAction->setEnabled(true);
+
+    int row = _canModel->findRow(_findFilter, currentIndex().isValid() ? currentIndex().row() : -1, backward);
+    if (row < 0)
+    {
+        return false;
+    }
+    QModelIndex index = _canModel->index(row, 0, QModelIndex());
+    setCurrentIndex(index);
+    scrollTo(index, PositionAtCenter);
+    return true;
+}
+
+void CanFrameListView::editFilter()
+{
+    bool ok;
+    QString expression = QInputDialog::getText(this,
+                                               tr("Filter frames"),
+                                               tr("Filter (node:5 service:sdo,emcy id:0x580-0x5FF data[1]:0x40 time:1.5-3):"),
+                                               QLineEdit::Normal,
+                                               _canModel->filter().expression(),
+                                               &ok);
+    if (ok && !setFilter(expression))
+    {
+        QMessageBox::warning(this, tr("Filter frames"), tr("Invalid filter expression '%1'").arg(expression));
+    }
+}
+
+void CanFrameListView::clearFilter()
+{
+    _canModel->clearFilter();
+    _clearFilterAction->setEnabled(false);
+}
+
+void CanFrameListView::editFind()
+{
+    bool ok;
+    QString expression = QInputDialog::getText(this,
+                                               tr("Find frame"),
+                                               tr("Find (node:5 service:sdo,emcy id:0x580-0x5FF data[1]:0x40 time:1.5-3):"),
+                                               QLineEdit::Normal,
+                                               _findFilter.expression(),
+                                               &ok);
+    if (ok && !expression.trimmed().isEmpty() && !find(expression))
+    {
+        QMessageBox::information(this, tr("Find frame"), tr("No frame found for '%1'").arg(expression));
+    }
+}
+
+void CanFrameListView::findNext()
+{
+    find(_findFilter.expression());
+}
+
+void CanFrameListView::findPrevious()
+{
+    find(_findFilter.expression(), true);
+}
+
 void CanFrameListView::updateSelect(const QItemSelection &selected, const QItemSelection &deselected)
 {
     Q_UNUSED(selected)
@@ -126,6 +219,54 @@ void CanFrameListView::createActions()
     _copyAction->setEnabled(false);
     connect(_copyAction, &QAction::triggered, this, &CanFrameListView::copy);
     addAction(_copyAction);
+
+    _filterAction = new QAction(this);
+    _filterAction->setText(tr("&Filter..."));
+    _filterAction->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_L));
+    _filterAction->setShortcutContext(Qt::WidgetShortcut);
+#if QT_VERSION >= 0x050A00
+    _filterAction->setShortcutVisibleInContextMenu(true);
+#endif
+    connect(_filterAction, &QAction::triggered, this, &CanFrameListView::editFilter);
+    addAction(_filterAction);
+
+    _clearFilterAction = new QAction(this);
+    _clearFilterAction->setText(tr("Clear filte&r"));
+    _clearFilterAction->setEnabled(false);
+    connect(_clearFilterAction, &QAction::triggered, this, &CanFrameListView::clearFilter);
+    addAction(_clearFilterAction);
+
+    _findAction = new QAction(this);
+    _findAction->setText(tr("F&ind..."));
+    _findAction->setShortcut(QKeySequence::Find);
+    _findAction->setShortcutContext(Qt::WidgetShortcut);
+#if QT_VERSION >= 0x050A00
+    _findAction->setShortcutVisibleInContextMenu(true);
+#endif
+    connect(_findAction, &QAction::triggered, this, &CanFrameListView::editFind);
+    addAction(_findAction);
+
+    _findNextAction = new QAction(this);
+    _findNextAction->setText(tr("Find &next"));
+    _findNextAction->setShortcut(QKeySequence::FindNext);
+    _findNextAction->setShortcutContext(Qt::WidgetShortcut);
+#if QT_VERSION >= 0x050A00
+    _findNextAction->setShortcutVisibleInContextMenu(true);
+#endif
+    _findNextAction->setEnabled(false);
+    connect(_findNextAction, &QAction::triggered, this, &CanFrameListView::findNext);
+    addAction(_findNextAction);
+
+    _findPreviousAction = new QAction(this);
+    _findPreviousAction->setText(tr("Find &previous"));
+    _findPreviousAction->setShortcut(QKeySequence::FindPrevious);
+    _findPreviousAction->setShortcutContext(Qt::WidgetShortcut);
+#if QT_VERSION >= 0x050A00
+    _findPreviousAction->setShortcutVisibleInContextMenu(true);
+#endif
+    _findPreviousAction->setEnabled(false);
+    connect(_findPreviousAction, &QAction::triggered, this, &CanFrameListView::findPrevious);
+    addAction(_findPreviousAction);
 }
 
 QAction *CanFrameListView::copyAction() const
@@ -138,11 +279,43 @@ QAction *CanFrameListView::clearAction() const
     return _clearAction;
 }
 
+QAction *CanFrameListView::filterAction() const
+{
+    return _filterAction;
+}
+
+QAction *CanFrameListView::clearFilterAction() const
+{
+    return _clearFilterAction;
+}
+
+QAction *CanFrameListView::findAction() const
+{
+    return _findAction;
+}
+
+QAction *CanFrameListView::findNextAction() const
+{
+    return _findNextAction;
+}
+
+QAction *CanFrameListView::findPreviousAction() const
+{
+    return _findPreviousAction;
+}
+
 void CanFrameListView::contextMenuEvent(QContextMenuEvent *event)
 {
     QMenu menu;
     menu.addAction(_clearAction);
     menu.addAction(_copyAction);
+    menu.addSeparator();
+    menu.addAction(_filterAction);
+    menu.addAction(_clearFilterAction);
+    menu.addSeparator();
+    menu.addAction(_findAction);
+    menu.addAction(_findNextAction);
+    menu.addAction(_findPreviousAction);
     menu.exec(event->globalPos());
 }
 
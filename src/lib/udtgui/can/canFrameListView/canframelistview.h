@@ -39,22 +39,41 @@ public:
 
     QAction *clearAction() const;
     QAction *copyAction() const;
+    QAction *filterAction() const;
+    QAction *clearFilterAction() const;
+    QAction *findAction() const;
+    QAction *findNextAction() const;
+    QAction *findPreviousAction() const;
+
+    bool setFilter(const QString &expression);
+    bool find(const QString &expression, bool backward = false);
 
 public slots:
     void appendCanFrame(const QCanBusFrame &frame);
     void clear();
     void copy();
+    void editFilter();
+    void clearFilter();
+    void editFind();
+    void findNext();
+    void findPrevious();
 
 protected slots:
     void updateSelect(const QItemSelection &selected, const QItemSelection &deselected);
 
 protected:
     CanFrameModel *_canModel;
+    CanFrameFilter _findFilter;
 
     // Actions
     void createActions();
     QAction *_clearAction;
     QAction *_copyAction;
+    QAction *_filterAction;
+    QAction *_clearFilterAction;
+    QAction *_findAction;
+    QAction *_findNextAction;
+    QAction *_findPreviousAction;
 
     // QWidget interface
 protected:
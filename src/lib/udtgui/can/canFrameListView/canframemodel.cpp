@@ -24,11 +24,19 @@
 #include <QColor>
 #include <QFont>
 
+#include <algorithm>
+
+enum
+{
+    DECODE_CACHE_SIZE = 1024
+};
+
 CanFrameModel::CanFrameModel(QObject *parent)
     : QAbstractItemModel(parent)
 {
     _bus = nullptr;
     _frameId = 0;
+    _decodeCache.setMaxCost(DECODE_CACHE_SIZE);
 }
 
 CanFrameModel::~CanFrameModel()
@@ -37,20 +45,42 @@ CanFrameModel::~CanFrameModel()
 
 void CanFrameModel::appendCanFrame(const QCanBusFrame &frame)
 {
-    beginInsertRows(QModelIndex(), _frames.count(), _frames.count());
-    if (_frames.isEmpty())
+    if (_bus != nullptr)
+    {
+        // bus data mode, frames come from the bus log
+        return;
+    }
+
+    int newFrameRow = _frames.count();
+    _index.append(frame);
+    if (!isFiltered())
     {
-        _startTime = frame.timeStamp().seconds();
+        beginInsertRows(QModelIndex(), newFrameRow, newFrameRow);
+        _frames.append(frame);
+        endInsertRows();
+        return;
     }
+
     _frames.append(frame);
-    endInsertRows();
+    if (_filter.matches(frame, _index.timeUs(newFrameRow)))
+    {
+        beginInsertRows(QModelIndex(), _rows.count(), _rows.count());
+        _rows.append(newFrameRow);
+        endInsertRows();
+    }
 }
 
 void CanFrameModel::clear()
 {
-    emit layoutAboutToBeChanged();
+    beginResetModel();
     _frames.clear();
-    emit layoutChanged();
+    if (_bus == nullptr)
+    {
+        _index.clear();
+        _rows.clear();
+        _decodeCache.clear();
+    }
+    endResetModel();
 }
 
 CanOpenBus *CanFrameModel::bus() const
@@ -60,18 +90,181 @@ CanOpenBus *CanFrameModel::bus() const
 
 void CanFrameModel::setBus(CanOpenBus *bus)
 {
-    emit layoutAboutToBeChanged();
+    beginResetModel();
+    if (_bus != nullptr)
+    {
+        disconnect(_bus, &CanOpenBus::frameAvailable, this, &CanFrameModel::updateFrames);
+    }
     _bus = bus;
-    _frameId = _bus->canFramesLog().count();
+    _decoder.setBus(bus);
+    _decodeCache.clear();
+
+    // frames already in the log are indexed once here, then incrementally on frameAvailable
+    _index.clear();
+    for (const QCanBusFrame &frame : _bus->canFramesLog())
+    {
+        _index.append(frame);
+    }
+    _frameId = _index.count();
+    if (isFiltered())
+    {
+        _rows = _index.select(_filter, frames());
+    }
     connect(bus, &CanOpenBus::frameAvailable, this, &CanFrameModel::updateFrames);
-    emit layoutChanged();
+    endResetModel();
+}
+
+const CanFrameFilter &CanFrameModel::filter() const
+{
+    return _filter;
+}
+
+/**
+ * @brief shows only frames matching filter, evaluated on the frame log indexes
+ */
+void CanFrameModel::setFilter(const CanFrameFilter &filter)
+{
+    beginResetModel();
+    _filter = filter;
+    if (isFiltered())
+    {
+        _rows = _index.select(_filter, frames());
+    }
+    else
+    {
+        _rows.clear();
+    }
+    endResetModel();
+}
+
+void CanFrameModel::clearFilter()
+{
+    setFilter(CanFrameFilter());
+}
+
+bool CanFrameModel::isFiltered() const
+{
+    return !_filter.isEmpty();
+}
+
+/**
+ * @brief number of frames in the log, filtered or not
+ */
+int CanFrameModel::frameCount() const
+{
+    if (_bus == nullptr)
+    {
+        return _frames.count();
+    }
+    return _frameId;
+}
+
+/**
+ * @brief frame row in the log of the model row, -1 if out of range
+ */
+int CanFrameModel::frameRow(int row) const
+{
+    if (row < 0)
+    {
+        return -1;
+    }
+    if (isFiltered())
+    {
+        return (row < _rows.count()) ? _rows.at(row) : -1;
+    }
+    return (row < frameCount()) ? row : -1;
+}
+
+/**
+ * @brief model row of a frame of the log, -1 if the frame is filtered out
+ */
+int CanFrameModel::rowOfFrame(int canFrameRow) const
+{
+    if (!isFiltered())
+    {
+        return (canFrameRow >= 0 && canFrameRow < frameCount()) ? canFrameRow : -1;
+    }
+    auto it = std::lower_bound(_rows.cbegin(), _rows.cend(), canFrameRow);
+    if (it == _rows.cend() || *it != canFrameRow)
+    {
+        return -1;
+    }
+    return static_cast<int>(it - _rows.cbegin());
+}
+
+/**
+ * @brief next model row after row (or before row if backward) whose frame matches filter
+ * @return -1 if no visible frame matches
+ */
+int CanFrameModel::findRow(const CanFrameFilter &filter, int row, bool backward) const
+{
+    int frameRowIt = frameRow(row);
+    if (frameRowIt < 0)
+    {
+        frameRowIt = backward ? frameCount() : -1;
+    }
+
+    while (true)
+    {
+        frameRowIt = _index.findNext(filter, frames(), frameRowIt, backward);
+        if (frameRowIt < 0 || frameRowIt >= frameCount())
+        {
+            return -1;
+        }
+        int foundRow = rowOfFrame(frameRowIt);
+        if (foundRow >= 0)
+        {
+            return foundRow;
+        }
+    }
 }
 
 void CanFrameModel::updateFrames(int id)
 {
-    beginInsertRows(QModelIndex(), _frameId, id - 1);
+    const QList<QCanBusFrame> &canFramesLog = _bus->canFramesLog();
+    for (int frameRowIt = _index.count(); frameRowIt < id; frameRowIt++)
+    {
+        _index.append(canFramesLog.at(frameRowIt));
+    }
+
+    if (!isFiltered())
+    {
+        beginInsertRows(QModelIndex(), _frameId, id - 1);
+        _frameId = id;
+        endInsertRows();
+        return;
+    }
+
+    QVector<int> newRows = _index.select(_filter, canFramesLog, _frameId);
     _frameId = id;
-    endInsertRows();
+    if (!newRows.isEmpty())
+    {
+        beginInsertRows(QModelIndex(), _rows.count(), _rows.count() + newRows.count() - 1);
+        _rows.append(newRows);
+        endInsertRows();
+    }
+}
+
+const QList<QCanBusFrame> &CanFrameModel::frames() const
+{
+    if (_bus == nullptr)
+    {
+        return _frames;
+    }
+    return _bus->canFramesLog();
+}
+
+QString CanFrameModel::decodedFrame(int canFrameRow, const QCanBusFrame &frame) const
+{
+    QString *decoded = _decodeCache.object(canFrameRow);
+    if (decoded != nullptr)
+    {
+        return *decoded;
+    }
+
+    QString text = _decoder.decode(frame);
+    _decodeCache.insert(canFrameRow, new QString(text));
+    return text;
 }
 
 int CanFrameModel::columnCount(const QModelIndex &parent) const
@@ -99,6 +292,8 @@ QVariant CanFrameModel::headerData(int section, Qt::Orientation orientation, int
                     return QVariant(tr("Type"));
                 case DataByte:
                     return QVariant(tr("DataByte"));
+                case Decoded:
+                    return QVariant(tr("CANopen"));
             }
             break;
     }
@@ -112,23 +307,12 @@ QVariant CanFrameModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    if (_bus == nullptr)
-    {
-        // internal data mode
-        if (index.row() >= _frames.count())
-        {
-            return QVariant();
-        }
-    }
-    else
+    int canFrameRow = frameRow(index.row());
+    if (canFrameRow < 0)
     {
-        // bus data mode
-        if (index.row() >= _frameId)
-        {
-            return QVariant();
-        }
+        return QVariant();
     }
-    const QCanBusFrame &canFrame = (_bus == nullptr) ? _frames.at(index.row()) : _bus->canFramesLog().at(index.row());
+    const QCanBusFrame &canFrame = frames().at(canFrameRow);
 
     switch (role)
     {
@@ -136,8 +320,10 @@ QVariant CanFrameModel::data(const QModelIndex &index, int role) const
             switch (index.column())
             {
                 case Time:
-                    return QVariant(
-                        QString("%1.%2").arg(canFrame.timeStamp().seconds() - _startTime).arg(QString::number(canFrame.timeStamp().microSeconds() / 1000).rightJustified(3, '0')));
+                {
+                    qint64 timeUs = _index.timeUs(canFrameRow);
+                    return QVariant(QString("%1.%2").arg(timeUs / 1000000).arg(QString::number((timeUs % 1000000) / 1000).rightJustified(3, '0')));
+                }
 
                 case CanId:
                     return QVariant(QString("0x%1 (%2)").arg(QString::number(canFrame.frameId(), 16)).arg(canFrame.frameId()));
@@ -161,6 +347,9 @@ QVariant CanFrameModel::data(const QModelIndex &index, int role) const
                 case DataByte:
                     return QVariant(canFrame.payload().toHex(' ').toUpper());
 
+                case Decoded:
+                    return QVariant(decodedFrame(canFrameRow, canFrame));
+
                 default:
                     return QVariant();
             }
@@ -207,21 +396,9 @@ QVariant CanFrameModel::data(const QModelIndex &index, int role) const
 QModelIndex CanFrameModel::index(int row, int column, const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
-    if (_bus == nullptr)
+    if (frameRow(row) < 0)
     {
-        // internal data mode
-        if (row >= _frames.count())
-        {
-            return QModelIndex();
-        }
-    }
-    else
-    {
-        // bus data mode
-        if (row >= _frameId)
-        {
-            return QModelIndex();
-        }
+        return QModelIndex();
     }
     return createIndex(row, column, nullptr);
 }
@@ -236,11 +413,11 @@ int CanFrameModel::rowCount(const QModelIndex &parent) const
 {
     if (!parent.isValid())
     {
-        if (_bus == nullptr)
+        if (isFiltered())
         {
-            return _frames.count();
+            return _rows.count();
         }
-        return _frameId;
+        return frameCount();
     }
     return 0;
 }
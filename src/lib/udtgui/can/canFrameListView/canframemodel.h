@@ -27,6 +27,12 @@
 
 #include "canopenbus.h"
 
+#include "canframedecoder.h"
+#include "canframefilter.h"
+#include "canframeindex.h"
+
+#include <QCache>
+
 class UDTGUI_EXPORT CanFrameModel : public QAbstractItemModel
 {
     Q_OBJECT
@@ -46,9 +52,20 @@ public:
         CanId,
         Type,
         DataByte,
+        Decoded,
         ColumnCount
     };
 
+    const CanFrameFilter &filter() const;
+    void setFilter(const CanFrameFilter &filter);
+    void clearFilter();
+    bool isFiltered() const;
+
+    int frameCount() const;
+    int frameRow(int row) const;
+    int rowOfFrame(int canFrameRow) const;
+    int findRow(const CanFrameFilter &filter, int row, bool backward = false) const;
+
 protected slots:
     void updateFrames(int id);
 
@@ -63,12 +80,22 @@ public:
     Qt::ItemFlags flags(const QModelIndex &index) const override;
 
 private:
-    qint64 _startTime;
-
     QList<QCanBusFrame> _frames;
 
     int _frameId;
     CanOpenBus *_bus;
+
+    // frame log indexes and filtered rows, _rows maps model rows to frame rows when filtered
+    CanFrameIndex _index;
+    CanFrameFilter _filter;
+    QVector<int> _rows;
+
+    // CANopen decoding, done on demand for visible rows and kept in a LRU cache by frame row
+    CanFrameDecoder _decoder;
+    mutable QCache<int, QString> _decodeCache;
+
+    const QList<QCanBusFrame> &frames() const;
+    QString decodedFrame(int canFrameRow, const QCanBusFrame &frame) const;
 };
 
 #endif  // CANFRAMEMODEL_H
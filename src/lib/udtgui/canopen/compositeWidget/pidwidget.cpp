@@ -22,6 +22,7 @@
 #include "canopen/indexWidget/indexcheckbox.h"
 #include "canopen/indexWidget/indexlabel.h"
 #include "canopen/indexWidget/indexspinbox.h"
+#include "canopenbus.h"
 #include "indexdb402.h"
 #include "node.h"
 #include "profile/p402/nodeprofile402.h"
@@ -33,13 +34,17 @@
 #include <QSplitter>
 #include <QWidget>
 
+enum
+{
+    READ_STATUS_PERIOD_MS = 10
+};
+
 PidWidget::PidWidget(QWidget *parent)
     : QWidget(parent)
 {
     _nodeProfile402 = nullptr;
     createWidgets();
     connect(&_timerTest, &QTimer::timeout, this, &PidWidget::manageMeasurement);
-    connect(&_readStatusTimer, &QTimer::timeout, this, &PidWidget::readStatus);
     _state = NONE;
     _modePid = MODE_PID_NONE;
 }
@@ -106,11 +111,11 @@ void PidWidget::toggleStartLogger(bool start)
 {
     if (start)
     {
-        _readStatusTimer.start();
+        startReadStatus();
     }
     else
     {
-        _readStatusTimer.stop();
+        stopReadStatus();
     }
 }
 
@@ -338,7 +343,7 @@ void PidWidget::manageMeasurement()
             _dataLogger->clear();
             _dataLogger->start(10);
             _timerTest.start(10);
-            _readStatusTimer.start(10);
+            startReadStatus();
             _state = LAUCH_DATALOGGER;
             break;
 
@@ -361,7 +366,7 @@ void PidWidget::manageMeasurement()
 
         case PidWidget::STOP_DATALOGGER:
             stopDataLogger();
-            _readStatusTimer.stop();
+            stopReadStatus();
             _state = NONE;
             break;
     }
@@ -438,13 +443,29 @@ void PidWidget::stopDataLogger()
     disconnect(_nodeProfile402, &NodeProfile402::modeChanged, this, &PidWidget::mode402Changed);
 }
 
-void PidWidget::readStatus()
+void PidWidget::startReadStatus()
 {
-    node()->readObject(_actualValue_ObjId);
-    _inputLabel->readObject();
-    _errorLabel->readObject();
-    _integratorLabel->readObject();
-    _outputLabel->readObject();
+    if (_nodeProfile402 == nullptr || node()->bus() == nullptr)
+    {
+        return;
+    }
+
+    PollScheduler *pollScheduler = node()->bus()->pollScheduler();
+    pollScheduler->addPoll(this, node(), _actualValue_ObjId, READ_STATUS_PERIOD_MS);
+    pollScheduler->addPoll(this, node(), _inputLabel->objId(), READ_STATUS_PERIOD_MS);
+    pollScheduler->addPoll(this, node(), _errorLabel->objId(), READ_STATUS_PERIOD_MS);
+    pollScheduler->addPoll(this, node(), _integratorLabel->objId(), READ_STATUS_PERIOD_MS);
+    pollScheduler->addPoll(this, node(), _outputLabel->objId(), READ_STATUS_PERIOD_MS);
+}
+
+void PidWidget::stopReadStatus()
+{
+    if (_nodeProfile402 == nullptr || node()->bus() == nullptr)
+    {
+        return;
+    }
+
+    node()->bus()->pollScheduler()->removePolls(this);
 }
 
 void PidWidget::readAllObject()
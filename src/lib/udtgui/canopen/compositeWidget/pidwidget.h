@@ -73,8 +73,6 @@ protected:
     NodeProfile402 *_nodeProfile402;
     ModePid _modePid;
 
-    QTimer _readStatusTimer;
-
     DataLogger *_dataLogger;
     DataLoggerWidget *_dataLoggerWidget;
 
@@ -138,7 +136,8 @@ protected:
     void stopSecondMeasurement();
     void stopMeasurement();
     void stopDataLogger();
-    void readStatus();
+    void startReadStatus();
+    void stopReadStatus();
     void readAllObject();
     void statusNodeChanged(Node::Status status);
 };
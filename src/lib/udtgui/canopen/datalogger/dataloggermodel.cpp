@@ -258,7 +258,7 @@ bool DataLoggerModel::setData(const QModelIndex &index, const QVariant &value, i
 
     if (role == Qt::CheckStateRole && index.column() == NodeName)
     {
-        dlData->setActive(!dlData->isActive());
+        _dataLogger->setDataActive(dlData, !dlData->isActive());
         return true;
     }
 
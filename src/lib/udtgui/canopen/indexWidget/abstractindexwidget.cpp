@@ -30,6 +30,7 @@
 
 AbstractIndexWidget::AbstractIndexWidget(const NodeObjectId &objId)
 {
+    setCoalescedNotify(true);
     setObjId(objId);
 
     _hint = DisplayDirectValue;
@@ -28,6 +28,7 @@ NodeOdItemModel::NodeOdItemModel(QObject *parent)
     _root = nullptr;
     _node = nullptr;
 
+    setCoalescedNotify(true);
     registerFullOd();
 }
 
@@ -76,6 +76,24 @@ void P401ChannelWidget::readInputObject()
     }
 }
 
+/**
+ * @brief objects read by readInputObject()
+ */
+QList<NodeObjectId> P401ChannelWidget::inputObjects() const
+{
+    QList<NodeObjectId> objects;
+    objects.append(_modeCombobox->objId());
+    if (_inputStackedWidget->currentWidget() == _inputWidget)
+    {
+        objects.append(_inputWidget->inputObjects());
+    }
+    else
+    {
+        objects.append(_inputOptionWidget->inputObjects());
+    }
+    return objects;
+}
+
 void P401ChannelWidget::setNode(Node *node)
 {
     _modeCombobox->setObjId(IndexDb401::getObjectId(IndexDb401::OD_MS_DO_MODE, _channel + 1));
@@ -47,6 +47,7 @@ public:
 
     void readAllObject();
     void readInputObject();
+    QList<NodeObjectId> inputObjects() const;
 
     P401InputWidget *inputWidget() const;
 
@@ -36,6 +36,11 @@ void P401InputOptionWidget::readAllObject()
     _diSchmittTriggersHigh->readObject();
 }
 
+QList<NodeObjectId> P401InputOptionWidget::inputObjects() const
+{
+    return QList<NodeObjectId>() << _diSchmittTriggersLow->objId() << _diSchmittTriggersHigh->objId();
+}
+
 void P401InputOptionWidget::setNode(Node *node)
 {
     if (node == nullptr)
@@ -19,6 +19,8 @@
 #ifndef P401INPUTOPTIONWIDGET_H
 #define P401INPUTOPTIONWIDGET_H
 
+#include "nodeobjectid.h"
+
 #include <QWidget>
 
 class IndexSpinBox;
@@ -31,6 +33,7 @@ public:
     P401InputOptionWidget(uint8_t channel, QWidget *parent = nullptr);
 
     void readAllObject();
+    QList<NodeObjectId> inputObjects() const;
 
 public slots:
     void setNode(Node *node);
@@ -38,6 +38,11 @@ void P401InputWidget::readAllObject()
     _node->readObject(_digitalObjectId);
 }
 
+QList<NodeObjectId> P401InputWidget::inputObjects() const
+{
+    return QList<NodeObjectId>() << _analogObjectId << _digitalObjectId;
+}
+
 void P401InputWidget::setNode(Node *node)
 {
     if (node == nullptr)
@@ -43,6 +43,7 @@ public:
     P401InputWidget(uint8_t channel, QWidget *parent = nullptr);
 
     void readAllObject();
+    QList<NodeObjectId> inputObjects() const;
 
     const NodeObjectId &analogObjectId() const;
 
@@ -20,6 +20,7 @@
 
 #include "canopen/datalogger/dataloggerwidget.h"
 #include "canopen/indexWidget/indexcombobox.h"
+#include "canopenbus.h"
 #include "node.h"
 #include "p401channelwidget.h"
 #include "p401inputwidget.h"
@@ -35,9 +36,9 @@ P401Widget::P401Widget(uint8_t channelCount, QWidget *parent)
     : QWidget(parent)
 {
     _channelCount = channelCount;
+    _node = nullptr;
+    _pollPeriodMs = 0;
     createWidgets();
-
-    connect(&_readTimer, &QTimer::timeout, this, &P401Widget::readInputObject);
 }
 
 Node *P401Widget::node() const
@@ -74,14 +75,19 @@ void P401Widget::dataLogger()
     _dataLoggerWidget->show();
 }
 
+/**
+ * @brief polls input objects of all channels every msec with the bus poll scheduler, while the widget is visible
+ */
 void P401Widget::start(int msec)
 {
-    _readTimer.start(msec);
+    _pollPeriodMs = msec;
+    updatePolls();
 }
 
 void P401Widget::stop()
 {
-    _readTimer.stop();
+    _pollPeriodMs = 0;
+    updatePolls();
 }
 
 void P401Widget::setNode(Node *node)
@@ -96,11 +102,36 @@ void P401Widget::setNode(Node *node)
     {
         p401ChannelWidget->setNode(_node);
     }
+    updatePolls();
 }
 
 void P401Widget::setSettings(bool checked)
 {
     emit settings(checked);
+    updatePolls();
+}
+
+void P401Widget::updatePolls()
+{
+    if (_node == nullptr || _node->bus() == nullptr)
+    {
+        return;
+    }
+
+    PollScheduler *pollScheduler = _node->bus()->pollScheduler();
+    pollScheduler->removePolls(this);
+    if (_pollPeriodMs <= 0)
+    {
+        return;
+    }
+
+    for (P401ChannelWidget *p401ChannelWidget : qAsConst(_p401ChannelWidgets))
+    {
+        for (const NodeObjectId &objectId : p401ChannelWidget->inputObjects())
+        {
+            pollScheduler->addPoll(this, _node, objectId, _pollPeriodMs);
+        }
+    }
 }
 
 void P401Widget::createWidgets()
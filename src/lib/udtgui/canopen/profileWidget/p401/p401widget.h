@@ -21,7 +21,6 @@
 
 #include "../../../udtgui_global.h"
 
-#include <QTimer>
 #include <QToolBar>
 #include <QWidget>
 
@@ -53,13 +52,15 @@ private:
     quint8 _channelCount;
     Node *_node;
 
-    QTimer _readTimer;
+    int _pollPeriodMs;
 
     QList<P401ChannelWidget *> _p401ChannelWidgets;
 
     // Create widgets
     void createWidgets();
     QToolBar *toolBarWidgets();
+
+    void updatePolls();
 };
 
 #endif  // P401WIDGET_H
@@ -28,12 +28,18 @@
 
 #include "canopen/indexWidget/indexcombobox.h"
 #include "canopen/indexWidget/indexlabel.h"
+#include "canopenbus.h"
 #include "screen/nodescreenswidget.h"
 
 #include "bootloader/bootloader.h"
 
 #include "canopen/bootloaderWidget/bootloaderwidget.h"
 
+enum
+{
+    READ_STATUS_PERIOD_MS = 1000
+};
+
 NodeScreenHome::NodeScreenHome()
 {
     createWidgets();
@@ -173,6 +179,7 @@ QWidget *NodeScreenHome::createStatusWidget()
     indexLabel->setUnit(" V");
     sumaryLayout->addRow(tr("Board voltage:"), indexLabel);
     _indexWidgets.append(indexLabel);
+    _statusWidgets.append(indexLabel);
 
     indexLabel = new IndexLabel(NodeObjectId(0x2020, 1));
     indexLabel->setDisplayHint(AbstractIndexWidget::DisplayFloat);
@@ -180,6 +187,7 @@ QWidget *NodeScreenHome::createStatusWidget()
     indexLabel->setUnit(" °C");
     sumaryLayout->addRow(tr("CPU temperature:"), indexLabel);
     _indexWidgets.append(indexLabel);
+    _statusWidgets.append(indexLabel);
 
     groupBox->setLayout(sumaryLayout);
     return groupBox;
@@ -273,6 +281,29 @@ void NodeScreenHome::updateInfos(Node *node)
     }
 }
 
+/**
+ * @brief status objects are polled with the bus poll scheduler while the screen is visible
+ */
+void NodeScreenHome::updateStatusPolls(Node *node)
+{
+    if (!_pollScheduler.isNull())
+    {
+        _pollScheduler->removePolls(this);
+    }
+    _pollScheduler = nullptr;
+
+    if (node == nullptr || node->bus() == nullptr)
+    {
+        return;
+    }
+
+    _pollScheduler = node->bus()->pollScheduler();
+    for (AbstractIndexWidget *indexWidget : qAsConst(_statusWidgets))
+    {
+        _pollScheduler->addPoll(this, node, indexWidget->objId(), READ_STATUS_PERIOD_MS, PollScheduler::PriorityLow);
+    }
+}
+
 QString NodeScreenHome::title() const
 {
     return QString(tr("Node"));
@@ -287,6 +318,7 @@ void NodeScreenHome::setNodeInternal(Node *node, uint8_t axis)
     }
 
     updateInfos(node);
+    updateStatusPolls(node);
 
     if (node != nullptr)
     {
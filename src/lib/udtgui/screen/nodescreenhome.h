@@ -25,10 +25,13 @@
 
 #include <canopen/nodeod/nodeodwidget.h>
 
+#include <QPointer>
+
 class AbstractIndexWidget;
 class QLabel;
 class IndexLabel;
 class IndexComboBox;
+class PollScheduler;
 
 class UDTGUI_EXPORT NodeScreenHome : public NodeScreen
 {
@@ -56,8 +59,11 @@ protected:
     QLabel *_odSubIndexCountLabel;
 
     QList<AbstractIndexWidget *> _indexWidgets;
+    QList<AbstractIndexWidget *> _statusWidgets;
+    QPointer<PollScheduler> _pollScheduler;
 
     void updateInfos(Node *node);
+    void updateStatusPolls(Node *node);
 
     // NodeScreen interface
 public:
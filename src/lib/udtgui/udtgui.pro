@@ -18,6 +18,10 @@ HEADERS += \
     $$PWD/od/odtreeviewdelegate.h \
     $$PWD/can/canFrameListView/canframelistview.h \
     $$PWD/can/canFrameListView/canframemodel.h \
+    $$PWD/can/canFrameListView/canframedecoder.h \
+    $$PWD/can/canFrameListView/canframefilter.h \
+    $$PWD/can/canFrameListView/canframeindex.h \
+    $$PWD/can/busStatisticsWidget/busstatisticswidget.h \
     $$PWD/canopen/busmanagerwidget.h \
     $$PWD/canopen/busnodesmanagerview.h \
     $$PWD/canopen/busnodesmodel.h \
@@ -86,6 +90,10 @@ SOURCES += \
     $$PWD/od/odtreeviewdelegate.cpp \
     $$PWD/can/canFrameListView/canframelistview.cpp \
     $$PWD/can/canFrameListView/canframemodel.cpp \
+    $$PWD/can/canFrameListView/canframedecoder.cpp \
+    $$PWD/can/canFrameListView/canframefilter.cpp \
+    $$PWD/can/canFrameListView/canframeindex.cpp \
+    $$PWD/can/busStatisticsWidget/busstatisticswidget.cpp \
     $$PWD/canopen/busmanagerwidget.cpp \
     $$PWD/canopen/busnodesmanagerview.cpp \
     $$PWD/canopen/busnodesmodel.cpp \
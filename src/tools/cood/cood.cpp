@@ -18,7 +18,16 @@
 
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
 
 #include "generator/cgenerator.h"
 #include "generator/csvgenerator.h"
@@ -44,23 +53,35 @@
 #    define cendl Qt::endl
 #endif
 
+// part of the batch cache key, to increase when generated outputs change
+#define COOD_GENERATOR_VERSION "1.3"
+
 /**
- * @brief main
- * @return
+ * @brief one generation, from a command line or from a batch manifest line
  */
-int main(int argc, char *argv[])
+struct CoodJob
+{
+    QStringList files;
+    QString outputFile;
+    QString nodeId;
+    QString duplicate;
+    QStringList configurationFiles;
+    QString range;
+    QString structName;
+    bool lookup;
+    bool layout;
+
+    // filled by run
+    int result;
+    QString errorStr;
+    QString layoutReport;
+    QByteArray hash;
+    bool upToDate;
+    int writtenCount;
+};
+
+static void addJobOptions(QCommandLineParser &cliParser)
 {
-    QCoreApplication app(argc, argv);
-    QCoreApplication::setApplicationName("COOD");
-    QCoreApplication::setApplicationVersion("1.0");
-
-    QTextStream out(stdout, QIODevice::WriteOnly);
-    QTextStream err(stderr, QIODevice::WriteOnly);
-
-    QCommandLineParser cliParser;
-    cliParser.setApplicationDescription(QCoreApplication::translate("cood", "Object dictionary command line interface."));
-    cliParser.addHelpOption();
-    cliParser.addVersionOption();
     cliParser.addPositionalArgument("file", QCoreApplication::translate("cood", "Object dictionary file (.dcf or .eds)"), "file");
 
     QCommandLineOption outOption(QStringList() << "o"
@@ -99,36 +120,126 @@ int main(int argc, char *argv[])
                                     "structName");
     cliParser.addOption(structOption);
 
-    cliParser.process(app);
+    QCommandLineOption lookupOption(QStringList() << "l"
+                                                  << "lookup",
+                                    QCoreApplication::translate("cood", "Generates O(1) index lookup and PDO mappable tables in C files"));
+    cliParser.addOption(lookupOption);
+
+    QCommandLineOption layoutOption(QStringList() << "p"
+                                                  << "pack",
+                                    QCoreApplication::translate("cood", "Generates optimized OD layout with size report in C files"));
+    cliParser.addOption(layoutOption);
+}
+
+static CoodJob jobFromParser(const QCommandLineParser &cliParser)
+{
+    CoodJob job;
+    job.files = cliParser.positionalArguments();
+    job.outputFile = cliParser.value("out");
+    job.nodeId = cliParser.value("nodeid");
+    job.duplicate = cliParser.value("duplicate");
+    job.configurationFiles = cliParser.values("configuration");
+    job.range = cliParser.value("range");
+    job.structName = cliParser.value("structName");
+    job.lookup = cliParser.isSet("lookup");
+    job.layout = cliParser.isSet("pack");
+    job.result = 0;
+    job.upToDate = false;
+    job.writtenCount = 0;
+    return job;
+}
 
-    const QStringList files = cliParser.positionalArguments();
-    if (files.isEmpty())
+/**
+ * @brief list of files written by the job, an output directory gives od_data.c, od_data.h and out.dcf
+ */
+static QStringList jobOutputFiles(const CoodJob &job)
+{
+    QString outputFile = job.outputFile.isEmpty() ? job.files.at(0) : job.outputFile;
+    QString outSuffix = QFileInfo(outputFile).suffix();
+    QStringList suffixes = {"c", "h", "dcf", "eds", "tex", "csv"};
+    if (!suffixes.contains(outSuffix) && QFileInfo(outputFile).isDir())
     {
-        err << QCoreApplication::translate("cood", "error (1): input file is needed") << cendl;
-        cliParser.showHelp(-1);
+        return QStringList() << outputFile + "/od_data.c" << outputFile + "/od_data.h" << outputFile + "/out.dcf";
+    }
+    return QStringList() << outputFile;
+}
+
+/**
+ * @brief hash of generator version, options and contents of all input files
+ */
+static QByteArray jobHash(const CoodJob &job)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray(COOD_GENERATOR_VERSION));
+    hash.addData(QStringList({job.outputFile, job.nodeId, job.duplicate, job.range, job.structName, job.lookup ? "lookup" : "", job.layout ? "pack" : ""}).join('\n').toUtf8());
+
+    const QStringList inputs = job.files + job.configurationFiles;
+    for (const QString &input : inputs)
+    {
+        hash.addData(input.toUtf8());
+        QFile file(input);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return QByteArray();
+        }
+        hash.addData(&file);
+    }
+    return hash.result().toHex();
+}
+
+/**
+ * @brief replaces filePath with generatedPath content only if bytes differ, keeps timestamps of unchanged outputs
+ * @return 1 if written, 0 if unchanged, -1 on error
+ */
+static int writeIfChanged(const QString &generatedPath, const QString &filePath)
+{
+    QFile generatedFile(generatedPath);
+    if (!generatedFile.open(QIODevice::ReadOnly))
+    {
+        return -1;
+    }
+    QByteArray content = generatedFile.readAll();
+
+    QFile file(filePath);
+    if (file.size() == content.size() && file.open(QIODevice::ReadOnly))
+    {
+        if (file.readAll() == content)
+        {
+            return 0;
+        }
+        file.close();
+    }
+
+    QSaveFile saveFile(filePath);
+    if (!saveFile.open(QIODevice::WriteOnly))
+    {
+        return -1;
+    }
+    saveFile.write(content);
+    if (!saveFile.commit())
+    {
+        return -1;
     }
+    return 1;
+}
+
+static int generate(CoodJob &job, const QString &outputFile, QString &errorStr)
+{
+    const QStringList &files = job.files;
     const QString &inputFile = files.at(0);
     QString inSuffix = QFileInfo(inputFile).suffix();
+    QString outSuffix = QFileInfo(outputFile).suffix();
 
     // node Id
     uint8_t nodeid = 0;
-
-    // output file
-    QString outputFile = cliParser.value("out");
-    QString outSuffix = QFileInfo(outputFile).suffix();
-    if (outputFile.isEmpty())
+    if (!job.outputFile.isEmpty())
     {
-        outputFile = inputFile;
-        outSuffix = QFileInfo(outputFile).suffix();
-    }
-    else
-    {
-        if (inSuffix == "eds" && outSuffix != "eds" && cliParser.value("range").isEmpty() && cliParser.value("structName").isEmpty())
+        if (inSuffix == "eds" && outSuffix != "eds" && job.range.isEmpty() && job.structName.isEmpty())
         {
-            nodeid = static_cast<uint8_t>(cliParser.value("nodeid").toUInt());
+            nodeid = static_cast<uint8_t>(job.nodeId.toUInt());
             if (nodeid == 0 || nodeid > 127)
             {
-                err << QCoreApplication::translate("cood", "error (2): invalid node id, nodeId > 0 && nodeId < 126") << cendl;
+                errorStr = QCoreApplication::translate("cood", "error (2): invalid node id, nodeId > 0 && nodeId < 126");
                 return -2;
             }
         }
@@ -143,7 +254,7 @@ int main(int argc, char *argv[])
         deviceDescription = parser.parse(inputFile);
         if (deviceDescription == nullptr)
         {
-            err << QCoreApplication::translate("cood", "error (5): invalid eds file or file does not exist '%1'").arg(inputFile) << cendl;
+            errorStr = QCoreApplication::translate("cood", "error (5): invalid eds file or file does not exist '%1'").arg(inputFile);
             return -5;
         }
         deviceConfiguration = DeviceConfiguration::fromDeviceDescription(deviceDescription, nodeid);
@@ -155,7 +266,7 @@ int main(int argc, char *argv[])
     }
     else
     {
-        err << QCoreApplication::translate("cood", "error (3): invalid input file format, .eds or .dcf accepted") << cendl;
+        errorStr = QCoreApplication::translate("cood", "error (3): invalid input file format, .eds or .dcf accepted");
         return -3;
     }
 
@@ -173,7 +284,7 @@ int main(int argc, char *argv[])
         {
             delete deviceDescription;
             delete deviceConfiguration;
-            err << QCoreApplication::translate("cood", "error (5): invalid eds file or file does not exist '%1'").arg(files.at(fileId)) << cendl;
+            errorStr = QCoreApplication::translate("cood", "error (5): invalid eds file or file does not exist '%1'").arg(files.at(fileId));
             return -5;
         }
         if (deviceDescription != nullptr)
@@ -183,8 +294,7 @@ int main(int argc, char *argv[])
         ODMerger::merge(deviceConfiguration, secondDeviceDescription);
     }
 
-    QStringList cfgFiles = cliParser.values("configuration");
-    for (const QString &cfgFile : qAsConst(cfgFiles))
+    for (const QString &cfgFile : job.configurationFiles)
     {
         if (deviceConfiguration != nullptr)
         {
@@ -201,7 +311,7 @@ int main(int argc, char *argv[])
     }
 
     uint8_t duplicate = 0;
-    duplicate = static_cast<uint8_t>(cliParser.value("duplicate").toUInt());
+    duplicate = static_cast<uint8_t>(job.duplicate.toUInt());
     if (duplicate != 0)
     {
         if (deviceConfiguration != nullptr)
@@ -211,36 +321,26 @@ int main(int argc, char *argv[])
         ProfileDuplicate::duplicate(deviceDescription, duplicate);
     }
 
-    /*if (deviceDescription)
-    {
-        for (Index *index : deviceDescription->indexes())
-        {
-            for (SubIndex *subIndex : index->subIndexes())
-            {
-                if (subIndex->accessType() & SubIndex::WRITE
-                        && !subIndex->value().isValid())
-                {
-                    subIndex->setValue(QVariant(0));
-                }
-            }
-        }
-    }*/
-
     // OUTPUT FILE
     if (outSuffix == "c")
     {
         CGenerator cgenerator;
+        cgenerator.setLookupEnabled(job.lookup);
+        cgenerator.setLayoutOptimized(job.layout);
         if (!cgenerator.generateC(deviceConfiguration, outputFile))
         {
-            err << cgenerator.errorStr();
+            errorStr = cgenerator.errorStr();
             return -4;
         }
+        job.layoutReport = cgenerator.layoutReport();
     }
     else if (outSuffix == "h")
     {
         CGenerator cgenerator;
+        cgenerator.setLookupEnabled(job.lookup);
+        cgenerator.setLayoutOptimized(job.layout);
         bool noError = true;
-        QString rangeStr = cliParser.value("range");
+        QString rangeStr = job.range;
         if (rangeStr.isEmpty())
         {
             noError = cgenerator.generateH(deviceConfiguration, outputFile);
@@ -251,10 +351,10 @@ int main(int argc, char *argv[])
             QStringList rangeList = rangeStr.split(':');
             uint16_t min;
             uint16_t max;
-            QString structName = cliParser.value("structName");
+            QString structName = job.structName;
             if (rangeList.size() != 2)
             {
-                err << QCoreApplication::translate("cood", "error (4): invalid range option value") << cendl;
+                errorStr = QCoreApplication::translate("cood", "error (4): invalid range option value");
                 return -4;
             }
 
@@ -281,7 +381,7 @@ int main(int argc, char *argv[])
 
         if (!noError)
         {
-            err << cgenerator.errorStr();
+            errorStr = cgenerator.errorStr();
             return -4;
         }
     }
@@ -308,15 +408,18 @@ int main(int argc, char *argv[])
     else if (QFileInfo(outputFile).isDir())
     {
         CGenerator cgenerator;
+        cgenerator.setLookupEnabled(job.lookup);
+        cgenerator.setLayoutOptimized(job.layout);
         DcfWriter dcfWriter;
         if (!cgenerator.generateC(deviceConfiguration, QString(outputFile + "/od_data.c")))
         {
-            err << cgenerator.errorStr();
+            errorStr = cgenerator.errorStr();
             return -4;
         }
+        job.layoutReport = cgenerator.layoutReport();
         if (!cgenerator.generateH(deviceConfiguration, QString(outputFile + "/od_data.h")))
         {
-            err << cgenerator.errorStr();
+            errorStr = cgenerator.errorStr();
             return -4;
         }
         dcfWriter.write(deviceConfiguration, QString(outputFile + "/out.dcf"));
@@ -325,7 +428,7 @@ int main(int argc, char *argv[])
     {
         delete deviceDescription;
         delete deviceConfiguration;
-        err << QCoreApplication::translate("cood", "error (4): invalid output file format, .c, .h, .dcf, .eds, .csv or .tex accepted") << cendl;
+        errorStr = QCoreApplication::translate("cood", "error (4): invalid output file format, .c, .h, .dcf, .eds, .csv or .tex accepted");
         return -4;
     }
 
@@ -334,3 +437,308 @@ int main(int argc, char *argv[])
 
     return 0;
 }
+
+/**
+ * @brief generates into a temporary directory with the same file names, then only replaces outputs that changed
+ */
+static void runJob(CoodJob &job)
+{
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid())
+    {
+        job.errorStr = QCoreApplication::translate("cood", "error (7): cannot create temporary directory");
+        job.result = -7;
+        return;
+    }
+
+    const QStringList outputFiles = jobOutputFiles(job);
+    QString outputFile = job.outputFile.isEmpty() ? job.files.at(0) : job.outputFile;
+    QString tempOutputFile = (outputFiles.count() > 1) ? tempDir.path() : tempDir.filePath(QFileInfo(outputFile).fileName());
+
+    job.result = generate(job, tempOutputFile, job.errorStr);
+    if (job.result != 0)
+    {
+        return;
+    }
+
+    for (const QString &file : outputFiles)
+    {
+        QString tempFile = tempDir.filePath(QFileInfo(file).fileName());
+        if (!QFile::exists(tempFile))
+        {
+            continue;
+        }
+        int written = writeIfChanged(tempFile, file);
+        if (written < 0)
+        {
+            job.errorStr = QCoreApplication::translate("cood", "error (7): cannot write output file '%1'").arg(file);
+            job.result = -7;
+            return;
+        }
+        job.writtenCount += written;
+    }
+}
+
+class CoodRunnable : public QRunnable
+{
+public:
+    CoodRunnable(CoodJob *job)
+        : _job(job)
+    {
+    }
+
+    void run() override
+    {
+        runJob(*_job);
+    }
+
+private:
+    CoodJob *_job;
+};
+
+/**
+ * @brief splits a manifest line in arguments, double quotes group arguments with spaces
+ */
+static QStringList splitArguments(const QString &line)
+{
+    QStringList args;
+    QString arg;
+    bool inQuotes = false;
+    bool hasArg = false;
+    for (const QChar &c : line)
+    {
+        if (c == '"')
+        {
+            inQuotes = !inQuotes;
+            hasArg = true;
+        }
+        else if (c.isSpace() && !inQuotes)
+        {
+            if (hasArg)
+            {
+                args.append(arg);
+                arg.clear();
+                hasArg = false;
+            }
+        }
+        else
+        {
+            arg.append(c);
+            hasArg = true;
+        }
+    }
+    if (hasArg)
+    {
+        args.append(arg);
+    }
+    return args;
+}
+
+static QString manifestPath(const QDir &dir, const QString &path)
+{
+    if (path.isEmpty())
+    {
+        return path;
+    }
+    return QDir::cleanPath(dir.absoluteFilePath(path));
+}
+
+/**
+ * @brief batch mode, one cood command line per manifest line, paths relative to the manifest
+ */
+static int runBatch(const QString &manifestFile, const QString &cacheFile, int jobsCount, bool force, QTextStream &out, QTextStream &err)
+{
+    QFile manifest(manifestFile);
+    if (!manifest.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        err << QCoreApplication::translate("cood", "error (8): cannot open manifest file '%1'").arg(manifestFile) << cendl;
+        return -8;
+    }
+    QDir manifestDir = QFileInfo(manifestFile).absoluteDir();
+
+    QList<CoodJob> jobs;
+    int lineNumber = 0;
+    while (!manifest.atEnd())
+    {
+        lineNumber++;
+        QString line = QString::fromUtf8(manifest.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+
+        QCommandLineParser lineParser;
+        addJobOptions(lineParser);
+        if (!lineParser.parse(QStringList() << QCoreApplication::applicationName() << splitArguments(line)) || lineParser.positionalArguments().isEmpty())
+        {
+            err << QCoreApplication::translate("cood", "error (8): invalid manifest line %1: %2").arg(lineNumber).arg(lineParser.errorText()) << cendl;
+            return -8;
+        }
+
+        CoodJob job = jobFromParser(lineParser);
+        for (QString &file : job.files)
+        {
+            file = manifestPath(manifestDir, file);
+        }
+        for (QString &file : job.configurationFiles)
+        {
+            file = manifestPath(manifestDir, file);
+        }
+        job.outputFile = manifestPath(manifestDir, job.outputFile);
+        jobs.append(job);
+    }
+
+    // cache: one line per job, hash and output files
+    QHash<QString, QByteArray> cache;
+    QFile cacheIn(cacheFile);
+    if (!force && cacheIn.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        while (!cacheIn.atEnd())
+        {
+            QByteArray line = cacheIn.readLine().trimmed();
+            int sep = line.indexOf(' ');
+            if (sep > 0)
+            {
+                cache.insert(QString::fromUtf8(line.mid(sep + 1)), line.left(sep));
+            }
+        }
+        cacheIn.close();
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobsCount);
+    for (CoodJob &job : jobs)
+    {
+        job.hash = jobHash(job);
+        const QStringList outputFiles = jobOutputFiles(job);
+        bool outputsExist = true;
+        for (const QString &file : outputFiles)
+        {
+            outputsExist = outputsExist && QFile::exists(file);
+        }
+        if (!job.hash.isEmpty() && outputsExist && cache.value(outputFiles.join(';')) == job.hash)
+        {
+            job.upToDate = true;
+            continue;
+        }
+        pool.start(new CoodRunnable(&job));
+    }
+    pool.waitForDone();
+
+    int result = 0;
+    int generatedCount = 0;
+    int upToDateCount = 0;
+    int writtenCount = 0;
+    for (const CoodJob &job : qAsConst(jobs))
+    {
+        QString key = jobOutputFiles(job).join(';');
+        if (job.upToDate)
+        {
+            upToDateCount++;
+            continue;
+        }
+        if (job.result != 0)
+        {
+            err << job.files.at(0) << ": " << job.errorStr << cendl;
+            cache.remove(key);
+            result = job.result;
+            continue;
+        }
+        generatedCount++;
+        writtenCount += job.writtenCount;
+        if (!job.layoutReport.isEmpty())
+        {
+            out << jobOutputFiles(job).join(", ") << ":\n" << job.layoutReport;
+        }
+        if (!job.hash.isEmpty())
+        {
+            cache.insert(key, job.hash);
+        }
+    }
+
+    QSaveFile cacheOut(cacheFile);
+    if (cacheOut.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        for (auto it = cache.cbegin(); it != cache.cend(); ++it)
+        {
+            cacheOut.write(it.value() + ' ' + it.key().toUtf8() + '\n');
+        }
+        cacheOut.commit();
+    }
+
+    out << QCoreApplication::translate("cood", "%1 job(s): %2 generated, %3 up to date, %4 file(s) written")
+               .arg(jobs.count())
+               .arg(generatedCount)
+               .arg(upToDateCount)
+               .arg(writtenCount)
+        << cendl;
+    return result;
+}
+
+/**
+ * @brief main
+ * @return
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("COOD");
+    QCoreApplication::setApplicationVersion(COOD_GENERATOR_VERSION);
+
+    QTextStream out(stdout, QIODevice::WriteOnly);
+    QTextStream err(stderr, QIODevice::WriteOnly);
+
+    QCommandLineParser cliParser;
+    cliParser.setApplicationDescription(QCoreApplication::translate("cood", "Object dictionary command line interface."));
+    cliParser.addHelpOption();
+    cliParser.addVersionOption();
+    addJobOptions(cliParser);
+
+    QCommandLineOption batchOption(QStringList() << "b"
+                                                 << "batch",
+                                   QCoreApplication::translate("cood", "Batch manifest, one cood command line per line"),
+                                   "manifest");
+    cliParser.addOption(batchOption);
+
+    QCommandLineOption jobsOption(QStringList() << "j"
+                                                << "jobs",
+                                  QCoreApplication::translate("cood", "Parallel jobs in batch mode (default: all cores)"),
+                                  "jobs");
+    cliParser.addOption(jobsOption);
+
+    QCommandLineOption forceOption(QStringList() << "f"
+                                                 << "force",
+                                   QCoreApplication::translate("cood", "Ignore batch cache and regenerate all outputs"));
+    cliParser.addOption(forceOption);
+
+    cliParser.process(app);
+
+    QString manifestFile = cliParser.value("batch");
+    if (!manifestFile.isEmpty())
+    {
+        int jobsCount = cliParser.value("jobs").toInt();
+        if (jobsCount <= 0)
+        {
+            jobsCount = QThread::idealThreadCount();
+        }
+        return runBatch(manifestFile, manifestFile + ".cache", jobsCount, cliParser.isSet("force"), out, err);
+    }
+
+    if (cliParser.positionalArguments().isEmpty())
+    {
+        err << QCoreApplication::translate("cood", "error (1): input file is needed") << cendl;
+        cliParser.showHelp(-1);
+    }
+
+    CoodJob job = jobFromParser(cliParser);
+    runJob(job);
+    if (job.result != 0 && !job.errorStr.isEmpty())
+    {
+        err << job.errorStr << cendl;
+    }
+    if (!job.layoutReport.isEmpty())
+    {
+        out << job.layoutReport;
+    }
+    return job.result;
+}
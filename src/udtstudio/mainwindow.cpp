@@ -63,6 +63,7 @@ MainWindow::MainWindow(QWidget *parent)
         bus->setBusName("Bus can0");
         CanOpen::addBus(bus);
         _canFrameListView->setBus(bus);
+        _busStatisticsWidget->setBus(bus);
     }
 
     bus = new CanOpenBus(new CanBusTcpUDT("192.168.1.80"));
@@ -135,6 +136,13 @@ void MainWindow::createDocks()
     addDockWidget(Qt::LeftDockWidgetArea, _canFrameListDock);
     tabifyDockWidget(_busNodesManagerDock, _canFrameListDock);
 
+    _busStatisticsDock = new QDockWidget(tr("Bus statistics"), this);
+    _busStatisticsDock->setObjectName("busStatisticsDock");
+    _busStatisticsWidget = new BusStatisticsWidget();
+    _busStatisticsDock->setWidget(_busStatisticsWidget);
+    addDockWidget(Qt::LeftDockWidgetArea, _busStatisticsDock);
+    tabifyDockWidget(_canFrameListDock, _busStatisticsDock);
+
     _dataLoggerDock = new QDockWidget(tr("Data logger"), this);
     _dataLoggerDock->setObjectName("dataLoggerDock");
     _dataLoggerWidget = new DataLoggerWidget();
@@ -225,6 +233,10 @@ void MainWindow::createMenus()
     action->setStatusTip(tr("View/hide CAN frame viewer"));
     viewMenu->addAction(action);
 
+    action = _busStatisticsDock->toggleViewAction();
+    action->setStatusTip(tr("View/hide bus statistics"));
+    viewMenu->addAction(action);
+
     action = _dataLoggerDock->toggleViewAction();
     action->setStatusTip(tr("View/hide data logger"));
     viewMenu->addAction(action);
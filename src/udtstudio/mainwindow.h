@@ -25,6 +25,7 @@
 
 #include "canopenbus.h"
 
+#include "can/busStatisticsWidget/busstatisticswidget.h"
 #include "can/canFrameListView/canframelistview.h"
 #include "canopen/busnodesmanagerview.h"
 
@@ -52,6 +53,8 @@ protected:
     BusNodesManagerView *_busNodesManagerView;
     QDockWidget *_canFrameListDock;
     CanFrameListView *_canFrameListView;
+    QDockWidget *_busStatisticsDock;
+    BusStatisticsWidget *_busStatisticsWidget;
     QDockWidget *_dataLoggerDock;
     DataLoggerWidget *_dataLoggerWidget;
 
@@ -0,0 +1,14 @@
+QT       += core network testlib
+QT       -= gui
+
+TEMPLATE = app
+DESTDIR = "$$PWD/../../bin"
+
+DEFINES += QT_DEPRECATED_WARNINGS
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../../src/lib/od/ $$PWD/../../src/lib/canopen/
+
+LIBS += -L"$$PWD/../../bin" -lod -lcanopen
+unix: QMAKE_RPATHDIR += $$PWD/../../bin
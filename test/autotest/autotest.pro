@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    tcpudtloopback \
+    socketcanbench \
+    iptrajectory \
+    odgenerator
@@ -0,0 +1,12 @@
+include(../autotest.pri)
+
+TARGET = tst_iptrajectory
+
+DEFINES += EDS_DIR=\\\"$$PWD/../../../eds\\\"
+
+SOURCES += \
+    $$PWD/simulatedipdrive.cpp \
+    $$PWD/tst_iptrajectory.cpp
+
+HEADERS += \
+    $$PWD/simulatedipdrive.h
@@ -0,0 +1,322 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "simulatedipdrive.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+enum
+{
+    IP_SETPOINT_INDEX = 0x60C1,
+    IP_BUFFER_CLEAR_INDEX = 0x60C4,
+    IP_BUFFER_CLEAR_SUBINDEX = 0x06,
+    MODES_OF_OPERATION_INDEX = 0x6060,
+    MODES_OF_OPERATION_DISPLAY_INDEX = 0x6061,
+    POSITION_ACTUAL_INDEX = 0x6064,
+
+    NMT_STOPPED = 0x04,
+    NMT_OPERATIONAL = 0x05,
+    NMT_PREOP = 0x7F
+};
+
+static quint32 objectKey(quint16 index, quint8 subIndex)
+{
+    return (static_cast<quint32>(index) << 8) | subIndex;
+}
+
+SimulatedIpDrive::SimulatedIpDrive(quint8 nodeId)
+    : CanBusDriver(QStringLiteral("simulated"))
+{
+    _nodeId = nodeId;
+    _nmtState = NMT_PREOP;
+    _rpdoSetpointValid = false;
+    _rpdoSetpoint = 0;
+    _position = 0;
+    _consumedSetpoints = 0;
+    _underruns = 0;
+    _notifyScheduled = false;
+
+    setObject(0x1400, 0x01, 0x200U + _nodeId);
+    setObject(0x1800, 0x01, 0x180U + _nodeId);
+    setObject(0x1800, 0x02, 1);
+
+    connect(&_heartbeatTimer, &QTimer::timeout, this, &SimulatedIpDrive::sendHeartbeat);
+    _heartbeatTimer.start(100);
+}
+
+quint32 SimulatedIpDrive::object(quint16 index, quint8 subIndex) const
+{
+    return _objects.value(objectKey(index, subIndex), 0);
+}
+
+void SimulatedIpDrive::setObject(quint16 index, quint8 subIndex, quint32 value)
+{
+    _objects.insert(objectKey(index, subIndex), value);
+}
+
+qint32 SimulatedIpDrive::position() const
+{
+    return _position;
+}
+
+int SimulatedIpDrive::consumedSetpoints() const
+{
+    return _consumedSetpoints;
+}
+
+/**
+ * @brief number of SYNC received in operational state with no setpoint to consume
+ */
+int SimulatedIpDrive::underruns() const
+{
+    return _underruns;
+}
+
+bool SimulatedIpDrive::connectDevice()
+{
+    setState(CONNECTED);
+    return true;
+}
+
+void SimulatedIpDrive::disconnectDevice()
+{
+    setState(DISCONNECTED);
+}
+
+QCanBusFrame SimulatedIpDrive::readFrame()
+{
+    if (_rxQueue.isEmpty())
+    {
+        return QCanBusFrame(QCanBusFrame::InvalidFrame);
+    }
+    return _rxQueue.dequeue();
+}
+
+bool SimulatedIpDrive::writeFrame(const QCanBusFrame &qtframe)
+{
+    if (state() != CONNECTED)
+    {
+        return false;
+    }
+
+    quint32 frameId = qtframe.frameId();
+    if (frameId == 0x000)
+    {
+        receiveNmt(qtframe);
+    }
+    else if (frameId == 0x080)
+    {
+        sync();
+    }
+    else if (frameId == 0x600U + _nodeId)
+    {
+        receiveSdo(qtframe);
+    }
+    else if (_nmtState == NMT_OPERATIONAL && frameId == (object(0x1400, 0x01) & 0x7FF) && (object(0x1400, 0x01) & 0x80000000U) == 0)
+    {
+        receiveRpdo(qtframe);
+    }
+    return true;
+}
+
+void SimulatedIpDrive::sync()
+{
+    if (_nmtState != NMT_OPERATIONAL)
+    {
+        return;
+    }
+
+    if (_rpdoSetpointValid)
+    {
+        _position = _rpdoSetpoint;
+        _rpdoSetpointValid = false;
+        _consumedSetpoints++;
+    }
+    else if (!_ipBuffer.isEmpty())
+    {
+        _position = _ipBuffer.dequeue();
+        _consumedSetpoints++;
+    }
+    else
+    {
+        _underruns++;
+    }
+    setObject(POSITION_ACTUAL_INDEX, 0x00, static_cast<quint32>(_position));
+
+    quint32 cobId = object(0x1800, 0x01);
+    if ((cobId & 0x80000000U) != 0)
+    {
+        return;
+    }
+    QByteArray payload;
+    quint8 count = static_cast<quint8>(object(0x1A00, 0x00));
+    for (quint8 entry = 1; entry <= count; entry++)
+    {
+        quint32 mapping = object(0x1A00, entry);
+        quint32 value = object(static_cast<quint16>(mapping >> 16), static_cast<quint8>(mapping >> 8));
+        char bytes[4];
+        qToLittleEndian<quint32>(value, bytes);
+        payload.append(bytes, static_cast<int>((mapping & 0xFF) / 8));
+    }
+    sendFrame(cobId & 0x7FF, payload);
+}
+
+void SimulatedIpDrive::receiveNmt(const QCanBusFrame &frame)
+{
+    const QByteArray payload = frame.payload();
+    if (payload.size() < 2 || (static_cast<quint8>(payload.at(1)) != 0 && static_cast<quint8>(payload.at(1)) != _nodeId))
+    {
+        return;
+    }
+
+    switch (static_cast<quint8>(payload.at(0)))
+    {
+        case 0x01:  // start
+            _nmtState = NMT_OPERATIONAL;
+            break;
+
+        case 0x02:  // stop
+            _nmtState = NMT_STOPPED;
+            break;
+
+        case 0x80:  // pre-operational
+            _nmtState = NMT_PREOP;
+            break;
+
+        default:
+            return;
+    }
+    sendHeartbeat();
+}
+
+void SimulatedIpDrive::receiveRpdo(const QCanBusFrame &frame)
+{
+    const QByteArray payload = frame.payload();
+    int offset = 0;
+    quint8 count = static_cast<quint8>(object(0x1600, 0x00));
+    for (quint8 entry = 1; entry <= count; entry++)
+    {
+        quint32 mapping = object(0x1600, entry);
+        int size = static_cast<int>((mapping & 0xFF) / 8);
+        if (offset + size > payload.size())
+        {
+            return;
+        }
+
+        char bytes[4] = {0, 0, 0, 0};
+        memcpy(bytes, payload.constData() + offset, static_cast<size_t>(size));
+        storeObject(static_cast<quint16>(mapping >> 16), static_cast<quint8>(mapping >> 8), qFromLittleEndian<quint32>(bytes), true);
+        offset += size;
+    }
+}
+
+void SimulatedIpDrive::receiveSdo(const QCanBusFrame &frame)
+{
+    const QByteArray payload = frame.payload();
+    if (payload.size() != 8)
+    {
+        return;
+    }
+
+    quint8 command = static_cast<quint8>(payload.at(0));
+    quint16 index = qFromLittleEndian<quint16>(payload.constData() + 1);
+    quint8 subIndex = static_cast<quint8>(payload.at(3));
+
+    QByteArray response(8, 0);
+    response[1] = payload.at(1);
+    response[2] = payload.at(2);
+    response[3] = payload.at(3);
+
+    switch (command >> 5)
+    {
+        case 1:  // download initiate, only expedited transfers are simulated
+        {
+            if ((command & 0x02) == 0)
+            {
+                response[0] = static_cast<char>(0x80);
+                qToLittleEndian<quint32>(0x05040001, response.data() + 4);  // command specifier not valid
+                break;
+            }
+            int size = ((command & 0x01) != 0) ? 4 - ((command >> 2) & 0x03) : 4;
+            char bytes[4] = {0, 0, 0, 0};
+            memcpy(bytes, payload.constData() + 4, static_cast<size_t>(size));
+            storeObject(index, subIndex, qFromLittleEndian<quint32>(bytes), false);
+            response[0] = 0x60;
+            break;
+        }
+
+        case 2:  // upload initiate, always answered with 4 bytes
+            response[0] = 0x43;
+            qToLittleEndian<quint32>(object(index, subIndex), response.data() + 4);
+            break;
+
+        default:
+            return;
+    }
+    sendFrame(0x580U + _nodeId, response);
+}
+
+void SimulatedIpDrive::storeObject(quint16 index, quint8 subIndex, quint32 value, bool fromRpdo)
+{
+    setObject(index, subIndex, value);
+
+    if (index == IP_SETPOINT_INDEX && subIndex == 0x01)
+    {
+        if (fromRpdo)
+        {
+            _rpdoSetpoint = static_cast<qint32>(value);
+            _rpdoSetpointValid = true;
+        }
+        else
+        {
+            _ipBuffer.enqueue(static_cast<qint32>(value));
+        }
+    }
+    else if (index == IP_BUFFER_CLEAR_INDEX && subIndex == IP_BUFFER_CLEAR_SUBINDEX && value == 0)
+    {
+        _ipBuffer.clear();
+        _rpdoSetpointValid = false;
+    }
+    else if (index == MODES_OF_OPERATION_INDEX)
+    {
+        setObject(MODES_OF_OPERATION_DISPLAY_INDEX, 0x00, value);
+    }
+}
+
+void SimulatedIpDrive::sendFrame(quint32 frameId, const QByteArray &payload)
+{
+    _rxQueue.enqueue(QCanBusFrame(frameId, payload));
+    if (!_notifyScheduled)
+    {
+        _notifyScheduled = true;
+        QTimer::singleShot(0, this, &SimulatedIpDrive::notifyFrames);
+    }
+}
+
+void SimulatedIpDrive::sendHeartbeat()
+{
+    sendFrame(0x700U + _nodeId, QByteArray(1, static_cast<char>(_nmtState)));
+}
+
+void SimulatedIpDrive::notifyFrames()
+{
+    _notifyScheduled = false;
+    emit framesReceived();
+}
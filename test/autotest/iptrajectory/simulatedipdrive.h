@@ -0,0 +1,82 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef SIMULATEDIPDRIVE_H
+#define SIMULATEDIPDRIVE_H
+
+#include "busdriver/canbusdriver.h"
+
+#include <QHash>
+#include <QQueue>
+#include <QTimer>
+
+/**
+ * @brief In-process bus driver simulating one CiA 402 drive in interpolated position mode
+ *
+ * Expedited SDO transfers read and write a flat object dictionary, PDO mappings are taken from it.
+ * At each SYNC the drive consumes the setpoint received by RPDO, or else the oldest setpoint written
+ * by SDO, moves to it without lag, and sends its TPDO1 with the new position actual value.
+ * A heartbeat is produced every 100 ms.
+ */
+class SimulatedIpDrive : public CanBusDriver
+{
+    Q_OBJECT
+public:
+    SimulatedIpDrive(quint8 nodeId);
+
+    quint32 object(quint16 index, quint8 subIndex) const;
+    void setObject(quint16 index, quint8 subIndex, quint32 value);
+
+    qint32 position() const;
+    int consumedSetpoints() const;
+    int underruns() const;
+
+    // CanBusDriver interface
+public:
+    bool connectDevice() override;
+    void disconnectDevice() override;
+    QCanBusFrame readFrame() override;
+    bool writeFrame(const QCanBusFrame &qtframe) override;
+
+private:
+    quint8 _nodeId;
+    quint8 _nmtState;
+    QHash<quint32, quint32> _objects;
+
+    QQueue<qint32> _ipBuffer;
+    bool _rpdoSetpointValid;
+    qint32 _rpdoSetpoint;
+    qint32 _position;
+    int _consumedSetpoints;
+    int _underruns;
+
+    QQueue<QCanBusFrame> _rxQueue;
+    bool _notifyScheduled;
+    QTimer _heartbeatTimer;
+
+    void sync();
+    void receiveNmt(const QCanBusFrame &frame);
+    void receiveRpdo(const QCanBusFrame &frame);
+    void receiveSdo(const QCanBusFrame &frame);
+    void storeObject(quint16 index, quint8 subIndex, quint32 value, bool fromRpdo);
+    void sendFrame(quint32 frameId, const QByteArray &payload);
+    void sendHeartbeat();
+    void notifyFrames();
+};
+
+#endif  // SIMULATEDIPDRIVE_H
@@ -0,0 +1,198 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <QtTest>
+
+#include "canopenbus.h"
+#include "node.h"
+#include "objectrequest.h"
+#include "profile/p402/iptrajectorystreamer.h"
+#include "profile/p402/modeip.h"
+#include "profile/p402/nodeprofile402.h"
+#include "services/rpdo.h"
+#include "services/tpdo.h"
+
+#include "simulatedipdrive.h"
+
+/**
+ * @brief Streams a ramp with IpTrajectoryStreamer at 1 kHz SYNC to a SimulatedIpDrive,
+ * with the setpoint mapped in RPDO1 and with the SDO fallback, and reads TPDO mapped objects
+ * with an asynchronous request
+ */
+class TestIpTrajectory : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void streamRamp_data();
+    void streamRamp();
+
+    void tpdoRead();
+
+private:
+    enum
+    {
+        NodeId = 2,
+        SyncPeriodMs = 1,
+        RampDurationUs = 300000,
+        RampPosition = 30000
+    };
+
+    SimulatedIpDrive *_drive;
+    CanOpenBus *_bus;
+    Node *_node;
+    NodeProfile402 *_nodeProfile402;
+
+    static bool waitMapping(PDO *pdo, SimulatedIpDrive *drive, quint16 commIndex, const NodeObjectId &objectId);
+};
+
+void TestIpTrajectory::init()
+{
+    _drive = new SimulatedIpDrive(NodeId);
+    _bus = new CanOpenBus(_drive);
+    _node = new Node(NodeId, QStringLiteral("sim"), QStringLiteral(EDS_DIR "/umc1bds32_v1.0.2.eds"));
+    _bus->addNode(_node);
+
+    _nodeProfile402 = nullptr;
+    if (!_node->profiles().isEmpty())
+    {
+        _nodeProfile402 = dynamic_cast<NodeProfile402 *>(_node->profiles().first());
+    }
+    QVERIFY(_nodeProfile402 != nullptr);
+
+    _node->sendStart();
+    QTRY_COMPARE(_node->status(), Node::STARTED);
+}
+
+void TestIpTrajectory::cleanup()
+{
+    _bus->sync()->stopSync();
+    delete _bus;
+}
+
+/**
+ * @brief waits until the mapping of objectId is written to the drive and the PDO enabled again
+ */
+bool TestIpTrajectory::waitMapping(PDO *pdo, SimulatedIpDrive *drive, quint16 commIndex, const NodeObjectId &objectId)
+{
+    return QTest::qWaitFor(
+        [=]()
+        {
+            return pdo->isEnabled() && (drive->object(commIndex, 0x01) & 0x80000000U) == 0 && drive->object(commIndex + 0x200, 0x00) == 1
+                   && pdo->currentMappind().count() == 1 && pdo->isMappedObject(objectId);
+        },
+        5000);
+}
+
+void TestIpTrajectory::streamRamp_data()
+{
+    QTest::addColumn<bool>("rpdo");
+    QTest::addColumn<int>("lookahead");
+
+    QTest::newRow("rpdo") << true << 1;
+    QTest::newRow("sdo") << false << 4;
+}
+
+void TestIpTrajectory::streamRamp()
+{
+    QFETCH(bool, rpdo);
+    QFETCH(int, lookahead);
+
+    ModeIp *modeIp = dynamic_cast<ModeIp *>(_nodeProfile402->mode(NodeProfile402::OperationMode::IP));
+    QVERIFY(modeIp != nullptr);
+
+    // position actual value fed back by TPDO1, setpoint in RPDO1 or written by SDO
+    TPDO *tpdo = _node->tpdos().at(0);
+    tpdo->writeMapping({modeIp->positionActualValueObjectId()});
+    QVERIFY(waitMapping(tpdo, _drive, 0x1800, modeIp->positionActualValueObjectId()));
+
+    RPDO *rpdo1 = _node->rpdos().at(0);
+    const NodeObjectId rpdoObject = rpdo ? modeIp->targetObjectId() : _nodeProfile402->controlWordObjectId();
+    rpdo1->writeMapping({rpdoObject});
+    QVERIFY(waitMapping(rpdo1, _drive, 0x1400, rpdoObject));
+
+    _bus->sync()->startSync(SyncPeriodMs);
+
+    IpTrajectoryStreamer streamer(_nodeProfile402);
+    streamer.setLookahead(lookahead);
+    streamer.setFeedbackDelay(0);  // the simulated drive reports the consumed setpoint on the same SYNC
+    streamer.setPath(
+        [](qint64 timeUs)
+        {
+            return static_cast<qint32>(timeUs * RampPosition / RampDurationUs);
+        },
+        RampDurationUs);
+
+    QSignalSpy finishedSpy(&streamer, &IpTrajectoryStreamer::finished);
+    QSignalSpy abortedSpy(&streamer, &IpTrajectoryStreamer::aborted);
+    QVERIFY(streamer.start());
+    QCOMPARE(streamer.isRpdoStreaming(), rpdo);
+    QCOMPARE(streamer.periodUs(), static_cast<qint64>(SyncPeriodMs * 1000));
+
+    QTRY_VERIFY_WITH_TIMEOUT(streamer.status() != IpTrajectoryStreamer::Streaming, 10000);
+    QCOMPARE(abortedSpy.count(), 0);
+    QCOMPARE(finishedSpy.count(), 1);
+    QTRY_COMPARE(_drive->position(), static_cast<qint32>(RampPosition));
+
+    const IpTrajectoryStreamer::Stats &stats = streamer.stats();
+    int setpointCount = RampDurationUs / (SyncPeriodMs * 1000) + 1;
+    QCOMPARE(static_cast<int>(stats.syncCount), setpointCount);
+    QCOMPARE(static_cast<int>(rpdo ? stats.rpdoSetpoints : stats.sdoSetpoints), setpointCount);
+    QCOMPARE(stats.sdoErrors, 0U);
+    QVERIFY(stats.feedbackSamples > static_cast<quint32>(setpointCount * 9 / 10));
+
+    // feedback of a SYNC may be handled after the next one, one ramp step of error at most
+    qint32 rampStep = RampPosition * SyncPeriodMs * 1000 / RampDurationUs;
+    qInfo("%s: max following error %d, rms %.1f, held %u, drive underruns %d",
+          rpdo ? "rpdo" : "sdo",
+          stats.maxFollowingError,
+          stats.rmsFollowingError,
+          stats.sdoHeld,
+          _drive->underruns());
+    QVERIFY(stats.maxFollowingError <= rampStep);
+}
+
+void TestIpTrajectory::tpdoRead()
+{
+    ModeIp *modeIp = dynamic_cast<ModeIp *>(_nodeProfile402->mode(NodeProfile402::OperationMode::IP));
+    QVERIFY(modeIp != nullptr);
+
+    TPDO *tpdo = _node->tpdos().at(0);
+    tpdo->writeMapping({modeIp->positionActualValueObjectId()});
+    QVERIFY(waitMapping(tpdo, _drive, 0x1800, modeIp->positionActualValueObjectId()));
+
+    _bus->sync()->startSync(SyncPeriodMs);
+    QTRY_VERIFY(_node->isReadByPdo(modeIp->positionActualValueObjectId()));
+
+    // not uploaded, ended by the next TPDO
+    ObjectRequest::Status status = ObjectRequest::Pending;
+    ObjectRequest *request = _node->readObjectAsync(modeIp->positionActualValueObjectId(), 1000);
+    request->then(
+        [&status](ObjectRequest *finishedRequest)
+        {
+            status = finishedRequest->status();
+        });
+    QTRY_VERIFY(status != ObjectRequest::Pending);
+    QCOMPARE(status, ObjectRequest::Done);
+}
+
+QTEST_GUILESS_MAIN(TestIpTrajectory)
+
+#include "tst_iptrajectory.moc"
@@ -0,0 +1,104 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * Host stand-in for the firmware CANopen stack co_od.h, only what generated od_data.h/.c use
+ */
+
+#ifndef CO_OD_H
+#define CO_OD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// empty on host, sizes match natural alignment (OD_LAYOUT_CHECK)
+#ifndef _od_align
+#    define _od_align
+#endif
+
+typedef float float32_t;
+typedef double float64_t;
+typedef const char *vstring_t;
+typedef const char *ostring_t;
+typedef void *OD_domain_t;
+
+enum
+{
+    OD_OBJECT_NULL = 0x0,
+    OD_OBJECT_DOMAIN = 0x2,
+    OD_OBJECT_DEFTYPE = 0x5,
+    OD_OBJECT_DEFSTRUCT = 0x6,
+    OD_OBJECT_VAR = 0x7,
+    OD_OBJECT_ARRAY = 0x8,
+    OD_OBJECT_RECORD = 0x9
+};
+
+enum
+{
+    OD_TYPE_BOOLEAN = 0x0001,
+    OD_TYPE_INTEGER8 = 0x0002,
+    OD_TYPE_INTEGER16 = 0x0003,
+    OD_TYPE_INTEGER32 = 0x0004,
+    OD_TYPE_UNSIGNED8 = 0x0005,
+    OD_TYPE_UNSIGNED16 = 0x0006,
+    OD_TYPE_UNSIGNED32 = 0x0007,
+    OD_TYPE_REAL32 = 0x0008,
+    OD_TYPE_VISIBLE_STRING = 0x0009,
+    OD_TYPE_OCTET_STRING = 0x000A,
+    OD_TYPE_UNICODE_STRING = 0x000B,
+    OD_TYPE_TIME_OF_DAY = 0x000C,
+    OD_TYPE_TIME_DIFFERENCE = 0x000D,
+    OD_TYPE_DOMAIN = 0x000F,
+    OD_TYPE_INTEGER24 = 0x0010,
+    OD_TYPE_REAL64 = 0x0011,
+    OD_TYPE_INTEGER40 = 0x0012,
+    OD_TYPE_INTEGER48 = 0x0013,
+    OD_TYPE_INTEGER56 = 0x0014,
+    OD_TYPE_INTEGER64 = 0x0015,
+    OD_TYPE_UNSIGNED24 = 0x0016,
+    OD_TYPE_UNSIGNED40 = 0x0018,
+    OD_TYPE_UNSIGNED48 = 0x0019,
+    OD_TYPE_UNSIGNED56 = 0x001A,
+    OD_TYPE_UNSIGNED64 = 0x001B
+};
+
+enum
+{
+    OD_ACCESS_READ = 0x01,
+    OD_ACCESS_WRITE = 0x02,
+    OD_ACCESS_TPDO = 0x04,
+    OD_ACCESS_RPDO = 0x08
+};
+
+typedef struct
+{
+    uint8_t subNumber;
+    uint8_t accessPDOmapping;
+    uint16_t typeObject;
+    void *ptData;
+} OD_entrySubIndex_t;
+
+typedef struct
+{
+    uint16_t index;
+    uint8_t typeObject;
+    uint8_t nbSubIndex;
+    const OD_entrySubIndex_t *subEntries;
+} OD_entry_t;
+
+#endif  // CO_OD_H
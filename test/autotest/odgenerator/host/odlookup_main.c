@@ -0,0 +1,46 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * Host runner of the generated od_lookupSelfTest() and od_lookupBenchmark()
+ * usage: odlookup [loops], returns the self test error count
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "od_data.h"
+
+int main(int argc, char *argv[])
+{
+    uint32_t loops = 1000u;
+    uint32_t lookupClocks;
+    uint32_t searchClocks;
+    int errors;
+
+    if (argc > 1)
+    {
+        loops = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    errors = od_lookupSelfTest();
+    od_lookupBenchmark(loops, &lookupClocks, &searchClocks);
+
+    printf("errors %d lookup %u search %u\n", errors, (unsigned)lookupClocks, (unsigned)searchClocks);
+    return errors;
+}
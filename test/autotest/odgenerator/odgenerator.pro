@@ -0,0 +1,14 @@
+include(../autotest.pri)
+
+TARGET = tst_odgenerator
+
+DEFINES += EDS_DIR=\\\"$$PWD/../../../eds\\\"
+DEFINES += HOST_DIR=\\\"$$PWD/host\\\"
+
+SOURCES += \
+    $$PWD/tst_odgenerator.cpp
+
+OTHER_FILES += \
+    $$PWD/host/co_od.h \
+    $$PWD/host/odlayout_main.c \
+    $$PWD/host/odlookup_main.c
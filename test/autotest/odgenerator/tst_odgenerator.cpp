@@ -0,0 +1,198 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <QDir>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "generator/cgenerator.h"
+#include "model/deviceconfiguration.h"
+#include "parser/edsparser.h"
+
+/**
+ * @brief Generates od_data.h/.c of each eds in eds/, with lookup tables and with optimized layout,
+ * and builds them on host with a C compiler
+ *
+ * The compiler is taken from the CC environment variable, cc by default. Generated files only
+ * depend on co_od.h of the firmware CANopen stack, replaced here by host/co_od.h.
+ */
+class TestOdGenerator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void lookup_data();
+    void lookup();
+
+    void layout_data();
+    void layout();
+
+private:
+    QString _compiler;
+
+    static bool generate(const QString &edsFile, const QString &outputDir, bool lookupEnabled, bool layoutOptimized);
+    bool build(const QString &outputDir, const QStringList &sources, const QStringList &defines, const QString &program);
+    static QString run(const QString &program, const QStringList &arguments, int *exitCode);
+};
+
+void TestOdGenerator::initTestCase()
+{
+    _compiler = qEnvironmentVariable("CC", QStringLiteral("cc"));
+
+    QProcess compiler;
+    compiler.start(_compiler, QStringList() << QStringLiteral("--version"));
+    if (!compiler.waitForFinished())
+    {
+        QSKIP(qPrintable(QString("C compiler '%1' not available").arg(_compiler)));
+    }
+}
+
+void TestOdGenerator::lookup_data()
+{
+    QTest::addColumn<QString>("edsFile");
+
+    const QStringList edsFiles = QDir(EDS_DIR).entryList(QStringList() << QStringLiteral("*.eds"), QDir::Files, QDir::Name);
+    QVERIFY(!edsFiles.isEmpty());
+    for (const QString &edsFile : edsFiles)
+    {
+        QTest::newRow(qPrintable(edsFile)) << QDir(EDS_DIR).filePath(edsFile);
+    }
+}
+
+/**
+ * @brief od_lookupSelfTest() finds no difference with a linear search, od_lookupBenchmark() timings are reported
+ */
+void TestOdGenerator::lookup()
+{
+    QFETCH(QString, edsFile);
+
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+    QVERIFY(generate(edsFile, outputDir.path(), true, false));
+
+    QString program = outputDir.filePath(QStringLiteral("odlookup"));
+    QVERIFY(build(outputDir.path(), QStringList() << QStringLiteral(HOST_DIR "/odlookup_main.c"), QStringList() << QStringLiteral("OD_LOOKUP_SELFTEST"), program));
+
+    int exitCode;
+    QString output = run(program, QStringList() << QStringLiteral("10000"), &exitCode);
+    qInfo().noquote() << QFileInfo(edsFile).fileName() << output;
+    QCOMPARE(exitCode, 0);
+}
+
+void TestOdGenerator::layout_data()
+{
+    lookup_data();
+}
+
+/**
+ * @brief optimized layout builds with OD_LAYOUT_CHECK, sizeof(struct sOD_RAM) before and after is reported
+ */
+void TestOdGenerator::layout()
+{
+    QFETCH(QString, edsFile);
+
+    QList<uint> ramSizes;
+    for (bool layoutOptimized : {false, true})
+    {
+        QTemporaryDir outputDir;
+        QVERIFY(outputDir.isValid());
+        QVERIFY(generate(edsFile, outputDir.path(), false, layoutOptimized));
+
+        QStringList defines;
+        if (layoutOptimized)
+        {
+            defines << QStringLiteral("OD_LAYOUT_CHECK");
+        }
+        QString program = outputDir.filePath(QStringLiteral("odlayout"));
+        QVERIFY(build(outputDir.path(), QStringList() << QStringLiteral(HOST_DIR "/odlayout_main.c"), defines, program));
+
+        int exitCode;
+        bool ok;
+        ramSizes.append(run(program, QStringList(), &exitCode).toUInt(&ok));
+        QCOMPARE(exitCode, 0);
+        QVERIFY(ok);
+    }
+
+    qInfo().noquote() << QFileInfo(edsFile).fileName() << "sizeof(struct sOD_RAM):" << ramSizes.at(0) << "->" << ramSizes.at(1);
+    QVERIFY(ramSizes.at(1) <= ramSizes.at(0));
+}
+
+bool TestOdGenerator::generate(const QString &edsFile, const QString &outputDir, bool lookupEnabled, bool layoutOptimized)
+{
+    DeviceDescription *deviceDescription = EdsParser().parse(edsFile);
+    if (deviceDescription == nullptr)
+    {
+        qWarning() << "cannot parse" << edsFile;
+        return false;
+    }
+    DeviceConfiguration *deviceConfiguration = DeviceConfiguration::fromDeviceDescription(deviceDescription, 1);
+    delete deviceDescription;
+
+    CGenerator generator;
+    generator.setLookupEnabled(lookupEnabled);
+    generator.setLayoutOptimized(layoutOptimized);
+    bool generated = generator.generateC(deviceConfiguration, outputDir + "/od_data.c") && generator.generateH(deviceConfiguration, outputDir + "/od_data.h");
+    if (!generated)
+    {
+        qWarning().noquote() << generator.errorStr();
+    }
+    delete deviceConfiguration;
+    return generated;
+}
+
+bool TestOdGenerator::build(const QString &outputDir, const QStringList &sources, const QStringList &defines, const QString &program)
+{
+    QStringList arguments;
+    arguments << QStringLiteral("-std=c99") << QStringLiteral("-O2");
+    for (const QString &define : defines)
+    {
+        arguments << QStringLiteral("-D") + define;
+    }
+    arguments << QStringLiteral("-I") + outputDir << QStringLiteral("-I" HOST_DIR);
+    arguments << outputDir + "/od_data.c" << sources;
+    arguments << QStringLiteral("-o") << program;
+
+    int exitCode;
+    QString output = run(_compiler, arguments, &exitCode);
+    if (exitCode != 0)
+    {
+        qWarning().noquote() << output;
+        return false;
+    }
+    return true;
+}
+
+QString TestOdGenerator::run(const QString &program, const QStringList &arguments, int *exitCode)
+{
+    QProcess process;
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.start(program, arguments);
+    if (!process.waitForFinished(60000) || process.exitStatus() != QProcess::NormalExit)
+    {
+        *exitCode = -1;
+        return process.errorString();
+    }
+    *exitCode = process.exitCode();
+    return QString::fromLocal8Bit(process.readAll()).trimmed();
+}
+
+QTEST_GUILESS_MAIN(TestOdGenerator)
+
+#include "tst_odgenerator.moc"
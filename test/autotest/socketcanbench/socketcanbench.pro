@@ -0,0 +1,6 @@
+include(../autotest.pri)
+
+TARGET = tst_socketcanbench
+
+SOURCES += \
+    $$PWD/tst_socketcanbench.cpp
@@ -0,0 +1,156 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <QElapsedTimer>
+#include <QVector>
+#include <QtTest>
+
+#include "busdriver/canbussocketcan.h"
+
+/**
+ * @brief Throughput of CanBusSocketCAN on a virtual CAN interface, with classic 8 bytes and FD 64 bytes frames,
+ * frame by frame and batched
+ *
+ * The interface is taken from the UDT_VCAN environment variable, vcan0 by default, and is created FD capable with:
+ * ip link add dev vcan0 type vcan && ip link set vcan0 mtu 72 && ip link set up vcan0
+ */
+class BenchSocketCan : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void throughput_data();
+    void throughput();
+
+private:
+    CanBusSocketCAN *_tx;
+    CanBusSocketCAN *_rx;
+
+    static int drain(CanBusDriver *driver);
+};
+
+void BenchSocketCan::initTestCase()
+{
+    QString interface = qEnvironmentVariable("UDT_VCAN", QStringLiteral("vcan0"));
+    _tx = new CanBusSocketCAN(interface);
+    _rx = new CanBusSocketCAN(interface);
+    if (!_tx->connectDevice() || !_rx->connectDevice())
+    {
+        QSKIP(qPrintable(QString("%1 not available").arg(interface)));
+    }
+}
+
+void BenchSocketCan::cleanupTestCase()
+{
+    delete _tx;
+    delete _rx;
+}
+
+int BenchSocketCan::drain(CanBusDriver *driver)
+{
+    int count = 0;
+    QCanBusFrame frame = driver->readFrame();
+    while (frame.isValid())
+    {
+        count++;
+        frame = driver->readFrame();
+    }
+    return count;
+}
+
+void BenchSocketCan::throughput_data()
+{
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<int>("batchSize");
+
+    QTest::newRow("classic 8 bytes") << 8 << 1;
+    QTest::newRow("fd 64 bytes") << 64 << 1;
+    QTest::newRow("classic writeFrames 8") << 8 << 8;
+    QTest::newRow("classic writeFrames 32") << 8 << 32;
+}
+
+void BenchSocketCan::throughput()
+{
+    enum
+    {
+        FrameCount = 50000
+    };
+    QFETCH(int, payloadSize);
+    QFETCH(int, batchSize);
+    if (payloadSize > 8 && (!_tx->isCanFd() || !_rx->isCanFd()))
+    {
+        QSKIP("interface MTU is not 72, CAN FD not available");
+    }
+
+    QVector<QCanBusFrame> frames;
+    frames.reserve(FrameCount);
+    for (int i = 0; i < FrameCount; i++)
+    {
+        QCanBusFrame frame(0x181 + static_cast<quint32>(i % 4), QByteArray(payloadSize, static_cast<char>(i)));
+        frame.setFlexibleDataRateFormat(payloadSize > 8);
+        frames.append(frame);
+    }
+    drain(_tx);
+    drain(_rx);
+
+    int written = 0;
+    int received = 0;
+    int txFull = 0;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (written < FrameCount && elapsed.elapsed() < 30000)
+    {
+        int count = qMin(batchSize, FrameCount - written);
+        int sent = (batchSize == 1) ? (_tx->writeFrame(frames.at(written)) ? 1 : 0) : _tx->writeFrames(frames.constData() + written, count);
+        written += sent;
+        if (sent < count)
+        {
+            // TX queue full, let the interface and the receiver catch up
+            txFull++;
+            QCoreApplication::processEvents();
+        }
+        drain(_tx);
+        received += drain(_rx);
+    }
+    while (received < written && elapsed.elapsed() < 30000)
+    {
+        QCoreApplication::processEvents();
+        drain(_tx);
+        received += drain(_rx);
+    }
+    qint64 elapsedNs = elapsed.nsecsElapsed();
+
+    QCOMPARE(written, static_cast<int>(FrameCount));
+    QCOMPARE(received, written);
+
+    qreal framesPerSecond = static_cast<qreal>(FrameCount) * 1e9 / static_cast<qreal>(elapsedNs);
+    qreal bytesPerSecond = framesPerSecond * payloadSize;
+    qInfo("payload %d, batch %d: %.0f frames/s, %.0f payload bytes/s, TX queue full %d times",
+          payloadSize,
+          batchSize,
+          framesPerSecond,
+          bytesPerSecond,
+          txFull);
+    QTest::setBenchmarkResult(framesPerSecond, QTest::Events);
+}
+
+QTEST_GUILESS_MAIN(BenchSocketCan)
+
+#include "tst_socketcanbench.moc"
@@ -0,0 +1,6 @@
+include(../autotest.pri)
+
+TARGET = tst_tcpudtloopback
+
+SOURCES += \
+    $$PWD/tst_tcpudtloopback.cpp
@@ -0,0 +1,190 @@
+/**
+ ** This file is part of the UDTStudio project.
+ ** Copyright 2019-2021 UniSwarm
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program. If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <QtTest>
+
+#include "busdriver/canbustcpudt.h"
+#include "busdriver/canbustcpudtserver.h"
+
+/**
+ * @brief Checks CanBusTcpUDT drivers against the local CanBusTcpUDTServer gateway stand-in
+ *
+ * Drivers with the same host and port share one TCP connection, distinct clients are obtained by
+ * reaching the server through 127.0.0.1 and localhost.
+ */
+class TestTcpUdtLoopback : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void forwardToOtherClients();
+    void echoToSender();
+    void busIdMultiplexing();
+    void batchOrder();
+
+private:
+    CanBusTcpUDTServer *_server;
+
+    QString adress(const QString &host, quint8 busId) const;
+    static bool waitConnected(CanBusTcpUDT *driver);
+    static int drain(CanBusDriver *driver, QList<QCanBusFrame> *frames);
+};
+
+void TestTcpUdtLoopback::init()
+{
+    _server = new CanBusTcpUDTServer();
+    QVERIFY(_server->listen(QHostAddress::Any, 0));
+}
+
+void TestTcpUdtLoopback::cleanup()
+{
+    delete _server;
+}
+
+QString TestTcpUdtLoopback::adress(const QString &host, quint8 busId) const
+{
+    return QString("%1:%2/%3").arg(host).arg(_server->serverPort()).arg(busId);
+}
+
+bool TestTcpUdtLoopback::waitConnected(CanBusTcpUDT *driver)
+{
+    driver->connectDevice();
+    return QTest::qWaitFor(
+        [driver]()
+        {
+            return driver->state() == CanBusDriver::CONNECTED;
+        },
+        5000);
+}
+
+int TestTcpUdtLoopback::drain(CanBusDriver *driver, QList<QCanBusFrame> *frames)
+{
+    QCanBusFrame frame = driver->readFrame();
+    while (frame.isValid())
+    {
+        frames->append(frame);
+        frame = driver->readFrame();
+    }
+    return frames->count();
+}
+
+void TestTcpUdtLoopback::forwardToOtherClients()
+{
+    _server->setEchoEnabled(false);
+    CanBusTcpUDT a(adress("127.0.0.1", 0));
+    CanBusTcpUDT b(adress("localhost", 0));
+    QVERIFY(waitConnected(&a));
+    QVERIFY(waitConnected(&b));
+    QTRY_COMPARE(_server->clientCount(), 2);
+
+    QList<QCanBusFrame> receivedA;
+    QList<QCanBusFrame> receivedB;
+    QVERIFY(a.writeFrame(QCanBusFrame(0x123, QByteArray::fromHex("0102030405060708"))));
+    QTRY_COMPARE(drain(&b, &receivedB), 1);
+    QCOMPARE(receivedB.first().frameId(), 0x123U);
+    QCOMPARE(receivedB.first().payload(), QByteArray::fromHex("0102030405060708"));
+
+    QTest::qWait(50);
+    QCOMPARE(drain(&a, &receivedA), 0);
+    QCOMPARE(_server->framesCount(), Q_UINT64_C(1));
+}
+
+void TestTcpUdtLoopback::echoToSender()
+{
+    _server->setEchoEnabled(true);
+    CanBusTcpUDT a(adress("127.0.0.1", 0));
+    QVERIFY(waitConnected(&a));
+    QTRY_COMPARE(_server->clientCount(), 1);
+
+    QList<QCanBusFrame> receivedA;
+    QVERIFY(a.writeFrame(QCanBusFrame(0x701, QByteArray(1, 0x05))));
+    QTRY_COMPARE(drain(&a, &receivedA), 1);
+    QCOMPARE(receivedA.first().frameId(), 0x701U);
+    QCOMPARE(receivedA.first().payload(), QByteArray(1, 0x05));
+}
+
+void TestTcpUdtLoopback::busIdMultiplexing()
+{
+    _server->setEchoEnabled(false);
+    CanBusTcpUDT a0(adress("127.0.0.1", 0));
+    CanBusTcpUDT a1(adress("127.0.0.1", 1));
+    CanBusTcpUDT b0(adress("localhost", 0));
+    CanBusTcpUDT b1(adress("localhost", 1));
+    QVERIFY(waitConnected(&a0));
+    QVERIFY(waitConnected(&a1));
+    QVERIFY(waitConnected(&b0));
+    QVERIFY(waitConnected(&b1));
+    QTRY_COMPARE(_server->clientCount(), 2);
+
+    QList<QCanBusFrame> receivedA0;
+    QList<QCanBusFrame> receivedB0;
+    QList<QCanBusFrame> receivedB1;
+    QVERIFY(a1.writeFrame(QCanBusFrame(0x181, QByteArray(2, 0x11))));
+    QVERIFY(a0.writeFrame(QCanBusFrame(0x182, QByteArray(2, 0x22))));
+    QTRY_COMPARE(drain(&b1, &receivedB1), 1);
+    QTRY_COMPARE(drain(&b0, &receivedB0), 1);
+    QCOMPARE(receivedB1.first().frameId(), 0x181U);
+    QCOMPARE(receivedB0.first().frameId(), 0x182U);
+
+    QTest::qWait(50);
+    QCOMPARE(drain(&b0, &receivedB0), 1);
+    QCOMPARE(drain(&b1, &receivedB1), 1);
+    QCOMPARE(drain(&a0, &receivedA0), 0);
+}
+
+void TestTcpUdtLoopback::batchOrder()
+{
+    enum
+    {
+        FrameCount = 5000
+    };
+
+    _server->setEchoEnabled(false);
+    CanBusTcpUDT a(adress("127.0.0.1", 0));
+    CanBusTcpUDT b(adress("localhost", 0));
+    QVERIFY(waitConnected(&a));
+    QVERIFY(waitConnected(&b));
+    QTRY_COMPARE(_server->clientCount(), 2);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (int i = 0; i < FrameCount; i++)
+    {
+        QByteArray payload(4, 0);
+        qToLittleEndian<quint32>(static_cast<quint32>(i), payload.data());
+        QVERIFY(a.writeFrame(QCanBusFrame(0x200 + static_cast<quint32>(i % 0x80), payload)));
+    }
+
+    QList<QCanBusFrame> receivedB;
+    QTRY_COMPARE_WITH_TIMEOUT(drain(&b, &receivedB), static_cast<int>(FrameCount), 10000);
+    qInfo("%d frames forwarded in %lld ms", static_cast<int>(FrameCount), elapsed.elapsed());
+
+    for (int i = 0; i < FrameCount; i++)
+    {
+        QCOMPARE(qFromLittleEndian<quint32>(receivedB.at(i).payload().constData()), static_cast<quint32>(i));
+    }
+    QCOMPARE(_server->framesCount(), static_cast<quint64>(FrameCount));
+}
+
+QTEST_GUILESS_MAIN(TestTcpUdtLoopback)
+
+#include "tst_tcpudtloopback.moc"